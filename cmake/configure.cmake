@@ -279,6 +279,17 @@ if (LITE_WITH_EXCEPTION)
   add_definitions("-DLITE_WITH_EXCEPTION")
 endif()
 
+if (LITE_WITH_JEMALLOC)
+  find_package(JeMalloc)
+  if (JEMALLOC_FOUND)
+    add_definitions("-DLITE_WITH_JEMALLOC")
+    # link jemalloc::jemalloc in common_link
+    set(WITH_JEMALLOC ON)
+  else()
+    message(WARNING "jemalloc is not found, the jemalloc allocator is disabled.")
+  endif()
+endif()
+
 if (LITE_ON_TINY_PUBLISH)
   add_definitions("-DLITE_ON_TINY_PUBLISH")
   add_definitions("-DLITE_ON_FLATBUFFERS_DESC_VIEW")
@@ -23,6 +23,7 @@
 
 #include "lite/api/paddle_use_passes.h"
 #include "lite/utils/io.h"
+#include "lite/utils/timer.h"
 
 namespace paddle {
 namespace lite {
@@ -323,6 +324,7 @@ void Predictor::Build(const std::string &model_path,
                       lite_api::LiteModelType model_type,
                       const lite_api::CxxConfig &config,
                       const lite_api::CxxModelBuffer &model_buffer) {
+  PhaseTimer timer;
   switch (model_type) {
     case lite_api::LiteModelType::kProtobuf: {
       bool combined_param = false;
@@ -341,12 +343,20 @@ void Predictor::Build(const std::string &model_path,
     case lite_api::LiteModelType::kNaiveBuffer:
       CHECK(!model_path.empty())
           << "NaiveBuffer backend only supported combined param";
-      LoadModelNaiveFromFile(model_path, scope_.get(), program_desc_.get());
+      LoadModelNaiveFromFile(
+          model_path, scope_.get(), program_desc_.get(), config.threads());
       break;
     default:
       LOG(FATAL) << "Unknown model type";
   }
+  timer.Mark("load_model");
   Build(program_desc_, valid_places, passes, config);
+  timer.Mark("optimize");
+#ifndef LITE_ON_MODEL_OPTIMIZE_TOOL
+  program_->PrepareKernelsAhead(config.threads());
+  timer.Mark("prepare_kernels");
+#endif
+  VLOG(1) << "Startup timing of the predictor: " << timer.Summary();
 }
 
 void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
@@ -396,6 +406,11 @@ void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
   // the same with that in models.
   CheckPaddleOpVersions(program_desc);
 
+  // Save the weights in the packed layouts of the kernels
+  if (config.prepacked_weights()) {
+    LOG(INFO) << "Packed the weights of " << program_->PackWeights()
+              << " kernels.";
+  }
   // Update the runtime program to program_desc only once
   program_->SaveRuntimProgramIntoProgramDesc(program_desc_);
 }
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>  //NOLINT
@@ -20,9 +21,11 @@
 #include <utility>
 #include <vector>
 #include "lite/api/paddle_api.h"
+#include "lite/api/streaming_runner.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/optimizer/optimizer.h"
 #include "lite/core/program.h"
+#include "lite/core/thread_pool.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/model_parser.h"
 
@@ -157,7 +160,11 @@ class LITE_API Predictor {
   void GenRuntimeProgram();
 
   // Run the predictor for a single batch of data.
-  void Run() {
+  void Run() { Run(std::function<bool()>()); }
+
+  // Run with `interrupted` checked between the ops, see RuntimeProgram::Run.
+  // Return false if the run was stopped.
+  bool Run(const std::function<bool()>& interrupted) {
     if (!program_generated_) {
       GenRuntimeProgram();
     }
@@ -171,11 +178,12 @@ class LITE_API Predictor {
     lite::TargetWrapperXPU::MallocL3Cache(query_shape);
 #endif
 
-    program_->Run();
+    bool completed = program_->Run(interrupted);
 
 #ifdef LITE_WITH_XPU
     lite::TargetWrapperXPU::FreeL3Cache();
 #endif
+    return completed;
   }
 
 #ifdef LITE_WITH_METAL
@@ -221,6 +229,7 @@ class LITE_API Predictor {
   const lite::Tensor* GetTensor(const std::string& name) const;
   const RuntimeProgram& runtime_program() const;
   Scope* scope() { return scope_.get(); }
+  Scope* exec_scope() { return exec_scope_; }
 
   // This method is disabled in mobile, for unnecessary dependencies required.
   void SaveModel(
@@ -288,6 +297,20 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       const std::string& name) const;
 
   void Run() override;
+  void FlushPipelinedRuns() override;
+  // Run with `interrupted` checked between the ops, the run stops once it
+  // returns true. Return false if the run was stopped.
+  bool RunInterruptible(const std::function<bool()>& interrupted);
+  void RunAsync(const std::function<void(lite_api::RunStatus)>& callback,
+                int64_t timeout_ms = 0) override;
+  void CancelAsync() override;
+  void AddStreamingState(const std::string& output_name,
+                         const std::string& input_name) override;
+  void AddStreamingContext(const std::string& input_name,
+                           int axis,
+                           int frames) override;
+  void RunStreaming() override;
+  void ResetStreaming() override;
 
   /// \brief Release all tmp tensor to compress the size of the memory pool.
   /// The memory pool is considered to be composed of a list of chunks, if
@@ -321,11 +344,48 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
       bool record_info = false) override;
 
+  Predictor* raw_predictor() { return raw_predictor_.get(); }
+
  private:
   std::shared_ptr<Predictor> raw_predictor_;
   lite_api::CxxConfig config_;
   std::mutex mutex_;
   bool status_is_cloned_;
+  StreamingRunner streaming_runner_{this};
+  // Destroyed first, it waits for the runs using the members above.
+  AsyncRunQueue async_runs_;
+};
+
+/*
+ * ModelGroupImpl runs the predictors of several models one after another with
+ * the weights deduplicated and the activations in a shared arena, see
+ * `lite_api::ModelGroup`.
+ */
+class ModelGroupImpl : public lite_api::ModelGroup {
+ public:
+  ModelGroupImpl() = default;
+  virtual ~ModelGroupImpl();
+  void Init(const std::vector<lite_api::CxxConfig>& configs);
+
+  int size() const override { return static_cast<int>(predictors_.size()); }
+  std::shared_ptr<lite_api::PaddlePredictor> GetPredictor(int i) override;
+  void Run(int i) override;
+  lite_api::ModelGroupStatistics Statistics() const override;
+
+ private:
+  // Share the persistable tensors identical to the ones of the models loaded
+  // before.
+  void DedupWeights(Predictor* predictor);
+
+  std::string arena_name_;
+  std::vector<std::shared_ptr<CxxPaddleApiImpl>> predictors_;
+  // The weights of the models loaded before by the hash of their content.
+  std::multimap<size_t, Tensor*> weights_;
+  // The largest activations of every model.
+  std::vector<int64_t> activation_bytes_;
+  lite_api::ModelGroupStatistics weight_stats_;
+  int last_run_{-1};
+  mutable std::mutex mutex_;
 };
 
 /*
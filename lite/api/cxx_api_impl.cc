@@ -17,7 +17,9 @@
 #include <mutex>  //NOLINT
 #include <string>
 #include "lite/api/paddle_api.h"
+#include "lite/core/allocator.h"
 #include "lite/core/device_info.h"
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
 #include "lite/core/optimizer/mir/pass_manager.h"
 #include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
 #include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
@@ -113,6 +115,8 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
             config.nnadapter_mixed_precision_quantization_config_buffer());
     Context<TargetType::kNNAdapter>::SetNNAdapterDynamicShapeInfo(
         raw_predictor_->scope(), config.nnadapter_dynamic_shape_info());
+    Context<TargetType::kNNAdapter>::SetNNAdapterPipelinedExecution(
+        raw_predictor_->scope(), config.nnadapter_pipelined_execution());
 #endif
 
     auto use_layout_preprocess_pass =
@@ -144,6 +148,15 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
       sparse_detect_pass->SetSparseThreshold(1.5);
     }
 
+    auto *constant_folding_pass =
+        mir::PassManager::Global().LookUp<mir::ConstantFoldingPass>(
+            "constant_folding_pass");
+    CHECK(constant_folding_pass);
+    constant_folding_pass->SetFoldPartialShapes(config.fold_partial_shapes());
+
+    // The persistable tensors are allocated when loading the model
+    AllocatorGuard allocator_guard(config.persistable_allocator(),
+                                   config.memory_alignment());
     raw_predictor_->Build(config, places, passes);
   } else {
     raw_predictor_->PrepareFeedFetch();
@@ -267,13 +280,60 @@ std::vector<std::string> CxxPaddleApiImpl::GetOutputNames() {
   return raw_predictor_->GetOutputNames();
 }
 
-void CxxPaddleApiImpl::Run() {
+void CxxPaddleApiImpl::Run() { RunInterruptible(std::function<bool()>()); }
+
+void CxxPaddleApiImpl::FlushPipelinedRuns() {
+#if defined(LITE_ON_MODEL_OPTIMIZE_TOOL) || defined(LITE_WITH_PYTHON) || \
+    defined(LITE_WITH_NNADAPTER)
+  auto scope = raw_predictor_->scope();
+  if (!Context<TargetType::kNNAdapter>::NNAdapterPipelinedExecution(scope)) {
+    return;
+  }
+  // The subgraphs deliver the results of the last run instead of executing
+  Context<TargetType::kNNAdapter>::SetNNAdapterPipelinedFlush(scope, true);
+  Run();
+  Context<TargetType::kNNAdapter>::SetNNAdapterPipelinedFlush(scope, false);
+#endif
+}
+
+bool CxxPaddleApiImpl::RunInterruptible(
+    const std::function<bool()> &interrupted) {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
 #endif
-  raw_predictor_->Run();
+  AllocatorGuard allocator_guard(config_.host_allocator(),
+                                 config_.memory_alignment());
+  return raw_predictor_->Run(interrupted);
 }
 
+void CxxPaddleApiImpl::RunAsync(
+    const std::function<void(lite_api::RunStatus)> &callback,
+    int64_t timeout_ms) {
+  async_runs_.Submit(
+      [this](const std::function<bool()> &interrupted) {
+        RunInterruptible(interrupted);
+      },
+      callback,
+      timeout_ms);
+}
+
+void CxxPaddleApiImpl::CancelAsync() { async_runs_.Cancel(); }
+
+void CxxPaddleApiImpl::AddStreamingState(const std::string &output_name,
+                                         const std::string &input_name) {
+  streaming_runner_.AddState(output_name, input_name);
+}
+
+void CxxPaddleApiImpl::AddStreamingContext(const std::string &input_name,
+                                           int axis,
+                                           int frames) {
+  streaming_runner_.AddContext(input_name, axis, frames);
+}
+
+void CxxPaddleApiImpl::RunStreaming() { streaming_runner_.Run(); }
+
+void CxxPaddleApiImpl::ResetStreaming() { streaming_runner_.Reset(); }
+
 std::shared_ptr<lite_api::PaddlePredictor> CxxPaddleApiImpl::Clone() {
   std::lock_guard<std::mutex> lock(mutex_);
   auto predictor =
@@ -312,7 +372,10 @@ void CxxPaddleApiImpl::SaveOptimizedModel(const std::string &model_dir,
 }
 
 bool CxxPaddleApiImpl::TryShrinkMemory() {
-  return raw_predictor_->TryShrinkMemory();
+  bool ret = raw_predictor_->TryShrinkMemory();
+  // Return the blocks cached by the pooled allocators to the system
+  AllocatorRegistry::Global().ReleaseAll();
+  return ret;
 }
 
 }  // namespace lite
@@ -15,21 +15,29 @@
 #include "lite/api/light_api.h"
 #include <algorithm>
 #include <map>
+#include <set>
+#include "lite/utils/timer.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
+#if defined(LITE_WITH_X86) && !defined(LITE_ON_MODEL_OPTIMIZE_TOOL)
+#include "lite/backends/x86/math/gemm_bf16.h"
+#endif
 
 namespace paddle {
 namespace lite {
 
 void LightPredictor::Build(const std::string& lite_model_file,
                            bool model_from_memory) {
+  PhaseTimer timer;
   if (model_from_memory) {
     LoadModelNaiveFromMemory(
-        lite_model_file, scope_.get(), program_desc_.get());
+        lite_model_file, scope_.get(), program_desc_.get(), threads_);
   } else {
-    LoadModelNaiveFromFile(lite_model_file, scope_.get(), program_desc_.get());
+    LoadModelNaiveFromFile(
+        lite_model_file, scope_.get(), program_desc_.get(), threads_);
   }
+  timer.Mark("load_model");
 
   // For weight quantization of post training, load the int8/16 weights
   // for optimized model, and dequant it to fp32.
@@ -38,8 +46,21 @@ void LightPredictor::Build(const std::string& lite_model_file,
   // fp16 Weight convert
   WeightFP32ToFP16();
 #endif
+#if defined(LITE_WITH_X86) && !defined(LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // bf16 Weight convert, left to the kernels for lazy weights
+  if (!lazy_weights_) WeightFP32ToBF16();
+#endif
+  timer.Mark("transform_weights");
   BuildRuntimeProgram(program_desc_);
   PrepareFeedFetch();
+  timer.Mark("build_program");
+  program_->PrepareKernelsAhead(threads_);
+  timer.Mark("prepare_kernels");
+  if (prefetch_weights_) {
+    PrefetchWeights();
+  }
+  startup_timing_ = timer.phases();
+  VLOG(1) << "Startup timing of the predictor: " << timer.Summary();
 }
 
 void LightPredictor::Build(const std::string& model_dir,
@@ -71,6 +92,10 @@ void LightPredictor::Build(const std::string& model_dir,
 #ifdef ENABLE_ARM_FP16
   // fp16 Weight convert
   WeightFP32ToFP16();
+#endif
+#if defined(LITE_WITH_X86) && !defined(LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // bf16 Weight convert, left to the kernels for lazy weights
+  if (!lazy_weights_) WeightFP32ToBF16();
 #endif
   BuildRuntimeProgram(program_desc_);
   PrepareFeedFetch();
@@ -204,6 +229,21 @@ void LightPredictor::BuildRuntimeProgram(
   CHECK(block_size);
   for (size_t block_idx = 0; block_idx < block_size; ++block_idx) {
     auto block_desc = program_desc->GetBlock<cpp::BlockDesc>(block_idx);
+    // The original weights replaced by the packed ones are not saved, but the
+    // ops still need their shapes
+    std::set<std::string> packed_var_names;
+    auto op_size = block_desc->OpsSize();
+    for (size_t op_idx = 0; op_idx < op_size; ++op_idx) {
+      auto op_desc = block_desc->GetOp<cpp::OpDesc>(op_idx);
+      if (op_desc->Type() == "lod_array_length") bool_clear_tensor_ = true;
+      if (op_desc->HasAttr(kPackedWeightsArgumentAttr)) {
+        auto argument =
+            op_desc->GetAttr<std::string>(kPackedWeightsArgumentAttr);
+        for (auto& var_name : op_desc->Input(argument)) {
+          packed_var_names.insert(var_name);
+        }
+      }
+    }
     auto var_size = block_desc->VarsSize();
     for (size_t var_idx = 0; var_idx < var_size; ++var_idx) {
       auto var_desc = block_desc->GetVar<cpp::VarDesc>(var_idx);
@@ -214,23 +254,64 @@ void LightPredictor::BuildRuntimeProgram(
               ConvertPrecisionType(var_desc->GetDataType());
           auto* tensor = var->GetMutable<lite::Tensor>();
           tensor->set_precision(var_data_type);
+          if (packed_var_names.count(var_desc->Name())) {
+            tensor->Resize(var_desc->GetShape());
+          }
         }
       } else {
         if (var_desc->Name() == "feed" || var_desc->Name() == "fetch") continue;
         scope_->Var(var_desc->Name());
       }
     }
-    auto op_size = block_desc->OpsSize();
-    for (size_t op_idx = 0; op_idx < op_size; ++op_idx) {
-      auto op_desc = block_desc->GetOp<cpp::OpDesc>(op_idx);
-      if (op_desc->Type() == "lod_array_length") bool_clear_tensor_ = true;
-    }
   }
   // Only extracting the ops and generate the runtime program from the main
   // block desc
   program_.reset(new RuntimeProgram(program_desc, exe_scope, kRootBlockIdx));
 }
 
+LightPredictor::~LightPredictor() { StopPrefetchWeights(); }
+
+void LightPredictor::StopPrefetchWeights() {
+  if (prefetch_thread_.joinable()) {
+    stop_prefetch_ = true;
+    prefetch_thread_.join();
+  }
+}
+
+void LightPredictor::PrefetchWeights() {
+  // Collect the weights in the order of the ops of the main block, which is
+  // the order the kernels touch them in the first run.
+  std::vector<const Tensor*> weights;
+  std::set<const Tensor*> visited;
+  auto* block = program_desc_->GetBlock<cpp::BlockDesc>(kRootBlockIdx);
+  for (size_t i = 0; i < block->OpsSize(); ++i) {
+    auto* op_desc = block->GetOp<cpp::OpDesc>(i);
+    for (auto& name : op_desc->input_vars()) {
+      auto* var = scope_->FindVar(name);
+      if (!var || !var->IsType<lite::Tensor>()) continue;
+      const auto* tensor = &var->Get<lite::Tensor>();
+      if (tensor->persistable() && visited.insert(tensor).second) {
+        weights.push_back(tensor);
+      }
+    }
+  }
+  prefetch_thread_ = std::thread([this, weights] {
+    const size_t page_size = 4096;
+    for (auto* tensor : weights) {
+      if (stop_prefetch_) break;
+      // Materialize the lazy buffers and fault in the pages of the mapped
+      // model file.
+      const volatile char* data =
+          static_cast<const char*>(tensor->raw_data());
+      if (!data) continue;
+      for (size_t j = 0; j < tensor->memory_size() && !stop_prefetch_;
+           j += page_size) {
+        (void)data[j];
+      }
+    }
+  });
+}
+
 void LightPredictor::DequantizeWeight() {
   std::shared_ptr<const cpp::ProgramDesc> program_desc = program_desc_;
   CHECK(program_desc != nullptr);
@@ -289,51 +370,71 @@ void LightPredictor::DequantizeWeight() {
             CHECK(scope_var != nullptr);
             auto input_tensor = scope_var->GetMutable<lite::Tensor>();
             CHECK(input_tensor != nullptr);
-            tmp_tensor.CopyDataFrom(*input_tensor);
             auto scale_list =
                 op_desc->GetAttr<std::vector<float>>(input_scale_name);
 
             int quantize_weight_bits =
                 op_desc->GetAttr<int>("quantize_weight_bits");
             CHECK(quantize_weight_bits == 8 || quantize_weight_bits == 16);
-            float* fp_data = input_tensor->mutable_data<float>();
-            CHECK(fp_data != nullptr);
 
             std::string op_type = op_desc->Type();
-            if (op_type == "conv2d" || op_type == "depthwise_conv2d") {
-              int64_t ch = input_tensor->dims()[0];
-              int64_t offset = input_tensor->numel() / ch;
-              CHECK_EQ(scale_list.size(), ch);
-              if (quantize_weight_bits == 8) {
-                const int8_t* int_data = tmp_tensor.data<int8_t>();
-                CHECK(int_data != nullptr);
-                PROCESS_CONV2D_DATA()
-              } else {
-                const int16_t* int_data = tmp_tensor.data<int16_t>();
-                CHECK(int_data != nullptr);
-                PROCESS_CONV2D_DATA()
-              }
-            } else if (op_type == "fc" || op_type == "mul" ||
-                       op_type == "lookup_table") {
-              int64_t chin = input_tensor->dims()[0];
-              int64_t chout = input_tensor->numel() / chin;
-              if (input_tensor->dims().size() > 1) {
-                chout = input_tensor->dims()[1];
-              } else {
-                // swap
-                chout = chin;
-                chin = 1;
-              }
-              CHECK_EQ(scale_list.size(), chout);
-              if (quantize_weight_bits == 8) {
-                const int8_t* int_data = tmp_tensor.data<int8_t>();
-                CHECK(int_data != nullptr);
-                PROCESS_FC_DATA()
-              } else {
-                const int16_t* int_data = tmp_tensor.data<int16_t>();
-                CHECK(int_data != nullptr);
-                PROCESS_FC_DATA()
+            const DDim dims = input_tensor->dims();
+            auto dequantize = [=](const Tensor& int_tensor, float* fp_data) {
+              CHECK(fp_data != nullptr);
+              if (op_type == "conv2d" || op_type == "depthwise_conv2d") {
+                int64_t ch = dims[0];
+                int64_t offset = dims.production() / ch;
+                CHECK_EQ(scale_list.size(), ch);
+                if (quantize_weight_bits == 8) {
+                  const int8_t* int_data = int_tensor.data<int8_t>();
+                  CHECK(int_data != nullptr);
+                  PROCESS_CONV2D_DATA()
+                } else {
+                  const int16_t* int_data = int_tensor.data<int16_t>();
+                  CHECK(int_data != nullptr);
+                  PROCESS_CONV2D_DATA()
+                }
+              } else if (op_type == "fc" || op_type == "mul" ||
+                         op_type == "lookup_table") {
+                int64_t chin = dims[0];
+                int64_t chout = dims.production() / chin;
+                if (dims.size() > 1) {
+                  chout = dims[1];
+                } else {
+                  // swap
+                  chout = chin;
+                  chin = 1;
+                }
+                CHECK_EQ(scale_list.size(), chout);
+                if (quantize_weight_bits == 8) {
+                  const int8_t* int_data = int_tensor.data<int8_t>();
+                  CHECK(int_data != nullptr);
+                  PROCESS_FC_DATA()
+                } else {
+                  const int16_t* int_data = int_tensor.data<int16_t>();
+                  CHECK(int_data != nullptr);
+                  PROCESS_FC_DATA()
+                }
               }
+            };
+
+            if (lazy_weights_) {
+              // Keep the quantized weight and dequantize it on the first use.
+              auto quantized = std::make_shared<Tensor>();
+              quantized->ShareDataWith(*input_tensor);
+              const size_t fp_size = dims.production() * sizeof(float);
+              input_tensor->ResetBuffer(
+                  std::make_shared<LazyBuffer>(
+                      TargetType::kHost,
+                      fp_size,
+                      [quantized, dequantize](void* dst, size_t size) {
+                        dequantize(*quantized, static_cast<float*>(dst));
+                      }),
+                  fp_size);
+              input_tensor->set_precision(PRECISION(kFloat));
+            } else {
+              tmp_tensor.CopyDataFrom(*input_tensor);
+              dequantize(tmp_tensor, input_tensor->mutable_data<float>());
             }
           }
         }
@@ -396,6 +497,25 @@ void LightPredictor::WeightFP32ToFP16() {
 }
 #endif
 
+#if defined(LITE_WITH_X86) && !defined(LITE_ON_MODEL_OPTIMIZE_TOOL)
+void LightPredictor::WeightFP32ToBF16() {
+  std::shared_ptr<const cpp::ProgramDesc> program_desc = program_desc_;
+  for (size_t i = 0; i < program_desc->BlocksSize(); i++) {
+    auto* block = program_desc->GetBlock<cpp::BlockDesc>(i);
+    for (size_t k = 0; k < block->OpsSize(); ++k) {
+      auto* op_desc = block->GetOp<cpp::OpDesc>(k);
+      for (auto& input_name : op_desc->input_vars()) {
+        // Set by bf16_attribute_pass on the weights of the x86 bf16 kernels.
+        if (!op_desc->HasAttr(input_name + "_bf16")) continue;
+        auto* var = scope_->FindVar(input_name);
+        if (var == nullptr) continue;
+        lite::x86::math::TensorToBF16(var->GetMutable<lite::Tensor>());
+      }
+    }
+  }
+}
+#endif
+
 void LightPredictor::CheckInputValid() {
   for (size_t idx = 0; idx < input_precisions_.size(); ++idx) {
     if (GetInput(idx)->precision() != input_precisions_[idx]) {
@@ -19,15 +19,20 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 #include "lite/api/paddle_api.h"
+#include "lite/api/streaming_runner.h"
 #include "lite/core/context.h"
 #include "lite/core/program.h"
 #include "lite/core/tensor.h"
+#include "lite/core/thread_pool.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/model_parser.h"
 
@@ -42,9 +47,19 @@ class LITE_API LightPredictor {
  public:
   // constructor function of LightPredictor, `lite_model_file` refers to data in
   // model file or buffer,`model_from_memory` refers to whther to load model
-  // from memory.
+  // from memory. `lazy_weights` defers the dequantization of the weights to
+  // their first use, and `prefetch_weights` touches the weights in execution
+  // order in a background thread from the end of the build to the first run,
+  // which stops the prefetching of the rest of the weights. `threads` is
+  // the number of threads to decode the params and prepare the kernels.
   LightPredictor(const std::string& lite_model_file,
-                 bool model_from_memory = false) {
+                 bool model_from_memory = false,
+                 bool lazy_weights = false,
+                 bool prefetch_weights = false,
+                 int threads = 1)
+      : lazy_weights_(lazy_weights),
+        prefetch_weights_(prefetch_weights),
+        threads_(threads) {
     scope_ = std::make_shared<Scope>();
     program_desc_ = std::make_shared<cpp::ProgramDesc>();
     Build(lite_model_file, model_from_memory);
@@ -62,10 +77,20 @@ class LITE_API LightPredictor {
     Build(model_dir, model_buffer, param_buffer, model_type, model_from_memory);
   }
 
-  void Run() {
+  ~LightPredictor();
+
+  void Run() { Run(std::function<bool()>()); }
+
+  // Run with `interrupted` checked between the ops, see RuntimeProgram::Run.
+  // Return false if the run was stopped.
+  bool Run(const std::function<bool()>& interrupted) {
+    // The kernels prepare, and may rewrite, their weights in the first run,
+    // so the prefetching must be done by then.
+    StopPrefetchWeights();
     CheckInputValid();
-    program_->Run();
+    bool completed = program_->Run(interrupted);
     if (bool_clear_tensor_) ClearTensorArray(program_desc_);
+    return completed;
   }
 
   /// \brief Release all tmp tensor to compress the size of the memory pool.
@@ -98,6 +123,11 @@ class LITE_API LightPredictor {
   void PrepareFeedFetch();
   Scope* scope() { return scope_.get(); }
 
+  // The elapsed time(ms) of the phases to build the predictor.
+  const std::vector<std::pair<std::string, float>>& startup_timing() const {
+    return startup_timing_;
+  }
+
 #ifdef LITE_WITH_METAL
   void ConfigMetalContext(const lite_api::MobileConfig& config) {
     program_->ConfigMetalContext(config.metal_lib_path(),
@@ -129,10 +159,18 @@ class LITE_API LightPredictor {
 
   void DequantizeWeight();
 
+  void PrefetchWeights();
+  // Stop the prefetching and wait for the thread to exit.
+  void StopPrefetchWeights();
+
 #ifdef ENABLE_ARM_FP16
   void WeightFP32ToFP16();
 #endif
 
+#if defined(LITE_WITH_X86) && !defined(LITE_ON_MODEL_OPTIMIZE_TOOL)
+  void WeightFP32ToBF16();
+#endif
+
   void ClearTensorArray(
       const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
 
@@ -144,6 +182,12 @@ class LITE_API LightPredictor {
   std::vector<std::string> output_names_;
   std::vector<PrecisionType> input_precisions_;
   bool bool_clear_tensor_ = false;
+  bool lazy_weights_{false};
+  bool prefetch_weights_{false};
+  int threads_{1};
+  std::vector<std::pair<std::string, float>> startup_timing_;
+  std::atomic<bool> stop_prefetch_{false};
+  std::thread prefetch_thread_;
 };
 
 class LightPredictorImpl : public lite_api::PaddlePredictor {
@@ -157,6 +201,20 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   std::unique_ptr<const lite_api::Tensor> GetOutputByName(
       const std::string& name) const;
   void Run() override;
+  void FlushPipelinedRuns() override;
+  // Run with `interrupted` checked between the ops, the run stops once it
+  // returns true. Return false if the run was stopped.
+  bool RunInterruptible(const std::function<bool()>& interrupted);
+  void RunAsync(const std::function<void(lite_api::RunStatus)>& callback,
+                int64_t timeout_ms = 0) override;
+  void CancelAsync() override;
+  void AddStreamingState(const std::string& output_name,
+                         const std::string& input_name) override;
+  void AddStreamingContext(const std::string& input_name,
+                           int axis,
+                           int frames) override;
+  void RunStreaming() override;
+  void ResetStreaming() override;
 
   std::shared_ptr<lite_api::PaddlePredictor> Clone() override;
   std::shared_ptr<lite_api::PaddlePredictor> Clone(
@@ -179,6 +237,11 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
 
  private:
   std::unique_ptr<lite::LightPredictor> raw_predictor_;
+  std::string host_allocator_{"default"};
+  size_t memory_alignment_{64};
+  StreamingRunner streaming_runner_{this};
+  // Destroyed first, it waits for the runs using the members above.
+  AsyncRunQueue async_runs_;
 };
 
 }  // namespace lite
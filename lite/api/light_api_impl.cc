@@ -15,6 +15,7 @@
 #include "lite/api/light_api.h"
 #include <string>
 #include "lite/api/paddle_api.h"
+#include "lite/core/allocator.h"
 #include "lite/core/version.h"
 #include "lite/model_parser/model_parser.h"
 #ifndef LITE_ON_TINY_PUBLISH
@@ -33,6 +34,11 @@ namespace paddle {
 namespace lite {
 
 void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
+  host_allocator_ = config.host_allocator();
+  memory_alignment_ = config.memory_alignment();
+  // The persistable tensors are allocated when loading the model
+  AllocatorGuard allocator_guard(config.persistable_allocator(),
+                                 memory_alignment_);
   // LightPredictor Only support NaiveBuffer backend in publish lib
   if (config.lite_model_file().empty()) {
     raw_predictor_.reset(
@@ -43,7 +49,10 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
                            lite_api::LiteModelType::kNaiveBuffer));
   } else {
     raw_predictor_.reset(new LightPredictor(config.lite_model_file(),
-                                            config.is_model_from_memory()));
+                                            config.is_model_from_memory(),
+                                            config.lazy_weights(),
+                                            config.prefetch_weights(),
+                                            config.threads()));
   }
   mode_ = config.power_mode();
   threads_ = config.threads();
@@ -80,6 +89,8 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
       raw_predictor_->scope(), config.nnadapter_model_cache_buffers());
   Context<TargetType::kNNAdapter>::SetNNAdapterDynamicShapeInfo(
       raw_predictor_->scope(), config.nnadapter_dynamic_shape_info());
+  Context<TargetType::kNNAdapter>::SetNNAdapterPipelinedExecution(
+      raw_predictor_->scope(), config.nnadapter_pipelined_execution());
 #endif
 
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
@@ -126,13 +137,59 @@ std::unique_ptr<const lite_api::Tensor> LightPredictorImpl::GetOutput(
       new lite_api::Tensor(raw_predictor_->GetOutput(i)));
 }
 
-void LightPredictorImpl::Run() {
+void LightPredictorImpl::Run() { RunInterruptible(std::function<bool()>()); }
+
+void LightPredictorImpl::FlushPipelinedRuns() {
+#if defined(LITE_ON_MODEL_OPTIMIZE_TOOL) || defined(LITE_WITH_PYTHON) || \
+    defined(LITE_WITH_NNADAPTER)
+  auto scope = raw_predictor_->scope();
+  if (!Context<TargetType::kNNAdapter>::NNAdapterPipelinedExecution(scope)) {
+    return;
+  }
+  // The subgraphs deliver the results of the last run instead of executing
+  Context<TargetType::kNNAdapter>::SetNNAdapterPipelinedFlush(scope, true);
+  Run();
+  Context<TargetType::kNNAdapter>::SetNNAdapterPipelinedFlush(scope, false);
+#endif
+}
+
+bool LightPredictorImpl::RunInterruptible(
+    const std::function<bool()>& interrupted) {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
 #endif
-  raw_predictor_->Run();
+  AllocatorGuard allocator_guard(host_allocator_, memory_alignment_);
+  return raw_predictor_->Run(interrupted);
+}
+
+void LightPredictorImpl::RunAsync(
+    const std::function<void(lite_api::RunStatus)>& callback,
+    int64_t timeout_ms) {
+  async_runs_.Submit(
+      [this](const std::function<bool()>& interrupted) {
+        RunInterruptible(interrupted);
+      },
+      callback,
+      timeout_ms);
+}
+
+void LightPredictorImpl::CancelAsync() { async_runs_.Cancel(); }
+
+void LightPredictorImpl::AddStreamingState(const std::string& output_name,
+                                           const std::string& input_name) {
+  streaming_runner_.AddState(output_name, input_name);
 }
 
+void LightPredictorImpl::AddStreamingContext(const std::string& input_name,
+                                             int axis,
+                                             int frames) {
+  streaming_runner_.AddContext(input_name, axis, frames);
+}
+
+void LightPredictorImpl::RunStreaming() { streaming_runner_.Run(); }
+
+void LightPredictorImpl::ResetStreaming() { streaming_runner_.Reset(); }
+
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone() {
   LOG(FATAL) << "The Clone API is not supported in LigthPredictor";
   return nullptr;
@@ -161,7 +218,10 @@ std::vector<std::string> LightPredictorImpl::GetOutputNames() {
 }
 
 bool LightPredictorImpl::TryShrinkMemory() {
-  return raw_predictor_->TryShrinkMemory();
+  bool ret = raw_predictor_->TryShrinkMemory();
+  // Return the blocks cached by the pooled allocators to the system
+  AllocatorRegistry::Global().ReleaseAll();
+  return ret;
 }
 
 }  // namespace lite
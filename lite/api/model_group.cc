@@ -0,0 +1,221 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include "lite/api/cxx_api.h"
+#include "lite/core/allocator.h"
+#include "lite/utils/hash.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+bool IsHostTensor(const Tensor& tensor) {
+  return tensor.target() == TARGET(kHost) || tensor.target() == TARGET(kX86) ||
+         tensor.target() == TARGET(kARM);
+}
+
+size_t HashTensor(const Tensor& tensor) {
+  size_t hash = 0;
+  CombineHash(static_cast<int>(tensor.precision()), &hash);
+  CombineHash(tensor.dims().repr(), &hash);
+  // FNV-1a over the 8-byte words, then the tail bytes.
+  const auto* data = static_cast<const uint8_t*>(tensor.raw_data());
+  const size_t size = tensor.memory_size();
+  uint64_t fnv = 14695981039346656037ULL;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(uint64_t));
+    fnv = (fnv ^ word) * 1099511628211ULL;
+  }
+  for (; i < size; i++) {
+    fnv = (fnv ^ data[i]) * 1099511628211ULL;
+  }
+  CombineHash(fnv, &hash);
+  return hash;
+}
+
+bool IsSameTensor(const Tensor& a, const Tensor& b) {
+  return a.precision() == b.precision() && a.dims() == b.dims() &&
+         a.memory_size() == b.memory_size() &&
+         memcmp(a.raw_data(), b.raw_data(), a.memory_size()) == 0;
+}
+
+// The bytes of the non-persistable tensors of a scope.
+int64_t ActivationBytes(Scope* scope) {
+  int64_t bytes = 0;
+  for (auto& name : scope->LocalVarNames()) {
+    auto* var = scope->FindLocalVar(name);
+    if (var->IsType<Tensor>()) {
+      auto& tensor = var->Get<Tensor>();
+      if (!tensor.persistable() && tensor.IsInitialized()) {
+        bytes += tensor.memory_size();
+      }
+    } else if (var->IsType<std::vector<Tensor>>()) {
+      for (auto& tensor : var->Get<std::vector<Tensor>>()) {
+        if (!tensor.persistable() && tensor.IsInitialized()) {
+          bytes += tensor.memory_size();
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
+}  // namespace
+
+void ModelGroupImpl::Init(const std::vector<lite_api::CxxConfig>& configs) {
+  CHECK(!configs.empty()) << "A model group needs one model at least.";
+  static std::atomic<int> group_count{0};
+  arena_name_ = "model_group_" + std::to_string(group_count++);
+  AllocatorRegistry::Global().Register(arena_name_, CreatePoolAllocator());
+
+  int threads = 1;
+  for (auto& config : configs) {
+    threads = (std::max)(threads, config.threads());
+  }
+  for (auto config : configs) {
+    // The weights keep the allocator of the config, the activations and the
+    // temporary buffers of all the models come from the arena.
+    config.set_host_allocator(arena_name_);
+    config.set_threads(threads);
+    auto predictor = std::make_shared<CxxPaddleApiImpl>();
+    predictor->Init(config);
+    DedupWeights(predictor->raw_predictor());
+    predictors_.push_back(predictor);
+    activation_bytes_.push_back(0);
+  }
+  VLOG(1) << "Model group " << arena_name_ << ": "
+          << Statistics().ToString();
+}
+
+ModelGroupImpl::~ModelGroupImpl() {
+  weights_.clear();
+  predictors_.clear();
+  if (!arena_name_.empty()) {
+    AllocatorRegistry::Global().Find(arena_name_)->allocator->Release();
+  }
+}
+
+void ModelGroupImpl::DedupWeights(Predictor* predictor) {
+  // The weights are in the root scope, the ones computed by the optimizer,
+  // such as the folded constants, may be in the exec scope.
+  std::vector<Scope*> scopes{predictor->scope()};
+  if (predictor->exec_scope() != predictor->scope()) {
+    scopes.push_back(predictor->exec_scope());
+  }
+  // Only the weights of different models are shared, the ones of a model are
+  // left as the optimizer laid them out. They are shared until written, so
+  // the kernels transforming their weights in place at PrepareForRun, such as
+  // conv2d_transpose on arm, write their own copies instead of the ones of
+  // the other models.
+  std::vector<std::pair<size_t, Tensor*>> loaded;
+  for (auto* scope : scopes) {
+    for (auto& name : scope->LocalVarNames()) {
+      auto* var = scope->FindLocalVar(name);
+      if (!var->IsType<Tensor>()) continue;
+      auto* tensor = var->GetMutable<Tensor>();
+      if (!tensor->persistable() || !tensor->IsInitialized() ||
+          !IsHostTensor(*tensor) || tensor->memory_size() == 0) {
+        continue;
+      }
+      weight_stats_.weight_bytes += tensor->memory_size();
+      size_t hash = HashTensor(*tensor);
+      auto range = weights_.equal_range(hash);
+      auto iter = std::find_if(
+          range.first,
+          range.second,
+          [&](const std::pair<const size_t, Tensor*>& weight) {
+            return IsSameTensor(*weight.second, *tensor);
+          });
+      if (iter != range.second) {
+        weight_stats_.deduped_weights++;
+        weight_stats_.deduped_weight_bytes += tensor->memory_size();
+        tensor->ShareDataCopyOnWrite(iter->second);
+      } else {
+        loaded.emplace_back(hash, tensor);
+      }
+    }
+  }
+  weights_.insert(loaded.begin(), loaded.end());
+}
+
+std::shared_ptr<lite_api::PaddlePredictor> ModelGroupImpl::GetPredictor(
+    int i) {
+  CHECK(i >= 0 && i < size()) << "The model " << i << " is out of the "
+                              << size() << " models of the group.";
+  return predictors_[i];
+}
+
+void ModelGroupImpl::Run(int i) {
+  CHECK(i >= 0 && i < size()) << "The model " << i << " is out of the "
+                              << size() << " models of the group.";
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Return the activations of the model run before to the arena, where the
+  // ones of this model are going to be allocated.
+  if (last_run_ >= 0 && last_run_ != i) {
+    predictors_[last_run_]->raw_predictor()->TryShrinkMemory();
+  }
+  predictors_[i]->Run();
+  last_run_ = i;
+  auto* exec_scope = predictors_[i]->raw_predictor()->exec_scope();
+  activation_bytes_[i] =
+      (std::max)(activation_bytes_[i], ActivationBytes(exec_scope));
+}
+
+lite_api::ModelGroupStatistics ModelGroupImpl::Statistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto stats = weight_stats_;
+  for (auto bytes : activation_bytes_) {
+    stats.activation_bytes += bytes;
+    stats.shared_activation_bytes =
+        (std::max)(stats.shared_activation_bytes, bytes);
+  }
+  stats.arena_bytes_peak =
+      AllocatorRegistry::Global().Statistics(arena_name_).bytes_peak;
+  return stats;
+}
+
+}  // namespace lite
+
+namespace lite_api {
+
+std::string ModelGroupStatistics::ToString() const {
+  auto mb = [](int64_t bytes) { return bytes / (1024. * 1024.); };
+  std::ostringstream os;
+  os.precision(2);
+  os << std::fixed << "weights: " << mb(weight_bytes) << " MB, deduped "
+     << deduped_weights << " tensors (" << mb(deduped_weight_bytes)
+     << " MB); activations: " << mb(activation_bytes) << " MB unshared, "
+     << mb(shared_activation_bytes)
+     << " MB shared; arena peak: " << mb(arena_bytes_peak) << " MB; saved "
+     << mb(deduped_weight_bytes + activation_bytes - shared_activation_bytes)
+     << " MB";
+  return os.str();
+}
+
+std::shared_ptr<ModelGroup> CreateModelGroup(
+    const std::vector<CxxConfig>& configs) {
+  auto group = std::make_shared<lite::ModelGroupImpl>();
+  group->Init(configs);
+  return group;
+}
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -16,10 +16,12 @@
 
 #include <utility>
 
+#include "lite/core/allocator.h"
 #include "lite/core/context.h"
 #include "lite/core/device_info.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
+#include "lite/core/thread_pool.h"
 
 #ifdef LITE_WITH_CUDA
 #include "lite/backends/cuda/target_wrapper.h"
@@ -113,6 +115,27 @@ void Tensor::ShareExternalMemory(void *data,
   tensor(raw_tensor_)->ResetBuffer(buf, memory_size);
 }
 
+void Tensor::ShareExternalMemory(void *data,
+                                 size_t memory_size,
+                                 TargetType target,
+                                 const std::function<void()> &release) {
+  std::shared_ptr<lite::Buffer> buf(
+      new lite::Buffer(data, target, memory_size),
+      [release](lite::Buffer *buffer) {
+        delete buffer;
+        if (release) release();
+      });
+  // Reset through a fresh tensor, ResetBuffer requires the new buffer to hold
+  // the current data of the tensor.
+  lite::Tensor shared;
+  shared.ResetBuffer(buf, memory_size);
+  auto *x = tensor(raw_tensor_);
+  shared.Resize(x->dims());
+  shared.set_precision(x->precision());
+  shared.set_lod(x->lod());
+  x->ShareDataWith(shared);
+}
+
 template <typename T>
 T *Tensor::mutable_data(TargetType type) const {
   return tensor(raw_tensor_)->mutable_data<T>(type);
@@ -277,6 +300,42 @@ lod_t Tensor::lod() const { return ctensor(raw_tensor_)->lod(); }
 
 void Tensor::SetLoD(const lod_t &lod) { tensor(raw_tensor_)->set_lod(lod); }
 
+void PaddlePredictor::RunAsync(const std::function<void(RunStatus)> &callback,
+                               int64_t timeout_ms) {
+  LOG(FATAL) << "The RunAsync API is not supported by this predictor.";
+}
+
+void PaddlePredictor::FlushPipelinedRuns() {}
+
+void PaddlePredictor::CancelAsync() {
+  LOG(FATAL) << "The CancelAsync API is not supported by this predictor.";
+}
+
+void PaddlePredictor::AddStreamingState(const std::string &output_name,
+                                        const std::string &input_name) {
+  LOG(FATAL) << "The AddStreamingState API is not supported by this "
+                "predictor.";
+}
+
+void PaddlePredictor::AddStreamingContext(const std::string &input_name,
+                                          int axis,
+                                          int frames) {
+  LOG(FATAL) << "The AddStreamingContext API is not supported by this "
+                "predictor.";
+}
+
+void PaddlePredictor::RunStreaming() {
+  LOG(FATAL) << "The RunStreaming API is not supported by this predictor.";
+}
+
+void PaddlePredictor::ResetStreaming() {
+  LOG(FATAL) << "The ResetStreaming API is not supported by this predictor.";
+}
+
+void SetAsyncRunThreads(int threads) {
+  lite::AsyncRunExecutor::Global().SetThreads(threads);
+}
+
 std::unique_ptr<Tensor> PaddlePredictor::GetMutableTensor(
     const std::string &name) {
   LOG(FATAL)
@@ -417,6 +476,33 @@ void ConfigBase::add_discarded_pass(const std::string pass) {
   return;
 }
 
+void ConfigBase::set_host_allocator(const std::string &name) {
+  CHECK(lite::AllocatorRegistry::Global().Has(name))
+      << "The allocator '" << name << "' is not registered.";
+  host_allocator_ = name;
+}
+
+void ConfigBase::set_persistable_allocator(const std::string &name) {
+  CHECK(lite::AllocatorRegistry::Global().Has(name))
+      << "The allocator '" << name << "' is not registered.";
+  persistable_allocator_ = name;
+}
+
+void ConfigBase::set_memory_alignment(size_t alignment) {
+  CHECK(alignment > 0 && (alignment & (alignment - 1)) == 0)
+      << "The memory alignment should be a power of 2, but got " << alignment;
+  memory_alignment_ = alignment;
+}
+
+void RegisterAllocator(const std::string &name,
+                       const std::shared_ptr<Allocator> &allocator) {
+  lite::AllocatorRegistry::Global().Register(name, allocator);
+}
+
+AllocatorStatistics GetAllocatorStatistics(const std::string &name) {
+  return lite::AllocatorRegistry::Global().Statistics(name);
+}
+
 #ifdef LITE_WITH_X86
 void ConfigBase::set_x86_math_num_threads(int threads) {
   x86_math_num_threads_ = threads;
@@ -70,6 +70,13 @@ struct LITE_API Tensor {
   // state
   // during the prediction process.
   void ShareExternalMemory(void* data, size_t memory_size, TargetType target);
+  // Share external memory, `release` is called once the tensor and the
+  // tensors sharing data with it no longer reference the memory. The previous
+  // buffer of the tensor is dropped whatever its size.
+  void ShareExternalMemory(void* data,
+                           size_t memory_size,
+                           TargetType target,
+                           const std::function<void()>& release);
 
   template <typename T, TargetType type = TargetType::kHost>
   void CopyFromCpu(const T* data);
@@ -93,6 +100,13 @@ struct LITE_API Tensor {
   void* raw_tensor_;
 };
 
+/// The result of an asynchronous run.
+enum class RunStatus {
+  kOk = 0,
+  kCancelled,         // Cancelled by `PaddlePredictor::CancelAsync`.
+  kDeadlineExceeded,  // The timeout expired before the run completed.
+};
+
 /// The PaddlePredictor defines the basic interfaces for different kinds of
 /// predictors.
 class LITE_API PaddlePredictor {
@@ -106,6 +120,7 @@ class LITE_API PaddlePredictor {
   virtual std::unique_ptr<const Tensor> GetOutput(int i) const = 0;
 
   virtual void Run() = 0;
+
   virtual std::shared_ptr<PaddlePredictor> Clone() = 0;
   virtual std::shared_ptr<PaddlePredictor> Clone(
       const std::vector<std::string>& var_names) = 0;
@@ -141,11 +156,106 @@ class LITE_API PaddlePredictor {
 
   virtual ~PaddlePredictor() = default;
 
+  // The virtuals below were added after the ones above, they are appended
+  // to keep the vtable layout of the earlier releases.
+
+  /// Run on the executor owned by the engine and return immediately, the
+  /// asynchronous runs of a predictor are executed one at a time in the order
+  /// of submission. The inputs should not be changed and the outputs should
+  /// not be read until `callback` is called with the status of the run on the
+  /// executor thread.
+  /// `timeout_ms` > 0 sets a deadline counted from the submission, it is
+  /// checked between the ops so an op in progress is never interrupted.
+  /// The destruction of the predictor cancels the pending runs and waits for
+  /// them, so it should not be released in `callback`.
+  virtual void RunAsync(const std::function<void(RunStatus)>& callback,
+                        int64_t timeout_ms = 0);
+
+  /// Cancel the asynchronous runs submitted before, the pending ones are
+  /// skipped and the running one stops before its next op. The outputs of a
+  /// cancelled run are undefined.
+  virtual void CancelAsync();
+
+  /// Get the results of the last `Run` to the outputs if the pipelined
+  /// execution is enabled, see `set_nnadapter_pipelined_execution`. The ops
+  /// outside the NNAdapter subgraphs are run again with the current inputs.
+  /// Do nothing otherwise.
+  virtual void FlushPipelinedRuns();
+
+  /// Streaming inference of a long sequence fed chunk by chunk, feed a chunk
+  /// to the inputs and call `RunStreaming`, so the cost of a chunk is
+  /// proportional to its size rather than to the whole history.
+  /// Carry the output `output_name` of a run, e.g. the `State` of a rnn op, to
+  /// the input `input_name` of the next run. The initial states should be fed
+  /// before the first chunk.
+  virtual void AddStreamingState(const std::string& output_name,
+                                 const std::string& input_name);
+  /// Prepend the last `frames` frames of the input `input_name` along `axis`
+  /// to its next chunk, which provides the receptive field of the
+  /// convolutions over time. Zeros are prepended to the first chunk.
+  /// The outputs are computed over the prepended frames as well, e.g. a
+  /// frame-wise output has `frames` more rows than the chunk, and these
+  /// leading rows must be dropped by the caller.
+  virtual void AddStreamingContext(const std::string& input_name,
+                                   int axis,
+                                   int frames);
+  /// Run a chunk of the stream, it should not be mixed with `RunAsync`. The
+  /// inputs with a context are left extended with the prepended frames, and
+  /// the outputs include the rows of these frames, see `AddStreamingContext`.
+  virtual void RunStreaming();
+  /// Start a new stream, the contexts are dropped and the states are zeroed.
+  virtual void ResetStreaming();
+
  protected:
   int threads_{1};
   lite_api::PowerMode mode_{lite_api::LITE_POWER_NO_BIND};
 };
 
+/// \brief Set the number of the worker threads which execute `RunAsync`, the
+/// default is the number of the hardware threads. Each run also uses the
+/// threads of its predictor, so set it to about cores / threads of a
+/// predictor to avoid oversubscribing the CPU. It only takes effect before
+/// the first `RunAsync`.
+LITE_API void SetAsyncRunThreads(int threads);
+
+/// \brief Host memory allocator used by the tensors and the temporary buffers
+/// of the kernels on kHost/kX86/kARM.
+///
+/// The built-in allocators are:
+///   "default": the system malloc.
+///   "pool": a size-class pool which caches the freed blocks, it avoids the
+///   reallocation of the activations when the input shape changes.
+///   "huge_page": 2MB transparent huge pages for the allocations larger than
+///   2MB (Linux only), it is suggested for the persistable tensors.
+///   "jemalloc": only available when compiled with LITE_WITH_JEMALLOC=ON.
+/// A custom allocator can be registered by `RegisterAllocator` and selected
+/// for a predictor by `ConfigBase::set_host_allocator`.
+class LITE_API Allocator {
+ public:
+  virtual ~Allocator() = default;
+  // Allocate at least `size` bytes, the alignment is handled by the caller.
+  virtual void* Allocate(size_t size) = 0;
+  // Deallocate the memory returned by `Allocate` with the same `size`.
+  virtual void Deallocate(void* ptr, size_t size) = 0;
+  // Return the cached memory to the system if any.
+  virtual void Release() {}
+};
+
+struct LITE_API AllocatorStatistics {
+  int64_t bytes_live{0};
+  int64_t bytes_peak{0};
+  int64_t alloc_count{0};
+  int64_t free_count{0};
+};
+
+/// \brief Register a host allocator with an unique name.
+LITE_API void RegisterAllocator(const std::string& name,
+                                const std::shared_ptr<Allocator>& allocator);
+
+/// \brief Get the statistics of the memory allocated by the allocator.
+LITE_API AllocatorStatistics
+GetAllocatorStatistics(const std::string& name = "default");
+
 /// Base class for all the configs.
 class LITE_API ConfigBase {
   std::string model_dir_;
@@ -175,6 +285,9 @@ class LITE_API ConfigBase {
       nnadapter_dynamic_shape_info_;
   // The buffers for loading the compiled NNAdapter models from memory.
   std::map<std::string, std::vector<char>> nnadapter_model_cache_buffers_{};
+  // Overlap the device execution of the NNAdapter subgraphs with the host ops
+  // of the next run.
+  bool nnadapter_pipelined_execution_{false};
   int device_id_{0};
   int x86_math_num_threads_ = 1;
 
@@ -186,6 +299,11 @@ class LITE_API ConfigBase {
 
   std::vector<std::string> discarded_passes_{};
 
+  // The host allocators for the activations and the persistable tensors.
+  std::string host_allocator_{"default"};
+  std::string persistable_allocator_{""};
+  size_t memory_alignment_{64};
+
  public:
   explicit ConfigBase(PowerMode mode = LITE_POWER_NO_BIND, int threads = 1);
   // set Model_dir
@@ -323,6 +441,18 @@ class LITE_API ConfigBase {
   nnadapter_model_cache_buffers() const {
     return nnadapter_model_cache_buffers_;
   }
+  // Execute the NNAdapter subgraph of a run on a worker thread while the host
+  // ops after it and the next run go on, so the outputs of each `Run` are the
+  // results of the previous one, and the outputs of the first `Run` after the
+  // creation or `FlushPipelinedRuns` are zeros. Call `FlushPipelinedRuns` to
+  // get the results of the last one. Each subgraph adds a run of delay, so it's
+  // meant for the models which are offloaded as a whole.
+  void set_nnadapter_pipelined_execution(bool pipelined) {
+    nnadapter_pipelined_execution_ = pipelined;
+  }
+  bool nnadapter_pipelined_execution() const {
+    return nnadapter_pipelined_execution_;
+  }
   // set Device ID
   void set_device_id(int device_id) { device_id_ = device_id; }
   int get_device_id() const { return device_id_; }
@@ -346,6 +476,21 @@ class LITE_API ConfigBase {
   const std::vector<std::string> get_discarded_passes() const {
     return discarded_passes_;
   }
+
+  // Set the registered host allocator to run the predictor, see `Allocator`.
+  void set_host_allocator(const std::string& name);
+  const std::string& host_allocator() const { return host_allocator_; }
+  // Set the host allocator to load the persistable tensors, such as
+  // "huge_page", the `host_allocator` is used if it is not set.
+  void set_persistable_allocator(const std::string& name);
+  const std::string& persistable_allocator() const {
+    return persistable_allocator_.empty() ? host_allocator_
+                                          : persistable_allocator_;
+  }
+  // Set the alignment of the host memory, 64 bytes by default which is
+  // suitable for AVX-512, it should be a power of 2.
+  void set_memory_alignment(size_t alignment);
+  size_t memory_alignment() const { return memory_alignment_; }
 };
 
 class LITE_API CxxModelBuffer {
@@ -378,6 +523,8 @@ class LITE_API CxxConfig : public ConfigBase {
   QuantType quant_type_{QuantType::QUANT_INT16};
   bool sparse_model_{false};  // Enable sparse_conv_detect_pass in opt
   float sparse_threshold_{0.6f};
+  bool prepacked_weights_{false};  // Save the packed weights of kernels
+  bool fold_partial_shapes_{false};  // Trust the var desc dims in folding
   std::map<int, std::vector<std::shared_ptr<void>>>
       preferred_inputs_for_warmup_;
 #ifdef LITE_WITH_CUDA
@@ -514,6 +661,21 @@ class LITE_API CxxConfig : public ConfigBase {
     sparse_threshold_ = sparse_threshold;
   }
   float sparse_threshold() const { return sparse_threshold_; }
+  // Save the weights in the packed layouts of the kernels, which depend on
+  // the ISA of the CPU, with `SaveOptimizedModel`. It needs the real kernels,
+  // so it has no effect in opt, whose x86 kernels are built as fakes. Only
+  // the x86 fp32 direct conv packs its weights now.
+  void set_prepacked_weights(bool prepacked_weights) {
+    prepacked_weights_ = prepacked_weights;
+  }
+  bool prepacked_weights() const { return prepacked_weights_; }
+  // Let constant_folding_pass fold the shape ops over the static dims of the
+  // var descs, only for the models never fed with other shapes than the ones
+  // they were exported with.
+  void set_fold_partial_shapes(bool fold_partial_shapes) {
+    fold_partial_shapes_ = fold_partial_shapes;
+  }
+  bool fold_partial_shapes() const { return fold_partial_shapes_; }
 
   // Enable the custom subgraph partition for NNAdapter by providing the
   // configuration file or buffer
@@ -568,6 +730,10 @@ class LITE_API MobileConfig : public ConfigBase {
   std::string model_buffer_;
   std::string param_buffer_;
 
+  // whether to defer reading and dequantizing the weights to their first use.
+  bool lazy_weights_{false};
+  bool prefetch_weights_{false};
+
  public:
   // set model data in combined format, `set_model_from_file` refers to loading
   // model from file, set_model_from_buffer refers to loading model from memory
@@ -599,6 +765,18 @@ class LITE_API MobileConfig : public ConfigBase {
   // NOTE: This is a deprecated API and will be removed in latter release.
   const std::string& param_buffer() const { return param_buffer_; }
 
+  // Load the weights on demand: the dequantization of the weights is deferred
+  // to the first kernel using them, and the weights of the models saved with
+  // mapped params (PADDLE_LITE_MODEL_MAPPED_PARAMS) are only read from the
+  // model file when they are touched. `prefetch` loads the weights in
+  // execution order in a background thread until the first run.
+  void set_lazy_weights(bool lazy, bool prefetch = false) {
+    lazy_weights_ = lazy;
+    prefetch_weights_ = prefetch;
+  }
+  bool lazy_weights() const { return lazy_weights_; }
+  bool prefetch_weights() const { return prefetch_weights_; }
+
   // This is the method for allocating workspace_size according to L3Cache size
   void SetArmL3CacheSize(
       L3CacheSetMethod method = L3CacheSetMethod::kDeviceL3Cache,
@@ -611,6 +789,61 @@ class LITE_API MobileConfig : public ConfigBase {
 template <typename ConfigT>
 LITE_API std::shared_ptr<PaddlePredictor> CreatePaddlePredictor(const ConfigT&);
 
+/// \brief The memory report of a `ModelGroup`, in bytes.
+struct LITE_API ModelGroupStatistics {
+  // The persistable tensors of all the models as loaded.
+  int64_t weight_bytes{0};
+  // The persistable tensors found identical to the ones of a model loaded
+  // before, and shared with them until a kernel writes either of them.
+  int64_t deduped_weights{0};
+  int64_t deduped_weight_bytes{0};
+  // The largest activations of every model summed, i.e. what the models
+  // would hold if each of them kept its own.
+  int64_t activation_bytes{0};
+  // The largest activations of a single model, i.e. what the group holds as
+  // the activations of a model are released before another one runs.
+  int64_t shared_activation_bytes{0};
+  // The peak of the host memory allocated from the arena of the group.
+  int64_t arena_bytes_peak{0};
+
+  std::string ToString() const;
+};
+
+/// \brief ModelGroup loads several models which run one after another in one
+/// process, such as the detector, classifier and OCR models of a pipeline,
+/// so the peak memory is close to the one of the largest model instead of
+/// the sum of all the models:
+///   1. the persistable tensors identical by content to the ones of a model
+///   loaded before are shared instead of being kept twice, a model whose
+///   kernels transform a shared weight in place gets its own copy of it;
+///   2. the activations and the temporary buffers of all the models are
+///   allocated from one pooled arena, and the activations of a model are
+///   released when another model of the group runs, so the outputs of a model
+///   should be read before running the next one;
+///   3. the models run under one lock with the same number of threads, so the
+///   thread pool is not resized between the models.
+/// The models should be run by `ModelGroup::Run` instead of
+/// `PaddlePredictor::Run`.
+class LITE_API ModelGroup {
+ public:
+  ModelGroup() = default;
+  virtual ~ModelGroup() = default;
+
+  // The number of the models, in the order of the configs.
+  virtual int size() const = 0;
+  // The predictor of the i-th model, to set the inputs and get the outputs.
+  virtual std::shared_ptr<PaddlePredictor> GetPredictor(int i) = 0;
+  // Run the i-th model.
+  virtual void Run(int i) = 0;
+  virtual ModelGroupStatistics Statistics() const = 0;
+};
+
+/// \brief Create a model group from the configs of the models, the host
+/// allocator of the configs is replaced by the arena of the group and the
+/// largest number of threads is used by all the models.
+LITE_API std::shared_ptr<ModelGroup> CreateModelGroup(
+    const std::vector<CxxConfig>& configs);
+
 }  // namespace lite_api
 }  // namespace paddle
 
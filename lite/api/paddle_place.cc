@@ -104,7 +104,8 @@ const std::string& PrecisionToStr(PrecisionType precision) {
                                                  "int64_t",
                                                  "int16_t",
                                                  "uint8_t",
-                                                 "double"};
+                                                 "double",
+                                                 "bfloat16"};
   auto x = static_cast<int>(precision);
   CHECK_LT(x, static_cast<int>(PRECISION(NUM)));
   return precision2string[x];
@@ -159,7 +160,10 @@ const std::string& PrecisionRepr(PrecisionType precision) {
                                                  "kFP16",
                                                  "kBool",
                                                  "kInt64",
-                                                 "kInt16"};
+                                                 "kInt16",
+                                                 "kUInt8",
+                                                 "kFP64",
+                                                 "kBF16"};
   auto x = static_cast<int>(precision);
   CHECK_LT(x, static_cast<int>(PRECISION(NUM)));
   return precision2string[x];
@@ -70,11 +70,13 @@ void BindLiteOpt(py::module *m) {
       .def("set_param_file", &OptBase::SetParamFile)
       .def("set_valid_places", &OptBase::SetValidPlaces)
       .def("enable_fp16", &OptBase::EnableFloat16)
+      .def("enable_bf16", &OptBase::EnableBFloat16)
       .def("set_optimize_out", &OptBase::SetOptimizeOut)
       .def("set_model_type", &OptBase::SetModelType)
       .def("set_quant_model", &OptBase::SetQuantModel)
       .def("set_quant_type", &OptBase::SetQuantType)
       .def("set_sparse_model", &OptBase::SetSparseModel)
+      .def("set_fold_partial_shapes", &OptBase::SetFoldPartialShapes)
       .def("set_sparse_threshold", &OptBase::SetSparseThreshold)
       .def("record_model_info", &OptBase::RecordModelInfo)
       .def("set_passes_internal", &OptBase::SetPassesInternal)
@@ -310,7 +312,8 @@ void BindLitePlace(py::module *m) {
       .value("INT64", PrecisionType::kInt64)
       .value("INT16", PrecisionType::kInt16)
       .value("UINT8", PrecisionType::kUInt8)
-      .value("FP64", PrecisionType::kFP64);
+      .value("FP64", PrecisionType::kFP64)
+      .value("BF16", PrecisionType::kBF16);
 
   // DataLayoutType
   py::enum_<DataLayoutType>(*m, "DataLayoutType")
@@ -346,7 +349,9 @@ void BindLiteTensor(py::module *m) {
   py::class_<Tensor> tensor(*m, "Tensor");
 
   tensor.def("resize", &Tensor::Resize)
-      .def("numpy", [](Tensor &self) { return TensorToPyArray(self); })
+      .def("numpy",
+           [](Tensor &self, bool copy) { return TensorToPyArray(self, copy); },
+           py::arg("copy") = false)
       .def("shape", &Tensor::shape)
       .def("target", &Tensor::target)
       .def("precision", &Tensor::precision)
@@ -405,7 +410,17 @@ void BindLiteCxxPredictor(py::module *m) {
       .def("get_input_names", &CxxPaddleApiImpl::GetInputNames)
       .def("get_input_by_name", &CxxPaddleApiImpl::GetInputByName)
       .def("get_output_by_name", &CxxPaddleApiImpl::GetOutputByName)
-      .def("run", &CxxPaddleApiImpl::Run)
+      // Release the GIL so that the predictors can run in parallel in the
+      // Python threads.
+      .def("run",
+           &CxxPaddleApiImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("add_streaming_state", &CxxPaddleApiImpl::AddStreamingState)
+      .def("add_streaming_context", &CxxPaddleApiImpl::AddStreamingContext)
+      .def("run_streaming",
+           &CxxPaddleApiImpl::RunStreaming,
+           py::call_guard<py::gil_scoped_release>())
+      .def("reset_streaming", &CxxPaddleApiImpl::ResetStreaming)
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
       .def("save_optimized_pb_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
@@ -429,7 +444,15 @@ void BindLiteLightPredictor(py::module *m) {
       .def("get_output_names", &LightPredictorImpl::GetOutputNames)
       .def("get_input_by_name", &LightPredictorImpl::GetInputByName)
       .def("get_output_by_name", &LightPredictorImpl::GetOutputByName)
-      .def("run", &LightPredictorImpl::Run)
+      .def("run",
+           &LightPredictorImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("add_streaming_state", &LightPredictorImpl::AddStreamingState)
+      .def("add_streaming_context", &LightPredictorImpl::AddStreamingContext)
+      .def("run_streaming",
+           &LightPredictorImpl::RunStreaming,
+           py::call_guard<py::gil_scoped_release>())
+      .def("reset_streaming", &LightPredictorImpl::ResetStreaming)
       .def("get_version", &LightPredictorImpl::GetVersion);
 }
 
@@ -71,7 +71,9 @@ inline std::string TensorDTypeToPyDTypeStr(PrecisionType type) {
 
 ////////////////////////////////////////////////////////////////
 // Function Name: TensorToPyArray
-// Usage: Transform tensor's data into numpy array
+// Usage: Transform tensor's data into numpy array, the array is
+//        a view of the tensor unless `need_deep_copy` is set, the
+//        view is only valid until the next run of the predictor.
 ////////////////////////////////////////////////////////////////
 inline py::array TensorToPyArray(const Tensor &tensor,
                                  bool need_deep_copy = false) {
@@ -94,6 +96,11 @@ inline py::array TensorToPyArray(const Tensor &tensor,
   }
 
   const void *tensor_buf_ptr = static_cast<const void *>(tensor.data<int8_t>());
+  if (need_deep_copy) {
+    // Without a base object numpy copies the data.
+    return py::array(
+        py::dtype(py_dtype_str.c_str()), py_dims, py_strides, tensor_buf_ptr);
+  }
   auto base = py::cast(std::move(tensor));
   return py::array(py::dtype(py_dtype_str.c_str()),
                    py_dims,
@@ -104,7 +111,10 @@ inline py::array TensorToPyArray(const Tensor &tensor,
 
 ////////////////////////////////////////////////////////////////
 // Function Name: SetTensorFromPyArrayT
-// Usage: Transform numpy of specified precision into tensor
+// Usage: Transform numpy of specified precision into tensor. The
+//        tensor on host shares the memory of the array (converted
+//        to a c-contiguous one of `T` if needed) and keeps it alive,
+//        so the array should not be modified until the run ends.
 ////////////////////////////////////////////////////////////////
 template <typename T>
 void SetTensorFromPyArrayT(
@@ -118,6 +128,21 @@ void SetTensorFromPyArrayT(
   }
   self->Resize(dims);
 
+  if (place == TargetType::kHost || place == TargetType::kX86 ||
+      place == TargetType::kARM) {
+    // The array may be released on a thread without the GIL, e.g. by a run
+    // which resets the input.
+    auto *holder = new py::object(array);
+    self->ShareExternalMemory(const_cast<T *>(array.data()),
+                              array.nbytes(),
+                              place,
+                              [holder]() {
+                                py::gil_scoped_acquire gil;
+                                delete holder;
+                              });
+    self->SetPrecision(lite_api::PrecisionTypeTrait<T>::Type());
+    return;
+  }
   auto dst = self->mutable_data<T>(place);
   std::memcpy(dst, array.data(), array.nbytes());
 }
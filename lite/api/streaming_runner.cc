@@ -0,0 +1,159 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/streaming_runner.h"
+#include <cstring>
+#include <memory>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+using lite_api::PrecisionType;
+using lite_api::Tensor;
+using lite_api::shape_t;
+
+namespace {
+
+int64_t ShapeProduction(const shape_t &shape) {
+  int64_t production = 1;
+  for (auto dim : shape) production *= dim;
+  return production;
+}
+
+// Get the host data of a tensor for writing without changing its precision.
+void *MutableRawData(Tensor *tensor, PrecisionType precision) {
+  switch (precision) {
+    case PrecisionType::kFloat:
+      return tensor->mutable_data<float>();
+    case PrecisionType::kFP64:
+      return tensor->mutable_data<double>();
+    case PrecisionType::kInt64:
+      return tensor->mutable_data<int64_t>();
+    case PrecisionType::kInt32:
+      return tensor->mutable_data<int32_t>();
+    case PrecisionType::kInt16:
+      return tensor->mutable_data<int16_t>();
+    case PrecisionType::kInt8:
+      return tensor->mutable_data<int8_t>();
+    case PrecisionType::kUInt8:
+      return tensor->mutable_data<uint8_t>();
+    case PrecisionType::kBool:
+      return tensor->mutable_data<bool>();
+    default:
+      LOG(FATAL) << "Unsupported precision " << PrecisionToStr(precision)
+                 << " for the streaming inference.";
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+void StreamingRunner::AddState(const std::string &output_name,
+                               const std::string &input_name) {
+  states_.emplace_back(output_name, input_name);
+}
+
+void StreamingRunner::AddContext(const std::string &input_name,
+                                 int axis,
+                                 int frames) {
+  CHECK_GT(frames, 0) << "The frames of the context of " << input_name
+                      << " should be positive.";
+  Context context;
+  context.input_name = input_name;
+  context.axis = axis;
+  context.frames = frames;
+  contexts_.push_back(context);
+}
+
+void StreamingRunner::Run() {
+  // Prepend the contexts kept from the previous chunk to the inputs
+  for (auto &context : contexts_) {
+    auto input = predictor_->GetInputByName(context.input_name);
+    auto precision = input->precision();
+    auto shape = input->shape();
+    int rank = static_cast<int>(shape.size());
+    int axis = context.axis < 0 ? context.axis + rank : context.axis;
+    CHECK(axis >= 0 && axis < rank) << "Invalid axis " << context.axis
+                                    << " of the context of "
+                                    << context.input_name;
+    int64_t outer = 1;
+    for (int i = 0; i < axis; i++) outer *= shape[i];
+    int64_t inner = PrecisionTypeLength(precision);
+    for (int i = axis + 1; i < rank; i++) inner *= shape[i];
+    int64_t context_step = context.frames * inner;
+    int64_t chunk_step = shape[axis] * inner;
+    if (context.data.empty()) {
+      context.data.assign(outer * context_step, 0);
+    }
+    CHECK_EQ(static_cast<int64_t>(context.data.size()), outer * context_step)
+        << "The shape of " << context.input_name
+        << " can only change along the axis of the context in a stream.";
+    std::vector<char> chunk(outer * chunk_step);
+    std::memcpy(chunk.data(), input->data<void>(), chunk.size());
+    shape[axis] += context.frames;
+    input->Resize(shape);
+    auto data = static_cast<char *>(MutableRawData(input.get(), precision));
+    for (int64_t i = 0; i < outer; i++) {
+      auto row = data + i * (context_step + chunk_step);
+      std::memcpy(row, context.data.data() + i * context_step, context_step);
+      std::memcpy(
+          row + context_step, chunk.data() + i * chunk_step, chunk_step);
+      // Keep the last frames for the next chunk
+      std::memcpy(context.data.data() + i * context_step,
+                  row + chunk_step,
+                  context_step);
+    }
+    auto lod = input->lod();
+    if (axis == 0 && !lod.empty()) {
+      CHECK(lod.size() == 1 && lod[0].size() == 2)
+          << "Only a single sequence is supported by the context of "
+          << context.input_name;
+      lod[0][1] += context.frames;
+      input->SetLoD(lod);
+    }
+  }
+  predictor_->Run();
+  // Carry the states to the next chunk
+  for (auto &state : states_) {
+    auto output = predictor_->GetTensor(state.first);
+    CHECK(output) << "The state " << state.first << " is not found.";
+    auto input = predictor_->GetInputByName(state.second);
+    auto precision = output->precision();
+    input->Resize(output->shape());
+    input->SetLoD(output->lod());
+    std::memcpy(MutableRawData(input.get(), precision),
+                output->data<void>(),
+                ShapeProduction(output->shape()) *
+                    PrecisionTypeLength(precision));
+  }
+}
+
+void StreamingRunner::Reset() {
+  for (auto &context : contexts_) {
+    context.data.clear();
+  }
+  for (auto &state : states_) {
+    auto input = predictor_->GetInputByName(state.second);
+    if (!input->IsInitialized()) continue;
+    auto precision = input->precision();
+    std::memset(
+        MutableRawData(input.get(), precision),
+        0,
+        ShapeProduction(input->shape()) * PrecisionTypeLength(precision));
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
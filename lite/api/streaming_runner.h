@@ -0,0 +1,56 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/api/paddle_api.h"
+
+namespace paddle {
+namespace lite {
+
+// The streaming inference of a predictor, see
+// lite_api::PaddlePredictor::RunStreaming. It only uses the public API of the
+// predictor, so it is shared by CxxPaddleApiImpl and LightPredictorImpl, each
+// of them owns one.
+class StreamingRunner {
+ public:
+  explicit StreamingRunner(lite_api::PaddlePredictor* predictor)
+      : predictor_(predictor) {}
+
+  void AddState(const std::string& output_name, const std::string& input_name);
+  void AddContext(const std::string& input_name, int axis, int frames);
+  // Prepend the contexts to the inputs, run the predictor and carry the
+  // states to the inputs of the next run.
+  void Run();
+  void Reset();
+
+ private:
+  struct Context {
+    std::string input_name;
+    int axis;
+    int frames;
+    // The last frames of the previous chunk, empty at the start of a stream.
+    std::vector<char> data;
+  };
+
+  lite_api::PaddlePredictor* predictor_;
+  // The <output, input> of the states carried between the runs.
+  std::vector<std::pair<std::string, std::string>> states_;
+  std::vector<Context> contexts_;
+};
+
+}  // namespace lite
+}  // namespace paddle
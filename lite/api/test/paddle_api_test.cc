@@ -15,6 +15,11 @@
 #include "lite/api/paddle_api.h"
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
 #include "lite/utils/io.h"
 #include "lite/utils/log/cp_logging.h"
 
@@ -110,6 +115,212 @@ TEST(CxxApi, share_external_data) {
   EXPECT_NEAR(out[1], -28.8729, 1e-3);
 }
 
+TEST(CxxApi, model_group) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  // The same model twice, all the weights of the second one are shared.
+  auto group = lite_api::CreateModelGroup({config, config});
+  ASSERT_EQ(group->size(), 2);
+  auto stats = group->Statistics();
+  EXPECT_GT(stats.deduped_weights, 0);
+  EXPECT_EQ(stats.deduped_weight_bytes * 2, stats.weight_bytes);
+
+  for (int i = 0; i < group->size(); i++) {
+    auto predictor = group->GetPredictor(i);
+    auto input_tensor = predictor->GetInput(0);
+    input_tensor->Resize(std::vector<int64_t>({100, 100}));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int j = 0; j < 100 * 100; j++) {
+      data[j] = j;
+    }
+
+    group->Run(i);
+
+    auto output = predictor->GetOutput(0);
+    auto* out = output->data<float>();
+    EXPECT_NEAR(out[0], 50.2132, 1e-3);
+    EXPECT_NEAR(out[1], -28.8729, 1e-3);
+  }
+
+  stats = group->Statistics();
+  LOG(INFO) << stats.ToString();
+  EXPECT_GT(stats.activation_bytes, 0);
+  EXPECT_EQ(stats.shared_activation_bytes * 2, stats.activation_bytes);
+}
+
+std::shared_ptr<PaddlePredictor> CreateAsyncPredictor() {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  auto input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(std::vector<int64_t>({100, 100}));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+  return predictor;
+}
+
+// Run asynchronously, the returned future gets the status.
+std::future<RunStatus> RunAsync(PaddlePredictor* predictor,
+                                int64_t timeout_ms = 0) {
+  auto promise = std::make_shared<std::promise<RunStatus>>();
+  predictor->RunAsync(
+      [promise](RunStatus status) { promise->set_value(status); }, timeout_ms);
+  return promise->get_future();
+}
+
+// Block the queue of the runs of a predictor: the returned promise releases
+// the callback of a run, which holds the next runs back, once it is started.
+std::shared_ptr<std::promise<void>> BlockAsyncRuns(PaddlePredictor* predictor) {
+  auto started = std::make_shared<std::promise<void>>();
+  auto release = std::make_shared<std::promise<void>>();
+  std::shared_future<void> released = release->get_future().share();
+  predictor->RunAsync([started, released](RunStatus status) {
+    EXPECT_EQ(status, RunStatus::kOk);
+    started->set_value();
+    released.wait();
+  });
+  started->get_future().wait();
+  return release;
+}
+
+TEST(CxxApi, run_async) {
+  auto predictor = CreateAsyncPredictor();
+  ASSERT_EQ(RunAsync(predictor.get()).get(), RunStatus::kOk);
+  auto output = predictor->GetOutput(0);
+  auto* out = output->data<float>();
+  EXPECT_NEAR(out[0], 50.2132, 1e-3);
+  EXPECT_NEAR(out[1], -28.8729, 1e-3);
+}
+
+TEST(CxxApi, run_async_cancel) {
+  auto predictor = CreateAsyncPredictor();
+  // The runs submitted before CancelAsync are cancelled, the later ones not.
+  auto release = BlockAsyncRuns(predictor.get());
+  auto cancelled = RunAsync(predictor.get());
+  predictor->CancelAsync();
+  auto next = RunAsync(predictor.get());
+  release->set_value();
+  EXPECT_EQ(cancelled.get(), RunStatus::kCancelled);
+  EXPECT_EQ(next.get(), RunStatus::kOk);
+  auto output = predictor->GetOutput(0);
+  EXPECT_NEAR(output->data<float>()[0], 50.2132, 1e-3);
+}
+
+TEST(CxxApi, run_async_deadline) {
+  auto predictor = CreateAsyncPredictor();
+  // The deadline of a run expires while it waits for the run before.
+  auto release = BlockAsyncRuns(predictor.get());
+  auto expired = RunAsync(predictor.get(), 1);
+  auto in_time = RunAsync(predictor.get(), 60 * 1000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  release->set_value();
+  EXPECT_EQ(expired.get(), RunStatus::kDeadlineExceeded);
+  EXPECT_EQ(in_time.get(), RunStatus::kOk);
+  auto output = predictor->GetOutput(0);
+  EXPECT_NEAR(output->data<float>()[0], 50.2132, 1e-3);
+}
+
+TEST(CxxApi, run_streaming) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  auto input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(std::vector<int64_t>({100, 100}));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+  predictor->Run();
+  auto output = predictor->GetOutput(0);
+  auto output_shape = output->shape();
+  int64_t output_size = output_shape[1];
+  std::vector<float> expected(output->data<float>(),
+                              output->data<float>() + 100 * output_size);
+
+  // Feed two chunks of 50 rows with a context of 2 rows, the outputs of the
+  // context rows of the second chunk are the ones of the rows 48 and 49.
+  predictor->AddStreamingContext(predictor->GetInputNames()[0], 0, 2);
+  for (int chunk = 0; chunk < 2; chunk++) {
+    input_tensor->Resize(std::vector<int64_t>({50, 100}));
+    data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 50 * 100; i++) {
+      data[i] = chunk * 50 * 100 + i;
+    }
+    predictor->RunStreaming();
+    EXPECT_EQ(input_tensor->shape()[0], 52);
+    output = predictor->GetOutput(0);
+    ASSERT_EQ(output->shape()[0], 52);
+    auto* out = output->data<float>();
+    for (int i = 2 * output_size; i < 52 * output_size; i++) {
+      EXPECT_NEAR(out[i], expected[(chunk * 50 - 2) * output_size + i], 1e-3);
+    }
+    if (chunk > 0) {
+      for (int i = 0; i < 2 * output_size; i++) {
+        EXPECT_NEAR(out[i], expected[48 * output_size + i], 1e-3);
+      }
+    }
+  }
+  predictor->ResetStreaming();
+}
+
+TEST(CxxApi, run_streaming_state) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  auto input_name = predictor->GetInputNames()[0];
+  auto output_name = predictor->GetOutputNames()[0];
+  // Carry the output of each run to the input of the next one
+  predictor->AddStreamingState(output_name, input_name);
+  auto input_tensor = predictor->GetInputByName(input_name);
+  input_tensor->Resize(std::vector<int64_t>({100, 100}));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+  predictor->RunStreaming();
+  auto output = predictor->GetTensor(output_name);
+  auto output_shape = output->shape();
+  int64_t output_size = 1;
+  for (auto dim : output_shape) {
+    output_size *= dim;
+  }
+  EXPECT_NEAR(output->data<float>()[0], 50.2132, 1e-3);
+  EXPECT_NEAR(output->data<float>()[1], -28.8729, 1e-3);
+  std::vector<float> state(output->data<float>(),
+                           output->data<float>() + output_size);
+  // The input of the next run holds the state
+  input_tensor = predictor->GetInputByName(input_name);
+  ASSERT_EQ(input_tensor->shape(), output_shape);
+  EXPECT_EQ(std::vector<float>(input_tensor->data<float>(),
+                               input_tensor->data<float>() + state.size()),
+            state);
+  // A new stream starts with the zero states
+  predictor->ResetStreaming();
+  ASSERT_EQ(input_tensor->shape(), output_shape);
+  for (size_t i = 0; i < state.size(); i++) {
+    EXPECT_EQ(input_tensor->data<float>()[i], 0.f);
+  }
+}
+
 // Demo1 for Mobile Devices :Load model from file and run
 #ifdef LITE_WITH_ARM
 TEST(LightApi, run) {
@@ -0,0 +1,142 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/cxx_api.h"
+#include "lite/api/light_api.h"
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+
+DEFINE_string(optimized_model, "prepacked_conv", "");
+
+namespace paddle {
+namespace lite {
+
+const std::vector<int64_t> kInputShape{1, 8, 10, 10};
+const std::vector<int64_t> kFilterShape{16, 8, 3, 3};
+const std::vector<int64_t> kOutputShape{1, 16, 10, 10};
+
+void AddVarDesc(cpp::BlockDesc* block_desc,
+                const std::string& name,
+                VarDescAPI::Type type,
+                const std::vector<int64_t>& shape,
+                bool persistable) {
+  auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+  var_desc->SetName(name);
+  var_desc->SetType(type);
+  var_desc->SetPersistable(persistable);
+  if (type == VarDescAPI::Type::LOD_TENSOR) {
+    var_desc->SetDataType(VarDescAPI::VarDataType::FP32);
+    var_desc->SetShape(shape);
+  }
+}
+
+// Build feed -> conv2d -> fetch, the filter of the 3x3s1p1 conv with 16
+// output channels is packed by the x86 direct conv.
+std::shared_ptr<cpp::ProgramDesc> BuildConvProgram(Scope* scope) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  AddVarDesc(block_desc, "feed", VarDescAPI::Type::FEED_MINIBATCH, {}, true);
+  AddVarDesc(block_desc, "fetch", VarDescAPI::Type::FETCH_LIST, {}, true);
+  AddVarDesc(block_desc, "x", VarDescAPI::Type::LOD_TENSOR, kInputShape, false);
+  AddVarDesc(block_desc, "w", VarDescAPI::Type::LOD_TENSOR, kFilterShape, true);
+  AddVarDesc(
+      block_desc, "out", VarDescAPI::Type::LOD_TENSOR, kOutputShape, false);
+  auto* filter = scope->Var("w")->GetMutable<Tensor>();
+  filter->Resize(kFilterShape);
+  auto* filter_data = filter->mutable_data<float>();
+  for (int64_t i = 0; i < filter->numel(); i++) {
+    filter_data[i] = static_cast<float>(i % 7) - 3.f;
+  }
+  filter->set_persistable(true);
+
+  auto* feed_desc = block_desc->AddOp<cpp::OpDesc>();
+  feed_desc->SetType("feed");
+  feed_desc->SetInput("X", {"feed"});
+  feed_desc->SetOutput("Out", {"x"});
+  feed_desc->SetAttr<int>("col", 0);
+  auto* conv_desc = block_desc->AddOp<cpp::OpDesc>();
+  conv_desc->SetType("conv2d");
+  conv_desc->SetInput("Input", {"x"});
+  conv_desc->SetInput("Filter", {"w"});
+  conv_desc->SetOutput("Output", {"out"});
+  conv_desc->SetAttr<std::vector<int>>("strides", {1, 1});
+  conv_desc->SetAttr<std::vector<int>>("paddings", {1, 1});
+  conv_desc->SetAttr<std::vector<int>>("dilations", {1, 1});
+  conv_desc->SetAttr<int>("groups", 1);
+  auto* fetch_desc = block_desc->AddOp<cpp::OpDesc>();
+  fetch_desc->SetType("fetch");
+  fetch_desc->SetInput("X", {"out"});
+  fetch_desc->SetOutput("Out", {"fetch"});
+  fetch_desc->SetAttr<int>("col", 0);
+  return program_desc;
+}
+
+void FillInput(Tensor* input) {
+  input->Resize(kInputShape);
+  auto* input_data = input->mutable_data<float>();
+  for (int64_t i = 0; i < input->numel(); i++) {
+    input_data[i] = static_cast<float>(i % 5) * 0.5f;
+  }
+}
+
+TEST(PrepackedWeights, save_and_load) {
+  Place place{TARGET(kX86), PRECISION(kFloat)};
+  lite_api::CxxConfig config;
+  config.set_prepacked_weights(true);
+  Predictor predictor;
+  auto program_desc = BuildConvProgram(predictor.scope());
+  predictor.Build(program_desc, {place}, {}, config);
+  FillInput(predictor.GetInput(0));
+  predictor.Run();
+  auto* expected_output = predictor.GetOutput(0);
+  ASSERT_EQ(expected_output->dims().Vectorize(), kOutputShape);
+  predictor.SaveModel(FLAGS_optimized_model,
+                      lite_api::LiteModelType::kNaiveBuffer);
+
+  // Only the packed weights are saved
+  auto* block_desc = program_desc->GetBlock<cpp::BlockDesc>(0);
+  for (size_t i = 0; i < block_desc->VarsSize(); i++) {
+    auto* var_desc = block_desc->GetVar<cpp::VarDesc>(i);
+    if (var_desc->Name() == "w") {
+      EXPECT_FALSE(var_desc->Persistable());
+      EXPECT_EQ(var_desc->GetShape(), kFilterShape);
+    }
+  }
+
+  LightPredictor light_predictor(FLAGS_optimized_model + ".nb", false);
+  FillInput(light_predictor.GetInput(0));
+  light_predictor.Run();
+  auto* output = light_predictor.GetOutput(0);
+  ASSERT_EQ(output->dims().Vectorize(), kOutputShape);
+  for (int64_t i = 0; i < output->numel(); i++) {
+    EXPECT_NEAR(output->data<float>()[i],
+                expected_output->data<float>()[i],
+                1e-5);
+  }
+  // The kernel runs with the packed weights, and the original filter is
+  // neither loaded nor restored
+  auto* filter = light_predictor.GetTensor("w");
+  EXPECT_EQ(filter->dims().Vectorize(), kFilterShape);
+  EXPECT_FALSE(filter->IsInitialized());
+  EXPECT_TRUE(light_predictor.GetTensor("out@PACKED")->IsInitialized());
+}
+
+}  // namespace lite
+}  // namespace paddle
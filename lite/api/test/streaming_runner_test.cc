@@ -0,0 +1,149 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/streaming_runner.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+// A predictor over the tensors of a map, its run computes
+//   y = 2 * x, h_out = h + the sum of the rows of x
+// where x is frames x 2 and h is 1 x 2.
+class FakePredictor : public lite_api::PaddlePredictor {
+ public:
+  FakePredictor() {
+    auto* h = &tensors_["h"];
+    h->Resize({1, 2});
+    h->mutable_data<float>()[0] = 1.f;
+    h->mutable_data<float>()[1] = 2.f;
+  }
+
+  std::unique_ptr<lite_api::Tensor> GetInput(int i) override {
+    return GetInputByName(GetInputNames()[i]);
+  }
+  std::unique_ptr<const lite_api::Tensor> GetOutput(int i) const override {
+    return GetTensor(i == 0 ? "y" : "h_out");
+  }
+  void Run() override {
+    auto& x = tensors_["x"];
+    auto& h = tensors_["h"];
+    auto* y = &tensors_["y"];
+    auto* h_out = &tensors_["h_out"];
+    y->Resize(x.dims());
+    h_out->Resize(h.dims());
+    auto* y_data = y->mutable_data<float>();
+    auto* h_out_data = h_out->mutable_data<float>();
+    for (int j = 0; j < 2; j++) h_out_data[j] = h.data<float>()[j];
+    for (int64_t i = 0; i < x.numel(); i++) {
+      y_data[i] = 2.f * x.data<float>()[i];
+      h_out_data[i % 2] += x.data<float>()[i];
+    }
+    runs_++;
+  }
+  std::shared_ptr<lite_api::PaddlePredictor> Clone() override {
+    return nullptr;
+  }
+  std::shared_ptr<lite_api::PaddlePredictor> Clone(
+      const std::vector<std::string>& var_names) override {
+    return nullptr;
+  }
+  std::string GetVersion() const override { return "fake"; }
+  std::vector<std::string> GetInputNames() override { return {"x", "h"}; }
+  std::vector<std::string> GetOutputNames() override { return {"y", "h_out"}; }
+  bool TryShrinkMemory() override { return true; }
+  std::unique_ptr<lite_api::Tensor> GetInputByName(
+      const std::string& name) override {
+    return std::unique_ptr<lite_api::Tensor>(
+        new lite_api::Tensor(&tensors_[name]));
+  }
+  std::unique_ptr<const lite_api::Tensor> GetTensor(
+      const std::string& name) const override {
+    auto it = tensors_.find(name);
+    if (it == tensors_.end()) return nullptr;
+    return std::unique_ptr<const lite_api::Tensor>(
+        new lite_api::Tensor(&it->second));
+  }
+
+  void FeedChunk(const std::vector<float>& rows) {
+    auto* x = &tensors_["x"];
+    x->Resize({static_cast<int64_t>(rows.size() / 2), 2});
+    std::copy(rows.begin(), rows.end(), x->mutable_data<float>());
+  }
+  std::vector<float> Values(const std::string& name) {
+    auto& tensor = tensors_[name];
+    return std::vector<float>(tensor.data<float>(),
+                              tensor.data<float>() + tensor.numel());
+  }
+
+  int runs_{0};
+
+ private:
+  std::map<std::string, Tensor> tensors_;
+};
+
+TEST(StreamingRunner, prepend_context) {
+  FakePredictor predictor;
+  StreamingRunner runner(&predictor);
+  runner.AddContext("x", 0, 2);
+  // Zeros are prepended to the first chunk
+  predictor.FeedChunk({1, 2, 3, 4, 5, 6});
+  runner.Run();
+  EXPECT_EQ(predictor.runs_, 1);
+  EXPECT_EQ(predictor.Values("x"),
+            std::vector<float>({0, 0, 0, 0, 1, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(predictor.Values("y"),
+            std::vector<float>({0, 0, 0, 0, 2, 4, 6, 8, 10, 12}));
+  // Then the last two frames of the previous chunk, even if the chunk is
+  // shorter than the context
+  predictor.FeedChunk({7, 8});
+  runner.Run();
+  EXPECT_EQ(predictor.Values("x"), std::vector<float>({3, 4, 5, 6, 7, 8}));
+  predictor.FeedChunk({9, 10});
+  runner.Run();
+  EXPECT_EQ(predictor.Values("x"), std::vector<float>({5, 6, 7, 8, 9, 10}));
+  // A new stream starts with zeros again
+  runner.Reset();
+  predictor.FeedChunk({11, 12});
+  runner.Run();
+  EXPECT_EQ(predictor.Values("x"), std::vector<float>({0, 0, 0, 0, 11, 12}));
+}
+
+TEST(StreamingRunner, carry_state) {
+  FakePredictor predictor;
+  StreamingRunner runner(&predictor);
+  runner.AddState("h_out", "h");
+  predictor.FeedChunk({1, 2, 3, 4});
+  runner.Run();
+  EXPECT_EQ(predictor.Values("h_out"), std::vector<float>({5, 8}));
+  EXPECT_EQ(predictor.Values("h"), std::vector<float>({5, 8}));
+  predictor.FeedChunk({10, 20});
+  runner.Run();
+  EXPECT_EQ(predictor.Values("h"), std::vector<float>({15, 28}));
+  // A new stream starts with the zero states
+  runner.Reset();
+  EXPECT_EQ(predictor.Values("h"), std::vector<float>({0, 0}));
+  predictor.FeedChunk({1, 1});
+  runner.Run();
+  EXPECT_EQ(predictor.Values("h"), std::vector<float>({1, 1}));
+}
+
+}  // namespace lite
+}  // namespace paddle
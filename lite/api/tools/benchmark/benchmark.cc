@@ -29,6 +29,7 @@
 #ifdef __linux__
 #include "lite/api/tools/benchmark/profile/resource_usage_monitor.h"
 #endif
+#include "lite/api/tools/benchmark/utils/load_generator.h"
 #include "lite/core/version.h"
 #include "lite/utils/timer.h"
 
@@ -57,7 +58,11 @@ int Benchmark(int argc, char** argv) {
   auto input_shapes = lite::GetShapes(FLAGS_input_shape);
 
   // Run
-  Run(model_file, input_shapes);
+  if (IsLoadTest()) {
+    RunLoadTest(model_file, input_shapes);
+  } else {
+    Run(model_file, input_shapes);
+  }
 
   return 0;
 }
@@ -76,6 +81,32 @@ std::shared_ptr<PaddlePredictor> CreatePredictor(
   return predictor;
 }
 
+void SetInputs(std::shared_ptr<PaddlePredictor> predictor,
+               const std::vector<std::vector<int64_t>>& input_shapes) {
+  for (size_t i = 0; i < input_shapes.size(); i++) {
+    auto input_tensor = predictor->GetInput(i);
+    input_tensor->Resize(input_shapes[i]);
+    // NOTE: Change input data type to other type as you need.
+    auto input_data = input_tensor->mutable_data<float>();
+    auto input_num = lite::ShapeProduction(input_shapes[i]);
+    if (FLAGS_input_data_path.empty()) {
+      for (auto j = 0; j < input_num; j++) {
+        input_data[j] = 1.f;
+      }
+    } else {
+      auto paths = lite::Split(FLAGS_input_data_path, ":");
+      std::ifstream fs(paths[i]);
+      if (!fs.is_open()) {
+        std::cerr << "Open input image " << paths[i] << " error." << std::endl;
+      }
+      for (int k = 0; k < input_num; k++) {
+        fs >> input_data[k];
+      }
+      fs.close();
+    }
+  }
+}
+
 void RunImpl(std::shared_ptr<PaddlePredictor> predictor, PerfData* perf_data) {
   lite::Timer timer;
   timer.Start();
@@ -135,29 +166,7 @@ void Run(const std::string& model_file,
 
   // Set inputs
   if (FLAGS_validation_set.empty()) {
-    for (size_t i = 0; i < input_shapes.size(); i++) {
-      auto input_tensor = predictor->GetInput(i);
-      input_tensor->Resize(input_shapes[i]);
-      // NOTE: Change input data type to other type as you need.
-      auto input_data = input_tensor->mutable_data<float>();
-      auto input_num = lite::ShapeProduction(input_shapes[i]);
-      if (FLAGS_input_data_path.empty()) {
-        for (auto j = 0; j < input_num; j++) {
-          input_data[j] = 1.f;
-        }
-      } else {
-        auto paths = lite::Split(FLAGS_input_data_path, ":");
-        std::ifstream fs(paths[i]);
-        if (!fs.is_open()) {
-          std::cerr << "Open input image " << paths[i] << " error."
-                    << std::endl;
-        }
-        for (int k = 0; k < input_num; k++) {
-          fs >> input_data[k];
-        }
-        fs.close();
-      }
-    }
+    SetInputs(predictor, input_shapes);
   } else {
 #ifdef __ANDROID__
     config = LoadConfigTxt(FLAGS_config_path);
@@ -331,5 +340,73 @@ void Run(const std::string& model_file,
   StoreBenchmarkResult(ss.str());
 }
 
+std::string JsonString(const std::string& str) {
+  std::string ret = "\"";
+  for (char c : str) {
+    if (c == '"' || c == '\\') ret += '\\';
+    ret += c;
+  }
+  return ret + "\"";
+}
+
+void RunLoadTest(const std::string& model_file,
+                 const std::vector<std::vector<int64_t>>& input_shapes) {
+  // LightPredictor can not be cloned, every worker loads its own copy of the
+  // model.
+  lite::Timer timer;
+  timer.Start();
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors;
+  for (int i = 0; i < FLAGS_concurrency; ++i) {
+    predictors.push_back(CreatePredictor(model_file));
+    SetInputs(predictors.back(), input_shapes);
+  }
+  float init_time = timer.Stop();
+
+  LoadTestOptions options;
+  options.qps = FLAGS_qps;
+  options.duration = FLAGS_duration;
+  options.requests = FLAGS_repeats;
+  options.warmup = FLAGS_warmup;
+  auto report = GenerateLoad(predictors, options);
+
+  std::stringstream ss;
+  ss << "\n======= Model Info =======\n";
+  ss << "optimized_model_file: " << model_file << std::endl;
+  ss << "input_shape: " << FLAGS_input_shape << std::endl;
+  ss << "\n======= Runtime Info =======\n";
+  ss << "benchmark_bin version: " << lite::version() << std::endl;
+  ss << "backend: " << FLAGS_backend << std::endl;
+  ss << "threads: " << FLAGS_threads << std::endl;
+  ss << "power_mode: " << FLAGS_power_mode << std::endl;
+  ss << "warmup: " << FLAGS_warmup << std::endl;
+  if (FLAGS_duration > 0.) {
+    ss << "duration(sec): " << FLAGS_duration << std::endl;
+  } else {
+    ss << "repeats: " << FLAGS_repeats << std::endl;
+  }
+  ss << "\n======= Load Test Info =======\n";
+  ss << std::fixed << std::left;
+  ss << "init(ms)     = " << init_time << std::endl;
+  ss << report.ToString();
+  std::cout << ss.str() << std::endl;
+  StoreBenchmarkResult(ss.str());
+
+  if (!FLAGS_json_result_path.empty()) {
+    std::ofstream fs(FLAGS_json_result_path);
+    if (!fs.is_open()) {
+      std::cerr << "Fail to open json result file: " << FLAGS_json_result_path
+                << std::endl;
+      return;
+    }
+    fs << "{\"version\": " << JsonString(lite::version())
+       << ", \"model_file\": " << JsonString(model_file)
+       << ", \"input_shape\": " << JsonString(FLAGS_input_shape)
+       << ", \"backend\": " << JsonString(FLAGS_backend)
+       << ", \"threads\": " << FLAGS_threads << ", \"init_ms\": " << init_time
+       << ", \"load_test\": " << report.ToJson() << "}" << std::endl;
+    fs.close();
+  }
+}
+
 }  // namespace lite_api
 }  // namespace paddle
@@ -95,6 +95,12 @@ class PerfData {
 int Benchmark(int argc, char** argv);
 void Run(const std::string& model_file,
          const std::vector<std::vector<int64_t>>& input_shape);
+void RunLoadTest(const std::string& model_file,
+                 const std::vector<std::vector<int64_t>>& input_shape);
+
+bool IsLoadTest() {
+  return FLAGS_concurrency > 1 || FLAGS_qps > 0. || FLAGS_duration > 0.;
+}
 
 #ifdef __ANDROID__
 std::string GetDeviceInfo() {
@@ -184,6 +190,15 @@ bool CheckFlagsValid() {
       ret = false;
     }
   }
+  if (FLAGS_concurrency < 1) {
+    std::cerr << "--concurrency must be at least 1!" << std::endl;
+    ret = false;
+  }
+  if (IsLoadTest() && !FLAGS_validation_set.empty()) {
+    std::cerr << "The load test does not support --validation_set!"
+              << std::endl;
+    ret = false;
+  }
   if (!FLAGS_validation_set.empty()) {
     if (FLAGS_config_path.empty()) {
       std::cerr
@@ -340,6 +355,7 @@ const std::string OutputOptModel(const std::string& opt_model_file) {
         std::find(backends_list.begin(), backends_list.end(), "nnadapter") !=
         backends_list.end();
     if (FLAGS_cpu_precision == "fp16") opt.EnableFloat16();
+    if (FLAGS_cpu_precision == "bf16") opt.EnableBFloat16();
     if (with_nnadapter) {
       std::string valid_places;
       for (auto& backend : backends_list) {
@@ -57,6 +57,12 @@ DEFINE_bool(enable_op_time_profile, false, enable_op_time_profile_msg);
 DEFINE_bool(enable_memory_profile, false, enable_memory_profile_msg);
 DEFINE_int32(memory_check_interval_ms, 5, memory_check_interval_ms_msg);
 
+// Load test options
+DEFINE_int32(concurrency, 1, concurrency_msg);
+DEFINE_double(qps, 0.0, qps_msg);
+DEFINE_double(duration, 0.0, duration_msg);
+DEFINE_string(json_result_path, "", json_result_path_msg);
+
 // Configuration options
 DEFINE_string(config_path, "", config_path_msg);
 
@@ -71,8 +71,8 @@ static const char backend_msg[] =
     "Should be one of: arm|opencl|x86|x86_opencl|"
     "npu|xpu|nnadapter|";
 static const char cpu_precision_msg[] =
-    "Register fp32 or fp16 arm-cpu kernel when optimized model. "
-    "Should be one of: fp32, fp16.";
+    "Register fp32 or fp16 arm-cpu kernel, or bf16 x86 kernel when optimized "
+    "model. Should be one of: fp32, fp16, bf16.";
 static const char gpu_precision_msg[] =
     "Set precision of computation in GPU. "
     "Should be one of: fp32, fp16.";
@@ -107,6 +107,21 @@ static const char memory_check_interval_ms_msg[] =
     "footprint checks. This is only used when "
     "--enable_memory_profile is set to true. Not supported yet.";
 
+// Load test options
+static const char concurrency_msg[] =
+    "The number of predictors running concurrently, each one from its own "
+    "thread. Values above 1, --qps or --duration switch to the load test, "
+    "which reports latency percentiles and the throughput.";
+static const char qps_msg[] =
+    "The target requests per second of the load test. The requests arrive "
+    "as a Poisson process regardless of the completed ones. Non-positive "
+    "values mean a closed loop.";
+static const char duration_msg[] =
+    "The seconds the load test issues requests for. Non-positive values mean "
+    "issuing --repeats requests in total.";
+static const char json_result_path_msg[] =
+    "Save the load test report as json to the file.";
+
 // Configuration options
 static const char config_path_msg[] = "Configuration options.";
 
@@ -146,6 +161,12 @@ DECLARE_bool(enable_op_time_profile);
 DECLARE_bool(enable_memory_profile);
 DECLARE_int32(memory_check_interval_ms);
 
+// Load test options
+DECLARE_int32(concurrency);
+DECLARE_double(qps);
+DECLARE_double(duration);
+DECLARE_string(json_result_path);
+
 // Configuration options
 DECLARE_string(config_path);
 
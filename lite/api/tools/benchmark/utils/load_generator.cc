@@ -0,0 +1,272 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/tools/benchmark/utils/load_generator.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <chrono>              // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <deque>
+#include <iomanip>
+#include <mutex>  // NOLINT(build/c++11)
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>  // NOLINT(build/c++11)
+#ifdef __linux__
+#include <unistd.h>
+#include "lite/api/tools/benchmark/profile/cpu_usage_info.h"
+#endif
+
+namespace paddle {
+namespace lite_api {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point from, Clock::time_point to) {
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// The arrivals of an open loop test, handed to the first free predictor.
+class ArrivalQueue {
+ public:
+  void Push(Clock::time_point arrival) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    arrivals_.push_back(arrival);
+    cv_.notify_one();
+  }
+
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    cv_.notify_all();
+  }
+
+  // Returns false once the queue is closed and drained.
+  bool Pop(Clock::time_point* arrival) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return closed_ || !arrivals_.empty(); });
+    if (arrivals_.empty()) return false;
+    *arrival = arrivals_.front();
+    arrivals_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Clock::time_point> arrivals_;
+  bool closed_{false};
+};
+
+// Samples the cpu usage of the process from a thread until stopped. Each
+// sample of profile::GetCpuUsageRatio takes 200ms.
+class CpuUsageSampler {
+ public:
+  void Start() {
+#ifdef __linux__
+    if (!profile::CpuUsage::IsSupported()) return;
+    thread_.reset(new std::thread([this] {
+      while (!stop_) {
+        float usage = profile::GetCpuUsageRatio(getpid());
+        if (!stop_) samples_.push_back(usage);
+      }
+    }));
+#endif
+  }
+
+  double Stop() {
+    stop_ = true;
+    if (thread_) thread_->join();
+    thread_.reset();
+    if (samples_.empty()) return -1.;
+    return std::accumulate(samples_.begin(), samples_.end(), 0.) /
+           samples_.size();
+  }
+
+ private:
+  std::atomic<bool> stop_{false};
+  std::unique_ptr<std::thread> thread_;
+  std::vector<float> samples_;
+};
+
+}  // namespace
+
+double Percentile(const std::vector<double>& sorted_values, double p) {
+  if (sorted_values.empty()) return 0.;
+  const int64_t n = sorted_values.size();
+  int64_t rank = static_cast<int64_t>(std::ceil(p / 100. * n));
+  rank = std::min(std::max<int64_t>(rank, 1), n);
+  return sorted_values[rank - 1];
+}
+
+LoadTestReport GenerateLoad(
+    const std::vector<std::shared_ptr<PaddlePredictor>>& predictors,
+    const LoadTestOptions& options) {
+  const int concurrency = predictors.size();
+  const bool open_loop = options.qps > 0.;
+  const bool timed = options.duration > 0.;
+  std::vector<std::vector<double>> latencies(concurrency);
+  std::vector<std::thread> workers;
+  ArrivalQueue queue;
+  std::atomic<int64_t> issued{0};
+  Clock::time_point start;
+  Clock::time_point deadline;
+
+  // Every worker warms up its predictor, then waits for the others so the
+  // measurement starts with all of them ready.
+  std::mutex start_mutex;
+  std::condition_variable start_cv;
+  int ready = 0;
+  bool started = false;
+  auto worker = [&](int id) {
+    auto& predictor = predictors[id];
+    for (int i = 0; i < options.warmup; ++i) {
+      predictor->Run();
+    }
+    {
+      std::unique_lock<std::mutex> lock(start_mutex);
+      ++ready;
+      start_cv.notify_all();
+      start_cv.wait(lock, [&] { return started; });
+    }
+    auto& latency = latencies[id];
+    if (open_loop) {
+      Clock::time_point arrival;
+      while (queue.Pop(&arrival)) {
+        predictor->Run();
+        latency.push_back(ElapsedMs(arrival, Clock::now()));
+      }
+    } else {
+      while (true) {
+        auto begin = Clock::now();
+        if (timed ? begin >= deadline : issued++ >= options.requests) break;
+        predictor->Run();
+        latency.push_back(ElapsedMs(begin, Clock::now()));
+      }
+    }
+  };
+  for (int i = 0; i < concurrency; ++i) {
+    workers.emplace_back(worker, i);
+  }
+  {
+    std::unique_lock<std::mutex> lock(start_mutex);
+    start_cv.wait(lock, [&] { return ready == concurrency; });
+    start = Clock::now();
+    deadline = start + std::chrono::duration_cast<Clock::duration>(
+                           std::chrono::duration<double>(options.duration));
+    started = true;
+    start_cv.notify_all();
+  }
+
+  CpuUsageSampler cpu_sampler;
+  cpu_sampler.Start();
+  if (open_loop) {
+    // Poisson arrivals, a fixed seed keeps the runs comparable.
+    std::mt19937 rng(2022);
+    std::exponential_distribution<double> interval(options.qps);
+    auto arrival = start;
+    for (int64_t i = 0; timed || i < options.requests; ++i) {
+      arrival += std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(interval(rng)));
+      if (timed && arrival >= deadline) break;
+      std::this_thread::sleep_until(arrival);
+      queue.Push(arrival);
+    }
+    queue.Close();
+  }
+  for (auto& t : workers) {
+    t.join();
+  }
+  auto end = Clock::now();
+
+  LoadTestReport report;
+  report.cpu_usage = cpu_sampler.Stop();
+  report.concurrency = concurrency;
+  report.target_qps = options.qps;
+  report.elapsed_s = ElapsedMs(start, end) / 1000.;
+  std::vector<double> all;
+  for (auto& latency : latencies) {
+    all.insert(all.end(), latency.begin(), latency.end());
+  }
+  std::sort(all.begin(), all.end());
+  report.completed = all.size();
+  if (report.elapsed_s > 0.) {
+    report.achieved_qps = report.completed / report.elapsed_s;
+  }
+  if (!all.empty()) {
+    report.latency_min = all.front();
+    report.latency_max = all.back();
+    report.latency_avg =
+        std::accumulate(all.begin(), all.end(), 0.) / all.size();
+  }
+  report.latency_p50 = Percentile(all, 50.);
+  report.latency_p90 = Percentile(all, 90.);
+  report.latency_p99 = Percentile(all, 99.);
+  report.latency_p999 = Percentile(all, 99.9);
+  return report;
+}
+
+std::string LoadTestReport::ToString() const {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3) << std::left;
+  ss << "concurrency  = " << concurrency << std::endl;
+  if (target_qps > 0.) {
+    ss << "target qps   = " << target_qps << std::endl;
+  } else {
+    ss << "target qps   = closed loop" << std::endl;
+  }
+  ss << "elapsed(s)   = " << elapsed_s << std::endl;
+  ss << "completed    = " << completed << std::endl;
+  ss << "achieved qps = " << achieved_qps << std::endl;
+  ss << "Latency(unit: ms):\n";
+  ss << "min   = " << std::setw(12) << latency_min << std::endl;
+  ss << "avg   = " << std::setw(12) << latency_avg << std::endl;
+  ss << "p50   = " << std::setw(12) << latency_p50 << std::endl;
+  ss << "p90   = " << std::setw(12) << latency_p90 << std::endl;
+  ss << "p99   = " << std::setw(12) << latency_p99 << std::endl;
+  ss << "p999  = " << std::setw(12) << latency_p999 << std::endl;
+  ss << "max   = " << std::setw(12) << latency_max << std::endl;
+  if (cpu_usage >= 0.) {
+    ss << "cpu usage ratio: " << std::setprecision(1) << cpu_usage * 100 << "%"
+       << std::endl;
+  }
+  return ss.str();
+}
+
+std::string LoadTestReport::ToJson() const {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "{\"concurrency\": " << concurrency
+     << ", \"target_qps\": " << target_qps << ", \"elapsed_s\": " << elapsed_s
+     << ", \"completed\": " << completed
+     << ", \"achieved_qps\": " << achieved_qps << ", \"latency_ms\": {"
+     << "\"min\": " << latency_min << ", \"avg\": " << latency_avg
+     << ", \"p50\": " << latency_p50 << ", \"p90\": " << latency_p90
+     << ", \"p99\": " << latency_p99 << ", \"p999\": " << latency_p999
+     << ", \"max\": " << latency_max << "}, \"cpu_usage\": ";
+  if (cpu_usage >= 0.) {
+    ss << cpu_usage;
+  } else {
+    ss << "null";
+  }
+  ss << "}";
+  return ss.str();
+}
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LITE_API_TOOLS_BENCHMARK_UTILS_LOAD_GENERATOR_H_
+#define LITE_API_TOOLS_BENCHMARK_UTILS_LOAD_GENERATOR_H_
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_api.h"
+
+namespace paddle {
+namespace lite_api {
+
+struct LoadTestOptions {
+  // Requests per second arriving independently of the completions, as a
+  // Poisson process. Non-positive values mean a closed loop, where every
+  // predictor issues its next request as soon as the last one finishes.
+  double qps{0.};
+  // Seconds to issue requests for. Non-positive values mean issuing
+  // `requests` requests in total instead.
+  double duration{0.};
+  int requests{1};
+  // Runs of every predictor before the measurement starts.
+  int warmup{0};
+};
+
+struct LoadTestReport {
+  int concurrency{0};
+  double target_qps{0.};
+  double elapsed_s{0.};
+  int64_t completed{0};
+  double achieved_qps{0.};
+  // Latencies in ms. With a target qps they are measured from the arrival
+  // of a request, so the time it waits for a free predictor is included.
+  double latency_min{0.};
+  double latency_avg{0.};
+  double latency_p50{0.};
+  double latency_p90{0.};
+  double latency_p99{0.};
+  double latency_p999{0.};
+  double latency_max{0.};
+  // Average usage of the process over the run, 1.0 for one busy core. -1 if
+  // it is not supported on the platform or the run was too short to sample.
+  double cpu_usage{-1.};
+
+  std::string ToString() const;
+  std::string ToJson() const;
+};
+
+// The value below which `p` percent of the sorted `values` fall, by the
+// nearest-rank method.
+double Percentile(const std::vector<double>& sorted_values, double p);
+
+// Drives every predictor from its own thread, their inputs must be set.
+LoadTestReport GenerateLoad(
+    const std::vector<std::shared_ptr<PaddlePredictor>>& predictors,
+    const LoadTestOptions& options);
+
+}  // namespace lite_api
+}  // namespace paddle
+
+#endif  // LITE_API_TOOLS_BENCHMARK_UTILS_LOAD_GENERATOR_H_
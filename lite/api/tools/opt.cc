@@ -48,6 +48,9 @@ DEFINE_string(quant_type,
               "Set the quant_type for post_quant_dynamic, "
               "and it should be QUANT_INT8 or QUANT_INT16 for now.");
 DEFINE_bool(enable_fp16, false, "Set kernel_type run in FP16.");
+DEFINE_bool(enable_bf16,
+            false,
+            "Store the weights of x86 fc/mul/matmul kernels in BF16.");
 DEFINE_bool(record_tailoring_info,
             false,
             "Record kernels and operators information of the optimized model "
@@ -74,6 +77,10 @@ DEFINE_bool(sparse_model,
 DEFINE_double(sparse_threshold,
               0.6,
               "Set 0.6 as the lower bound for the sparse conv pass.");
+DEFINE_bool(fold_partial_shapes,
+            false,
+            "Fold the shape ops over the dims of the var descs, only for the "
+            "models always fed with the shapes they were exported with.");
 DEFINE_string(optimized_nb_model_path,
               "",
               "path of the optimized nb model, this argument is use for the "
@@ -112,6 +119,7 @@ int main(int argc, char** argv) {
   }
   if (FLAGS_valid_targets != "") {
     if (FLAGS_enable_fp16) opt.EnableFloat16();
+    if (FLAGS_enable_bf16) opt.EnableBFloat16();
     opt.SetValidPlaces(FLAGS_valid_targets);
   }
 
@@ -129,6 +137,9 @@ int main(int argc, char** argv) {
     opt.SetSparseModel(true);
     opt.SetSparseThreshold(FLAGS_sparse_threshold);
   }
+  if (FLAGS_fold_partial_shapes) {
+    opt.SetFoldPartialShapes(true);
+  }
   if (FLAGS_print_all_ops) {
     opt.PrintAllOps();
     return 0;
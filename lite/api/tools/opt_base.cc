@@ -82,6 +82,10 @@ void OptBase::SetSparseThreshold(float sparse_threshold) {
   }
 }
 
+void OptBase::SetFoldPartialShapes(bool fold_partial_shapes) {
+  opt_config_.set_fold_partial_shapes(fold_partial_shapes);
+}
+
 void OptBase::SetPassesInternal(
     const std::vector<std::string>& passes_internal) {
   opt_config_.set_passes_internal(passes_internal);
@@ -142,6 +146,9 @@ void OptBase::SetValidPlaces(const std::string& valid_places) {
       valid_places_.emplace_back(TARGET(kX86));
       valid_places_.emplace_back(TARGET(kHost));
     } else if (target_repr == "x86") {
+      if (enable_bf16_) {
+        valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kBF16)});
+      }
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kFloat)});
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kInt64)});
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kAny)});
@@ -427,6 +434,10 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "        `--sparse_threshold=(float)`\n"
       "  Arguments of enable_fp16 in opt: \n"
       "        `--enable_fp16=(true|false)`\n"
+      "  Arguments of enable_bf16 in opt: \n"
+      "        `--enable_bf16=(true|false)`\n"
+      "  Arguments of fold_partial_shapes in opt: \n"
+      "        `--fold_partial_shapes=(true|false)`\n"
       "  Arguments of model checking and ops information:\n"
       "        `--print_all_ops=true`   Display all the valid operators of "
       "Paddle-Lite\n"
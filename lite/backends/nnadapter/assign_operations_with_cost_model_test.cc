@@ -0,0 +1,108 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "optimizer/assign_operations_with_cost_model.h"
+#include "utility/modeling.h"
+
+namespace nnadapter {
+
+typedef std::vector<std::pair<int, std::unordered_set<core::Operation*>>>
+    DeviceOperations;
+
+// The rows of a latency lookup table in the format of
+// lite/tests/benchmark/latency_lookup_table.txt
+static std::string LatencyRow(const std::string& op_name, double latency) {
+  auto latency_text = std::to_string(latency);
+  return op_name + "\t[1 8 16 16]\t[1 8 16 16]\t()\t" + latency_text + "\t" +
+         latency_text + "\t" + latency_text + "\n";
+}
+
+static core::Operation* AddOperationWithOperands(
+    core::Model* model,
+    NNAdapterOperationType type,
+    core::Operand* input_operand,
+    core::Operand* output_operand) {
+  auto operation = AddOperation(model);
+  operation->type = type;
+  operation->input_operands = {input_operand};
+  operation->output_operands = {output_operand};
+  return operation;
+}
+
+// Partition conv_2d -> relu -> conv_2d between fake_device, which only
+// supports relu, and builtin_device, which supports all of them, and return
+// the number of the operations assigned to fake_device.
+static size_t AssignToFakeDevice(double fake_device_relu_latency) {
+  core::Model model;
+  std::vector<core::Operand*> operands;
+  for (int i = 0; i < 4; i++) {
+    operands.push_back(AddFloat32VariableOperand(&model, {1, 8, 16, 16}));
+  }
+  auto conv0 = AddOperationWithOperands(
+      &model, NNADAPTER_CONV_2D, operands[0], operands[1]);
+  auto relu = AddOperationWithOperands(
+      &model, NNADAPTER_RELU, operands[1], operands[2]);
+  auto conv1 = AddOperationWithOperands(
+      &model, NNADAPTER_CONV_2D, operands[2], operands[3]);
+  operands[0]->type.lifetime = NNADAPTER_MODEL_INPUT;
+  operands[3]->type.lifetime = NNADAPTER_MODEL_OUTPUT;
+  model.input_operands = {operands[0]};
+  model.output_operands = {operands[3]};
+
+  DeviceOperations supported_operations;
+  supported_operations.emplace_back(
+      0, std::unordered_set<core::Operation*>({relu}));
+  supported_operations.emplace_back(
+      1, std::unordered_set<core::Operation*>({conv0, relu, conv1}));
+  std::vector<LatencyLookupTable> latency_tables(2);
+  EXPECT_TRUE(
+      latency_tables[0].Parse(LatencyRow("relu", fake_device_relu_latency)));
+  EXPECT_TRUE(latency_tables[1].Parse(LatencyRow("conv", 1.0) +
+                                      LatencyRow("activation", 0.5)));
+  DeviceOperations assigned_operations;
+  AssignOperationsWithCostModel(&model,
+                                supported_operations,
+                                latency_tables,
+                                1.0,
+                                0.1,
+                                &assigned_operations);
+  EXPECT_EQ(assigned_operations.size(), 2u);
+  EXPECT_EQ(assigned_operations[0].second.size() +
+                assigned_operations[1].second.size(),
+            3u);
+  EXPECT_EQ(assigned_operations[1].second.count(conv0), 1u);
+  EXPECT_EQ(assigned_operations[1].second.count(conv1), 1u);
+  auto assigned_count = assigned_operations[0].second.size();
+  ClearModel(&model);
+  return assigned_count;
+}
+
+TEST(AssignOperationsWithCostModel, move_slow_island) {
+  // relu is assigned to fake_device at first, and moving it to builtin_device
+  // reduces both its latency and the transfer and submodel costs.
+  EXPECT_EQ(AssignToFakeDevice(5.0), 0u);
+}
+
+TEST(AssignOperationsWithCostModel, keep_fast_island) {
+  // The 0.49ms saved by fake_device is more than the additional transfer and
+  // submodel costs.
+  EXPECT_EQ(AssignToFakeDevice(0.01), 1u);
+}
+
+}  // namespace nnadapter
@@ -0,0 +1,73 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "core/types.h"
+
+namespace nnadapter {
+
+// The latency lookup table of a device, it has the same format as
+// lite/tests/benchmark/latency_lookup_table.txt, each row is consisted of the
+// tab-separated op_name, input_dims, output_dims, param_info, min_latency(ms),
+// max_latency(ms) and avg_latency(ms), and op_name can be the name of the
+// NNAdapter operation type(such as 'conv_2d') or the one used by the benchmark
+// (such as 'conv').
+class LatencyLookupTable {
+ public:
+  bool Load(const std::string &path);
+  bool Parse(const std::string &content);
+  bool empty() const { return rows_.empty(); }
+  // Estimate the latency(ms) of an operation with the row whose input
+  // dimensions are matched, otherwise the row which has the nearest number of
+  // the input elements is used and its latency is scaled linearly. Return a
+  // negative value if no row is found for the operation type.
+  double Estimate(const core::Operation *operation) const;
+
+ private:
+  struct Row {
+    std::vector<int32_t> input_dimensions;
+    double latency;
+  };
+  std::map<std::string, std::vector<Row>> rows_;
+};
+
+// Reassign the operations which are supported by the multiple devices to
+// minimize the estimated latency of the whole model, it is the sum of the
+// latency of each operation on its device, the cost of transferring the
+// operands between the submodels of the different devices, and the fixed cost
+// of each submodel. It merges the small islands into their neighbors if the
+// saved transfer and submodel costs are more than the additional latency.
+// <supported_operations>: all of the operations supported by each device, the
+// index of the device is the same as the one of <latency_tables>.
+// <assigned_operations>: the operations assigned to each device, an operation
+// is assigned to the first device which supports it at the beginning.
+// <transfer_cost>: the cost(ms) of transferring 1MB between two submodels.
+// <submodel_cost>: the fixed cost(ms) of each submodel, such as the launch and
+// synchronization.
+void AssignOperationsWithCostModel(
+    core::Model *model,
+    const std::vector<std::pair<int, std::unordered_set<core::Operation *>>>
+        &supported_operations,
+    const std::vector<LatencyLookupTable> &latency_tables,
+    double transfer_cost,
+    double submodel_cost,
+    std::vector<std::pair<int, std::unordered_set<core::Operation *>>>
+        *assigned_operations);
+
+}  // namespace nnadapter
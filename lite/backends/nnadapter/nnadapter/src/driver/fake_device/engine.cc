@@ -35,6 +35,17 @@ namespace fake_device {
 
 Context::Context(void* device, const char* properties) : device_(device) {
   // TODO(hong19860320) create the raw context from fake_ddk
+  // Extract the runtime parameters from the context properties
+  NNADAPTER_LOG(INFO) << "properties: " << std::string(properties);
+  auto key_values = GetKeyValues(properties);
+  // FAKE_DEVICE_SIMULATED_LATENCY
+  if (key_values.count(FAKE_DEVICE_SIMULATED_LATENCY)) {
+    simulated_latency_ =
+        string_parse<int>(key_values[FAKE_DEVICE_SIMULATED_LATENCY]);
+  } else {
+    simulated_latency_ = GetIntFromEnv(FAKE_DEVICE_SIMULATED_LATENCY, 0);
+  }
+  NNADAPTER_LOG(INFO) << "simulated_latency: " << simulated_latency_ << "ms";
 }
 
 Context::~Context() {}
@@ -209,6 +220,9 @@ int Program::Execute(uint32_t input_count,
   NNADAPTER_CHECK_EQ(execution_->SetInputs(input_tensors),
                      fake_ddk::StatusType::SUCCESS);
   NNADAPTER_CHECK_EQ(execution_->Run(), fake_ddk::StatusType::SUCCESS);
+  if (context_->simulated_latency() > 0) {
+    usleep(context_->simulated_latency() * 1000);
+  }
   std::vector<fake_ddk::Argument> output_tensors;
   NNADAPTER_CHECK_EQ(execution_->GetOutputs(&output_tensors),
                      fake_ddk::StatusType::SUCCESS);
@@ -33,9 +33,11 @@ class Context {
  public:
   explicit Context(void* device, const char* properties);
   ~Context();
+  int simulated_latency() { return simulated_latency_; }
 
  private:
   void* device_{nullptr};
+  int simulated_latency_{0};
   void* context_{nullptr};
 };
 
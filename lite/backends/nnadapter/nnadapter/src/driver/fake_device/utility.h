@@ -23,6 +23,12 @@
 namespace nnadapter {
 namespace fake_device {
 
+// The following environment variables can be used at runtime:
+// Specify the latency(ms) added to each execution to simulate a real device,
+// such as FAKE_DEVICE_SIMULATED_LATENCY=20, it's useful for testing the
+// pipelined execution(default value is 0).
+#define FAKE_DEVICE_SIMULATED_LATENCY "FAKE_DEVICE_SIMULATED_LATENCY"
+
 // Convert the NNAdapter types to the fake device types
 fake_ddk::PrecisionType ConvertToFakeDevicePrecisionType(
     NNAdapterOperandPrecisionCode input_precision);
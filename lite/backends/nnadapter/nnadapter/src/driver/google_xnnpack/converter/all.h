@@ -15,11 +15,34 @@
 #ifndef __NNADAPTER_DRIVER_GOOGLE_XNNPACK_CONVERTER_ALL_H__  // NOLINT
 #define __NNADAPTER_DRIVER_GOOGLE_XNNPACK_CONVERTER_ALL_H__
 
+REGISTER_CONVERTER(ABS, ValidateUnaryActivations, ConvertUnaryActivations)
+REGISTER_CONVERTER(ADAPTIVE_AVERAGE_POOL_2D,
+                   ValidateAdaptivePool2D,
+                   ConvertAdaptivePool2D)
 REGISTER_CONVERTER(ADD, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(AVERAGE_POOL_2D, ValidatePool2D, ConvertPool2D)
+REGISTER_CONVERTER(CLIP, ValidateClip, ConvertClip)
+REGISTER_CONVERTER(CONCAT, ValidateConcat, ConvertConcat)
+REGISTER_CONVERTER(CONV_2D, ValidateConv2D, ConvertConv2D)
 REGISTER_CONVERTER(DIV, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(FLATTEN, ValidateFlatten, ConvertFlatten)
+REGISTER_CONVERTER(FULLY_CONNECTED,
+                   ValidateFullyConnected,
+                   ConvertFullyConnected)
+REGISTER_CONVERTER(HARD_SWISH, ValidateHardSwish, ConvertHardSwish)
+REGISTER_CONVERTER(LEAKY_RELU, ValidateLeakyRelu, ConvertLeakyRelu)
+REGISTER_CONVERTER(MAT_MUL, ValidateMatMul, ConvertMatMul)
+REGISTER_CONVERTER(MAX, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(MAX_POOL_2D, ValidatePool2D, ConvertPool2D)
+REGISTER_CONVERTER(MIN, ValidateElementwise, ConvertElementwise)
 REGISTER_CONVERTER(MUL, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(RELU, ValidateUnaryActivations, ConvertUnaryActivations)
+REGISTER_CONVERTER(RELU6, ValidateUnaryActivations, ConvertUnaryActivations)
 REGISTER_CONVERTER(RESHAPE, ValidateReshape, ConvertReshape)
+REGISTER_CONVERTER(RESIZE_LINEAR, ValidateResizeLinear, ConvertResizeLinear)
+REGISTER_CONVERTER(SIGMOID, ValidateUnaryActivations, ConvertUnaryActivations)
 REGISTER_CONVERTER(SOFTMAX, ValidateSoftmax, ConvertSoftmax)
 REGISTER_CONVERTER(SUB, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(TRANSPOSE, ValidateTranspose, ConvertTranspose)
 
 #endif  // NOLINT
@@ -0,0 +1,83 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "operation/concat.h"
+#include <vector>
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidateConcat(Validator* validator, const core::Operation* operation) {
+  // XNNPACK only supports concatenating 2, 3 or 4 inputs
+  auto input_count = operation->input_operands.size() - 1;
+  return input_count >= 2 && input_count <= 4;
+}
+
+int ConvertConcat(Converter* converter, core::Operation* operation) {
+  CONCAT_OPERATION_EXTRACT_INPUTS_OUTPUTS
+
+  // Convert to XNNPACK tensor value ids and nodes
+  std::vector<uint32_t> input_tensor_value_ids;
+  for (size_t i = 0; i < input_count - 1; i++) {
+    auto input_operand = input_operands[i];
+    auto input_tensor_value_id =
+        converter->GetMappedTensorValueId(input_operand);
+    if (input_tensor_value_id == XNN_INVALID_VALUE_ID) {
+      input_tensor_value_id = converter->ConvertOperand(input_operand);
+    }
+    input_tensor_value_ids.push_back(input_tensor_value_id);
+  }
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  switch (input_tensor_value_ids.size()) {
+    case 2:
+      ADD_OPERATOR(xnn_define_concatenate2,
+                   axis,
+                   input_tensor_value_ids[0],
+                   input_tensor_value_ids[1],
+                   output_tensor_value_id,
+                   0);
+      break;
+    case 3:
+      ADD_OPERATOR(xnn_define_concatenate3,
+                   axis,
+                   input_tensor_value_ids[0],
+                   input_tensor_value_ids[1],
+                   input_tensor_value_ids[2],
+                   output_tensor_value_id,
+                   0);
+      break;
+    case 4:
+      ADD_OPERATOR(xnn_define_concatenate4,
+                   axis,
+                   input_tensor_value_ids[0],
+                   input_tensor_value_ids[1],
+                   input_tensor_value_ids[2],
+                   input_tensor_value_ids[3],
+                   output_tensor_value_id,
+                   0);
+      break;
+    default:
+      NNADAPTER_LOG(FATAL) << "Unsupported the number of inputs("
+                           << input_tensor_value_ids.size()
+                           << ") for concat, only 2, 3 or 4 are supported.";
+      break;
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
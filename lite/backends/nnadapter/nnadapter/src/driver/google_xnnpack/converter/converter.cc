@@ -98,7 +98,10 @@ uint32_t Converter::AddTensorValue(int32_t* dimensions_data,
     NNADAPTER_CHECK(datatype == xnn_datatype_qint8 ||
                     datatype == xnn_datatype_qint32);
     if (quant_scale_count > 1) {
-      // Symmetric per-channel quantization
+      // Symmetric per-channel quantization, XNNPACK uses the dedicated
+      // channelwise data types for the filter and bias
+      datatype = datatype == xnn_datatype_qint8 ? xnn_datatype_qcint8
+                                                : xnn_datatype_qcint32;
       xnn_define_channelwise_quantized_tensor_value(
           subgraph_,
           datatype,
@@ -188,16 +191,26 @@ uint32_t Converter::AddQuant8ConstantTensorValue(int8_t* values,
 uint32_t Converter::AddQuant32ConstantTensorValue(int32_t* values,
                                                   int32_t* dimensions_data,
                                                   uint32_t dimensions_count,
-                                                  float quant_scale) {
+                                                  float* quant_scales,
+                                                  uint32_t quant_scale_count,
+                                                  uint32_t quant_channel_dim) {
   return AddTensorValue(dimensions_data,
                         dimensions_count,
                         xnn_datatype_qint32,
-                        &quant_scale,
-                        1,
-                        0,
+                        quant_scales,
+                        quant_scale_count,
+                        quant_channel_dim,
                         values);
 }
 
+uint32_t Converter::AddQuant32ConstantTensorValue(int32_t* values,
+                                                  int32_t* dimensions_data,
+                                                  uint32_t dimensions_count,
+                                                  float quant_scale) {
+  return AddQuant32ConstantTensorValue(
+      values, dimensions_data, dimensions_count, &quant_scale, 1, 0);
+}
+
 uint32_t Converter::AddFloat32VariableTensorValue(int32_t* dimensions_data,
                                                   uint32_t dimensions_count,
                                                   uint32_t flags) {
@@ -291,6 +304,17 @@ uint32_t Converter::ConvertOperand(core::Operand* operand,
                                         dimensions.size(),
                                         type.symm_per_layer_params.scale);
     } break;
+    case NNADAPTER_QUANT_INT32_SYMM_PER_CHANNEL: {
+      // Only for bias
+      NNADAPTER_CHECK(is_constant);
+      tensor_value_id = AddQuant32ConstantTensorValue(
+          reinterpret_cast<int32_t*>(buffer),
+          dimensions.data(),
+          dimensions.size(),
+          type.symm_per_channel_params.scales,
+          type.symm_per_channel_params.scale_count,
+          type.symm_per_channel_params.channel_dim);
+    } break;
     default:
       NNADAPTER_LOG(FATAL) << "Missing the processing "
                            << OperandPrecisionCodeToString(type.precision)
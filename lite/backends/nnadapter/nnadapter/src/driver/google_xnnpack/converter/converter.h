@@ -61,6 +61,12 @@ class Converter {
                                         int32_t* dimensions_data,
                                         uint32_t dimensions_count,
                                         float quant_scale);
+  uint32_t AddQuant32ConstantTensorValue(int32_t* values,
+                                         int32_t* dimensions_data,
+                                         uint32_t dimensions_count,
+                                         float* quant_scales,
+                                         uint32_t quant_scale_count,
+                                         uint32_t quant_channel_dim);
   uint32_t AddQuant32ConstantTensorValue(int32_t* values,
                                          int32_t* dimensions_data,
                                          uint32_t dimensions_count,
@@ -23,6 +23,17 @@ namespace google_xnnpack {
 
 bool ValidateElementwise(Validator* validator,
                          const core::Operation* operation) {
+  ELEMENTWISE_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // XNNPACK only supports the quantized add and mul
+  if (operation->type != NNADAPTER_ADD && operation->type != NNADAPTER_MUL &&
+      input0_operand->type.precision != NNADAPTER_FLOAT32) {
+    return false;
+  }
+  // The maximum and minimum nodes have no output clipping range
+  if ((operation->type == NNADAPTER_MAX || operation->type == NNADAPTER_MIN) &&
+      fuse_code != NNADAPTER_FUSED_NONE) {
+    return false;
+  }
   return true;
 }
 
@@ -75,6 +86,18 @@ int ConvertElementwise(Converter* converter, core::Operation* operation) {
                  input1_tensor_value_id,
                  output_tensor_value_id,
                  0);
+  } else if (operation->type == NNADAPTER_MAX) {
+    ADD_OPERATOR(xnn_define_maximum2,
+                 input0_tensor_value_id,
+                 input1_tensor_value_id,
+                 output_tensor_value_id,
+                 0);
+  } else if (operation->type == NNADAPTER_MIN) {
+    ADD_OPERATOR(xnn_define_minimum2,
+                 input0_tensor_value_id,
+                 input1_tensor_value_id,
+                 output_tensor_value_id,
+                 0);
   } else {
     NNADAPTER_LOG(FATAL) << "Unsupported element-wise operation type "
                          << OperationTypeToString(operation->type)
@@ -0,0 +1,55 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "operation/flatten.h"
+#include <vector>
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidateFlatten(Validator* validator, const core::Operation* operation) {
+  return true;
+}
+
+int ConvertFlatten(Converter* converter, core::Operation* operation) {
+  FLATTEN_OPERATION_EXTRACT_INPUTS_OUTPUTS
+
+  // Convert to XNNPACK tensor value ids and nodes
+  auto input_tensor_value_id = converter->GetMappedTensorValueId(input_operand);
+  if (input_tensor_value_id == XNN_INVALID_VALUE_ID) {
+    input_tensor_value_id = converter->ConvertOperand(input_operand);
+  }
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  // Flatten is a static reshape to the inferred output dimensions
+  auto output_dimensions_data = output_operand->type.dimensions.data;
+  auto output_dimensions_count = output_operand->type.dimensions.count;
+  std::vector<size_t> shape;
+  for (uint32_t i = 0; i < output_dimensions_count; i++) {
+    NNADAPTER_CHECK_GT(output_dimensions_data[i], 0);
+    shape.push_back(output_dimensions_data[i]);
+  }
+  ADD_OPERATOR(xnn_define_static_reshape,
+               shape.size(),
+               shape.data(),
+               input_tensor_value_id,
+               output_tensor_value_id,
+               0);
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
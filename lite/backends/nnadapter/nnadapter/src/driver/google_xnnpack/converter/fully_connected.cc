@@ -0,0 +1,67 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "operation/fully_connected.h"
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+#include "utility/modeling.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidateFullyConnected(Validator* validator,
+                            const core::Operation* operation) {
+  auto weight_operand = operation->input_operands[1];
+  auto bias_operand = operation->input_operands[2];
+  // The per-channel quantized weight is not supported by XNNPACK
+  return IsConstantOperand(weight_operand) && IsConstantOperand(bias_operand) &&
+         weight_operand->type.precision !=
+             NNADAPTER_QUANT_INT8_SYMM_PER_CHANNEL;
+}
+
+int ConvertFullyConnected(Converter* converter, core::Operation* operation) {
+  FULLY_CONNECTED_OPERATION_EXTRACT_INPUTS_OUTPUTS
+
+  // Convert to XNNPACK tensor value ids and nodes
+  auto input_tensor_value_id = converter->GetMappedTensorValueId(input_operand);
+  if (input_tensor_value_id == XNN_INVALID_VALUE_ID) {
+    input_tensor_value_id = converter->ConvertOperand(input_operand);
+  }
+  auto weight_tensor_value_id = converter->ConvertOperand(weight_operand);
+  auto bias_tensor_value_id = converter->ConvertOperand(bias_operand);
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  float output_min, output_max;
+  ConvertFuseCodeToXNNClippingRange(fuse_code, &output_min, &output_max);
+  // The input is reshaped to [batch_size, input_size] if its last dimension is
+  // not equal to input_size, e.g. [N, C, H, W] -> [N, C * H * W]
+  auto input_dimensions_count = input_operand->type.dimensions.count;
+  uint32_t flags = 0;
+  if (input_operand->type.dimensions.data[input_dimensions_count - 1] !=
+      input_size) {
+    flags |= XNN_FLAG_TENSORFLOW_RESHAPE_2D;
+  }
+  ADD_OPERATOR(xnn_define_fully_connected,
+               output_min,
+               output_max,
+               input_tensor_value_id,
+               weight_tensor_value_id,
+               bias_tensor_value_id,
+               output_tensor_value_id,
+               flags);
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
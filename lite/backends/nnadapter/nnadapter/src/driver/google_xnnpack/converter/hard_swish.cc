@@ -0,0 +1,47 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "operation/hard_sigmoid_swish.h"
+#include <cmath>
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidateHardSwish(Validator* validator, const core::Operation* operation) {
+  HARD_SIGMOID_SWISH_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // XNNPACK only supports the float32 hard swish of x * relu6(x + 3) / 6
+  return input_operand->type.precision == NNADAPTER_FLOAT32 &&
+         std::fabs(alpha - 1.0f / 6.0f) <= 1e-5f &&
+         std::fabs(beta - 0.5f) <= 1e-5f;
+}
+
+int ConvertHardSwish(Converter* converter, core::Operation* operation) {
+  HARD_SIGMOID_SWISH_OPERATION_EXTRACT_INPUTS_OUTPUTS
+
+  // Convert to XNNPACK tensor value ids and nodes
+  auto input_tensor_value_id = converter->GetMappedTensorValueId(input_operand);
+  if (input_tensor_value_id == XNN_INVALID_VALUE_ID) {
+    input_tensor_value_id = converter->ConvertOperand(input_operand);
+  }
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  ADD_OPERATOR(
+      xnn_define_hardswish, input_tensor_value_id, output_tensor_value_id, 0);
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
@@ -0,0 +1,64 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "operation/mat_mul.h"
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+#include "utility/modeling.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidateMatMul(Validator* validator, const core::Operation* operation) {
+  MAT_MUL_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // Only supports the constant 2-D y, which is mapped to a fully connected
+  // node without bias
+  return !transpose_x && IsConstantOperand(y_operand) &&
+         y_operand->type.dimensions.count == 2 &&
+         x_operand->type.dimensions.count >= 2 &&
+         y_operand->type.precision != NNADAPTER_QUANT_INT8_SYMM_PER_CHANNEL;
+}
+
+int ConvertMatMul(Converter* converter, core::Operation* operation) {
+  MAT_MUL_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  NNADAPTER_CHECK(!transpose_x);
+  // y should be transposed to [num_units, input_size] by
+  // ResolveOperationLiminations()
+  NNADAPTER_CHECK(transpose_y);
+  NNADAPTER_CHECK(IsConstantOperand(y_operand));
+
+  // Convert to XNNPACK tensor value ids and nodes
+  auto x_tensor_value_id = converter->GetMappedTensorValueId(x_operand);
+  if (x_tensor_value_id == XNN_INVALID_VALUE_ID) {
+    x_tensor_value_id = converter->ConvertOperand(x_operand);
+  }
+  auto y_tensor_value_id = converter->ConvertOperand(y_operand);
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  float output_min, output_max;
+  ConvertFuseCodeToXNNClippingRange(
+      NNADAPTER_FUSED_NONE, &output_min, &output_max);
+  ADD_OPERATOR(xnn_define_fully_connected,
+               output_min,
+               output_max,
+               x_tensor_value_id,
+               y_tensor_value_id,
+               XNN_INVALID_VALUE_ID,
+               output_tensor_value_id,
+               0);
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
@@ -0,0 +1,145 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "operation/pool2d.h"
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidatePool2D(Validator* validator, const core::Operation* operation) {
+  POOL_2D_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // The model is still in NCHW data layout at the validation stage
+  auto input_height = input_operand->type.dimensions.data[2];
+  auto input_width = input_operand->type.dimensions.data[3];
+  if (operation_type == NNADAPTER_AVERAGE_POOL_2D && global_pooling) {
+    return true;
+  }
+  // XNNPACK rejects the pooling window of 1x1
+  if (kernel_height * kernel_width <= 1) return false;
+  // XNNPACK excludes the padding elements when averaging
+  if (operation_type == NNADAPTER_AVERAGE_POOL_2D) {
+    if (input_operand->type.precision != NNADAPTER_FLOAT32) return false;
+    if (flag && (pad_height_top != 0 || pad_height_bottom != 0 ||
+                 pad_width_left != 0 || pad_width_right != 0)) {
+      return false;
+    }
+  }
+  // Only the ceil mode which produces the same output size as the floor mode
+  if (ceil_mode) {
+    auto output_height = operation::CalPoolOutputSize(input_height,
+                                                      kernel_height,
+                                                      auto_pad,
+                                                      pad_height_top,
+                                                      pad_height_bottom,
+                                                      stride_height,
+                                                      false);
+    auto output_width = operation::CalPoolOutputSize(input_width,
+                                                     kernel_width,
+                                                     auto_pad,
+                                                     pad_width_left,
+                                                     pad_width_right,
+                                                     stride_width,
+                                                     false);
+    if (output_height != output_operand->type.dimensions.data[2] ||
+        output_width != output_operand->type.dimensions.data[3]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int ConvertPool2D(Converter* converter, core::Operation* operation) {
+  POOL_2D_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // NHWC
+  auto input_height = input_operand->type.dimensions.data[1];
+  auto input_width = input_operand->type.dimensions.data[2];
+  global_pooling =
+      kernel_height == input_height && kernel_width == input_width;
+  if (auto_pad != NNADAPTER_AUTO_PAD_NONE) {
+    operation::UpdatePool2DPadAndDilation(input_height,
+                                          kernel_height,
+                                          auto_pad,
+                                          &pad_height_top,
+                                          &pad_height_bottom,
+                                          stride_height);
+    operation::UpdatePool2DPadAndDilation(input_width,
+                                          kernel_width,
+                                          auto_pad,
+                                          &pad_width_left,
+                                          &pad_width_right,
+                                          stride_width);
+  }
+
+  // Convert to XNNPACK tensor value ids and nodes
+  auto input_tensor_value_id = converter->GetMappedTensorValueId(input_operand);
+  if (input_tensor_value_id == XNN_INVALID_VALUE_ID) {
+    input_tensor_value_id = converter->ConvertOperand(input_operand);
+  }
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  float output_min, output_max;
+  ConvertFuseCodeToXNNClippingRange(fuse_code, &output_min, &output_max);
+  if (operation_type == NNADAPTER_AVERAGE_POOL_2D) {
+    if (global_pooling) {
+      ADD_OPERATOR(xnn_define_global_average_pooling_2d,
+                   output_min,
+                   output_max,
+                   input_tensor_value_id,
+                   output_tensor_value_id,
+                   0);
+    } else {
+      ADD_OPERATOR(xnn_define_average_pooling_2d,
+                   pad_height_top,
+                   pad_width_right,
+                   pad_height_bottom,
+                   pad_width_left,
+                   kernel_height,
+                   kernel_width,
+                   stride_height,
+                   stride_width,
+                   output_min,
+                   output_max,
+                   input_tensor_value_id,
+                   output_tensor_value_id,
+                   0);
+    }
+  } else if (operation_type == NNADAPTER_MAX_POOL_2D) {
+    ADD_OPERATOR(xnn_define_max_pooling_2d,
+                 pad_height_top,
+                 pad_width_right,
+                 pad_height_bottom,
+                 pad_width_left,
+                 kernel_height,
+                 kernel_width,
+                 stride_height,
+                 stride_width,
+                 1,
+                 1,
+                 output_min,
+                 output_max,
+                 input_tensor_value_id,
+                 output_tensor_value_id,
+                 0);
+  } else {
+    NNADAPTER_LOG(FATAL) << "Unsupported pooling operation type "
+                         << OperationTypeToString(operation->type)
+                         << " is found.";
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
@@ -0,0 +1,66 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "operation/resize_linear.h"
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidateResizeLinear(Validator* validator,
+                          const core::Operation* operation) {
+  auto input_operand = operation->input_operands[0];
+  auto output_operand = operation->output_operands[0];
+  // Only supports the 4-D input and the output size known at build time
+  return input_operand->type.dimensions.count == 4 &&
+         output_operand->type.dimensions.data[2] > 0 &&
+         output_operand->type.dimensions.data[3] > 0;
+}
+
+int ConvertResizeLinear(Converter* converter, core::Operation* operation) {
+  RESIZE_LINEAR_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // NHWC
+  auto output_height = output_operand->type.dimensions.data[1];
+  auto output_width = output_operand->type.dimensions.data[2];
+  NNADAPTER_CHECK_GT(output_height, 0);
+  NNADAPTER_CHECK_GT(output_width, 0);
+  // align_corners=true -> src = dst * (in - 1) / (out - 1)
+  // align_mode=0 -> src = (dst + 0.5) * scale - 0.5, the default of XNNPACK
+  // align_mode=1 -> src = dst * scale, the legacy mode of TensorFlow
+  uint32_t flags = 0;
+  if (align_corners) {
+    flags |= XNN_FLAG_ALIGN_CORNERS;
+  } else if (align_mode == 1) {
+    flags |= XNN_FLAG_TENSORFLOW_LEGACY_MODE;
+  }
+
+  // Convert to XNNPACK tensor value ids and nodes
+  auto input_tensor_value_id = converter->GetMappedTensorValueId(input_operand);
+  if (input_tensor_value_id == XNN_INVALID_VALUE_ID) {
+    input_tensor_value_id = converter->ConvertOperand(input_operand);
+  }
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  ADD_OPERATOR(xnn_define_static_resize_bilinear_2d,
+               output_height,
+               output_width,
+               input_tensor_value_id,
+               output_tensor_value_id,
+               flags);
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
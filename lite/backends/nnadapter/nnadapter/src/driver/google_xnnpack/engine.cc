@@ -19,12 +19,10 @@
 #include "driver/google_xnnpack/converter/validator.h"
 #include "driver/google_xnnpack/optimizer/resolve_operation_liminations.h"
 #include "optimizer/convert_datalayout_nchw_to_nhwc.h"
-#include "optimizer/convert_quantization_symm_to_asymm.h"
 #include "optimizer/fuse_conv2d_activation_into_conv2d.h"
 #include "optimizer/fuse_conv2d_add_into_conv2d.h"
 #include "optimizer/fuse_conv2d_batch_norm_into_conv2d.h"
 #include "optimizer/fuse_matmul_add_into_fully_connected.h"
-#include "optimizer/fuse_reshape_transpose_reshape_into_channel_shuffle.h"
 #include "utility/debug.h"
 #include "utility/logging.h"
 #include "utility/modeling.h"
@@ -123,7 +121,7 @@ int Program::Build(core::Model* model, core::Cache* cache) {
     FuseConv2DAddIntoConv2D(model);
     FuseConv2DActivationIntoConv2D(model);
     FuseMatMulAddIntoFullyConnected(model);
-    FuseReshapeTransposeReshapeIntoChannelShuffle(model);
+    ConvertDataLayoutNCHWToNHWC(model);
     ResolveOperationLiminations(model);
     NNADAPTER_VLOG(5) << "Optimized model:" << std::endl << Visualize(model);
   }
@@ -259,9 +257,10 @@ int Program::Execute(uint32_t input_count,
     NNADAPTER_CHECK(arg.memory);
     NNADAPTER_CHECK(arg.access);
     auto type = &output_types_[arg.index];
-    // TODO(hong19860320) Get the dimensions of the outputs from NNAPI
-    // according to the dynamic dimensions of the inputs, fill them to 'type'
-    // and call the 'access' function to re-allocate the host output memory
+    // The XNNPACK runtime is built for the static input dimensions, a program
+    // with the different input dimensions is rejected by
+    // CheckInputsAndOutputs() and rebuilt by the caller, so the output
+    // dimensions are always the ones of the model
     auto buffer = arg.access(arg.memory, type, nullptr);
     NNADAPTER_CHECK(buffer);
     // auto length = GetOperandTypeBufferLength(*type);
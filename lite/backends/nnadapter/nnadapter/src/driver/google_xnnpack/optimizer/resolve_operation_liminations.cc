@@ -120,6 +120,24 @@ static void ResolveSoftmax(core::Model* model, core::Operation* operation) {
   }
 }
 
+static void ResolveMatMul(core::Model* model, core::Operation* operation) {
+  auto& input_operands = operation->input_operands;
+  auto& output_operands = operation->output_operands;
+  auto input_count = input_operands.size();
+  auto output_count = output_operands.size();
+  NNADAPTER_CHECK_EQ(input_count, 4);
+  NNADAPTER_CHECK_EQ(output_count, 1);
+  auto y_operand = input_operands[1];
+  auto transpose_y = reinterpret_cast<bool*>(input_operands[3]->buffer);
+  // XNNPACK fully connected node requires the weight of [num_units,
+  // input_size], so transpose the constant y of [input_size, num_units]
+  if (!*transpose_y && IsConstantOperand(y_operand) &&
+      y_operand->type.dimensions.count == 2) {
+    TransposeOperand(y_operand, std::vector<int32_t>({1, 0}));
+    *transpose_y = true;
+  }
+}
+
 void ResolveOperationLiminations(core::Model* model) {
   std::vector<core::Operation*> operations =
       SortOperationsInTopologicalOrder(model);
@@ -127,6 +145,9 @@ void ResolveOperationLiminations(core::Model* model) {
     NNADAPTER_VLOG(5) << "Converting " << OperationTypeToString(operation->type)
                       << " ...";
     switch (operation->type) {
+      case NNADAPTER_MAT_MUL:
+        ResolveMatMul(model, operation);
+        break;
       case NNADAPTER_SOFTMAX:
         ResolveSoftmax(model, operation);
         break;
@@ -0,0 +1,407 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "optimizer/assign_operations_with_cost_model.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include "utility/debug.h"
+#include "utility/logging.h"
+#include "utility/micros.h"
+#include "utility/modeling.h"
+#include "utility/string.h"
+#include "utility/utility.h"
+
+namespace nnadapter {
+
+static std::string ToLowerCase(std::string text) {
+  std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+  return text;
+}
+
+static std::string Trim(const std::string &text) {
+  auto begin = text.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) return "";
+  auto end = text.find_last_not_of(" \t\r\n");
+  return text.substr(begin, end - begin + 1);
+}
+
+// The names of the operations used by lite/tests/benchmark
+static std::string GetBenchmarkOperationName(NNAdapterOperationType type) {
+  switch (type) {
+    case NNADAPTER_CONV_2D:
+      return "conv";
+    case NNADAPTER_FULLY_CONNECTED:
+      return "fc";
+    case NNADAPTER_BATCH_NORMALIZATION:
+      return "batchnorm";
+    case NNADAPTER_AVERAGE_POOL_2D:
+    case NNADAPTER_MAX_POOL_2D:
+      return "pooling";
+    case NNADAPTER_HARD_SIGMOID:
+    case NNADAPTER_HARD_SWISH:
+    case NNADAPTER_LEAKY_RELU:
+    case NNADAPTER_PRELU:
+    case NNADAPTER_RELU:
+    case NNADAPTER_RELU6:
+    case NNADAPTER_SIGMOID:
+    case NNADAPTER_SWISH:
+    case NNADAPTER_TANH:
+      return "activation";
+    default:
+      break;
+  }
+  return "";
+}
+
+// Treat the unknown dimensions as 1
+static int64_t CountElements(const std::vector<int32_t> &dimensions) {
+  int64_t count = 1;
+  for (auto dimension : dimensions) {
+    count *= std::max(dimension, 1);
+  }
+  return count;
+}
+
+bool LatencyLookupTable::Load(const std::string &path) {
+  std::vector<uint8_t> buffer;
+  if (!ReadFile(path, &buffer)) {
+    return false;
+  }
+  return Parse(std::string(buffer.begin(), buffer.end()));
+}
+
+bool LatencyLookupTable::Parse(const std::string &content) {
+  rows_.clear();
+  std::istringstream stream(content);
+  std::string line;
+  while (std::getline(stream, line)) {
+    std::vector<std::string> fields;
+    std::istringstream line_stream(line);
+    std::string field;
+    while (std::getline(line_stream, field, '\t')) {
+      fields.push_back(Trim(field));
+    }
+    // Skip the device information and the header
+    if (fields.size() < 7 || fields[1].empty() || fields[1][0] != '[') {
+      continue;
+    }
+    Row row;
+    std::istringstream dimensions_stream(
+        fields[1].substr(1, fields[1].find(']') - 1));
+    int32_t dimension;
+    while (dimensions_stream >> dimension) {
+      row.input_dimensions.push_back(dimension);
+    }
+    row.latency = string_parse<double>(fields.back());
+    rows_[ToLowerCase(fields[0])].push_back(row);
+  }
+  return !rows_.empty();
+}
+
+double LatencyLookupTable::Estimate(const core::Operation *operation) const {
+  auto it = rows_.find(ToLowerCase(OperationTypeToString(operation->type)));
+  if (it == rows_.end()) {
+    it = rows_.find(GetBenchmarkOperationName(operation->type));
+    if (it == rows_.end()) return -1.0;
+  }
+  auto &rows = it->second;
+  if (operation->input_operands.empty() || !operation->input_operands[0]) {
+    return rows.front().latency;
+  }
+  auto &type = operation->input_operands[0]->type;
+  std::vector<int32_t> input_dimensions(
+      type.dimensions.data, type.dimensions.data + type.dimensions.count);
+  auto input_count = CountElements(input_dimensions);
+  const Row *nearest_row = nullptr;
+  double nearest_distance = 0;
+  for (auto &row : rows) {
+    if (row.input_dimensions == input_dimensions) {
+      return row.latency;
+    }
+    double distance = std::fabs(
+        std::log(static_cast<double>(CountElements(row.input_dimensions)) /
+                 input_count));
+    if (!nearest_row || distance < nearest_distance) {
+      nearest_row = &row;
+      nearest_distance = distance;
+    }
+  }
+  return nearest_row->latency * input_count /
+         CountElements(nearest_row->input_dimensions);
+}
+
+class CostModel {
+ public:
+  CostModel(
+      core::Model *model,
+      const std::vector<std::pair<int, std::unordered_set<core::Operation *>>>
+          &supported_operations,
+      const std::vector<LatencyLookupTable> &latency_tables,
+      double transfer_cost,
+      double submodel_cost);
+  // The estimated latency(ms) of the model and the number of the submodels
+  double Estimate(const std::vector<int> &assignment, size_t *submodel_count);
+  // The connected operations which are assigned to the same device
+  std::vector<std::vector<size_t>> Islands(const std::vector<int> &assignment);
+  bool IsSupported(size_t operation_index, int device_index) {
+    return supported_operations_[device_index].second.count(
+               operations_[operation_index]) != 0;
+  }
+  const std::vector<core::Operation *> &operations() { return operations_; }
+  // The operations connected to the given one
+  const std::set<size_t> &neighbors(size_t operation_index) {
+    return neighbors_[operation_index];
+  }
+
+ private:
+  struct Edge {
+    size_t producer;
+    std::vector<size_t> consumers;
+    double megabytes;
+  };
+  std::vector<core::Operation *> operations_;
+  const std::vector<std::pair<int, std::unordered_set<core::Operation *>>>
+      &supported_operations_;
+  // The latency of each operation on each device
+  std::vector<std::vector<double>> latencies_;
+  std::vector<Edge> edges_;
+  std::vector<std::set<size_t>> neighbors_;
+  double transfer_cost_;
+  double submodel_cost_;
+};
+
+CostModel::CostModel(
+    core::Model *model,
+    const std::vector<std::pair<int, std::unordered_set<core::Operation *>>>
+        &supported_operations,
+    const std::vector<LatencyLookupTable> &latency_tables,
+    double transfer_cost,
+    double submodel_cost)
+    : operations_(SortOperationsInTopologicalOrder(model)),
+      supported_operations_(supported_operations),
+      transfer_cost_(transfer_cost),
+      submodel_cost_(submodel_cost) {
+  auto operation_count = operations_.size();
+  auto device_count = supported_operations.size();
+  NNADAPTER_CHECK_EQ(latency_tables.size(), device_count);
+  // Use the average latency of the other devices if an operation is not found
+  // in the latency lookup table of a device
+  latencies_.resize(operation_count);
+  for (size_t i = 0; i < operation_count; i++) {
+    latencies_[i].resize(device_count, -1.0);
+    double total_latency = 0;
+    size_t known_count = 0;
+    for (size_t j = 0; j < device_count; j++) {
+      if (!IsSupported(i, j)) continue;
+      latencies_[i][j] = latency_tables[j].Estimate(operations_[i]);
+      if (latencies_[i][j] >= 0) {
+        total_latency += latencies_[i][j];
+        known_count++;
+      }
+    }
+    auto default_latency = known_count > 0 ? total_latency / known_count : 0;
+    for (size_t j = 0; j < device_count; j++) {
+      if (latencies_[i][j] < 0) {
+        latencies_[i][j] = default_latency;
+      }
+    }
+  }
+  // Collect the non-constant operands shared by the operations
+  std::unordered_map<core::Operand *, size_t> producers;
+  for (size_t i = 0; i < operation_count; i++) {
+    for (auto operand : operations_[i]->output_operands) {
+      if (operand) {
+        producers[operand] = i;
+      }
+    }
+  }
+  std::unordered_map<core::Operand *, size_t> operand_to_edge;
+  neighbors_.resize(operation_count);
+  for (size_t i = 0; i < operation_count; i++) {
+    for (auto operand : operations_[i]->input_operands) {
+      if (!operand || !producers.count(operand)) continue;
+      if (!operand_to_edge.count(operand)) {
+        Edge edge;
+        edge.producer = producers[operand];
+        edge.megabytes =
+            GetOperandTypeBufferLength(operand->type) / (1024.0 * 1024.0);
+        operand_to_edge[operand] = edges_.size();
+        edges_.push_back(edge);
+      }
+      auto &edge = edges_[operand_to_edge[operand]];
+      edge.consumers.push_back(i);
+      neighbors_[edge.producer].insert(i);
+      neighbors_[i].insert(edge.producer);
+    }
+  }
+}
+
+std::vector<std::vector<size_t>> CostModel::Islands(
+    const std::vector<int> &assignment) {
+  auto operation_count = operations_.size();
+  std::vector<size_t> parents(operation_count);
+  for (size_t i = 0; i < operation_count; i++) {
+    parents[i] = i;
+  }
+  std::function<size_t(size_t)> find = [&](size_t i) {
+    return parents[i] == i ? i : parents[i] = find(parents[i]);
+  };
+  for (auto &edge : edges_) {
+    for (auto consumer : edge.consumers) {
+      if (assignment[edge.producer] == assignment[consumer]) {
+        parents[find(consumer)] = find(edge.producer);
+      }
+    }
+  }
+  std::map<size_t, size_t> root_to_island;
+  std::vector<std::vector<size_t>> islands;
+  for (size_t i = 0; i < operation_count; i++) {
+    auto root = find(i);
+    if (!root_to_island.count(root)) {
+      root_to_island[root] = islands.size();
+      islands.emplace_back();
+    }
+    islands[root_to_island[root]].push_back(i);
+  }
+  return islands;
+}
+
+double CostModel::Estimate(const std::vector<int> &assignment,
+                           size_t *submodel_count) {
+  double latency = 0;
+  for (size_t i = 0; i < operations_.size(); i++) {
+    latency += latencies_[i][assignment[i]];
+  }
+  // The operand is transferred once to each of the other devices
+  for (auto &edge : edges_) {
+    std::set<int> devices;
+    for (auto consumer : edge.consumers) {
+      if (assignment[consumer] != assignment[edge.producer]) {
+        devices.insert(assignment[consumer]);
+      }
+    }
+    latency += devices.size() * edge.megabytes * transfer_cost_;
+  }
+  *submodel_count = Islands(assignment).size();
+  return latency + *submodel_count * submodel_cost_;
+}
+
+NNADAPTER_EXPORT void AssignOperationsWithCostModel(
+    core::Model *model,
+    const std::vector<std::pair<int, std::unordered_set<core::Operation *>>>
+        &supported_operations,
+    const std::vector<LatencyLookupTable> &latency_tables,
+    double transfer_cost,
+    double submodel_cost,
+    std::vector<std::pair<int, std::unordered_set<core::Operation *>>>
+        *assigned_operations) {
+  CostModel cost_model(model,
+                       supported_operations,
+                       latency_tables,
+                       transfer_cost,
+                       submodel_cost);
+  auto &operations = cost_model.operations();
+  auto operation_count = operations.size();
+  auto device_count = static_cast<int>(supported_operations.size());
+  // Assign each operation to the first device which supports it
+  std::vector<int> assignment(operation_count, -1);
+  for (size_t i = 0; i < operation_count; i++) {
+    for (int j = 0; j < device_count; j++) {
+      if (cost_model.IsSupported(i, j)) {
+        assignment[i] = j;
+        break;
+      }
+    }
+    NNADAPTER_CHECK_GE(assignment[i], 0)
+        << "None of these " << device_count << " devices support "
+        << OperationTypeToString(operations[i]->type) << "!";
+  }
+  size_t origin_submodel_count = 0;
+  auto origin_latency =
+      cost_model.Estimate(assignment, &origin_submodel_count);
+  // Move the whole island to the device of one of its neighbors, and accept
+  // it only if the estimated latency of the model is reduced. Each accepted
+  // move reduces the latency, so the loop always terminates.
+  auto latency = origin_latency;
+  auto submodel_count = origin_submodel_count;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    auto islands = cost_model.Islands(assignment);
+    for (auto &island : islands) {
+      auto device_index = assignment[island.front()];
+      std::set<int> candidate_devices;
+      for (auto operation_index : island) {
+        for (auto neighbor : cost_model.neighbors(operation_index)) {
+          if (assignment[neighbor] != device_index) {
+            candidate_devices.insert(assignment[neighbor]);
+          }
+        }
+      }
+      for (auto candidate_device : candidate_devices) {
+        bool supported = true;
+        for (auto operation_index : island) {
+          if (!cost_model.IsSupported(operation_index, candidate_device)) {
+            supported = false;
+            break;
+          }
+        }
+        if (!supported) continue;
+        auto candidate_assignment = assignment;
+        for (auto operation_index : island) {
+          candidate_assignment[operation_index] = candidate_device;
+        }
+        size_t candidate_submodel_count = 0;
+        auto candidate_latency = cost_model.Estimate(
+            candidate_assignment, &candidate_submodel_count);
+        if (candidate_latency < latency - 1e-6) {
+          NNADAPTER_VLOG(5) << "Move " << island.size()
+                            << " operations from device #" << device_index
+                            << " to device #" << candidate_device
+                            << ", the estimated latency is reduced from "
+                            << latency << "ms to " << candidate_latency
+                            << "ms.";
+          assignment = candidate_assignment;
+          latency = candidate_latency;
+          submodel_count = candidate_submodel_count;
+          changed = true;
+          break;
+        }
+      }
+      // The islands should be detected again after any change
+      if (changed) break;
+    }
+  }
+  NNADAPTER_LOG(INFO) << "Cost model based partition: " << origin_submodel_count
+                      << " submodels with the estimated latency "
+                      << origin_latency << "ms -> " << submodel_count
+                      << " submodels with the estimated latency " << latency
+                      << "ms.";
+  assigned_operations->clear();
+  for (int i = 0; i < device_count; i++) {
+    assigned_operations->emplace_back(supported_operations[i].first,
+                                      std::unordered_set<core::Operation *>());
+  }
+  for (size_t i = 0; i < operation_count; i++) {
+    assigned_operations->at(assignment[i]).second.insert(operations[i]);
+  }
+}
+
+}  // namespace nnadapter
@@ -16,6 +16,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include "optimizer/assign_operations_with_cost_model.h"
 #include "optimizer/partition_model_into_submodels.h"
 #include "utility/cache.h"
 #include "utility/debug.h"
@@ -24,6 +25,18 @@
 #include "utility/string.h"
 #include "utility/utility.h"
 
+// Specify the directory of the latency lookup tables to enable the cost model
+// based model partition, the table of a device is named '<device_name>.txt',
+// such as '/data/local/tmp/latency/builtin_device.txt'.
+#define NNADAPTER_PARTITION_LATENCY_TABLE_DIR \
+  "NNADAPTER_PARTITION_LATENCY_TABLE_DIR"
+// The cost(ms) of transferring 1MB between the submodels of the different
+// devices(default value is 1.0).
+#define NNADAPTER_PARTITION_TRANSFER_COST "NNADAPTER_PARTITION_TRANSFER_COST"
+// The fixed cost(ms) of launching and synchronizing a submodel(default value is
+// 0.1).
+#define NNADAPTER_PARTITION_SUBMODEL_COST "NNADAPTER_PARTITION_SUBMODEL_COST"
+
 namespace nnadapter {
 namespace runtime {
 
@@ -395,6 +408,9 @@ int Compilation::PartitionModel(
     std::fill(flags.get(), flags.get() + operation_count, false);
     std::vector<std::pair<int, std::unordered_set<core::Operation*>>>
         supported_operations(device_count);
+    // All of the operations supported by each device for the cost model
+    std::vector<std::pair<int, std::unordered_set<core::Operation*>>>
+        all_supported_operations(device_count);
     for (size_t i = 0; i < device_count; i++) {
       auto device_context = context->GetDeviceContext(i);
       NNADAPTER_CHECK(device_context);
@@ -405,8 +421,12 @@ int Compilation::PartitionModel(
         return result;
       }
       supported_operations[i].first = i;
+      all_supported_operations[i].first = i;
       size_t operation_index = 0;
       for (auto& operation : model->model_.operations) {
+        if (_flags_[operation_index]) {
+          all_supported_operations[i].second.insert(&operation);
+        }
         if (_flags_[operation_index] && !flags[operation_index]) {
           flags[operation_index] = true;
           // Only the operations which are not supported by the previous devices
@@ -424,12 +444,49 @@ int Compilation::PartitionModel(
                            << " devices support "
                            << OperationTypeToString(operation.type) << "!";
     }
+    // Reassign the operations with the latency lookup tables of the devices
+    auto key_values = GetKeyValues(context->GetProperties());
+    auto latency_table_dir =
+        key_values.count(NNADAPTER_PARTITION_LATENCY_TABLE_DIR)
+            ? key_values[NNADAPTER_PARTITION_LATENCY_TABLE_DIR]
+            : GetStringFromEnv(NNADAPTER_PARTITION_LATENCY_TABLE_DIR);
+    if (!latency_table_dir.empty()) {
+      auto transfer_cost =
+          key_values.count(NNADAPTER_PARTITION_TRANSFER_COST)
+              ? string_parse<double>(
+                    key_values[NNADAPTER_PARTITION_TRANSFER_COST])
+              : GetDoubleFromEnv(NNADAPTER_PARTITION_TRANSFER_COST, 1.0);
+      auto submodel_cost =
+          key_values.count(NNADAPTER_PARTITION_SUBMODEL_COST)
+              ? string_parse<double>(
+                    key_values[NNADAPTER_PARTITION_SUBMODEL_COST])
+              : GetDoubleFromEnv(NNADAPTER_PARTITION_SUBMODEL_COST, 0.1);
+      std::vector<LatencyLookupTable> latency_tables(device_count);
+      for (size_t i = 0; i < device_count; i++) {
+        auto device_name = context->GetDeviceContext(i)->device->GetName();
+        auto latency_table_path =
+            latency_table_dir + "/" + std::string(device_name) + ".txt";
+        if (!latency_tables[i].Load(latency_table_path)) {
+          NNADAPTER_LOG(WARNING) << "Failed to load the latency lookup table '"
+                                 << latency_table_path << "' for the device '"
+                                 << device_name << "'.";
+        }
+      }
+      AssignOperationsWithCostModel(&model->model_,
+                                    all_supported_operations,
+                                    latency_tables,
+                                    transfer_cost,
+                                    submodel_cost,
+                                    &supported_operations);
+    }
     std::vector<std::pair<
         int,
         std::tuple<core::Model*, bool, std::vector<int>, std::vector<int>>>>
         _models_;
     PartitionModelIntoSubmodels(
         &model->model_, supported_operations, &_models_);
+    NNADAPTER_VLOG(3) << "The model is partitioned into " << _models_.size()
+                      << " submodels.";
     for (auto& _model_ : _models_) {
       auto device_context = context->GetDeviceContext(_model_.first);
       NNADAPTER_CHECK(device_context) << "No device found.";
@@ -26,6 +26,9 @@
 #endif  // _WIN32
 
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include "lite/utils/log/cp_logging.h"
 
 #include "lite/utils/env.h"
@@ -167,6 +170,83 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
 }
 #endif
 
+bool HostSupportsIsa(const cpu_isa_t cpu_isa) {
+#ifdef PADDLE_WITH_XBYAK
+  using namespace Xbyak::util;  // NOLINT
+  switch (cpu_isa) {
+    case isa_any:
+      return true;
+    case sse42:
+      return cpu.has(Cpu::tSSE42);
+    case avx2:
+      return cpu.has(Cpu::tAVX2) && cpu.has(Cpu::tFMA);
+    case avx512f:
+      return cpu.has(Cpu::tAVX512F) && cpu.has(Cpu::tAVX2) &&
+             cpu.has(Cpu::tFMA);
+    default:
+      return false;
+  }
+#elif (defined(__GNUC__) || defined(__clang__)) && !defined(_WIN32)
+  switch (cpu_isa) {
+    case isa_any:
+      return true;
+    case sse42:
+      return __builtin_cpu_supports("sse4.2");
+    case avx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case avx512f:
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    default:
+      return false;
+  }
+#else
+  return cpu_isa == isa_any;
+#endif
+}
+
+namespace {
+
+// Variants ordered from the lowest to the highest ISA.
+const cpu_isa_t kIsaVariants[] = {isa_any, sse42, avx2, avx512f};
+const int kNumIsaVariants = sizeof(kIsaVariants) / sizeof(kIsaVariants[0]);
+
+int IsaRank(cpu_isa_t cpu_isa) {
+  for (int i = 0; i < kNumIsaVariants; ++i) {
+    if (kIsaVariants[i] == cpu_isa) return i;
+  }
+  LOG(FATAL) << "No multi-versioned kernels for cpu_isa_t " << cpu_isa;
+  return 0;
+}
+
+int MaxIsaRankFromEnv() {
+  const char* env = std::getenv("PADDLE_LITE_X86_MAX_ISA");
+  if (env == nullptr) return kNumIsaVariants - 1;
+  const char* names[] = {"any", "sse42", "avx2", "avx512f"};
+  for (int i = 0; i < kNumIsaVariants; ++i) {
+    if (std::strcmp(env, names[i]) == 0) return i;
+  }
+  LOG(WARNING) << "Ignore unknown PADDLE_LITE_X86_MAX_ISA=" << env;
+  return kNumIsaVariants - 1;
+}
+
+int DetectIsaRank() {
+  int rank = MaxIsaRankFromEnv();
+  while (rank > 0 && !HostSupportsIsa(kIsaVariants[rank])) --rank;
+  return rank;
+}
+
+std::atomic<int> max_isa_rank{kNumIsaVariants - 1};
+
+}  // namespace
+
+cpu_isa_t RuntimeIsa() {
+  static const int host_rank = DetectIsaRank();
+  return kIsaVariants[std::min(host_rank, max_isa_rank.load())];
+}
+
+void SetMaxIsa(const cpu_isa_t cpu_isa) { max_isa_rank = IsaRank(cpu_isa); }
+
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
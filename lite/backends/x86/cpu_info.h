@@ -75,6 +75,20 @@ typedef enum {
 // May I use some instruction
 bool MayIUse(const cpu_isa_t cpu_isa);
 
+// Whether the host can run the multi-versioned kernels built for `cpu_isa`.
+// Only isa_any, sse42, avx2 (which also requires FMA) and avx512f have
+// variants. Unlike MayIUse, this does not depend on Xbyak.
+bool HostSupportsIsa(const cpu_isa_t cpu_isa);
+
+// The ISA the multi-versioned kernels run with: the best variant supported
+// by the host, detected once. It can be lowered with SetMaxIsa() or with the
+// environment variable PADDLE_LITE_X86_MAX_ISA=any|sse42|avx2|avx512f.
+cpu_isa_t RuntimeIsa();
+
+// Caps RuntimeIsa() at `cpu_isa`, it never raises it above what the host
+// supports. Mainly used to test the lower variants on a modern host.
+void SetMaxIsa(const cpu_isa_t cpu_isa);
+
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,300 @@
+/* Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "lite/backends/x86/jit/gen/elementwise_chain.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/jit/registry.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+namespace gen {
+
+// ymm11~ymm15 are used by the activations
+constexpr int kChainNumRegs = 11;
+constexpr int kChainTmpReg = 15;
+
+bool ElementwiseChainJitCode::AllocRegs(const elementwise_chain_attr_t& attr,
+                                        std::vector<int>* regs) {
+  const int n_in = attr.num_inputs;
+  const int n_vals = n_in + attr.num_steps;
+  if (attr.num_steps <= 0 || attr.num_steps > kChainMaxSteps ||
+      n_in > kChainMaxInputs) {
+    return false;
+  }
+  std::vector<int> last_use(n_vals, -1);
+  for (int s = 0; s < attr.num_steps; ++s) {
+    const auto& step = attr.steps[s];
+    bool binary = IsChainBinaryOp(step.type);
+    if (step.x < 0 || step.x >= n_in + s ||
+        (binary && (step.y < 0 || step.y >= n_in + s))) {
+      return false;
+    }
+    last_use[step.x] = s;
+    if (binary) {
+      last_use[step.y] = s;
+    }
+  }
+  // the output is stored after the last step
+  last_use[n_vals - 1] = attr.num_steps;
+
+  std::vector<bool> used(kChainNumRegs, false);
+  regs->assign(n_vals, -1);
+  auto alloc = [&](int v) -> bool {
+    for (int r = 0; r < kChainNumRegs; ++r) {
+      if (!used[r]) {
+        used[r] = true;
+        (*regs)[v] = r;
+        return true;
+      }
+    }
+    return false;
+  };
+  auto pinned = [&](int v) -> bool {
+    return v < n_in &&
+           (attr.bcast[v] == kChainCol || attr.bcast[v] == kChainScalar);
+  };
+
+  // broadcast inputs are loaded once per row and stay in their registers
+  for (int k = 0; k < n_in; ++k) {
+    if (pinned(k) && last_use[k] >= 0 && !alloc(k)) {
+      return false;
+    }
+  }
+  for (int s = 0; s < attr.num_steps; ++s) {
+    const auto& step = attr.steps[s];
+    int operands[2] = {step.x, step.y};
+    int num_operands = IsChainBinaryOp(step.type) ? 2 : 1;
+    for (int i = 0; i < num_operands; ++i) {
+      // other inputs are loaded before their first use
+      if ((*regs)[operands[i]] < 0 && !alloc(operands[i])) {
+        return false;
+      }
+    }
+    for (int i = 0; i < num_operands; ++i) {
+      int v = operands[i];
+      if (last_use[v] == s && !pinned(v)) {
+        used[(*regs)[v]] = false;
+      }
+    }
+    if (!alloc(n_in + s)) {
+      return false;
+    }
+    if (last_use[n_in + s] < s) {
+      used[(*regs)[n_in + s]] = false;
+    }
+  }
+  return true;
+}
+
+Xbyak::Reg64 ElementwiseChainJitCode::reg_x(int i) const {
+  static const Xbyak::Operand::Code codes[kChainMaxInputs] = {
+      Xbyak::Operand::R8,
+      Xbyak::Operand::R9,
+      Xbyak::Operand::R10,
+      Xbyak::Operand::R11,
+      Xbyak::Operand::R12,
+      Xbyak::Operand::R13};
+  return Xbyak::Reg64(codes[i]);
+}
+
+void ElementwiseChainJitCode::load(int idx,
+                                   const Xbyak::Reg64& base,
+                                   int block,
+                                   int offset) {
+  if (block == YMM_FLOAT_BLOCK) {
+    vmovups(ymm_t(idx), ptr[base + reg_offset + offset]);
+  } else if (block == 4) {
+    vmovups(xmm_t(idx), ptr[base + reg_offset + offset]);
+  } else if (block == 2) {
+    vmovq(xmm_t(idx), ptr[base + reg_offset + offset]);
+  } else {
+    vmovss(xmm_t(idx), ptr[base + reg_offset + offset]);
+  }
+}
+
+void ElementwiseChainJitCode::store(int idx,
+                                    const Xbyak::Reg64& base,
+                                    int block,
+                                    int offset) {
+  if (block == YMM_FLOAT_BLOCK) {
+    vmovups(ptr[base + reg_offset + offset], ymm_t(idx));
+  } else if (block == 4) {
+    vmovups(ptr[base + reg_offset + offset], xmm_t(idx));
+  } else if (block == 2) {
+    vmovq(ptr[base + reg_offset + offset], xmm_t(idx));
+  } else {
+    vmovss(ptr[base + reg_offset + offset], xmm_t(idx));
+  }
+}
+
+template <typename JMM>
+void ElementwiseChainJitCode::genBlock(int block, int offset) {
+  const int n_in = attr_.num_inputs;
+  std::vector<bool> loaded(n_in, false);
+  auto value = [&](int v) -> int {
+    if (v < n_in && !IsPinned(v) && !loaded[v]) {
+      load(regs_[v], reg_x(v), block, offset);
+      loaded[v] = true;
+    }
+    return regs_[v];
+  };
+  for (int s = 0; s < attr_.num_steps; ++s) {
+    const auto& step = attr_.steps[s];
+    JMM x = JMM(value(step.x));
+    JMM y = IsChainBinaryOp(step.type) ? JMM(value(step.y)) : x;
+    JMM dst = JMM(regs_[n_in + s]);
+    JMM tmp = JMM(kChainTmpReg);
+    const size_t step_offset =
+        offsetof(elementwise_chain_attr_t, steps) + s * sizeof(chain_step_t);
+    switch (step.type) {
+      case kChainAdd:
+        vaddps(dst, x, y);
+        break;
+      case kChainSub:
+        vsubps(dst, x, y);
+        break;
+      case kChainMul:
+        vmulps(dst, x, y);
+        break;
+      case kChainDiv:
+        vdivps(dst, x, y);
+        break;
+      case kChainMax:
+        vmaxps(dst, x, y);
+        break;
+      case kChainMin:
+        vminps(dst, x, y);
+        break;
+      case kChainScale:
+        // alpha and beta are read from the attr of this call
+        vbroadcastss(
+            tmp,
+            ptr[param_attr + step_offset + offsetof(chain_step_t, alpha)]);
+        vmulps(dst, x, tmp);
+        vbroadcastss(
+            tmp, ptr[param_attr + step_offset + offsetof(chain_step_t, beta)]);
+        vaddps(dst, dst, tmp);
+        break;
+      case kChainRelu:
+        relu_jmm<JMM>(dst, x, kChainTmpReg);
+        break;
+      case kChainSigmoid:
+        sigmoid_jmm<JMM>(dst, x, 11, 12, 13, 14, 15);
+        break;
+      case kChainTanh:
+        tanh_jmm<JMM>(dst, x, 11, 12, 13, 14, 15);
+        break;
+      case kChainExp:
+        exp_jmm<JMM>(dst, x, 11, 12, 13, 14, 15);
+        break;
+      case kChainSquare:
+        square_jmm<JMM>(dst, x);
+        break;
+      case kChainSqrt:
+        vsqrtps(dst, x);
+        break;
+      default:
+        LOG(FATAL) << "Do not support this chain op type: " << step.type;
+        break;
+    }
+  }
+  store(regs_[n_in + attr_.num_steps - 1], reg_ptr_out, block, offset);
+}
+
+void ElementwiseChainJitCode::genCode() {
+  preCode();
+  const int n_in = attr_.num_inputs;
+  const int row_size = sizeof(float) * attr_.w;
+  const int num_blocks = attr_.w / YMM_FLOAT_BLOCK;
+  const int block_size = sizeof(float) * YMM_FLOAT_BLOCK;
+
+  mov(reg_height.cvt32(),
+      dword[param_attr + offsetof(elementwise_chain_attr_t, h)]);
+  for (int k = 0; k < n_in; ++k) {
+    mov(reg_x(k), ptr[param_x + k * sizeof(void*)]);
+  }
+  mov(reg_ptr_out, param_out);
+
+  Label l_next_h, l_next_w, l_end;
+  test(reg_height, reg_height);
+  jle(l_end, T_NEAR);
+  L(l_next_h);
+  {
+    for (int k = 0; k < n_in; ++k) {
+      if (IsPinned(k) && regs_[k] >= 0) {
+        vbroadcastss(ymm_t(regs_[k]), ptr[reg_x(k)]);
+      }
+    }
+    xor_(reg_offset, reg_offset);
+    if (num_blocks > 0) {
+      L(l_next_w);
+      genBlock<ymm_t>(YMM_FLOAT_BLOCK, 0);
+      add(reg_offset, block_size);
+      cmp(reg_offset, num_blocks * block_size);
+      jl(l_next_w, T_NEAR);
+    }
+    int rest = attr_.w % YMM_FLOAT_BLOCK;
+    int offset = 0;
+    while (rest > 0) {
+      int block = rest >= 4 ? 4 : (rest >= 2 ? 2 : 1);
+      genBlock<xmm_t>(block, offset);
+      offset += sizeof(float) * block;
+      rest -= block;
+    }
+    for (int k = 0; k < n_in; ++k) {
+      if (attr_.bcast[k] == kChainFull) {
+        add(reg_x(k), row_size);
+      } else if (attr_.bcast[k] == kChainCol) {
+        add(reg_x(k), sizeof(float));
+      }
+    }
+    add(reg_ptr_out, row_size);
+    dec(reg_height);
+    jnz(l_next_h, T_NEAR);
+  }
+  L(l_end);
+  postCode();
+}
+
+class ElementwiseChainCreator
+    : public JitCodeCreator<elementwise_chain_attr_t> {
+ public:
+  bool CanBeUsed(const elementwise_chain_attr_t& attr) const override {
+    std::vector<int> regs;
+    return x86::MayIUse(x86::avx) && attr.w > 0 &&
+           ElementwiseChainJitCode::AllocRegs(attr, &regs);
+  }
+  size_t CodeSize(const elementwise_chain_attr_t& attr) const override {
+    // one ymm block and at most three tails, sigmoid and tanh are the longest
+    return 256 + attr.num_inputs * 64 +
+           4 * (attr.num_steps * 96 + attr.num_inputs + 1) * 8;
+  }
+  std::unique_ptr<GenBase> CreateJitCode(
+      const elementwise_chain_attr_t& attr) const override {
+    return make_unique<ElementwiseChainJitCode>(attr, CodeSize(attr));
+  }
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
+
+namespace gen = paddle::lite::jit::gen;
+
+REGISTER_JITKERNEL_GEN_LITE(kElementwiseChain, gen::ElementwiseChainCreator);
@@ -0,0 +1,76 @@
+/* Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "lite/backends/x86/jit/gen/act.h"
+#include "lite/backends/x86/jit/gen/jitcode.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+namespace gen {
+
+// One loop over the [h, w] output for a whole elementwise chain. Every value
+// of the chain lives in a ymm register, only the inputs are loaded and only
+// the last value is stored.
+class ElementwiseChainJitCode : public VActFunc {
+ public:
+  explicit ElementwiseChainJitCode(const elementwise_chain_attr_t& attr,
+                                   size_t code_size,
+                                   void* code_ptr = nullptr)
+      : VActFunc(code_size, code_ptr), attr_(attr) {
+    CHECK(AllocRegs(attr_, &regs_)) << "The chain needs too many registers";
+    this->genCode();
+  }
+
+  DECLARE_JIT_CODE(ElementwiseChainJitCode);
+  void genCode() override;
+
+  // Give every value of the chain one of ymm0~ymm10, ymm11~ymm15 are left to
+  // the activations. A register is reused once its value is dead.
+  // Return false if the chain needs more than that.
+  static bool AllocRegs(const elementwise_chain_attr_t& attr,
+                        std::vector<int>* regs);
+
+ private:
+  template <typename JMM>
+  void genBlock(int block, int offset);
+  void load(int idx, const Xbyak::Reg64& base, int block, int offset);
+  void store(int idx, const Xbyak::Reg64& base, int block, int offset);
+  Xbyak::Reg64 reg_x(int i) const;
+  bool IsPinned(int v) const {
+    return v < attr_.num_inputs && (attr_.bcast[v] == kChainCol ||
+                                    attr_.bcast[v] == kChainScalar);
+  }
+
+  elementwise_chain_attr_t attr_;
+  std::vector<int> regs_;
+
+  reg64_t param_x{abi_param1};
+  reg64_t param_out{abi_param2};
+  reg64_t param_attr{abi_param3};
+
+  reg64_t reg_offset{rcx};
+  reg64_t reg_height{r14};
+  reg64_t reg_ptr_out{r15};
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
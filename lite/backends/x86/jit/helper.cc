@@ -61,6 +61,7 @@ const char* to_string(KernelType kt) {
     ONE_CASE(kSoftmax);
     ONE_CASE(kEmbSeqPool);
     ONE_CASE(kSgd);
+    ONE_CASE(kElementwiseChain);
     default:
       LOG(FATAL) << "Not support type: %d, or forget to add it.";
       return "NOT JITKernel";
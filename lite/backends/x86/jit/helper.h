@@ -259,6 +259,14 @@ inline std::ostream& operator<<(std::ostream& os, const matmul_attr_t& attr) {
   return os;
 }
 
+inline std::ostream& operator<<(std::ostream& os,
+                                const elementwise_chain_attr_t& attr) {
+  os << "height_size[" << attr.h << "],width_size[" << attr.w
+     << "],num_inputs[" << attr.num_inputs << "],num_steps["
+     << attr.num_steps << "]";
+  return os;
+}
+
 // expose the method to pack matmul weight
 template <typename T>
 void pack_weights(const T* src, T* dst, int n, int k);
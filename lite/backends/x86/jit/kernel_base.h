@@ -54,6 +54,7 @@ typedef enum {
   kVSquare,
   kVSub,
   kVTanh,
+  kElementwiseChain,
 } KernelType;
 
 typedef enum {
@@ -328,6 +329,67 @@ struct NCHW16CMulNCTuple {
   typedef void (*func_type)(const T*, const T*, T*, int, int);
 };
 
+typedef enum {
+  kChainNone = 0,
+  // binary
+  kChainAdd = 1,
+  kChainSub,
+  kChainMul,
+  kChainDiv,
+  kChainMax,
+  kChainMin,
+  // unary
+  kChainScale,  // alpha * x + beta
+  kChainRelu,
+  kChainSigmoid,
+  kChainTanh,
+  kChainExp,
+  kChainSquare,
+  kChainSqrt,
+} ChainOpType;
+
+// How one input of the chain maps onto the [h, w] output
+typedef enum {
+  kChainFull = 0,  // h * w, same as the output
+  kChainRow,       // w, the same for every row
+  kChainCol,       // h, one value for every row
+  kChainScalar,    // 1
+} ChainBcastType;
+
+constexpr int kChainMaxInputs = 6;
+constexpr int kChainMaxSteps = 16;
+
+inline bool IsChainBinaryOp(ChainOpType type) {
+  return type >= kChainAdd && type <= kChainMin;
+}
+
+// Value ids [0, num_inputs) are the inputs, num_inputs + i is the result of
+// steps[i]. The result of the last step is the output.
+typedef struct chain_step_s {
+  ChainOpType type;
+  int x, y;  // y is only used by binary ops
+  float alpha, beta;
+} chain_step_t;
+
+// h is not a part of the jit key, it must stay the last member
+typedef struct elementwise_chain_attr_s {
+  int w{0};
+  int num_inputs{0}, num_steps{0};
+  ChainBcastType bcast[kChainMaxInputs]{};
+  chain_step_t steps[kChainMaxSteps]{};
+  int h{0};
+} elementwise_chain_attr_t;
+
+template <typename T>
+struct ElementwiseChainTuple {
+  static constexpr KernelType kernel_type = kElementwiseChain;
+  typedef T data_type;
+  typedef elementwise_chain_attr_t attr_type;
+  typedef void (*func_type)(const T* const*,
+                            T*,
+                            const elementwise_chain_attr_t*);
+};
+
 // Just for adding to kernel pool without template
 class Kernel {
  public:
@@ -14,6 +14,7 @@
 
 #include "lite/backends/x86/jit/kernel_key.h"
 #include <xxhash.h>  // XXH64: 13.8 GB/s
+#include <cstddef>
 #include "lite/utils/log/cp_logging.h"
 
 namespace paddle {
@@ -66,6 +67,13 @@ int64_t JitCodeKey<sgd_attr_t>(const sgd_attr_t& attr) {
   return attr.grad_width;
 }
 
+template <>
+int64_t JitCodeKey<elementwise_chain_attr_t>(
+    const elementwise_chain_attr_t& attr) {
+  // w and the program, but not h
+  return XXH64(&attr, offsetof(elementwise_chain_attr_t, h), 0);
+}
+
 }  // namespace jit
 }  // namespace lite
 }  // namespace paddle
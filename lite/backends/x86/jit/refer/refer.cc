@@ -57,5 +57,6 @@ REGISTER_REFER_KERNEL(Softmax);
 REGISTER_REFER_KERNEL(EmbSeqPool);
 REGISTER_REFER_KERNEL(Sgd);
 REGISTER_REFER_KERNEL(VBroadcast);
+REGISTER_REFER_KERNEL(ElementwiseChain);
 
 #undef REGISTER_REFER_KERNEL
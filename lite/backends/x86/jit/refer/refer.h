@@ -540,6 +540,86 @@ void Sgd(const T* lr,
   }
 }
 
+template <typename T>
+inline T ChainStep(const chain_step_t& step, const T* vals) {
+  const T x = vals[step.x];
+  switch (step.type) {
+    case kChainAdd:
+      return x + vals[step.y];
+    case kChainSub:
+      return x - vals[step.y];
+    case kChainMul:
+      return x * vals[step.y];
+    case kChainDiv:
+      return x / vals[step.y];
+    case kChainMax:
+      return x > vals[step.y] ? x : vals[step.y];
+    case kChainMin:
+      return x < vals[step.y] ? x : vals[step.y];
+    case kChainScale:
+      return static_cast<T>(step.alpha) * x + static_cast<T>(step.beta);
+    case kChainRelu:
+      return x > 0 ? x : 0;
+    case kChainSigmoid: {
+      T y;
+      VSigmoid(&x, &y, 1);
+      return y;
+    }
+    case kChainTanh: {
+      T y;
+      VTanh(&x, &y, 1);
+      return y;
+    }
+    case kChainExp:
+      return std::exp(x);
+    case kChainSquare:
+      return x * x;
+    case kChainSqrt:
+      return std::sqrt(x);
+    default:
+      LOG(FATAL) << "Not support chain op type: " << step.type;
+  }
+  return 0;
+}
+
+// Evaluate the whole chain element by element, the intermediate values never
+// go back to memory.
+template <typename T>
+void ElementwiseChain(const T* const* x,
+                      T* out,
+                      const elementwise_chain_attr_t* attr) {
+  CHECK_GT(attr->num_steps, 0);
+  CHECK_LE(attr->num_inputs, kChainMaxInputs);
+  CHECK_LE(attr->num_steps, kChainMaxSteps);
+  T vals[kChainMaxInputs + kChainMaxSteps];
+  const int n_in = attr->num_inputs;
+  const int last = n_in + attr->num_steps - 1;
+  for (int i = 0; i < attr->h; ++i) {
+    for (int j = 0; j < attr->w; ++j) {
+      for (int k = 0; k < n_in; ++k) {
+        switch (attr->bcast[k]) {
+          case kChainFull:
+            vals[k] = x[k][i * attr->w + j];
+            break;
+          case kChainRow:
+            vals[k] = x[k][j];
+            break;
+          case kChainCol:
+            vals[k] = x[k][i];
+            break;
+          default:
+            vals[k] = x[k][0];
+            break;
+        }
+      }
+      for (int s = 0; s < attr->num_steps; ++s) {
+        vals[n_in + s] = ChainStep<T>(attr->steps[s], vals);
+      }
+      out[i * attr->w + j] = vals[last];
+    }
+  }
+}
+
 #define DECLARE_REFER_KERNEL(name)                                     \
   template <typename T>                                                \
   class name##Kernel : public lite::jit::ReferKernel<name##Tuple<T>> { \
@@ -593,6 +673,7 @@ DECLARE_REFER_KERNEL(Softmax);
 DECLARE_REFER_KERNEL(EmbSeqPool);
 DECLARE_REFER_KERNEL(Sgd);
 DECLARE_REFER_KERNEL(VBroadcast);
+DECLARE_REFER_KERNEL(ElementwiseChain);
 
 #undef DECLARE_REFER_KERNEL
 
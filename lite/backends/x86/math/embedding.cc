@@ -0,0 +1,247 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/embedding.h"
+#include <xmmintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "lite/utils/float16.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// Ids looked ahead when prefetching rows, and the bytes of a row prefetched.
+const int64_t kPrefetchDistance = 8;
+const int64_t kMaxPrefetchBytes = 1024;
+// Below this many output values a single thread is faster.
+const int64_t kParallelThreshold = 1 << 14;
+// ARM's lookup_table_dequant divides max - min by 2^8.
+const float kUInt8Levels = 256.f;
+
+int64_t CodesPerFloat(EmbeddingQuantType type) {
+  switch (type) {
+    case EmbeddingQuantType::kUInt8:
+      return 4;
+    case EmbeddingQuantType::kFP16:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+bool IsPadding(int64_t id, int64_t padding_idx) {
+  return padding_idx != -1 && id == padding_idx;
+}
+
+const float* TableRow(const float* table,
+                      int64_t rows,
+                      int64_t table_width,
+                      int64_t id) {
+  CHECK_LT(id, rows) << "lookup table ids[i] < row_number check failed";
+  CHECK_GE(id, 0) << "lookup table ids[i] >= 0 check failed";
+  return table + id * table_width;
+}
+
+void PrefetchRow(const float* table,
+                 int64_t rows,
+                 int64_t table_width,
+                 int64_t id) {
+  if (id < 0 || id >= rows) return;
+  const char* row = reinterpret_cast<const char*>(table + id * table_width);
+  int64_t bytes = std::min<int64_t>(table_width * sizeof(float),
+                                    kMaxPrefetchBytes);
+  for (int64_t offset = 0; offset < bytes; offset += 64) {
+    _mm_prefetch(row + offset, _MM_HINT_T0);
+  }
+}
+
+// Writes (or adds, with kAccumulate) one dequantized row to `out`.
+template <bool kAccumulate>
+void DequantRow(const float* row,
+                EmbeddingQuantType type,
+                int64_t row_width,
+                float* out) {
+  switch (type) {
+    case EmbeddingQuantType::kNone: {
+      if (!kAccumulate) {
+        std::memcpy(out, row, row_width * sizeof(float));
+      } else {
+        for (int64_t k = 0; k < row_width; ++k) out[k] += row[k];
+      }
+      break;
+    }
+    case EmbeddingQuantType::kUInt8: {
+      const float min = row[0];
+      const float scale = (row[1] - row[0]) / kUInt8Levels;
+      const uint8_t* codes = reinterpret_cast<const uint8_t*>(row + 2);
+      for (int64_t k = 0; k < row_width; ++k) {
+        float v = scale * static_cast<int>(codes[k]) + min;
+        out[k] = kAccumulate ? out[k] + v : v;
+      }
+      break;
+    }
+    case EmbeddingQuantType::kFP16: {
+      const float scale = row[0];
+      const float bias = row[1];
+      const float16* values = reinterpret_cast<const float16*>(row + 2);
+      for (int64_t k = 0; k < row_width; ++k) {
+        float v = static_cast<float>(values[k]) * scale + bias;
+        out[k] = kAccumulate ? out[k] + v : v;
+      }
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+EmbeddingQuantType ParseEmbeddingQuantType(const std::string& quant_type) {
+  if (quant_type == "none") return EmbeddingQuantType::kNone;
+  if (quant_type == "uint8") return EmbeddingQuantType::kUInt8;
+  if (quant_type == "fp16") return EmbeddingQuantType::kFP16;
+  LOG(FATAL) << "Unsupported embedding quant_type: " << quant_type;
+  return EmbeddingQuantType::kNone;
+}
+
+int64_t EmbeddingRowWidth(EmbeddingQuantType type, int64_t table_width) {
+  if (type == EmbeddingQuantType::kNone) return table_width;
+  CHECK_GT(table_width, 2);
+  return (table_width - 2) * CodesPerFloat(type);
+}
+
+int64_t EmbeddingTableWidth(EmbeddingQuantType type, int64_t row_width) {
+  if (type == EmbeddingQuantType::kNone) return row_width;
+  CHECK_EQ(row_width % CodesPerFloat(type), 0);
+  return row_width / CodesPerFloat(type) + 2;
+}
+
+void QuantizeEmbeddingTable(const float* table,
+                            int64_t rows,
+                            int64_t row_width,
+                            EmbeddingQuantType type,
+                            float* out) {
+  const int64_t table_width = EmbeddingTableWidth(type, row_width);
+  for (int64_t i = 0; i < rows; ++i) {
+    const float* src = table + i * row_width;
+    float* dst = out + i * table_width;
+    if (type == EmbeddingQuantType::kNone) {
+      std::memcpy(dst, src, row_width * sizeof(float));
+      continue;
+    }
+    float min = *std::min_element(src, src + row_width);
+    float max = *std::max_element(src, src + row_width);
+    if (type == EmbeddingQuantType::kUInt8) {
+      dst[0] = min;
+      dst[1] = max;
+      float scale = (max - min) / kUInt8Levels;
+      uint8_t* codes = reinterpret_cast<uint8_t*>(dst + 2);
+      for (int64_t k = 0; k < row_width; ++k) {
+        float code = scale > 0.f ? std::round((src[k] - min) / scale) : 0.f;
+        codes[k] = static_cast<uint8_t>(std::min(code, kUInt8Levels - 1));
+      }
+    } else {
+      // Center and scale the row into [-1, 1] to keep fp16 precision.
+      float bias = (max + min) / 2.f;
+      float scale = (max - min) / 2.f;
+      dst[0] = scale > 0.f ? scale : 1.f;
+      dst[1] = bias;
+      float16* values = reinterpret_cast<float16*>(dst + 2);
+      for (int64_t k = 0; k < row_width; ++k) {
+        values[k] = float16((src[k] - bias) / dst[0]);
+      }
+    }
+  }
+}
+
+void EmbeddingLookup(const float* table,
+                     int64_t rows,
+                     int64_t table_width,
+                     EmbeddingQuantType type,
+                     const int64_t* ids,
+                     int64_t ids_numel,
+                     int64_t padding_idx,
+                     float* out) {
+  const int64_t row_width = EmbeddingRowWidth(type, table_width);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (ids_numel * row_width >= kParallelThreshold)
+#endif
+  for (int64_t i = 0; i < ids_numel; ++i) {
+    if (i + kPrefetchDistance < ids_numel) {
+      PrefetchRow(table, rows, table_width, ids[i + kPrefetchDistance]);
+    }
+    float* dst = out + i * row_width;
+    if (IsPadding(ids[i], padding_idx)) {
+      std::memset(dst, 0, row_width * sizeof(float));
+    } else {
+      DequantRow<false>(
+          TableRow(table, rows, table_width, ids[i]), type, row_width, dst);
+    }
+  }
+}
+
+void EmbeddingSeqPool(const float* table,
+                      int64_t rows,
+                      int64_t table_width,
+                      EmbeddingQuantType type,
+                      const int64_t* ids,
+                      const uint64_t* lod,
+                      int64_t num_seqs,
+                      int64_t padding_idx,
+                      const std::string& pool_type,
+                      float pad_value,
+                      float* out) {
+  const int64_t row_width = EmbeddingRowWidth(type, table_width);
+  const bool average = pool_type == "AVERAGE";
+  const bool use_sqrt = pool_type == "SQRT";
+  CHECK(average || use_sqrt || pool_type == "SUM")
+      << "Unsupported pool_type: " << pool_type;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if ( \
+    static_cast<int64_t>(lod[num_seqs]) * row_width >= kParallelThreshold)
+#endif
+  for (int64_t s = 0; s < num_seqs; ++s) {
+    float* dst = out + s * row_width;
+    const int64_t begin = lod[s];
+    const int64_t end = lod[s + 1];
+    if (begin == end) {
+      std::fill(dst, dst + row_width, pad_value);
+      continue;
+    }
+    std::memset(dst, 0, row_width * sizeof(float));
+    for (int64_t i = begin; i < end; ++i) {
+      if (i + kPrefetchDistance < end) {
+        PrefetchRow(table, rows, table_width, ids[i + kPrefetchDistance]);
+      }
+      if (IsPadding(ids[i], padding_idx)) continue;
+      DequantRow<true>(
+          TableRow(table, rows, table_width, ids[i]), type, row_width, dst);
+    }
+    if (average || use_sqrt) {
+      float len = static_cast<float>(end - begin);
+      float scale = 1.f / (average ? len : std::sqrt(len));
+      for (int64_t k = 0; k < row_width; ++k) dst[k] *= scale;
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,82 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Storage of an embedding table W of shape [rows, table_width] in floats.
+//   kNone:  every row holds table_width fp32 values.
+//   kUInt8: every row is [min, max, uint8 codes], value = min + code *
+//           (max - min) / 256, the layout of lookup_table_dequant on ARM.
+//   kFP16:  every row is [scale, bias, fp16 values], value = fp16 * scale +
+//           bias.
+// The codes are packed into the trailing floats of the row, 4 per float for
+// kUInt8 and 2 for kFP16.
+enum class EmbeddingQuantType { kNone = 0, kUInt8, kFP16 };
+
+// "none", "uint8" or "fp16".
+EmbeddingQuantType ParseEmbeddingQuantType(const std::string& quant_type);
+
+// The number of fp32 values a row of `table_width` floats holds.
+int64_t EmbeddingRowWidth(EmbeddingQuantType type, int64_t table_width);
+
+// The table_width a row of `row_width` values needs, row_width must be a
+// multiple of 4 for kUInt8 and of 2 for kFP16.
+int64_t EmbeddingTableWidth(EmbeddingQuantType type, int64_t row_width);
+
+// Quantizes a fp32 [rows, row_width] table into `out`, which holds rows *
+// EmbeddingTableWidth(type, row_width) floats.
+void QuantizeEmbeddingTable(const float* table,
+                            int64_t rows,
+                            int64_t row_width,
+                            EmbeddingQuantType type,
+                            float* out);
+
+// out[i] = dequantized table[ids[i]], zeros where ids[i] == padding_idx.
+// Rows are gathered in parallel and prefetched a few ids ahead.
+void EmbeddingLookup(const float* table,
+                     int64_t rows,
+                     int64_t table_width,
+                     EmbeddingQuantType type,
+                     const int64_t* ids,
+                     int64_t ids_numel,
+                     int64_t padding_idx,
+                     float* out);
+
+// Pools the dequantized rows of each sequence ids[lod[s], lod[s + 1]) into
+// out[s] without materializing them, the same as EmbeddingLookup followed by
+// sequence_pool. pool_type is "SUM", "AVERAGE" or "SQRT"; empty sequences
+// are filled with pad_value.
+void EmbeddingSeqPool(const float* table,
+                      int64_t rows,
+                      int64_t table_width,
+                      EmbeddingQuantType type,
+                      const int64_t* ids,
+                      const uint64_t* lod,
+                      int64_t num_seqs,
+                      int64_t padding_idx,
+                      const std::string& pool_type,
+                      float pad_value,
+                      float* out);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
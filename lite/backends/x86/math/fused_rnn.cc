@@ -0,0 +1,177 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/fused_rnn.h"
+#include "lite/backends/x86/math/activation_functions.h"
+#include "lite/backends/x86/math/blas.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace forward = paddle::lite::x86::math::detail::forward;
+
+RnnRecurrentGemm::~RnnRecurrentGemm() {
+#ifdef PADDLE_WITH_MKLML
+  if (packed_weight_) {
+    CBlas<float>::GEMM_FREE(packed_weight_);
+  }
+#endif
+}
+
+void RnnRecurrentGemm::Init(const float* weight, int n, int k) {
+  if (weight == weight_ && n == n_ && k == k_) {
+    return;
+  }
+#ifdef PADDLE_WITH_MKLML
+  if (packed_weight_) {
+    CBlas<float>::GEMM_FREE(packed_weight_);
+    packed_weight_ = nullptr;
+  }
+#endif
+  packed_m_ = 0;
+  weight_ = weight;
+  n_ = n;
+  k_ = k;
+}
+
+void RnnRecurrentGemm::Compute(const X86Context& ctx,
+                               int m,
+                               const float* a,
+                               int lda,
+                               float* c,
+                               int ldc,
+                               bool accumulate) {
+  CHECK(weight_) << "The recurrent weight is not set.";
+  Blas<lite::TargetType::kX86> blas(ctx);
+  const float beta = accumulate ? 1.f : 0.f;
+#ifdef PADDLE_WITH_MKLML
+  // Repack only when the batch size changes
+  if (packed_m_ != m) {
+    if (packed_weight_) {
+      blas.GEMM_FREE<float>(packed_weight_);
+    }
+    packed_weight_ = blas.GEMM_ALLOC<float>(CblasBMatrix, m, n_, k_);
+    blas.GEMM_PACK<float>(
+        CblasBMatrix, CblasTrans, m, n_, k_, 1.f, weight_, k_, packed_weight_);
+    packed_m_ = m;
+  }
+  blas.GEMM_COMPUTE<float>(CblasNoTrans,
+                           CblasPacked,
+                           m,
+                           n_,
+                           k_,
+                           a,
+                           lda,
+                           packed_weight_,
+                           k_,
+                           beta,
+                           c,
+                           ldc);
+#else
+  blas.GEMM<float>(
+      false, true, m, n_, k_, 1.f, a, lda, weight_, k_, beta, c, ldc);
+#endif
+}
+
+void FusedLstmCell(const float* gates,
+                   const float* prev_c,
+                   float* c,
+                   float* h,
+                   int ldh,
+                   int batch,
+                   int hidden) {
+  for (int b = 0; b < batch; b++) {
+    const float* gate_i = gates + b * 4 * hidden;
+    const float* gate_f = gate_i + hidden;
+    const float* gate_g = gate_f + hidden;
+    const float* gate_o = gate_g + hidden;
+    const float* prev_c_row = prev_c + b * hidden;
+    float* c_row = c + b * hidden;
+    float* h_row = h + b * ldh;
+    int i = 0;
+#ifdef __AVX__
+    for (; i + 7 < hidden; i += 8) {
+      __m256 vi = forward::avx::Sigmoid(_mm256_loadu_ps(gate_i + i));
+      __m256 vf = forward::avx::Sigmoid(_mm256_loadu_ps(gate_f + i));
+      __m256 vg = forward::avx::Tanh(_mm256_loadu_ps(gate_g + i));
+      __m256 vo = forward::avx::Sigmoid(_mm256_loadu_ps(gate_o + i));
+      __m256 vc = _mm256_add_ps(
+          _mm256_mul_ps(vf, _mm256_loadu_ps(prev_c_row + i)),
+          _mm256_mul_ps(vi, vg));
+      _mm256_storeu_ps(c_row + i, vc);
+      _mm256_storeu_ps(h_row + i, _mm256_mul_ps(vo, forward::avx::Tanh(vc)));
+    }
+#endif
+    for (; i < hidden; i++) {
+      float vc = forward::Sigmoid<float>(gate_f[i]) * prev_c_row[i] +
+                 forward::Sigmoid<float>(gate_i[i]) *
+                     forward::Tanh<float>(gate_g[i]);
+      c_row[i] = vc;
+      h_row[i] = forward::Sigmoid<float>(gate_o[i]) * forward::Tanh<float>(vc);
+    }
+  }
+}
+
+void FusedGruCell(const float* x_gates,
+                  const float* h_gates,
+                  const float* reset_bias,
+                  const float* prev_h,
+                  int ld_prev_h,
+                  float* h,
+                  int ldh,
+                  int batch,
+                  int hidden) {
+  for (int b = 0; b < batch; b++) {
+    const float* x_r = x_gates + b * 3 * hidden;
+    const float* x_z = x_r + hidden;
+    const float* x_c = x_z + hidden;
+    const float* h_r = h_gates + b * 3 * hidden;
+    const float* h_z = h_r + hidden;
+    const float* h_c = h_z + hidden;
+    const float* prev_h_row = prev_h + b * ld_prev_h;
+    float* h_row = h + b * ldh;
+    int i = 0;
+#ifdef __AVX__
+    for (; i + 7 < hidden; i += 8) {
+      __m256 vr = forward::avx::Sigmoid(
+          _mm256_add_ps(_mm256_loadu_ps(x_r + i), _mm256_loadu_ps(h_r + i)));
+      __m256 vz = forward::avx::Sigmoid(
+          _mm256_add_ps(_mm256_loadu_ps(x_z + i), _mm256_loadu_ps(h_z + i)));
+      __m256 vh = _mm256_add_ps(_mm256_loadu_ps(h_c + i),
+                                _mm256_loadu_ps(reset_bias + i));
+      __m256 vc = forward::avx::Tanh(
+          _mm256_add_ps(_mm256_loadu_ps(x_c + i), _mm256_mul_ps(vr, vh)));
+      __m256 vp = _mm256_loadu_ps(prev_h_row + i);
+      vp = _mm256_mul_ps(vz, _mm256_sub_ps(vp, vc));
+      _mm256_storeu_ps(h_row + i, _mm256_add_ps(vc, vp));
+    }
+#endif
+    for (; i < hidden; i++) {
+      float vr = forward::Sigmoid<float>(x_r[i] + h_r[i]);
+      float vz = forward::Sigmoid<float>(x_z[i] + h_z[i]);
+      float vc = forward::Tanh<float>(x_c[i] + vr * (h_c[i] + reset_bias[i]));
+      h_row[i] = vc + vz * (prev_h_row[i] - vc);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
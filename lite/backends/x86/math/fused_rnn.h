@@ -0,0 +1,89 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/core/context.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The GEMM of the hidden states and the recurrent weight at every time step
+// of a LSTM/GRU. With MKL the weight is packed once and the packed panel is
+// reused by all the steps, otherwise it falls back to the plain GEMM.
+class RnnRecurrentGemm {
+ public:
+  RnnRecurrentGemm() = default;
+  ~RnnRecurrentGemm();
+
+  // `weight` is [n, k] and should outlive this, it is repacked if changed.
+  void Init(const float* weight, int n, int k);
+
+  // c[m, n] = a[m, k] * weight^T, or c += a * weight^T if `accumulate`.
+  void Compute(const X86Context& ctx,
+               int m,
+               const float* a,
+               int lda,
+               float* c,
+               int ldc,
+               bool accumulate);
+
+ private:
+  RnnRecurrentGemm(const RnnRecurrentGemm&) = delete;
+  RnnRecurrentGemm& operator=(const RnnRecurrentGemm&) = delete;
+
+  const float* weight_{nullptr};
+  int n_{0};
+  int k_{0};
+  // The packed weight for the batch size `packed_m_`.
+  float* packed_weight_{nullptr};
+  int packed_m_{0};
+};
+
+// The LSTM cell of a time step fused with its activations, the gates
+// [batch, 4 * hidden] in the order of i, f, g, o hold the sums of the input
+// and the recurrent projections:
+//   c = sigmoid(f) * prev_c + sigmoid(i) * tanh(g)
+//   h = sigmoid(o) * tanh(c)
+// `c` may be `prev_c`, the rows of `h` are `ldh` apart.
+void FusedLstmCell(const float* gates,
+                   const float* prev_c,
+                   float* c,
+                   float* h,
+                   int ldh,
+                   int batch,
+                   int hidden);
+
+// The GRU cell of a time step fused with its activations, `x_gates` and
+// `h_gates` [batch, 3 * hidden] in the order of r, z, c are the input and the
+// recurrent projections, `reset_bias` is the recurrent bias of c:
+//   r = sigmoid(x_r + h_r), z = sigmoid(x_z + h_z)
+//   c = tanh(x_c + r * (h_c + reset_bias))
+//   h = (1 - z) * c + z * prev_h
+void FusedGruCell(const float* x_gates,
+                  const float* h_gates,
+                  const float* reset_bias,
+                  const float* prev_h,
+                  int ld_prev_h,
+                  float* h,
+                  int ldh,
+                  int batch,
+                  int hidden);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,88 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include <algorithm>
+#include "lite/backends/x86/math/isa/gemm_bf16_isa.h"
+#include "lite/backends/x86/parallel.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+// Columns of c given to a thread at a time, a multiple of the 32 columns
+// the AVX-512 kernel computes at once.
+const int kColumnBlock = 64;
+// Below this many multiply-adds a single thread is faster.
+const int64_t kParallelThreshold = 1 << 16;
+}  // namespace
+
+uint16_t FloatToBF16(float v) {
+  uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  if ((bits & 0x7fffffffu) > 0x7f800000u) {
+    return static_cast<uint16_t>((bits >> 16) | 0x0040u);
+  }
+  bits += 0x7fffu + ((bits >> 16) & 1u);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+void FloatToBF16(const float* x, uint16_t* y, int64_t num) {
+  for (int64_t i = 0; i < num; ++i) {
+    y[i] = FloatToBF16(x[i]);
+  }
+}
+
+void TensorToBF16(Tensor* tensor) {
+  CHECK(tensor);
+  if (tensor->precision() != PRECISION(kFloat)) return;
+  Tensor tmp;
+  tmp.CopyDataFrom(*tensor);
+  tensor->clear();
+  uint16_t* out = tensor->mutable_data<uint16_t>();
+  tensor->set_precision(PRECISION(kBF16));
+  FloatToBF16(tmp.data<float>(), out, tmp.numel());
+}
+
+void GemmBF16(int m,
+              int n,
+              int k,
+              const float* a,
+              int lda,
+              const uint16_t* b,
+              int ldb,
+              const float* bias,
+              bool relu,
+              float* c,
+              int ldc) {
+  if (m <= 0 || n <= 0) return;
+  const isa::GemmBF16Fn gemm = isa::GemmBF16().gemm;
+  const int64_t blocks = (n + kColumnBlock - 1) / kColumnBlock;
+  auto run = [&](int64_t begin, int64_t end) {
+    int n_begin = static_cast<int>(begin * kColumnBlock);
+    int n_end = static_cast<int>((std::min)(end * kColumnBlock, int64_t(n)));
+    gemm(m, k, a, lda, b, ldb, bias, relu, c, ldc, n_begin, n_end);
+  };
+  if (static_cast<int64_t>(m) * n * k < kParallelThreshold) {
+    run(0, blocks);
+  } else {
+    RunParallelFor(0, blocks, run);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
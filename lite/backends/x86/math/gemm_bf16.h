@@ -0,0 +1,64 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// bfloat16 is the upper half of a fp32: same exponent range, 8 bits of
+// mantissa. Weights stored in it take half the memory of fp32 ones and are
+// widened back to fp32 inside the kernels.
+
+// Rounds to the nearest bf16, ties to even. NaNs stay (quiet) NaNs.
+uint16_t FloatToBF16(float v);
+
+inline float BF16ToFloat(uint16_t v) {
+  uint32_t bits = static_cast<uint32_t>(v) << 16;
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+void FloatToBF16(const float* x, uint16_t* y, int64_t num);
+
+// Replaces the fp32 data of `tensor` by bf16 data of the same shape and
+// sets its precision to kBF16. Does nothing if it is not kFloat.
+void TensorToBF16(Tensor* tensor);
+
+// c = relu?(a * b + bias) with a: m x k fp32, b: k x n bf16 and c: m x n
+// fp32, all row-major with the given leading dimensions; bias holds n values
+// or is nullptr. The columns of c are split among the threads, and the
+// widest kernel variant allowed by RuntimeIsa() computes them.
+void GemmBF16(int m,
+              int n,
+              int k,
+              const float* a,
+              int lda,
+              const uint16_t* b,
+              int ldb,
+              const float* bias,
+              bool relu,
+              float* c,
+              int ldc);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,72 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/isa/elementwise_isa.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+namespace isa {
+
+// Defined by elementwise_isa_<isa>.cc.
+namespace any {
+const ElementwiseKernels* Kernels();
+}  // namespace any
+namespace sse42 {
+const ElementwiseKernels* Kernels();
+}  // namespace sse42
+namespace avx2 {
+const ElementwiseKernels* Kernels();
+}  // namespace avx2
+namespace avx512f {
+const ElementwiseKernels* Kernels();
+}  // namespace avx512f
+
+const ElementwiseKernels* ElementwiseKernelsFor(cpu_isa_t cpu_isa) {
+  switch (cpu_isa) {
+    case x86::isa_any:
+      return any::Kernels();
+    case x86::sse42:
+      return sse42::Kernels();
+    case x86::avx2:
+      return avx2::Kernels();
+    case x86::avx512f:
+      return avx512f::Kernels();
+    default:
+      return nullptr;
+  }
+}
+
+const ElementwiseKernels& Elementwise() {
+  const cpu_isa_t order[] = {x86::avx512f, x86::avx2, x86::sse42};
+  const cpu_isa_t runtime_isa = RuntimeIsa();
+  bool reached = false;
+  for (auto cpu_isa : order) {
+    reached = reached || cpu_isa == runtime_isa;
+    if (!reached) continue;
+    const ElementwiseKernels* kernels = ElementwiseKernelsFor(cpu_isa);
+    if (kernels != nullptr) return *kernels;
+  }
+  const ElementwiseKernels* kernels = any::Kernels();
+  CHECK(kernels != nullptr);
+  return *kernels;
+}
+
+}  // namespace isa
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
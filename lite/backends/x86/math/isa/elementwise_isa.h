@@ -0,0 +1,60 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include "lite/backends/x86/cpu_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+namespace isa {
+
+// The fp32 elementwise kernels below are compiled once per ISA variant
+// (see elementwise_isa_<isa>.cc) and picked at runtime, so one library runs
+// everywhere and still uses AVX-512 where the host has it.
+
+enum class BinaryOp { kAdd = 0, kSub, kMul, kDiv, kMax, kMin };
+
+// z = op(x, y), followed by relu if `relu` is set.
+typedef void (*ElementwiseFn)(const float* x,
+                              const float* y,
+                              float* z,
+                              int num,
+                              BinaryOp op,
+                              bool relu);
+
+struct ElementwiseKernels {
+  cpu_isa_t isa;
+  // x, y and z all hold `num` values.
+  ElementwiseFn range_to_range;
+  // y is a single value broadcast to the `num` values of x.
+  ElementwiseFn range_to_one;
+  // x is a single value broadcast to the `num` values of y.
+  ElementwiseFn one_to_range;
+};
+
+// The kernels built for `cpu_isa` (isa_any, sse42, avx2 or avx512f), or
+// nullptr if this library was built without that variant. The caller must
+// check HostSupportsIsa(cpu_isa) before running them.
+const ElementwiseKernels* ElementwiseKernelsFor(cpu_isa_t cpu_isa);
+
+// The kernels of the best variant not above RuntimeIsa().
+const ElementwiseKernels& Elementwise();
+
+}  // namespace isa
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,193 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Body of one ISA variant of the kernels in elementwise_isa.h. It has no
+// include guard on purpose: every elementwise_isa_<isa>.cc includes it once
+// after defining
+//   LITE_X86_ISA_NAMESPACE  the namespace of the variant, e.g. avx2;
+//   LITE_X86_ISA            the cpu_isa_t it reports;
+//   LITE_X86_ISA_WIDTH      16 (AVX-512), 8 (AVX2), 4 (SSE) or 1 (scalar),
+//                           left undefined when the compiler flags of that
+//                           file do not enable the ISA.
+// Each variant is built with its own -m flags, so nothing here may have
+// external linkage except Kernels(): an inline function shared by two
+// variants would be merged by the linker and could run AVX-512 code on a
+// host without it. Hence only intrinsics and our own header are included.
+
+#include "lite/backends/x86/math/isa/elementwise_isa.h"
+
+#if defined(LITE_X86_ISA_WIDTH) && LITE_X86_ISA_WIDTH > 1
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+namespace isa {
+namespace LITE_X86_ISA_NAMESPACE {
+
+#ifdef LITE_X86_ISA_WIDTH
+
+namespace {
+
+const int kLanes = LITE_X86_ISA_WIDTH;
+
+#if LITE_X86_ISA_WIDTH == 16
+typedef __m512 vec_t;
+inline vec_t vload(const float* p) { return _mm512_loadu_ps(p); }
+inline void vstore(float* p, vec_t v) { _mm512_storeu_ps(p, v); }
+inline vec_t vset1(float v) { return _mm512_set1_ps(v); }
+inline vec_t vzero() { return _mm512_setzero_ps(); }
+inline vec_t vadd(vec_t a, vec_t b) { return _mm512_add_ps(a, b); }
+inline vec_t vsub(vec_t a, vec_t b) { return _mm512_sub_ps(a, b); }
+inline vec_t vmul(vec_t a, vec_t b) { return _mm512_mul_ps(a, b); }
+inline vec_t vdiv(vec_t a, vec_t b) { return _mm512_div_ps(a, b); }
+inline vec_t vmax(vec_t a, vec_t b) { return _mm512_max_ps(a, b); }
+inline vec_t vmin(vec_t a, vec_t b) { return _mm512_min_ps(a, b); }
+#elif LITE_X86_ISA_WIDTH == 8
+typedef __m256 vec_t;
+inline vec_t vload(const float* p) { return _mm256_loadu_ps(p); }
+inline void vstore(float* p, vec_t v) { _mm256_storeu_ps(p, v); }
+inline vec_t vset1(float v) { return _mm256_set1_ps(v); }
+inline vec_t vzero() { return _mm256_setzero_ps(); }
+inline vec_t vadd(vec_t a, vec_t b) { return _mm256_add_ps(a, b); }
+inline vec_t vsub(vec_t a, vec_t b) { return _mm256_sub_ps(a, b); }
+inline vec_t vmul(vec_t a, vec_t b) { return _mm256_mul_ps(a, b); }
+inline vec_t vdiv(vec_t a, vec_t b) { return _mm256_div_ps(a, b); }
+inline vec_t vmax(vec_t a, vec_t b) { return _mm256_max_ps(a, b); }
+inline vec_t vmin(vec_t a, vec_t b) { return _mm256_min_ps(a, b); }
+#elif LITE_X86_ISA_WIDTH == 4
+typedef __m128 vec_t;
+inline vec_t vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, vec_t v) { _mm_storeu_ps(p, v); }
+inline vec_t vset1(float v) { return _mm_set1_ps(v); }
+inline vec_t vzero() { return _mm_setzero_ps(); }
+inline vec_t vadd(vec_t a, vec_t b) { return _mm_add_ps(a, b); }
+inline vec_t vsub(vec_t a, vec_t b) { return _mm_sub_ps(a, b); }
+inline vec_t vmul(vec_t a, vec_t b) { return _mm_mul_ps(a, b); }
+inline vec_t vdiv(vec_t a, vec_t b) { return _mm_div_ps(a, b); }
+inline vec_t vmax(vec_t a, vec_t b) { return _mm_max_ps(a, b); }
+inline vec_t vmin(vec_t a, vec_t b) { return _mm_min_ps(a, b); }
+#else
+typedef float vec_t;
+inline vec_t vload(const float* p) { return *p; }
+inline void vstore(float* p, vec_t v) { *p = v; }
+inline vec_t vset1(float v) { return v; }
+inline vec_t vzero() { return 0.f; }
+inline vec_t vadd(vec_t a, vec_t b) { return a + b; }
+inline vec_t vsub(vec_t a, vec_t b) { return a - b; }
+inline vec_t vmul(vec_t a, vec_t b) { return a * b; }
+inline vec_t vdiv(vec_t a, vec_t b) { return a / b; }
+inline vec_t vmax(vec_t a, vec_t b) { return a > b ? a : b; }
+inline vec_t vmin(vec_t a, vec_t b) { return a < b ? a : b; }
+#endif
+
+// The scalar tail mirrors the vector semantics, e.g. max/min return the
+// second operand when either one is NaN.
+inline float sadd(float a, float b) { return a + b; }
+inline float ssub(float a, float b) { return a - b; }
+inline float smul(float a, float b) { return a * b; }
+inline float sdiv(float a, float b) { return a / b; }
+inline float smax(float a, float b) { return a > b ? a : b; }
+inline float smin(float a, float b) { return a < b ? a : b; }
+
+template <BinaryOp op>
+struct Op;
+
+#define LITE_X86_ISA_OP(op, name)                                       \
+  template <>                                                           \
+  struct Op<BinaryOp::op> {                                             \
+    static vec_t Apply(vec_t a, vec_t b) { return v##name(a, b); }      \
+    static float ApplyScalar(float a, float b) { return s##name(a, b); } \
+  };
+LITE_X86_ISA_OP(kAdd, add)
+LITE_X86_ISA_OP(kSub, sub)
+LITE_X86_ISA_OP(kMul, mul)
+LITE_X86_ISA_OP(kDiv, div)
+LITE_X86_ISA_OP(kMax, max)
+LITE_X86_ISA_OP(kMin, min)
+#undef LITE_X86_ISA_OP
+
+enum Mode { kRangeToRange, kRangeToOne, kOneToRange };
+
+template <BinaryOp op, bool relu, Mode mode>
+void Run(const float* x, const float* y, float* z, int num) {
+  if (num <= 0) return;
+  const vec_t vx = vset1(*x);
+  const vec_t vy = vset1(*y);
+  const vec_t vzeros = vzero();
+  int i = 0;
+  for (; i + 2 * kLanes <= num; i += 2 * kLanes) {
+    vec_t a0 = mode == kOneToRange ? vx : vload(x + i);
+    vec_t a1 = mode == kOneToRange ? vx : vload(x + i + kLanes);
+    vec_t b0 = mode == kRangeToOne ? vy : vload(y + i);
+    vec_t b1 = mode == kRangeToOne ? vy : vload(y + i + kLanes);
+    vec_t r0 = Op<op>::Apply(a0, b0);
+    vec_t r1 = Op<op>::Apply(a1, b1);
+    if (relu) {
+      r0 = vmax(r0, vzeros);
+      r1 = vmax(r1, vzeros);
+    }
+    vstore(z + i, r0);
+    vstore(z + i + kLanes, r1);
+  }
+  for (; i < num; ++i) {
+    float a = mode == kOneToRange ? *x : x[i];
+    float b = mode == kRangeToOne ? *y : y[i];
+    float r = Op<op>::ApplyScalar(a, b);
+    z[i] = relu && r < 0.f ? 0.f : r;
+  }
+}
+
+template <Mode mode>
+void Dispatch(const float* x,
+              const float* y,
+              float* z,
+              int num,
+              BinaryOp op,
+              bool relu) {
+  typedef void (*Fn)(const float*, const float*, float*, int);
+  static const Fn fns[][2] = {
+      {Run<BinaryOp::kAdd, false, mode>, Run<BinaryOp::kAdd, true, mode>},
+      {Run<BinaryOp::kSub, false, mode>, Run<BinaryOp::kSub, true, mode>},
+      {Run<BinaryOp::kMul, false, mode>, Run<BinaryOp::kMul, true, mode>},
+      {Run<BinaryOp::kDiv, false, mode>, Run<BinaryOp::kDiv, true, mode>},
+      {Run<BinaryOp::kMax, false, mode>, Run<BinaryOp::kMax, true, mode>},
+      {Run<BinaryOp::kMin, false, mode>, Run<BinaryOp::kMin, true, mode>},
+  };
+  fns[static_cast<int>(op)][relu ? 1 : 0](x, y, z, num);
+}
+
+const ElementwiseKernels kKernels = {
+    ::paddle::lite::x86::LITE_X86_ISA,
+    Dispatch<kRangeToRange>,
+    Dispatch<kRangeToOne>,
+    Dispatch<kOneToRange>};
+
+}  // namespace
+
+const ElementwiseKernels* Kernels() { return &kKernels; }
+
+#else   // LITE_X86_ISA_WIDTH
+
+const ElementwiseKernels* Kernels() { return nullptr; }
+
+#endif  // LITE_X86_ISA_WIDTH
+
+}  // namespace LITE_X86_ISA_NAMESPACE
+}  // namespace isa
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
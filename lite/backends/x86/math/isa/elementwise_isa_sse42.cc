@@ -0,0 +1,22 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// SSE variant, built with -msse4.2 -mno-avx.
+
+#define LITE_X86_ISA_NAMESPACE sse42
+#define LITE_X86_ISA sse42
+#if defined(__SSE4_2__) || defined(_M_X64)
+#define LITE_X86_ISA_WIDTH 4
+#endif
+#include "lite/backends/x86/math/isa/elementwise_isa_impl.h"
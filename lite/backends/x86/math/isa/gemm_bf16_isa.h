@@ -0,0 +1,61 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <stdint.h>
+#include "lite/backends/x86/cpu_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+namespace isa {
+
+// GEMM with fp32 activations and bf16 weights. The weights are widened to
+// fp32 in registers right after they are loaded, so only their memory
+// traffic is halved and the accumulation stays in fp32. Built once per ISA
+// variant (see gemm_bf16_isa_<isa>.cc) like the elementwise kernels.
+
+// c[i, j] = relu?(bias[j] + sum_k a[i, k] * b[k, j]) for the m rows of c
+// and the columns j in [n_begin, n_end). a is m x k with leading dimension
+// lda, b is k x n in bf16 with leading dimension ldb, bias may be nullptr.
+typedef void (*GemmBF16Fn)(int m,
+                           int k,
+                           const float* a,
+                           int lda,
+                           const uint16_t* b,
+                           int ldb,
+                           const float* bias,
+                           bool relu,
+                           float* c,
+                           int ldc,
+                           int n_begin,
+                           int n_end);
+
+struct GemmBF16Kernels {
+  cpu_isa_t isa;
+  GemmBF16Fn gemm;
+};
+
+// Same contract as ElementwiseKernelsFor().
+const GemmBF16Kernels* GemmBF16KernelsFor(cpu_isa_t cpu_isa);
+
+// The kernels of the best variant not above RuntimeIsa().
+const GemmBF16Kernels& GemmBF16();
+
+}  // namespace isa
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,228 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Body of one ISA variant of the kernels in gemm_bf16_isa.h, included once
+// by every gemm_bf16_isa_<isa>.cc. It takes the same three macros as
+// elementwise_isa_impl.h and follows the same rule: nothing but
+// GemmKernels() may have external linkage.
+
+#include "lite/backends/x86/math/isa/gemm_bf16_isa.h"
+
+#if defined(LITE_X86_ISA_WIDTH) && LITE_X86_ISA_WIDTH > 1
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+namespace isa {
+namespace LITE_X86_ISA_NAMESPACE {
+
+#ifdef LITE_X86_ISA_WIDTH
+
+namespace {
+
+const int kLanes = LITE_X86_ISA_WIDTH;
+// Rows of c computed together, so that each widened row of b is reused
+// kRows times before it leaves the registers.
+const int kRows = 4;
+
+inline float widen(uint16_t v) {
+  union {
+    uint32_t u;
+    float f;
+  } bits;
+  bits.u = static_cast<uint32_t>(v) << 16;
+  return bits.f;
+}
+
+#if LITE_X86_ISA_WIDTH == 16
+typedef __m512 vec_t;
+inline vec_t vload_bf16(const uint16_t* p) {
+  __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16));
+}
+inline vec_t vload(const float* p) { return _mm512_loadu_ps(p); }
+inline void vstore(float* p, vec_t v) { _mm512_storeu_ps(p, v); }
+inline vec_t vset1(float v) { return _mm512_set1_ps(v); }
+inline vec_t vzero() { return _mm512_setzero_ps(); }
+inline vec_t vmax(vec_t a, vec_t b) { return _mm512_max_ps(a, b); }
+inline vec_t vfmadd(vec_t a, vec_t b, vec_t c) {
+  return _mm512_fmadd_ps(a, b, c);
+}
+#elif LITE_X86_ISA_WIDTH == 8
+typedef __m256 vec_t;
+inline vec_t vload_bf16(const uint16_t* p) {
+  __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+}
+inline vec_t vload(const float* p) { return _mm256_loadu_ps(p); }
+inline void vstore(float* p, vec_t v) { _mm256_storeu_ps(p, v); }
+inline vec_t vset1(float v) { return _mm256_set1_ps(v); }
+inline vec_t vzero() { return _mm256_setzero_ps(); }
+inline vec_t vmax(vec_t a, vec_t b) { return _mm256_max_ps(a, b); }
+inline vec_t vfmadd(vec_t a, vec_t b, vec_t c) {
+  return _mm256_fmadd_ps(a, b, c);
+}
+#elif LITE_X86_ISA_WIDTH == 4
+typedef __m128 vec_t;
+inline vec_t vload_bf16(const uint16_t* p) {
+  __m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+  return _mm_castsi128_ps(_mm_slli_epi32(_mm_cvtepu16_epi32(h), 16));
+}
+inline vec_t vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, vec_t v) { _mm_storeu_ps(p, v); }
+inline vec_t vset1(float v) { return _mm_set1_ps(v); }
+inline vec_t vzero() { return _mm_setzero_ps(); }
+inline vec_t vmax(vec_t a, vec_t b) { return _mm_max_ps(a, b); }
+inline vec_t vfmadd(vec_t a, vec_t b, vec_t c) {
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+#else
+typedef float vec_t;
+inline vec_t vload_bf16(const uint16_t* p) { return widen(*p); }
+inline vec_t vload(const float* p) { return *p; }
+inline void vstore(float* p, vec_t v) { *p = v; }
+inline vec_t vset1(float v) { return v; }
+inline vec_t vzero() { return 0.f; }
+inline vec_t vmax(vec_t a, vec_t b) { return a > b ? a : b; }
+inline vec_t vfmadd(vec_t a, vec_t b, vec_t c) { return a * b + c; }
+#endif
+
+// c[rows, j:j + cols * kLanes] for `rows` <= kRows rows starting at a and c.
+template <int rows, int cols>
+void Tile(int k,
+          const float* a,
+          int lda,
+          const uint16_t* b,
+          int ldb,
+          const float* bias,
+          bool relu,
+          float* c,
+          int ldc) {
+  vec_t acc[rows][cols];
+  for (int r = 0; r < rows; ++r) {
+    for (int v = 0; v < cols; ++v) {
+      acc[r][v] = bias ? vload(bias + v * kLanes) : vzero();
+    }
+  }
+  for (int p = 0; p < k; ++p) {
+    const uint16_t* b_row = b + static_cast<int64_t>(p) * ldb;
+    vec_t w[cols];
+    for (int v = 0; v < cols; ++v) {
+      w[v] = vload_bf16(b_row + v * kLanes);
+    }
+    for (int r = 0; r < rows; ++r) {
+      const vec_t x = vset1(a[static_cast<int64_t>(r) * lda + p]);
+      for (int v = 0; v < cols; ++v) {
+        acc[r][v] = vfmadd(x, w[v], acc[r][v]);
+      }
+    }
+  }
+  const vec_t zeros = vzero();
+  for (int r = 0; r < rows; ++r) {
+    for (int v = 0; v < cols; ++v) {
+      vec_t out = relu ? vmax(acc[r][v], zeros) : acc[r][v];
+      vstore(c + static_cast<int64_t>(r) * ldc + v * kLanes, out);
+    }
+  }
+}
+
+template <int cols>
+void Columns(int m,
+             int k,
+             const float* a,
+             int lda,
+             const uint16_t* b,
+             int ldb,
+             const float* bias,
+             bool relu,
+             float* c,
+             int ldc) {
+  int i = 0;
+  for (; i + kRows <= m; i += kRows) {
+    Tile<kRows, cols>(k,
+                      a + static_cast<int64_t>(i) * lda,
+                      lda,
+                      b,
+                      ldb,
+                      bias,
+                      relu,
+                      c + static_cast<int64_t>(i) * ldc,
+                      ldc);
+  }
+  for (; i < m; ++i) {
+    Tile<1, cols>(k,
+                  a + static_cast<int64_t>(i) * lda,
+                  lda,
+                  b,
+                  ldb,
+                  bias,
+                  relu,
+                  c + static_cast<int64_t>(i) * ldc,
+                  ldc);
+  }
+}
+
+void Gemm(int m,
+          int k,
+          const float* a,
+          int lda,
+          const uint16_t* b,
+          int ldb,
+          const float* bias,
+          bool relu,
+          float* c,
+          int ldc,
+          int n_begin,
+          int n_end) {
+  int j = n_begin;
+  for (; j + 2 * kLanes <= n_end; j += 2 * kLanes) {
+    Columns<2>(
+        m, k, a, lda, b + j, ldb, bias ? bias + j : nullptr, relu, c + j, ldc);
+  }
+  for (; j + kLanes <= n_end; j += kLanes) {
+    Columns<1>(
+        m, k, a, lda, b + j, ldb, bias ? bias + j : nullptr, relu, c + j, ldc);
+  }
+  for (; j < n_end; ++j) {
+    for (int i = 0; i < m; ++i) {
+      const float* a_row = a + static_cast<int64_t>(i) * lda;
+      float sum = bias ? bias[j] : 0.f;
+      for (int p = 0; p < k; ++p) {
+        sum += a_row[p] * widen(b[static_cast<int64_t>(p) * ldb + j]);
+      }
+      c[static_cast<int64_t>(i) * ldc + j] = relu && sum < 0.f ? 0.f : sum;
+    }
+  }
+}
+
+const GemmBF16Kernels kKernels = {::paddle::lite::x86::LITE_X86_ISA, Gemm};
+
+}  // namespace
+
+const GemmBF16Kernels* GemmKernels() { return &kKernels; }
+
+#else   // LITE_X86_ISA_WIDTH
+
+const GemmBF16Kernels* GemmKernels() { return nullptr; }
+
+#endif  // LITE_X86_ISA_WIDTH
+
+}  // namespace LITE_X86_ISA_NAMESPACE
+}  // namespace isa
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
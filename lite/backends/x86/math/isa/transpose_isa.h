@@ -0,0 +1,51 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <stdint.h>
+#include "lite/backends/x86/cpu_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+namespace isa {
+
+// The fp32 tile transpose of BlockedTranspose(), built once per ISA variant
+// (see transpose_isa_<isa>.cc) like the elementwise kernels.
+
+// out[c * ld_out + r] = in[r * ld_in + c] for r in [0, rows), c in [0, cols).
+typedef void (*TransposeTileFn)(const float* in,
+                                int64_t ld_in,
+                                float* out,
+                                int64_t ld_out,
+                                int64_t rows,
+                                int64_t cols);
+
+struct TransposeKernels {
+  cpu_isa_t isa;
+  TransposeTileFn tile;
+};
+
+// Same contract as ElementwiseKernelsFor().
+const TransposeKernels* TransposeKernelsFor(cpu_isa_t cpu_isa);
+
+// The kernels of the best variant not above RuntimeIsa().
+const TransposeKernels& Transpose();
+
+}  // namespace isa
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
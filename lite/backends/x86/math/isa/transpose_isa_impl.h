@@ -0,0 +1,150 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Body of one ISA variant of the kernels in transpose_isa.h, included once
+// by every transpose_isa_<isa>.cc. It takes the same three macros as
+// elementwise_isa_impl.h and follows the same rule: nothing but
+// TileKernels() may have external linkage.
+
+#include "lite/backends/x86/math/isa/transpose_isa.h"
+
+#if defined(LITE_X86_ISA_WIDTH) && LITE_X86_ISA_WIDTH > 1
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+namespace isa {
+namespace LITE_X86_ISA_NAMESPACE {
+
+#ifdef LITE_X86_ISA_WIDTH
+
+namespace {
+
+inline void TransposeScalar(const float* in,
+                            int64_t ld_in,
+                            float* out,
+                            int64_t ld_out,
+                            int64_t r0,
+                            int64_t r1,
+                            int64_t c0,
+                            int64_t c1) {
+  for (int64_t r = r0; r < r1; ++r) {
+    for (int64_t c = c0; c < c1; ++c) {
+      out[c * ld_out + r] = in[r * ld_in + c];
+    }
+  }
+}
+
+// The AVX-512 variant uses the 8x8 AVX micro kernel as well: a 16x16 one
+// needs twice the registers and the 32x32 tiles leave it little to gain.
+#if LITE_X86_ISA_WIDTH >= 8
+const int64_t kBlock = 8;
+
+inline void TransposeBlock(const float* in,
+                           int64_t ld_in,
+                           float* out,
+                           int64_t ld_out) {
+  __m256 r0 = _mm256_loadu_ps(in);
+  __m256 r1 = _mm256_loadu_ps(in + ld_in);
+  __m256 r2 = _mm256_loadu_ps(in + 2 * ld_in);
+  __m256 r3 = _mm256_loadu_ps(in + 3 * ld_in);
+  __m256 r4 = _mm256_loadu_ps(in + 4 * ld_in);
+  __m256 r5 = _mm256_loadu_ps(in + 5 * ld_in);
+  __m256 r6 = _mm256_loadu_ps(in + 6 * ld_in);
+  __m256 r7 = _mm256_loadu_ps(in + 7 * ld_in);
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+  __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+  _mm256_storeu_ps(out, _mm256_permute2f128_ps(s0, s4, 0x20));
+  _mm256_storeu_ps(out + ld_out, _mm256_permute2f128_ps(s1, s5, 0x20));
+  _mm256_storeu_ps(out + 2 * ld_out, _mm256_permute2f128_ps(s2, s6, 0x20));
+  _mm256_storeu_ps(out + 3 * ld_out, _mm256_permute2f128_ps(s3, s7, 0x20));
+  _mm256_storeu_ps(out + 4 * ld_out, _mm256_permute2f128_ps(s0, s4, 0x31));
+  _mm256_storeu_ps(out + 5 * ld_out, _mm256_permute2f128_ps(s1, s5, 0x31));
+  _mm256_storeu_ps(out + 6 * ld_out, _mm256_permute2f128_ps(s2, s6, 0x31));
+  _mm256_storeu_ps(out + 7 * ld_out, _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+#elif LITE_X86_ISA_WIDTH == 4
+const int64_t kBlock = 4;
+
+inline void TransposeBlock(const float* in,
+                           int64_t ld_in,
+                           float* out,
+                           int64_t ld_out) {
+  __m128 r0 = _mm_loadu_ps(in);
+  __m128 r1 = _mm_loadu_ps(in + ld_in);
+  __m128 r2 = _mm_loadu_ps(in + 2 * ld_in);
+  __m128 r3 = _mm_loadu_ps(in + 3 * ld_in);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(out, r0);
+  _mm_storeu_ps(out + ld_out, r1);
+  _mm_storeu_ps(out + 2 * ld_out, r2);
+  _mm_storeu_ps(out + 3 * ld_out, r3);
+}
+#endif
+
+void TransposeTile(const float* in,
+                   int64_t ld_in,
+                   float* out,
+                   int64_t ld_out,
+                   int64_t rows,
+                   int64_t cols) {
+  int64_t r = 0;
+  int64_t c_end = 0;
+#if LITE_X86_ISA_WIDTH > 1
+  c_end = cols - cols % kBlock;
+  for (; r + kBlock <= rows; r += kBlock) {
+    for (int64_t c = 0; c < c_end; c += kBlock) {
+      TransposeBlock(in + r * ld_in + c, ld_in, out + c * ld_out + r, ld_out);
+    }
+  }
+#endif
+  TransposeScalar(in, ld_in, out, ld_out, 0, r, c_end, cols);
+  TransposeScalar(in, ld_in, out, ld_out, r, rows, 0, cols);
+}
+
+const TransposeKernels kKernels = {::paddle::lite::x86::LITE_X86_ISA,
+                                   TransposeTile};
+
+}  // namespace
+
+const TransposeKernels* TileKernels() { return &kKernels; }
+
+#else   // LITE_X86_ISA_WIDTH
+
+const TransposeKernels* TileKernels() { return nullptr; }
+
+#endif  // LITE_X86_ISA_WIDTH
+
+}  // namespace LITE_X86_ISA_NAMESPACE
+}  // namespace isa
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
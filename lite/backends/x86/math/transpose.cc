@@ -0,0 +1,239 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/transpose.h"
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include "lite/backends/x86/math/isa/transpose_isa.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// Edge of the square tiles a 2-D transpose is split into, 32x32 floats of
+// input and output fit in L1 together.
+const int64_t kTileSize = 32;
+// Below this many elements a single thread is faster.
+const int64_t kParallelThreshold = 1 << 14;
+
+// out[c * ld_out + r] = in[r * ld_in + c] for r in [r0, r1), c in [c0, c1).
+template <typename T>
+inline void TransposeScalar(const T* in,
+                            int64_t ld_in,
+                            T* out,
+                            int64_t ld_out,
+                            int64_t r0,
+                            int64_t r1,
+                            int64_t c0,
+                            int64_t c1) {
+  for (int64_t r = r0; r < r1; ++r) {
+    for (int64_t c = c0; c < c1; ++c) {
+      out[c * ld_out + r] = in[r * ld_in + c];
+    }
+  }
+}
+
+// Transposes one rows x cols tile.
+template <typename T>
+inline void TransposeTile(const T* in,
+                          int64_t ld_in,
+                          T* out,
+                          int64_t ld_out,
+                          int64_t rows,
+                          int64_t cols) {
+  TransposeScalar(in, ld_in, out, ld_out, 0, rows, 0, cols);
+}
+
+template <>
+inline void TransposeTile<float>(const float* in,
+                                 int64_t ld_in,
+                                 float* out,
+                                 int64_t ld_out,
+                                 int64_t rows,
+                                 int64_t cols) {
+  isa::Transpose().tile(in, ld_in, out, ld_out, rows, cols);
+}
+
+// out[b][c][r] = in[b][r][c] for `batch` matrices of rows x cols.
+template <typename T>
+void BatchTranspose2D(
+    const T* in, T* out, int64_t batch, int64_t rows, int64_t cols) {
+  const int64_t row_tiles = (rows + kTileSize - 1) / kTileSize;
+  const int64_t col_tiles = (cols + kTileSize - 1) / kTileSize;
+  auto run = [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const int64_t b = i / row_tiles;
+      const int64_t r = (i % row_tiles) * kTileSize;
+      const T* src = in + b * rows * cols;
+      T* dst = out + b * rows * cols;
+      for (int64_t ct = 0; ct < col_tiles; ++ct) {
+        const int64_t c = ct * kTileSize;
+        TransposeTile(src + r * cols + c,
+                      cols,
+                      dst + c * rows + r,
+                      rows,
+                      (std::min)(kTileSize, rows - r),
+                      (std::min)(kTileSize, cols - c));
+      }
+    }
+  };
+  if (batch * rows * cols >= kParallelThreshold) {
+    RunParallelFor(0, batch * row_tiles, run);
+  } else {
+    run(0, batch * row_tiles);
+  }
+}
+
+// Copies the contiguous rows of `inner` elements to their permuted place,
+// `dims` and `axis` describe the outer axes only.
+template <typename T>
+void PermuteRows(const T* in,
+                 T* out,
+                 const std::vector<int64_t>& dims,
+                 const std::vector<int>& axis,
+                 int64_t inner) {
+  const int rank = dims.size();
+  std::vector<int64_t> in_stride(rank, inner);
+  for (int i = rank - 2; i >= 0; --i) {
+    in_stride[i] = in_stride[i + 1] * dims[i + 1];
+  }
+  // Input stride and extent of every output axis.
+  std::vector<int64_t> stride(rank);
+  std::vector<int64_t> extent(rank);
+  int64_t num_rows = 1;
+  for (int i = 0; i < rank; ++i) {
+    stride[i] = in_stride[axis[i]];
+    extent[i] = dims[axis[i]];
+    num_rows *= extent[i];
+  }
+  auto run = [&](int64_t begin, int64_t end) {
+    std::vector<int64_t> index(rank);
+    int64_t offset = 0;
+    int64_t rem = begin;
+    for (int i = rank - 1; i >= 0; --i) {
+      index[i] = rem % extent[i];
+      rem /= extent[i];
+      offset += index[i] * stride[i];
+    }
+    for (int64_t row = begin; row < end; ++row) {
+      memcpy(out + row * inner, in + offset, inner * sizeof(T));
+      for (int i = rank - 1; i >= 0; --i) {
+        offset += stride[i];
+        if (++index[i] < extent[i]) break;
+        offset -= extent[i] * stride[i];
+        index[i] = 0;
+      }
+    }
+  };
+  if (num_rows * inner >= kParallelThreshold) {
+    RunParallelFor(0, num_rows, run);
+  } else {
+    run(0, num_rows);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+bool BlockedTranspose(const T* in,
+                      T* out,
+                      const std::vector<int64_t>& dims,
+                      const std::vector<int>& axis) {
+  CHECK_EQ(dims.size(), axis.size());
+  const int rank = dims.size();
+  int64_t numel = 1;
+  for (auto d : dims) numel *= d;
+  if (numel == 0) return true;
+
+  // Drop size-1 dims, renumbering the remaining input axes.
+  std::vector<int> new_id(rank, -1);
+  std::vector<int64_t> squeezed;
+  for (int i = 0; i < rank; ++i) {
+    if (dims[i] != 1) {
+      new_id[i] = squeezed.size();
+      squeezed.push_back(dims[i]);
+    }
+  }
+  std::vector<int> perm;
+  for (int i = 0; i < rank; ++i) {
+    if (new_id[axis[i]] >= 0) perm.push_back(new_id[axis[i]]);
+  }
+
+  // Merge runs of consecutive input axes that stay consecutive in the
+  // output, each run becomes one axis.
+  std::vector<std::pair<int, int>> runs;  // [first, last] input axes
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (i > 0 && perm[i] == runs.back().second + 1) {
+      runs.back().second = perm[i];
+    } else {
+      runs.emplace_back(perm[i], perm[i]);
+    }
+  }
+  std::vector<int> order(runs.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return runs[a].first < runs[b].first;
+  });
+  const int n = runs.size();
+  std::vector<int64_t> merged_dims(n);
+  std::vector<int> merged_axis(n);
+  for (int i = 0; i < n; ++i) {
+    const auto& run = runs[order[i]];
+    int64_t d = 1;
+    for (int k = run.first; k <= run.second; ++k) d *= squeezed[k];
+    merged_dims[i] = d;
+    merged_axis[order[i]] = i;
+  }
+
+  if (n <= 1) {
+    memcpy(out, in, numel * sizeof(T));
+    return true;
+  }
+  if (merged_axis[n - 1] == n - 1) {
+    std::vector<int64_t> outer_dims(merged_dims.begin(), merged_dims.end() - 1);
+    std::vector<int> outer_axis(merged_axis.begin(), merged_axis.end() - 1);
+    PermuteRows(in, out, outer_dims, outer_axis, merged_dims[n - 1]);
+    return true;
+  }
+  if (n == 2) {
+    BatchTranspose2D(in, out, 1, merged_dims[0], merged_dims[1]);
+    return true;
+  }
+  if (n == 3 && merged_axis[0] == 0) {
+    BatchTranspose2D(in, out, merged_dims[0], merged_dims[1], merged_dims[2]);
+    return true;
+  }
+  return false;
+}
+
+template bool BlockedTranspose<float>(const float*,
+                                      float*,
+                                      const std::vector<int64_t>&,
+                                      const std::vector<int>&);
+template bool BlockedTranspose<int64_t>(const int64_t*,
+                                        int64_t*,
+                                        const std::vector<int64_t>&,
+                                        const std::vector<int>&);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,43 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// out = in permuted by `axis`, where `in` has shape `dims` and the output
+// shape is dims[axis[0]], dims[axis[1]], ...
+// Size-1 dims are dropped and input axes that stay adjacent in the output
+// are merged first, so the common permutations reduce to one of two forms:
+//   - the last axis is kept (e.g. 0213): contiguous rows are copied;
+//   - a batch of 2-D transposes (e.g. 0132, NCHW <-> NHWC): done in cache
+//     sized tiles with an 8x8 AVX (4x4 SSE) micro kernel for float, picked
+//     at runtime by RuntimeIsa().
+// Returns false, leaving `out` untouched, for any other permutation.
+template <typename T>
+bool BlockedTranspose(const T* in,
+                      T* out,
+                      const std::vector<int64_t>& dims,
+                      const std::vector<int>& axis);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,301 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/allocator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#ifdef LITE_WITH_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+// Extra bytes at the end of every block, the SIMD kernels may read a little
+// beyond the end of the tensors.
+const size_t kMallocExtra = 64;
+const size_t kDefaultAlignment = 64;
+const size_t kHugePageSize = 2 * 1024 * 1024;
+
+struct BlockHeader {
+  void* raw;
+  size_t size;
+  AllocatorRegistry::Entry* entry;
+};
+
+size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+class DefaultAllocator : public Allocator {
+ public:
+  void* Allocate(size_t size) override { return malloc(size); }
+  void Deallocate(void* ptr, size_t size) override { free(ptr); }
+};
+
+// Cache the freed blocks by the power-of-2 size classes, so the activations
+// which are reallocated on every shape change are reused instead of going
+// back to the system.
+class PoolAllocator : public Allocator {
+ public:
+  ~PoolAllocator() { Release(); }
+
+  void* Allocate(size_t size) override {
+    int index = SizeClass(size);
+    if (index < 0) return malloc(size);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& blocks = free_blocks_[index];
+      if (!blocks.empty()) {
+        void* ptr = blocks.back();
+        blocks.pop_back();
+        return ptr;
+      }
+    }
+    return malloc(ClassSize(index));
+  }
+
+  void Deallocate(void* ptr, size_t size) override {
+    int index = SizeClass(size);
+    if (index < 0) {
+      free(ptr);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_blocks_[index].push_back(ptr);
+  }
+
+  void Release() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& blocks : free_blocks_) {
+      for (auto* ptr : blocks) {
+        free(ptr);
+      }
+      blocks.clear();
+    }
+  }
+
+ private:
+  // The size classes are [256B, 256MB], the larger blocks are not cached.
+  static const int kMinShift = 8;
+  static const int kMaxShift = 28;
+
+  static int SizeClass(size_t size) {
+    int shift = kMinShift;
+    while (shift <= kMaxShift && (static_cast<size_t>(1) << shift) < size) {
+      shift++;
+    }
+    return shift > kMaxShift ? -1 : shift - kMinShift;
+  }
+
+  static size_t ClassSize(int index) {
+    return static_cast<size_t>(1) << (index + kMinShift);
+  }
+
+  std::mutex mutex_;
+  std::vector<void*> free_blocks_[kMaxShift - kMinShift + 1];
+};
+
+// Back the blocks larger than 2MB with the transparent huge pages to reduce
+// the TLB misses when accessing the large weights.
+class HugePageAllocator : public Allocator {
+ public:
+  void* Allocate(size_t size) override {
+#if defined(__linux__)
+    if (size >= kHugePageSize) {
+      size_t length = RoundUp(size, kHugePageSize);
+      // Map one more huge page to make the start address 2MB aligned.
+      size_t map_length = length + kHugePageSize;
+      void* ptr = mmap(nullptr,
+                       map_length,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1,
+                       0);
+      if (ptr == MAP_FAILED) return nullptr;
+      auto* begin = static_cast<char*>(ptr);
+      auto* aligned = reinterpret_cast<char*>(
+          RoundUp(reinterpret_cast<size_t>(begin), kHugePageSize));
+      if (aligned > begin) {
+        munmap(begin, aligned - begin);
+      }
+      size_t tail = (begin + map_length) - (aligned + length);
+      if (tail > 0) {
+        munmap(aligned + length, tail);
+      }
+#ifdef MADV_HUGEPAGE
+      madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+      return aligned;
+    }
+#endif
+    return malloc(size);
+  }
+
+  void Deallocate(void* ptr, size_t size) override {
+#if defined(__linux__)
+    if (size >= kHugePageSize) {
+      munmap(ptr, RoundUp(size, kHugePageSize));
+      return;
+    }
+#endif
+    free(ptr);
+  }
+};
+
+#ifdef LITE_WITH_JEMALLOC
+class JeMallocAllocator : public Allocator {
+ public:
+  void* Allocate(size_t size) override { return mallocx(size, 0); }
+  void Deallocate(void* ptr, size_t size) override { sdallocx(ptr, size, 0); }
+};
+#endif
+
+}  // namespace
+
+AllocatorRegistry& AllocatorRegistry::Global() {
+  // Never destroyed, the tensors in the static storage may be freed after it.
+  static AllocatorRegistry* x = new AllocatorRegistry;
+  return *x;
+}
+
+AllocatorRegistry::AllocatorRegistry() {
+  Register("default", std::make_shared<DefaultAllocator>());
+  Register("pool", std::make_shared<PoolAllocator>());
+  Register("huge_page", std::make_shared<HugePageAllocator>());
+#ifdef LITE_WITH_JEMALLOC
+  Register("jemalloc", std::make_shared<JeMallocAllocator>());
+#endif
+  default_entry_ = Find("default");
+}
+
+void AllocatorRegistry::Register(const std::string& name,
+                                 const std::shared_ptr<Allocator>& allocator) {
+  CHECK(allocator) << "The allocator '" << name << "' should not be nullptr.";
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(!entries_.count(name)) << "The allocator '" << name
+                               << "' has been registered.";
+  std::unique_ptr<Entry> entry(new Entry);
+  entry->name = name;
+  entry->allocator = allocator;
+  entries_[name] = std::move(entry);
+}
+
+bool AllocatorRegistry::Has(const std::string& name) {
+  return Find(name) != nullptr;
+}
+
+AllocatorRegistry::Entry* AllocatorRegistry::Find(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(name);
+  return it != entries_.end() ? it->second.get() : nullptr;
+}
+
+AllocatorStatistics AllocatorRegistry::Statistics(const std::string& name) {
+  auto* entry = Find(name);
+  CHECK(entry) << "The allocator '" << name << "' is not registered.";
+  AllocatorStatistics stats;
+  stats.bytes_live = entry->bytes_live.load();
+  stats.bytes_peak = entry->bytes_peak.load();
+  stats.alloc_count = entry->alloc_count.load();
+  stats.free_count = entry->free_count.load();
+  return stats;
+}
+
+void AllocatorRegistry::ReleaseAll() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& entry : entries_) {
+    entry.second->allocator->Release();
+  }
+}
+
+void* AllocatorRegistry::Malloc(size_t size) {
+  CHECK(size);
+  auto* entry = Current() ? Current() : default_entry_;
+  size_t alignment = CurrentAlignment();
+  size_t offset = sizeof(BlockHeader) + alignment - 1;
+  CHECK_GT(offset + size, size);
+  size_t raw_size = offset + size + kMallocExtra;
+  CHECK_GT(raw_size, offset + size);
+  auto* raw = static_cast<char*>(entry->allocator->Allocate(raw_size));
+  CHECK(raw) << "Error occurred in TargetMalloc period: no enough for "
+                "mallocing "
+             << size << " bytes with the allocator '" << entry->name << "'.";
+  auto* data = reinterpret_cast<char*>(
+      RoundUp(reinterpret_cast<size_t>(raw + sizeof(BlockHeader)), alignment));
+  auto* header = reinterpret_cast<BlockHeader*>(data) - 1;
+  header->raw = raw;
+  header->size = raw_size;
+  header->entry = entry;
+
+  int64_t live = (entry->bytes_live += static_cast<int64_t>(raw_size));
+  int64_t peak = entry->bytes_peak.load();
+  while (live > peak && !entry->bytes_peak.compare_exchange_weak(peak, live)) {
+  }
+  entry->alloc_count++;
+  return data;
+}
+
+void AllocatorRegistry::Free(void* ptr) {
+  if (!ptr) return;
+  auto* header = static_cast<BlockHeader*>(ptr) - 1;
+  auto* entry = header->entry;
+  entry->bytes_live -= static_cast<int64_t>(header->size);
+  entry->free_count++;
+  entry->allocator->Deallocate(header->raw, header->size);
+}
+
+AllocatorRegistry::Entry*& AllocatorRegistry::Current() {
+  static LITE_THREAD_LOCAL Entry* x = nullptr;
+  return x;
+}
+
+size_t& AllocatorRegistry::CurrentAlignment() {
+  static LITE_THREAD_LOCAL size_t x = kDefaultAlignment;
+  return x;
+}
+
+std::shared_ptr<Allocator> CreatePoolAllocator() {
+  return std::make_shared<PoolAllocator>();
+}
+
+AllocatorGuard::AllocatorGuard(const std::string& name, size_t alignment) {
+  auto* entry = AllocatorRegistry::Global().Find(name);
+  CHECK(entry) << "The allocator '" << name << "' is not registered.";
+  prev_entry_ = AllocatorRegistry::Current();
+  prev_alignment_ = AllocatorRegistry::CurrentAlignment();
+  AllocatorRegistry::Current() = entry;
+  if (alignment) {
+    CHECK((alignment & (alignment - 1)) == 0)
+        << "The memory alignment should be a power of 2, but got "
+        << alignment;
+    AllocatorRegistry::CurrentAlignment() =
+        (std::max)(alignment, sizeof(BlockHeader*) * 2);
+  }
+}
+
+AllocatorGuard::~AllocatorGuard() {
+  AllocatorRegistry::Current() = prev_entry_;
+  AllocatorRegistry::CurrentAlignment() = prev_alignment_;
+}
+
+}  // namespace lite
+}  // namespace paddle
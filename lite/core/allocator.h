@@ -0,0 +1,97 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include "lite/api/paddle_api.h"
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+
+using lite_api::Allocator;
+using lite_api::AllocatorStatistics;
+
+/*
+ * AllocatorRegistry keeps the host allocators, the host memory of
+ * `TargetMalloc`/`TargetFree` is dispatched to the allocator which is active in
+ * the current thread, see `AllocatorGuard`.
+ *
+ * Every block is prefixed with a small header which records its allocator, so
+ * a block can be freed in any thread, no matter which allocator is active
+ * there.
+ */
+class AllocatorRegistry {
+ public:
+  struct Entry {
+    std::string name;
+    std::shared_ptr<Allocator> allocator;
+    std::atomic<int64_t> bytes_live{0};
+    std::atomic<int64_t> bytes_peak{0};
+    std::atomic<int64_t> alloc_count{0};
+    std::atomic<int64_t> free_count{0};
+  };
+
+  static AllocatorRegistry& Global();
+
+  void Register(const std::string& name,
+                const std::shared_ptr<Allocator>& allocator);
+  bool Has(const std::string& name);
+  Entry* Find(const std::string& name);
+  AllocatorStatistics Statistics(const std::string& name);
+  // Return the cached memory of all the allocators to the system.
+  void ReleaseAll();
+
+  // Allocate the host memory from the active allocator of the current thread.
+  void* Malloc(size_t size);
+  void Free(void* ptr);
+
+  // The active allocator and memory alignment of the current thread.
+  static Entry*& Current();
+  static size_t& CurrentAlignment();
+
+ private:
+  AllocatorRegistry();
+
+  std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<Entry>> entries_;
+  Entry* default_entry_{nullptr};
+
+  DISALLOW_COPY_AND_ASSIGN(AllocatorRegistry);
+};
+
+// Create a pool allocator of its own, such as the arena shared by the models
+// of a `ModelGroup`, the "pool" allocator is shared by all the predictors.
+std::shared_ptr<Allocator> CreatePoolAllocator();
+
+// Activate an allocator for the current thread during the lifetime of the
+// guard, the previous one is restored on destruction.
+class AllocatorGuard {
+ public:
+  explicit AllocatorGuard(const std::string& name, size_t alignment = 0);
+  ~AllocatorGuard();
+
+ private:
+  AllocatorRegistry::Entry* prev_entry_{nullptr};
+  size_t prev_alignment_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(AllocatorGuard);
+};
+
+}  // namespace lite
+}  // namespace paddle
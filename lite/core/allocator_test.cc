@@ -0,0 +1,75 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/allocator.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include "lite/core/memory.h"
+
+namespace paddle {
+namespace lite {
+
+class CountingAllocator : public Allocator {
+ public:
+  void* Allocate(size_t size) override {
+    allocated++;
+    return malloc(size);
+  }
+  void Deallocate(void* ptr, size_t size) override {
+    deallocated++;
+    free(ptr);
+  }
+  int allocated{0};
+  int deallocated{0};
+};
+
+TEST(allocator, builtin) {
+  for (auto name : {"default", "pool", "huge_page"}) {
+    AllocatorGuard guard(name, 128);
+    auto stats = AllocatorRegistry::Global().Statistics(name);
+    for (size_t size : {1UL, 1000UL, 3UL * 1024 * 1024}) {
+      auto* buf = static_cast<char*>(TargetMalloc(TARGET(kHost), size));
+      ASSERT_TRUE(buf);
+      EXPECT_EQ(reinterpret_cast<size_t>(buf) % 128, 0UL);
+      std::memset(buf, 0, size);
+      TargetFree(TARGET(kHost), buf);
+    }
+    auto new_stats = AllocatorRegistry::Global().Statistics(name);
+    EXPECT_EQ(new_stats.alloc_count - stats.alloc_count, 3);
+    EXPECT_EQ(new_stats.free_count - stats.free_count, 3);
+    EXPECT_EQ(new_stats.bytes_live, stats.bytes_live);
+    EXPECT_GT(new_stats.bytes_peak, 3 * 1024 * 1024);
+  }
+  AllocatorRegistry::Global().ReleaseAll();
+}
+
+TEST(allocator, custom) {
+  auto allocator = std::make_shared<CountingAllocator>();
+  lite_api::RegisterAllocator("counting", allocator);
+  void* buf = nullptr;
+  {
+    AllocatorGuard guard("counting");
+    buf = TargetMalloc(TARGET(kX86), 100);
+  }
+  EXPECT_EQ(allocator->allocated, 1);
+  // Freed by its own allocator even if another one is active.
+  TargetFree(TARGET(kX86), buf);
+  EXPECT_EQ(allocator->deallocated, 1);
+  auto stats = lite_api::GetAllocatorStatistics("counting");
+  EXPECT_EQ(stats.bytes_live, 0);
+  EXPECT_EQ(stats.alloc_count, 1);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -322,6 +322,34 @@ class Context<TargetType::kNNAdapter> {
     if (!var) return "";
     return var->Get<std::string>();
   }
+  static void SetNNAdapterPipelinedExecution(Scope* scope, bool pipelined) {
+    auto var = scope->Var("NNADAPTER_PIPELINED_EXECUTION");
+    CHECK(var);
+    auto data = var->GetMutable<bool>();
+    CHECK(data);
+    *data = pipelined;
+  }
+
+  static bool NNAdapterPipelinedExecution(Scope* scope) {
+    auto var = scope->FindVar("NNADAPTER_PIPELINED_EXECUTION");
+    if (!var) return false;
+    return var->Get<bool>();
+  }
+
+  // Set during the run of PaddlePredictor::FlushPipelinedRuns
+  static void SetNNAdapterPipelinedFlush(Scope* scope, bool flush) {
+    auto var = scope->Var("NNADAPTER_PIPELINED_FLUSH");
+    CHECK(var);
+    auto data = var->GetMutable<bool>();
+    CHECK(data);
+    *data = flush;
+  }
+
+  static bool NNAdapterPipelinedFlush(Scope* scope) {
+    auto var = scope->FindVar("NNADAPTER_PIPELINED_FLUSH");
+    if (!var) return false;
+    return var->Get<bool>();
+  }
 };
 #endif
 
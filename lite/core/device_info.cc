@@ -130,6 +130,7 @@ LITE_THREAD_LOCAL ARMArch DeviceInfo::arch_;
 LITE_THREAD_LOCAL int DeviceInfo::mem_size_;
 LITE_THREAD_LOCAL std::vector<int> DeviceInfo::active_ids_;
 LITE_THREAD_LOCAL TensorLite DeviceInfo::workspace_;
+LITE_THREAD_LOCAL size_t DeviceInfo::workspace_request_ = 0;
 LITE_THREAD_LOCAL int64_t DeviceInfo::count_ = 0;
 
 #ifdef TARGET_IOS
@@ -1375,6 +1376,7 @@ void DeviceInfo::SetCache(int l1size, int l2size, int l3size) {
 }
 
 bool DeviceInfo::ExtendWorkspace(size_t size) {
+  workspace_request_ = (std::max)(workspace_request_, size);
   workspace_.Resize(
       {static_cast<int64_t>(size + static_cast<size_t>(llc_size()))});
   return workspace_.mutable_data<int8_t>() != nullptr;
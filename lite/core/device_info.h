@@ -165,6 +165,10 @@ class DeviceInfo {
     return reinterpret_cast<T*>(workspace_.mutable_data<int8_t>());
   }
   bool ExtendWorkspace(size_t size);
+  // The largest size requested by `ExtendWorkspace` since the last
+  // `ResetWorkspaceRequest`, it records the scratch peak of the kernels.
+  size_t workspace_request() const { return workspace_request_; }
+  void ResetWorkspaceRequest() { workspace_request_ = 0; }
 
  private:
   int core_num_;
@@ -196,6 +200,7 @@ class DeviceInfo {
   static LITE_THREAD_LOCAL int mem_size_;
   static LITE_THREAD_LOCAL std::vector<int> active_ids_;
   static LITE_THREAD_LOCAL TensorLite workspace_;
+  static LITE_THREAD_LOCAL size_t workspace_request_;
   static LITE_THREAD_LOCAL int64_t count_;
 
   void SetDotInfo(int argc, ...);
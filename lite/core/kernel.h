@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -38,6 +39,15 @@
 namespace paddle {
 namespace lite {
 
+// The attributes of an op whose weights are packed ahead of time by its kernel,
+// they are the name of the packed weights, the tag of their layout and the
+// input argument of the original weights replaced by them.
+static const char kPackedWeightsAttr[] = "__@packed_weights_attr@__";
+static const char kPackedWeightsLayoutAttr[] =
+    "__@packed_weights_layout_attr@__";
+static const char kPackedWeightsArgumentAttr[] =
+    "__@packed_weights_argument_attr@__";
+
 // An base with virtual functions to unify all the kernel implementation on
 // different targets.
 class KernelBase {
@@ -52,6 +62,39 @@ class KernelBase {
   /// `SetContext`, that is both the param_ and context_ are valid.
   virtual void PrepareForRun() {}
 
+  /// Whether `PrepareForRun` only reads the attributes and the weights of the
+  /// kernel but not the shapes of its inputs. Such kernels are prepared when
+  /// the runtime program is built, concurrently with each other.
+  virtual bool CanPrepareAhead() const { return false; }
+
+  /// Run `PrepareForRun` before the first `Launch`.
+  void PrepareAhead() {
+    if (is_first_epoch_) {
+      PrepareForRun();
+      is_first_epoch_ = false;
+    }
+  }
+
+  /// Pack the weights into the layout used by `Run`, it's used by opt to save
+  /// the packed weights into the optimized model instead of the original ones.
+  /// Return the tag of the layout which includes the ISA, or an empty string
+  /// if the kernel doesn't repack its weights, and set `argument` to the input
+  /// argument of the original weights.
+  virtual std::string PackWeights(Tensor* packed_weights,
+                                  std::string* argument) {
+    return "";
+  }
+
+  /// Set the packed weights loaded from the optimized model, `PrepareForRun`
+  /// uses them instead of repacking if the layout tag matches the one of the
+  /// running CPU. Otherwise the kernel restores the original weights from the
+  /// packed ones if they are not saved in the model, and repacks them.
+  void SetPackedWeights(const Tensor* packed_weights,
+                        const std::string& packed_weights_layout) {
+    packed_weights_ = packed_weights;
+    packed_weights_layout_ = packed_weights_layout;
+  }
+
   /// Run kernel initialization if needed at every run (eg. input shape changed)
   virtual void ReInitWhenNeeded() {}
 
@@ -106,6 +149,9 @@ class KernelBase {
 #if defined(LITE_WITH_MLU)
     WorkSpace::Global_MLU().AllocReset();
 #endif
+#if defined(LITE_WITH_ARM)
+    DeviceInfo::Global().ResetWorkspaceRequest();
+#endif
 
 #ifdef LITE_WITH_PROFILE
     if (!is_kernel_test_) {
@@ -123,9 +169,29 @@ class KernelBase {
 
 #else
     Run();
+#endif
+    // Record the scratch high-water mark of this kernel, it is used to
+    // pre-size the workspace after the warm-up run.
+    workspace_peak_ =
+        (std::max)(workspace_peak_, WorkSpace::Global_Host().used());
+#if defined(LITE_WITH_ARM)
+    // Most of the arm kernels get their scratch by `ExtendWorkspace`.
+    extended_workspace_peak_ = (std::max)(
+        extended_workspace_peak_, DeviceInfo::Global().workspace_request());
+#endif
+#ifdef LITE_WITH_PROFILE
+    if (!is_kernel_test_) {
+      profiler_->GetOpCharacter(profile_id_)->workspace_size =
+          workspace_peak_ + extended_workspace_peak_;
+    }
 #endif
   }
 
+  // The maximum bytes of the host workspace used by a single `Run`.
+  size_t workspace_peak() const { return workspace_peak_; }
+  // The maximum size requested by `ExtendWorkspace` in a single `Run`.
+  size_t extended_workspace_peak() const { return extended_workspace_peak_; }
+
   void SetContext(std::unique_ptr<KernelContext>&& ctx) {
     ctx_ = std::move(ctx);
   }
@@ -208,6 +274,10 @@ class KernelBase {
   // is the unique ID for the kernel.
   std::string alias_{};
   bool is_first_epoch_{true};
+  size_t workspace_peak_{0};
+  size_t extended_workspace_peak_{0};
+  const Tensor* packed_weights_{nullptr};
+  std::string packed_weights_layout_{};
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_{nullptr};
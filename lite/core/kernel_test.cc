@@ -42,6 +42,38 @@ TEST(Kernel, test) {
   ASSERT_EQ(test_code, 100);
 }
 
+class ScratchKernel : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {
+    auto* data = WorkSpace::Global_Host().Alloc(1000);
+    CHECK(data);
+#ifdef LITE_WITH_ARM
+    CHECK(DeviceInfo::Global().ExtendWorkspace(2000));
+#endif
+  }
+};
+
+TEST(Kernel, workspace_peak) {
+#ifdef LITE_WITH_ARM
+  DeviceInfo::Init();
+#endif
+  ScratchKernel kernel;
+  EXPECT_EQ(kernel.workspace_peak(), 0UL);
+  kernel.Launch();
+  // The allocation is aligned up.
+  EXPECT_GE(kernel.workspace_peak(), 1000UL);
+  EXPECT_EQ(WorkSpace::Global_Host().used(), kernel.workspace_peak());
+#ifdef LITE_WITH_ARM
+  EXPECT_EQ(kernel.extended_workspace_peak(), 2000UL);
+#else
+  EXPECT_EQ(kernel.extended_workspace_peak(), 0UL);
+#endif
+  // The workspace is reset before each run, the peak isn't accumulated.
+  size_t peak = kernel.workspace_peak();
+  kernel.Launch();
+  EXPECT_EQ(kernel.workspace_peak(), peak);
+}
+
 TEST(Kernel, kernel_type) {
   const std::string op_type = "fc";
   const std::string alias = "def";
@@ -58,5 +58,39 @@ TEST(tensor, shared_memory) {
 #endif
 }
 
+TEST(tensor, share_data_copy_on_write) {
+  const std::vector<float> data({0, 1, 2, 3});
+  TensorLite a;
+  a.Assign<float, DDim, TargetType::kHost>(data.data(), DDim({2, 2}));
+  TensorLite b;
+  TensorLite c;
+  b.ShareDataCopyOnWrite(&a);
+  c.ShareDataCopyOnWrite(&b);
+  EXPECT_EQ(b.data<float>(), a.data<float>());
+  EXPECT_EQ(c.data<float>(), a.data<float>());
+  EXPECT_EQ(c.dims(), a.dims());
+
+  // Writing a tensor copies the data, the others keep reading the original.
+  const float* original = a.data<float>();
+  float* b_data = b.mutable_data<float>();
+  EXPECT_NE(b_data, original);
+  b_data[0] = 10;
+  EXPECT_EQ(a.data<float>(), original);
+  EXPECT_EQ(a.data<float>()[0], 0);
+  EXPECT_EQ(c.data<float>()[0], 0);
+  EXPECT_EQ(b.data<float>()[3], 3);
+
+  // So does the first one of the tensors, its data is dropped once the last
+  // reader writes its own copy.
+  a.mutable_data<float>()[1] = 11;
+  TensorLite d;
+  d.Resize({2, 2});
+  d.mutable_data<float>()[0] = 20;
+  c.CopyDataFrom(d);
+  EXPECT_EQ(a.data<float>()[1], 11);
+  EXPECT_EQ(b.data<float>()[1], 1);
+  EXPECT_EQ(c.data<float>()[0], 20);
+}
+
 }  // namespace lite
 }  // namespace paddle
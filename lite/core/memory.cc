@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/core/memory.h"
+#include "lite/core/allocator.h"
 
 #ifdef LITE_WITH_METAL
 #include "lite/backends/metal/target_wrapper.h"
@@ -22,13 +23,88 @@
 namespace paddle {
 namespace lite {
 
+void LazyBuffer::ResetLazy(TargetType target, size_t size) {
+  if (target != target_ || space_ < size) {
+    // The buffer is reallocated, the pending content is dropped.
+    Free();
+  }
+  Buffer::ResetLazy(target, size);
+}
+
+void LazyBuffer::CopyDataFrom(const Buffer& other, size_t nbytes) {
+  Free();
+  Buffer::CopyDataFrom(other, nbytes);
+}
+
+void LazyBuffer::Free() {
+  std::call_once(once_, [this] {
+    materialized_ = true;
+    loader_ = nullptr;
+  });
+  Buffer::Free();
+}
+
+void LazyBuffer::Materialize() const {
+  std::call_once(once_, [this] {
+    auto* self = const_cast<LazyBuffer*>(this);
+    self->data_ = TargetMalloc(target_, space_);
+    if (space_ > 0) {
+      loader_(self->data_, space_);
+    }
+    loader_ = nullptr;
+    materialized_ = true;
+  });
+}
+
+CopyOnWriteBuffer::CopyOnWriteBuffer(std::shared_ptr<Buffer> source) {
+  // Share the source of a buffer still shared, so the buffers reading the
+  // same content are independent of each other.
+  source_ = source->shared()
+                ? static_cast<CopyOnWriteBuffer*>(source.get())->source_
+                : source;
+  data_ = source_->data();
+  target_ = source_->target();
+  space_ = source_->space();
+  own_data_ = false;
+}
+
+void CopyOnWriteBuffer::ResetLazy(TargetType target, size_t size) {
+  if (source_) {
+    auto source = source_;
+    Unshare();
+    const size_t nbytes = source->space();
+    target_ = source->target();
+    Buffer::ResetLazy(target_, (std::max)(size, nbytes));
+    TargetCopy(target_, data_, source->data(), nbytes);
+  }
+  Buffer::ResetLazy(target, size);
+}
+
+void CopyOnWriteBuffer::CopyDataFrom(const Buffer& other, size_t nbytes) {
+  Unshare();
+  Buffer::CopyDataFrom(other, nbytes);
+}
+
+void CopyOnWriteBuffer::Free() {
+  Unshare();
+  Buffer::Free();
+}
+
+void CopyOnWriteBuffer::Unshare() {
+  if (!source_) return;
+  source_.reset();
+  data_ = nullptr;
+  space_ = 0;
+  own_data_ = true;
+}
+
 void* TargetMalloc(TargetType target, size_t size) {
   void* data{nullptr};
   switch (target) {
     case TargetType::kHost:
     case TargetType::kX86:
     case TargetType::kARM:
-      data = TargetWrapper<TARGET(kHost)>::Malloc(size);
+      data = AllocatorRegistry::Global().Malloc(size);
       break;
 #ifdef LITE_WITH_CUDA
     case TargetType::kCUDA:
@@ -77,7 +153,7 @@ void TargetFree(TargetType target, void* data, std::string free_flag) {
     case TargetType::kHost:
     case TargetType::kX86:
     case TargetType::kARM:
-      TargetWrapper<TARGET(kHost)>::Free(data);
+      AllocatorRegistry::Global().Free(data);
       break;
 
 #ifdef LITE_WITH_CUDA
@@ -14,6 +14,9 @@
 
 #pragma once
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
@@ -130,10 +133,20 @@ class Buffer {
   Buffer(void* data, TargetType target, size_t size)
       : space_(size), data_(data), own_data_(false), target_(target) {}
 
-  void* data() const { return data_; }
+  void* data() const {
+    if (lazy_) {
+      Materialize();
+    }
+    return data_;
+  }
   TargetType target() const { return target_; }
   size_t space() const { return space_; }
   bool own_data() const { return own_data_; }
+  // Whether it is a lazy buffer whose content is not produced yet.
+  virtual bool pending() const { return false; }
+  // Whether the content is shared with other buffers until it is written, see
+  // CopyOnWriteBuffer.
+  virtual bool shared() const { return false; }
 
   virtual void ResetLazy(TargetType target, size_t size) {
     if (target != target_ || space_ < size) {
@@ -243,7 +256,7 @@ class Buffer {
     target_ = other.target_;
     ResizeLazy(nbytes);
     // TODO(Superjomn) support copy between different targets.
-    TargetCopy(target_, data_, other.data_, nbytes);
+    TargetCopy(target_, data_, other.data(), nbytes);
   }
 
   virtual ~Buffer() { Free(); }
@@ -253,6 +266,12 @@ class Buffer {
   Buffer(Buffer&&) = default;
 
  protected:
+  // Produces the content of a lazy buffer, see LazyBuffer.
+  virtual void Materialize() const {}
+  // Set only in the ctor of the subclasses, so it is safe to read it from
+  // several threads.
+  bool lazy_{false};
+
   // memory it actually malloced.
   size_t space_{0};
   bool cl_use_image2d_{false};   // only used for OpenCL Image2D
@@ -273,5 +292,62 @@ class Buffer {
   TargetType target_{TargetType::kHost};
 };
 
+// A buffer whose content is produced by `loader` on the first access to
+// data(), e.g. a weight which is read or dequantized only when a kernel uses
+// it. The space is reserved at construction, the memory is allocated when the
+// buffer is materialized. It is safe to materialize it from several threads.
+class LazyBuffer : public Buffer {
+ public:
+  using Loader = std::function<void(void* dst, size_t size)>;
+
+  LazyBuffer(TargetType target, size_t size, Loader loader)
+      : loader_(std::move(loader)) {
+    lazy_ = true;
+    target_ = target;
+    space_ = size;
+  }
+  ~LazyBuffer() {
+    if (!materialized_) {
+      space_ = 0;
+    }
+  }
+
+  void ResetLazy(TargetType target, size_t size) override;
+  void CopyDataFrom(const Buffer& other, size_t nbytes) override;
+  void Free() override;
+
+  bool materialized() const { return materialized_; }
+  bool pending() const override { return !materialized_; }
+
+ protected:
+  void Materialize() const override;
+
+ private:
+  mutable std::once_flag once_;
+  mutable Loader loader_;
+  mutable bool materialized_{false};
+};
+
+// A buffer reading the content of `source` until it is written, i.e. reset by
+// ResetLazy or CopyDataFrom, when the content is copied into a buffer of its
+// own. It is used to share the identical weights of several models while the
+// kernels transforming their weights in place write their own copies.
+class CopyOnWriteBuffer : public Buffer {
+ public:
+  explicit CopyOnWriteBuffer(std::shared_ptr<Buffer> source);
+
+  void ResetLazy(TargetType target, size_t size) override;
+  void CopyDataFrom(const Buffer& other, size_t nbytes) override;
+  void Free() override;
+
+  bool shared() const override { return source_ != nullptr; }
+
+ private:
+  // Stop reading the source, the buffer is empty then.
+  void Unshare();
+
+  std::shared_ptr<Buffer> source_;
+};
+
 }  // namespace lite
 }  // namespace paddle
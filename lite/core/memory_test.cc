@@ -14,6 +14,10 @@
 
 #include "lite/core/memory.h"
 #include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
 
 namespace paddle {
 namespace lite {
@@ -36,5 +40,48 @@ TEST(memory, test) {
 #endif
 }
 
+TEST(memory, lazy_buffer) {
+  int loads = 0;
+  auto loader = [&](void* dst, size_t size) {
+    ++loads;
+    std::memset(dst, 7, size);
+  };
+
+  LazyBuffer buf(TARGET(kHost), 16, loader);
+  EXPECT_FALSE(buf.materialized());
+  EXPECT_TRUE(buf.pending());
+  EXPECT_EQ(buf.space(), 16u);
+  // Resizing within the space keeps the pending content.
+  buf.ResizeLazy(8);
+  EXPECT_EQ(loads, 0);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] { ASSERT_TRUE(buf.data()); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(loads, 1);
+  EXPECT_TRUE(buf.materialized());
+  EXPECT_FALSE(buf.pending());
+  EXPECT_EQ(static_cast<char*>(buf.data())[15], 7);
+
+  // Growing an unmaterialized buffer drops the content and never loads it.
+  LazyBuffer grown(TARGET(kHost), 16, loader);
+  grown.ResizeLazy(32);
+  EXPECT_FALSE(grown.pending());
+  ASSERT_TRUE(grown.data());
+  EXPECT_EQ(loads, 1);
+
+  // An unused buffer is never loaded.
+  { LazyBuffer unused(TARGET(kHost), 16, loader); }
+  EXPECT_EQ(loads, 1);
+
+  // A plain buffer is never pending.
+  Buffer plain;
+  EXPECT_FALSE(plain.pending());
+}
+
 }  // namespace lite
 }  // namespace paddle
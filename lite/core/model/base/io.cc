@@ -13,6 +13,12 @@
 // limitations under the License.
 
 #include "lite/core/model/base/io.h"
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace paddle {
 namespace lite {
@@ -41,7 +47,8 @@ std::string ByteReader::ReadToString(size_t size) const {
   return tmp;
 }
 
-BinaryFileReader::BinaryFileReader(const std::string& path, size_t offset) {
+BinaryFileReader::BinaryFileReader(const std::string& path, size_t offset)
+    : path_(path) {
   file_ = fopen(path.c_str(), "rb");
   CHECK(file_) << "Unable to open file: " << path;
   fseek(file_, 0L, SEEK_END);
@@ -63,6 +70,45 @@ void BinaryFileWriter::Write(const void* src, size_t size) const {
   cur_ += size;
 }
 
+MappedFile::MappedFile(const std::string& path) {
+#if !defined(_WIN32)
+  int fd = open(path.c_str(), O_RDONLY);
+  CHECK_GE(fd, 0) << "Unable to open file: " << path;
+  struct stat st;
+  CHECK_EQ(fstat(fd, &st), 0) << "Unable to stat file: " << path;
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ > 0) {
+    // Private writable mapping: kernels which rewrite their weights in place
+    // only copy the touched pages, the rest stays shared.
+    void* addr =
+        mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      data_ = addr;
+      mapped_ = true;
+    }
+  }
+  close(fd);
+  if (mapped_ || size_ == 0) {
+    return;
+  }
+  LOG(WARNING) << "Failed to map " << path << ", fall back to reading it.";
+#endif
+  BinaryFileReader reader(path);
+  size_ = reader.length();
+  buf_.reset(new lite::Buffer);
+  buf_->ResetLazy(TargetType::kHost, size_);
+  data_ = buf_->data();
+  reader.Read(data_, size_);
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32)
+  if (mapped_) {
+    munmap(data_, size_);
+  }
+#endif
+}
+
 void StringBufferReader::Read(void* dst, size_t size) const {
   CHECK(dst);
   lite::TargetCopy(TargetType::kHost, dst, buf_ + cur_, size);
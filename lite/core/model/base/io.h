@@ -138,13 +138,37 @@ class BinaryFileReader : public ByteReader {
   bool ReachEnd() const override { return cur_ >= length_; }
   size_t length() const override { return length_; }
   size_t current() const override { return cur_; }
+  const std::string& path() const { return path_; }
 
  private:
   FILE* file_{};
+  std::string path_;
   size_t length_{0};
   mutable size_t cur_{0};
 };
 
+// Maps a whole file into memory with copy-on-write semantics, so processes
+// loading the same file share its pages in the page cache. On platforms
+// without mmap the content of the file is read into an owned buffer.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  void* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool mapped() const { return mapped_; }
+
+ private:
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  void* data_{nullptr};
+  size_t size_{0};
+  bool mapped_{false};
+  std::unique_ptr<lite::Buffer> buf_;
+};
+
 class BinaryFileWriter : public ByteWriter {
  public:
   explicit BinaryFileWriter(const std::string& path) {
@@ -76,6 +76,16 @@ std::vector<std::unique_ptr<KernelBase>> OpLite::CreateKernels(
             << place.DebugString() << " get " << ks.size() << " kernels";
     for (auto &&it : ks) {
       AttachKernel(it.get());
+      // Use the weights packed by opt if any
+      if (op_info()->HasAttr(kPackedWeightsAttr)) {
+        auto packed_weights = scope_->FindTensor(
+            op_info()->GetAttr<std::string>(kPackedWeightsAttr));
+        if (packed_weights) {
+          it->SetPackedWeights(
+              packed_weights,
+              op_info()->GetAttr<std::string>(kPackedWeightsLayoutAttr));
+        }
+      }
       kernels.emplace_back(std::move(it));
     }
   };
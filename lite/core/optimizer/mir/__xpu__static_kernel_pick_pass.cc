@@ -85,15 +85,11 @@ void XPUStaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     std::map<std::string, PrecisionType> out_types;
     // threse precision info store in __model__ file, if selected fp16 kernel,
     // the output precision should be changed
-    for (std::list<Node*>::iterator i = node->inlinks.begin();
-         i != node->inlinks.end();
-         ++i) {
+    for (auto i = node->inlinks.begin(); i != node->inlinks.end(); ++i) {
       if ((*i)->arg()->type)
         in_types[(*i)->arg()->name] = (*i)->arg()->type->precision();
     }
-    for (std::list<Node*>::iterator i = node->outlinks.begin();
-         i != node->outlinks.end();
-         ++i) {
+    for (auto i = node->outlinks.begin(); i != node->outlinks.end(); ++i) {
       if ((*i)->arg()->type)
         out_types[(*i)->arg()->name] = (*i)->arg()->type->precision();
     }
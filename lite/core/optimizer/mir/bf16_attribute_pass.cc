@@ -0,0 +1,139 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "lite/core/optimizer/mir/bf16_attribute_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/context.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+bool GetBoolAttr(const OpInfo& op_info, const std::string& name) {
+  return op_info.HasAttr(name) && op_info.GetAttr<bool>(name);
+}
+
+bool IsBF16Stmt(Node* node) {
+  if (!node->IsStmt()) return false;
+  auto& kernel = node->AsStmt().picked_kernel();
+  return kernel.target() == TARGET(kX86) &&
+         kernel.precision() == PRECISION(kBF16);
+}
+
+// Replace the bf16 kernel of `inst` with the fp32 one of the same op.
+void UseFP32Kernel(Node::Stmt* inst) {
+  auto kernel_type = KernelBase::SerializeKernelType(
+      inst->op_type(), "def", Place{TARGET(kX86), PRECISION(kFloat)});
+  auto kernels = inst->op()->CreateKernels({}, kernel_type);
+  kernels.front()->SetContext(
+      ContextScheduler::Global().NewContext(TARGET(kX86), inst->stream_id_));
+  kernels.resize(1);
+  inst->SetKernels(std::move(kernels));
+}
+}  // namespace
+
+std::vector<std::string> BF16AttributePass::BF16Weights(Node::Stmt* inst) {
+  std::vector<std::string> weight_names;
+  const std::string op_type = inst->op_type();
+  auto iter = std::find_if(
+      bf16_weights_.begin(),
+      bf16_weights_.end(),
+      [&](const std::pair<std::string, std::string>& weight) {
+        return weight.first == op_type;
+      });
+  if (iter == bf16_weights_.end()) return weight_names;
+  const OpInfo* op_info = inst->op_info();
+  // matmul and matmul_v2 only keep a 2-D, non transposed y in bf16, see
+  // GetBF16GemmArgs() of the x86 kernels.
+  if (op_type == "matmul" || op_type == "matmul_v2") {
+    bool v2 = op_type == "matmul_v2";
+    if (GetBoolAttr(*op_info, v2 ? "trans_x" : "transpose_X") ||
+        GetBoolAttr(*op_info, v2 ? "trans_y" : "transpose_Y")) {
+      return weight_names;
+    }
+  }
+  auto* scope = inst->op()->scope();
+  for (auto& weight_name : op_info->Input(iter->second)) {
+    auto* var = scope->FindVar(weight_name);
+    if (var == nullptr) continue;
+    auto* weight = var->GetMutable<Tensor>();
+    if (!weight->persistable() || weight->precision() != PRECISION(kFloat)) {
+      continue;
+    }
+    if (op_type != "fc" && op_type != "mul" && weight->dims().size() != 2) {
+      continue;
+    }
+    weight_names.push_back(weight_name);
+  }
+  return weight_names;
+}
+
+void BF16AttributePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The weights each bf16 kernel would keep in bf16.
+  std::map<Node*, std::vector<std::string>> bf16_stmts;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (IsBF16Stmt(node)) {
+      bf16_stmts[node] = BF16Weights(&node->AsStmt());
+    }
+  }
+  // The weights are converted in place, so a weight is only kept in bf16 if
+  // all of its consumers are bf16 kernels taking it as their bf16 weight,
+  // e.g. not if it is also the table of a lookup_table.
+  std::set<std::string> shared_weight_names;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsArg()) continue;
+    const std::string& name = node.AsArg().name;
+    for (auto* consumer : node.outlinks) {
+      auto iter = bf16_stmts.find(consumer);
+      if (iter == bf16_stmts.end() ||
+          std::find(iter->second.begin(), iter->second.end(), name) ==
+              iter->second.end()) {
+        shared_weight_names.insert(name);
+        break;
+      }
+    }
+  }
+  for (auto& item : bf16_stmts) {
+    auto& inst = item.first->AsStmt();
+    bool shared = false;
+    for (auto& weight_name : item.second) {
+      if (!shared_weight_names.count(weight_name)) {
+        inst.mutable_op_info()->SetAttr<std::string>(weight_name + "_bf16",
+                                                     "bf16");
+      } else {
+        shared = true;
+      }
+    }
+    // The bf16 kernel would convert the weight shared with the fp32 kernels.
+    if (shared) {
+      VLOG(4) << "Keep the fp32 weight of " << inst.op_type()
+              << " shared with other kernels";
+      UseFP32Kernel(&inst);
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(bf16_attribute_pass, paddle::lite::mir::BF16AttributePass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,47 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Marks the weights of the x86 kernels picked in kBF16, adding the attribute
+ * weight_name_bf16 to their op. The model keeps fp32 weights, and the light
+ * predictor converts the marked ones to bf16 when loading it, the same way
+ * as fp16_attribute_pass does for arm. A weight shared with other kernels,
+ * which would read the bf16 data as fp32, is not marked, and the bf16 kernels
+ * using it are replaced with the fp32 ones.
+ */
+class BF16AttributePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // The weights the bf16 kernel of `inst` keeps in bf16.
+  std::vector<std::string> BF16Weights(Node::Stmt* inst);
+
+  // The weight argument of each op having a bf16 kernel.
+  std::vector<std::pair<std::string, std::string>> bf16_weights_{
+      {"fc", "W"}, {"mul", "Y"}, {"matmul", "Y"}, {"matmul_v2", "Y"}};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,326 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <algorithm>
+#include <set>
+#include <utility>
+#include "lite/core/context.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The ops never folded: io, control flow and the ops with random outputs.
+static const std::set<std::string> kUnfoldableOps{"feed",
+                                                  "fetch",
+                                                  "io_copy",
+                                                  "io_copy_once",
+                                                  "while",
+                                                  "conditional_block",
+                                                  "dropout",
+                                                  "uniform_random",
+                                                  "gaussian_random",
+                                                  "randint",
+                                                  "randperm",
+                                                  "sampling_id",
+                                                  "print"};
+
+// The ops reading only the dims of their input.
+static const std::set<std::string> kShapeOps{"shape", "size"};
+
+// The folded outputs growing beyond this number of elements, and larger than
+// the inputs, are kept computed at runtime to not bloat the model.
+static const int64_t kMaxFoldedNumel = 1 << 20;
+
+static Tensor* GetTensor(Scope* scope, const std::string& name) {
+  auto* var = scope->FindVar(name);
+  if (var == nullptr || !var->IsType<lite::Tensor>()) return nullptr;
+  return var->GetMutable<lite::Tensor>();
+}
+
+static bool IsStaticShape(const DDim& dims) {
+  if (dims.empty()) return false;
+  for (size_t i = 0; i < dims.size(); i++) {
+    if (dims[i] <= 0) return false;
+  }
+  return true;
+}
+
+void ConstantFoldingPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  producers_.clear();
+  partial_shapes_.clear();
+  auto nodes = graph->StmtTopologicalOrder();
+  for (auto* node : nodes) {
+    if (!node->IsStmt()) continue;
+    for (auto* out : node->outlinks) {
+      producers_[out->AsArg().name]++;
+    }
+  }
+
+  int num_folded = 0;
+  for (auto* node : nodes) {
+    if (!node->IsStmt()) continue;
+    const auto op_type = node->AsStmt().op_type();
+    if (fold_partial_shapes_ && op_type == "shape") {
+      auto* scope = node->AsStmt().op()->scope();
+      auto* in = GetTensor(scope, node->inlinks.front()->AsArg().name);
+      if (in != nullptr && !in->dims().empty()) {
+        partial_shapes_[node->outlinks.front()->AsArg().name] =
+            in->dims().Vectorize();
+      }
+    }
+    bool folded = false;
+    if (op_type == "slice") {
+      folded = FoldSliceOfShape(node);
+    }
+    if (!folded && IsFoldable(node)) {
+      folded = op_type == "shape" ? FoldShape(node) : FoldByKernel(node);
+    }
+    if (folded) {
+      VLOG(4) << "Fold " << op_type << " into constants";
+      RemoveFoldedNode(graph.get(), node);
+      num_folded++;
+    }
+  }
+
+  // The shape ops left without consumers once their slices were folded.
+  std::set<const Node*> nodes2rm;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsStmt() || node.AsStmt().op_type() != "shape") continue;
+    if (node.outlinks.size() != 1 || !node.outlinks.front()->outlinks.empty()) {
+      continue;
+    }
+    if (producers_[node.outlinks.front()->AsArg().name] != 1) continue;
+    nodes2rm.insert(&node);
+    nodes2rm.insert(node.outlinks.front());
+  }
+  GraphSafeRemoveNodes(graph.get(), nodes2rm);
+  VLOG(3) << "Fold " << num_folded << " ops into constants, remove "
+          << nodes2rm.size() / 2 << " unused shape ops";
+}
+
+bool ConstantFoldingPass::IsConstant(Node* arg_node, Scope* scope) {
+  // The var written somewhere, e.g. a state updated in place, is not constant
+  // even if it is read before any write.
+  if (!arg_node->inlinks.empty() || producers_.count(arg_node->AsArg().name)) {
+    return false;
+  }
+  auto* tensor = GetTensor(scope, arg_node->AsArg().name);
+  return tensor != nullptr && tensor->persistable() &&
+         tensor->IsInitialized();
+}
+
+bool ConstantFoldingPass::IsOutputFoldable(Node* node) {
+  auto* scope = node->AsStmt().op()->scope();
+  bool has_consumers = false;
+  for (auto* out : node->outlinks) {
+    const auto& name = out->AsArg().name;
+    auto* tensor = GetTensor(scope, name);
+    if (tensor == nullptr || tensor->persistable() || producers_[name] != 1) {
+      return false;
+    }
+    for (auto* consumer : out->outlinks) {
+      // Keep the fetched outputs, and the vars updated by the consumers, such
+      // as the loop counters of the control flow ops.
+      auto* consumer_info = consumer->AsStmt().op_info();
+      if (consumer_info->Type() == "fetch" ||
+          consumer_info->HasAttr("sub_block")) {
+        return false;
+      }
+      auto consumer_outs = consumer_info->output_names();
+      if (std::find(consumer_outs.begin(), consumer_outs.end(), name) !=
+          consumer_outs.end()) {
+        return false;
+      }
+      has_consumers = true;
+    }
+  }
+  return has_consumers;
+}
+
+bool ConstantFoldingPass::IsFoldable(Node* node) {
+  auto& stmt = node->AsStmt();
+  const auto op_type = stmt.op_type();
+  auto* op_info = stmt.op_info();
+  if (kUnfoldableOps.count(op_type) || op_type.find("fake_") == 0 ||
+      op_info->HasAttr("sub_block") || op_info->HasAttr("enable_int8")) {
+    return false;
+  }
+  auto* scope = stmt.op()->scope();
+  for (auto* in : node->inlinks) {
+    if (IsConstant(in, scope)) continue;
+    auto* tensor = GetTensor(scope, in->AsArg().name);
+    if (fold_partial_shapes_ && kShapeOps.count(op_type) &&
+        tensor != nullptr && IsStaticShape(tensor->dims())) {
+      continue;
+    }
+    return false;
+  }
+  return IsOutputFoldable(node);
+}
+
+bool ConstantFoldingPass::FoldShape(Node* node) {
+  auto* scope = node->AsStmt().op()->scope();
+  auto* in = GetTensor(scope, node->inlinks.front()->AsArg().name);
+  auto* out = GetTensor(scope, node->outlinks.front()->AsArg().name);
+  auto dims = in->dims();
+  out->Resize(DDim(std::vector<int64_t>{static_cast<int64_t>(dims.size())}));
+  auto* out_data = out->mutable_data<int32_t>();
+  for (size_t i = 0; i < dims.size(); i++) {
+    out_data[i] = static_cast<int32_t>(dims[i]);
+  }
+  return true;
+}
+
+bool ConstantFoldingPass::FoldSliceOfShape(Node* node) {
+  auto* op_info = node->AsStmt().op_info();
+  if (node->inlinks.size() != 1 || op_info->input_names().size() != 1 ||
+      node->outlinks.size() != 1) {
+    return false;
+  }
+  const auto in_name = node->inlinks.front()->AsArg().name;
+  auto iter = partial_shapes_.find(in_name);
+  if (iter == partial_shapes_.end() || producers_[in_name] > 1 ||
+      !op_info->HasAttr("axes") || !op_info->HasAttr("starts") ||
+      !op_info->HasAttr("ends")) {
+    return false;
+  }
+  auto axes = op_info->GetAttr<std::vector<int>>("axes");
+  auto starts = op_info->GetAttr<std::vector<int>>("starts");
+  auto ends = op_info->GetAttr<std::vector<int>>("ends");
+  if (axes != std::vector<int>{0} || starts.size() != 1 || ends.size() != 1) {
+    return false;
+  }
+  const auto& shape = iter->second;
+  const int rank = static_cast<int>(shape.size());
+  int start = starts[0] < 0 ? starts[0] + rank : starts[0];
+  int end = ends[0] < 0 ? ends[0] + rank : ends[0];
+  start = std::min(std::max(start, 0), rank);
+  end = std::min(std::max(end, 0), rank);
+  if (start >= end) return false;
+  for (int i = start; i < end; i++) {
+    if (shape[i] <= 0) return false;
+  }
+  bool decrease = op_info->HasAttr("decrease_axis") &&
+                  !op_info->GetAttr<std::vector<int>>("decrease_axis").empty();
+  if ((decrease && end - start != 1) || !IsOutputFoldable(node)) return false;
+
+  auto* scope = node->AsStmt().op()->scope();
+  auto* out = GetTensor(scope, node->outlinks.front()->AsArg().name);
+  out->Resize(DDim(std::vector<int64_t>{end - start}));
+  auto* out_data = out->mutable_data<int32_t>();
+  for (int i = start; i < end; i++) {
+    out_data[i - start] = static_cast<int32_t>(shape[i]);
+  }
+  return true;
+}
+
+bool ConstantFoldingPass::FoldByKernel(Node* node) {
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
+  // The kernels are faked in the opt tool, only the shape ops are folded.
+  return false;
+#else
+  auto& stmt = node->AsStmt();
+  auto* op_info = stmt.op_info();
+  auto* scope = stmt.op()->scope();
+  // Pick the first kernel running on the host memory and accepting the
+  // precisions of the inputs, the kernels are in the order of valid places.
+  KernelBase* kernel = nullptr;
+  for (auto& candidate : stmt.kernels()) {
+    if (candidate->target() != TARGET(kHost) &&
+        candidate->target() != TARGET(kX86) &&
+        candidate->target() != TARGET(kARM)) {
+      continue;
+    }
+    if (candidate->layout() != DATALAYOUT(kNCHW) &&
+        candidate->layout() != DATALAYOUT(kAny)) {
+      continue;
+    }
+    bool matched = true;
+    for (auto* in : node->inlinks) {
+      std::string arg_name;
+      CHECK(op_info->GetInputArgname(in->AsArg().name, &arg_name));
+      auto precision = GetTensor(scope, in->AsArg().name)->precision();
+      auto decl_precision = candidate->GetInputDeclType(arg_name)->precision();
+      if (precision != PRECISION(kUnk) && decl_precision != PRECISION(kAny) &&
+          decl_precision != precision) {
+        matched = false;
+        break;
+      }
+    }
+    if (matched) {
+      kernel = candidate.get();
+      break;
+    }
+  }
+  if (kernel == nullptr) return false;
+
+  auto op = stmt.op();
+  std::vector<DDim> out_dims;
+  for (auto* out : node->outlinks) {
+    out_dims.push_back(GetTensor(scope, out->AsArg().name)->dims());
+  }
+  if (!op->CheckShape() || !op->InferShape()) return false;
+  int64_t in_numel = 0;
+  int64_t out_numel = 0;
+  for (auto* in : node->inlinks) {
+    in_numel += GetTensor(scope, in->AsArg().name)->numel();
+  }
+  for (auto* out : node->outlinks) {
+    out_numel += GetTensor(scope, out->AsArg().name)->numel();
+  }
+  if (out_numel > kMaxFoldedNumel && out_numel > in_numel) {
+    auto dims_iter = out_dims.begin();
+    for (auto* out : node->outlinks) {
+      GetTensor(scope, out->AsArg().name)->Resize(*dims_iter++);
+    }
+    return false;
+  }
+  kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  kernel->Launch();
+  return true;
+#endif
+}
+
+void ConstantFoldingPass::RemoveFoldedNode(SSAGraph* graph, Node* node) {
+  std::set<const Node*> nodes2rm{node};
+  for (auto* in : node->inlinks) {
+    // The weights only used by the folded op.
+    if (in->inlinks.empty() && in->outlinks.size() == 1 &&
+        in->AsArg().is_weight) {
+      nodes2rm.insert(in);
+    }
+  }
+  auto* scope = node->AsStmt().op()->scope();
+  for (auto* out : node->outlinks) {
+    if (out->outlinks.empty()) {
+      nodes2rm.insert(out);
+      continue;
+    }
+    GetTensor(scope, out->AsArg().name)->set_persistable(true);
+    out->AsArg().is_weight = true;
+    // Written by nobody now, so constant to the consumers.
+    producers_.erase(out->AsArg().name);
+  }
+  GraphSafeRemoveNodes(graph, nodes2rm);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(constant_folding_pass, paddle::lite::mir::ConstantFoldingPass)
+    .BindTargets({TARGET(kHost), TARGET(kX86), TARGET(kARM)});
@@ -0,0 +1,70 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+#include "lite/core/types.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Evaluates at optimization time every op whose inputs are all constants,
+ * i.e. persistable tensors or outputs of the ops folded before, with the
+ * host, x86 or arm kernel the op already holds. The folded op is removed from
+ * the graph and its outputs become persistable weights, so a chain such as
+ *   shape -> slice -> concat -> reshape2
+ * over the weights collapses into a single weight feeding the consumers.
+ * The dims of the other vars come from the var descs, which are only hints
+ * for the analysis, e.g. a model exported with a static feed shape may be fed
+ * with another one. Folding the shape ops over them, and the `slice` of the
+ * static dims of such a shape, is therefore enabled only on demand by
+ * SetFoldPartialShapes(true), for the models whose shapes are known fixed.
+ */
+class ConstantFoldingPass : public mir::StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  void SetFoldPartialShapes(bool fold_partial_shapes) {
+    fold_partial_shapes_ = fold_partial_shapes;
+  }
+
+ private:
+  bool IsConstant(Node* arg_node, Scope* scope);
+  bool IsOutputFoldable(Node* node);
+  bool IsFoldable(Node* node);
+  bool FoldShape(Node* node);
+  bool FoldSliceOfShape(Node* node);
+  bool FoldByKernel(Node* node);
+  void RemoveFoldedNode(SSAGraph* graph, Node* node);
+
+  // The number of the ops writing each var.
+  std::map<std::string, int> producers_;
+  // The partially known shapes produced by the shape ops, -1 for unknown dims.
+  std::map<std::string, std::vector<int64_t>> partial_shapes_;
+  bool fold_partial_shapes_{false};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
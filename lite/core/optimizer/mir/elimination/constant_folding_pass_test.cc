@@ -0,0 +1,136 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "lite/core/optimizer/mir/test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+using test::AddOp;
+using test::AddVar;
+using test::CountOps;
+
+// Build feed -> x -> shape -> x_shape -> slice -> x_dim -> reshape2, where the
+// dims of x come from the var desc as in Program::PrepareWorkspace.
+void BuildFeedShapeGraph(SSAGraph* graph,
+                         Scope* scope,
+                         const std::vector<int64_t>& x_shape) {
+  auto* feed = AddVar(graph, scope, "feed", {}, false);
+  auto* x = AddVar(graph, scope, "x", x_shape, false);
+  auto* shape = AddVar(graph, scope, "x_shape", {}, false);
+  auto* dim = AddVar(graph, scope, "x_dim", {}, false);
+  auto* out = AddVar(graph, scope, "out", {}, false);
+
+  cpp::OpDesc feed_desc;
+  feed_desc.SetType("feed");
+  feed_desc.SetInput("X", {"feed"});
+  feed_desc.SetOutput("Out", {"x"});
+  feed_desc.SetAttr<int>("col", 0);
+  AddOp(graph, scope, feed_desc, {feed}, {x});
+
+  cpp::OpDesc shape_desc;
+  shape_desc.SetType("shape");
+  shape_desc.SetInput("Input", {"x"});
+  shape_desc.SetOutput("Out", {"x_shape"});
+  AddOp(graph, scope, shape_desc, {x}, {shape});
+
+  cpp::OpDesc slice_desc;
+  slice_desc.SetType("slice");
+  slice_desc.SetInput("Input", {"x_shape"});
+  slice_desc.SetOutput("Out", {"x_dim"});
+  slice_desc.SetAttr<std::vector<int>>("axes", {0});
+  slice_desc.SetAttr<std::vector<int>>("starts", {1});
+  slice_desc.SetAttr<std::vector<int>>("ends", {2});
+  AddOp(graph, scope, slice_desc, {shape}, {dim});
+
+  cpp::OpDesc reshape_desc;
+  reshape_desc.SetType("reshape2");
+  reshape_desc.SetInput("X", {"x"});
+  reshape_desc.SetInput("Shape", {"x_dim"});
+  reshape_desc.SetOutput("Out", {"out"});
+  AddOp(graph, scope, reshape_desc, {x, dim}, {out});
+}
+
+TEST(ConstantFoldingPass, fold_shape_of_weight) {
+  Scope scope;
+  std::unique_ptr<SSAGraph> graph(new SSAGraph());
+  auto* x = AddVar(graph.get(), &scope, "x", {-1, 6}, false);
+  auto* w = AddVar(graph.get(), &scope, "w", {2, 3}, true);
+  auto* w_shape = AddVar(graph.get(), &scope, "w_shape", {}, false);
+  auto* out = AddVar(graph.get(), &scope, "out", {}, false);
+
+  cpp::OpDesc shape_desc;
+  shape_desc.SetType("shape");
+  shape_desc.SetInput("Input", {"w"});
+  shape_desc.SetOutput("Out", {"w_shape"});
+  AddOp(graph.get(), &scope, shape_desc, {w}, {w_shape});
+  cpp::OpDesc reshape_desc;
+  reshape_desc.SetType("reshape2");
+  reshape_desc.SetInput("X", {"x"});
+  reshape_desc.SetInput("Shape", {"w_shape"});
+  reshape_desc.SetOutput("Out", {"out"});
+  AddOp(graph.get(), &scope, reshape_desc, {x, w_shape}, {out});
+
+  ConstantFoldingPass pass;
+  pass.Apply(graph);
+  EXPECT_EQ(CountOps(graph.get(), "shape"), 0);
+  EXPECT_EQ(CountOps(graph.get(), "reshape2"), 1);
+  auto* folded = scope.FindVar("w_shape")->GetMutable<Tensor>();
+  EXPECT_TRUE(folded->persistable());
+  ASSERT_EQ(folded->numel(), 2);
+  EXPECT_EQ(folded->data<int32_t>()[0], 2);
+  EXPECT_EQ(folded->data<int32_t>()[1], 3);
+}
+
+TEST(ConstantFoldingPass, keep_shape_of_feed) {
+  // The static dims of the var desc of a feed are no promise of the shape fed
+  // at runtime, even if fully known.
+  for (auto x_shape : std::vector<std::vector<int64_t>>{{1, 6}, {-1, 6}}) {
+    Scope scope;
+    std::unique_ptr<SSAGraph> graph(new SSAGraph());
+    BuildFeedShapeGraph(graph.get(), &scope, x_shape);
+    ConstantFoldingPass pass;
+    pass.Apply(graph);
+    EXPECT_EQ(CountOps(graph.get(), "shape"), 1);
+    EXPECT_EQ(CountOps(graph.get(), "slice"), 1);
+    EXPECT_FALSE(scope.FindVar("x_dim")->GetMutable<Tensor>()->persistable());
+  }
+}
+
+TEST(ConstantFoldingPass, fold_partial_shapes_on_demand) {
+  for (auto x_shape : std::vector<std::vector<int64_t>>{{1, 6}, {-1, 6}}) {
+    Scope scope;
+    std::unique_ptr<SSAGraph> graph(new SSAGraph());
+    BuildFeedShapeGraph(graph.get(), &scope, x_shape);
+    ConstantFoldingPass pass;
+    pass.SetFoldPartialShapes(true);
+    pass.Apply(graph);
+    EXPECT_EQ(CountOps(graph.get(), "shape"), 0);
+    EXPECT_EQ(CountOps(graph.get(), "slice"), 0);
+    EXPECT_EQ(CountOps(graph.get(), "reshape2"), 1);
+    auto* folded = scope.FindVar("x_dim")->GetMutable<Tensor>();
+    EXPECT_TRUE(folded->persistable());
+    ASSERT_EQ(folded->numel(), 1);
+    EXPECT_EQ(folded->data<int32_t>()[0], 6);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
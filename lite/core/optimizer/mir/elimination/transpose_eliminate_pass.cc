@@ -0,0 +1,227 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+bool IsTranspose(Node* node) {
+  if (!node->IsStmt()) return false;
+  auto* op_info = node->stmt()->op_info();
+  if (op_info->HasAttr("enable_int8") &&
+      op_info->GetAttr<bool>("enable_int8")) {
+    return false;
+  }
+  auto op_type = op_info->Type();
+  return op_type == "transpose" || op_type == "transpose2";
+}
+
+bool IsMatmul(Node* node) {
+  if (!node->IsStmt()) return false;
+  auto op_type = node->stmt()->op_type();
+  return op_type == "matmul" || op_type == "matmul_v2";
+}
+
+Node* FindArg(const std::list<Node*>& links, const std::string& name) {
+  for (auto* node : links) {
+    if (node->IsArg() && node->arg()->name == name) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+Node* TransposeInput(Node* transpose) {
+  auto name = transpose->stmt()->op_info()->Input("X").front();
+  return FindArg(transpose->inlinks, name);
+}
+
+Node* TransposeOutput(Node* transpose) {
+  auto name = transpose->stmt()->op_info()->Output("Out").front();
+  return FindArg(transpose->outlinks, name);
+}
+
+// Whether nothing reads the XShape of a transpose2.
+bool XShapeUnused(Node* transpose) {
+  Node* out = TransposeOutput(transpose);
+  for (auto* arg : transpose->outlinks) {
+    if (arg != out && !arg->outlinks.empty()) return false;
+  }
+  return true;
+}
+
+// The only op reading the output of a transpose, or nullptr.
+Node* SoleConsumer(Node* transpose) {
+  Node* out = TransposeOutput(transpose);
+  if (out == nullptr || out->outlinks.size() != 1 ||
+      !XShapeUnused(transpose)) {
+    return nullptr;
+  }
+  return out->outlinks.front();
+}
+
+// The rank of the arg if it is known before the shapes are inferred, from
+// a transpose producing it or from its tensor in the scope; 0 otherwise.
+size_t KnownRank(Node* arg, Scope* scope) {
+  if (arg->inlinks.size() == 1 && IsTranspose(arg->inlinks.front())) {
+    return arg->inlinks.front()
+        ->stmt()
+        ->op_info()
+        ->GetAttr<std::vector<int>>("axis")
+        .size();
+  }
+  auto* var = scope->FindVar(arg->arg()->name);
+  if (var == nullptr || !var->IsType<lite::Tensor>()) return 0;
+  return var->Get<lite::Tensor>().dims().size();
+}
+
+}  // namespace
+
+/*
+ * Removes the transposes that only shuffle the layout between two ops:
+ *
+ * - transpose -> transpose becomes one transpose with the composed axis,
+ *   or nothing if the two cancel, e.g. NCHW -> NHWC -> NCHW;
+ * - a transpose of the last two axes feeding the X (Y) of matmul or
+ *   matmul_v2 is dropped and transpose_X (transpose_Y) is flipped instead,
+ *   the gemm reads the operand transposed for free.
+ *
+ * The output of the transpose must have a single consumer and the XShape of
+ * transpose2 must be unused. Transposes of weights are left for the constant
+ * folding, which keeps the matmul -> fc fusion possible.
+ */
+class TransposeEliminatePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto* node : graph->StmtTopologicalOrder()) {
+        if (!IsTranspose(node)) continue;
+        Node* next = SoleConsumer(node);
+        if (next == nullptr) continue;
+        if (IsTranspose(next)) {
+          changed = MergeTransposes(graph.get(), node, next);
+        } else if (IsMatmul(next)) {
+          changed = AbsorbIntoMatmul(graph.get(), node, next);
+        }
+        if (changed) break;
+      }
+    }
+  }
+
+ private:
+  bool MergeTransposes(SSAGraph* graph, Node* first, Node* second) {
+    if (!XShapeUnused(second)) return false;
+    auto axis1 = first->stmt()->op_info()->GetAttr<std::vector<int>>("axis");
+    auto axis2 = second->stmt()->op_info()->GetAttr<std::vector<int>>("axis");
+    if (axis1.size() != axis2.size()) return false;
+    std::vector<int> axis(axis1.size());
+    bool identity = true;
+    for (size_t i = 0; i < axis.size(); ++i) {
+      axis[i] = axis1[axis2[i]];
+      identity = identity && axis[i] == static_cast<int>(i);
+    }
+    Node* in = TransposeInput(first);
+    Node* out = TransposeOutput(second);
+    if (in == nullptr || out == nullptr) return false;
+
+    std::set<const Node*> to_remove(first->outlinks.begin(),
+                                    first->outlinks.end());
+    to_remove.insert(first);
+    if (identity) {
+      // The consumers of the second output read the first input instead.
+      if (out->outlinks.empty()) return false;
+      std::vector<Node*> consumers(out->outlinks.begin(), out->outlinks.end());
+      for (auto* consumer : consumers) {
+        auto op_info = *consumer->stmt()->op_info();
+        op_info.UpdateAllInputs(out->arg()->name, in->arg()->name);
+        consumer->stmt()->ResetOp(op_info, graph->valid_places());
+      }
+      to_remove.insert(second->outlinks.begin(), second->outlinks.end());
+      to_remove.insert(second);
+      GraphSafeRemoveNodes(graph, to_remove);
+      for (auto* consumer : consumers) {
+        IR_NODE_LINK_TO(in, consumer);
+      }
+    } else {
+      auto op_info = *second->stmt()->op_info();
+      op_info.SetInput("X", {in->arg()->name});
+      op_info.SetAttr("axis", axis);
+      second->stmt()->ResetOp(op_info, graph->valid_places());
+      GraphSafeRemoveNodes(graph, to_remove);
+      IR_NODE_LINK_TO(in, second);
+    }
+    return true;
+  }
+
+  bool AbsorbIntoMatmul(SSAGraph* graph, Node* transpose, Node* matmul) {
+    auto axis = transpose->stmt()->op_info()->GetAttr<std::vector<int>>("axis");
+    const int rank = axis.size();
+    if (rank < 2 || axis[rank - 2] != rank - 1 || axis[rank - 1] != rank - 2) {
+      return false;
+    }
+    for (int i = 0; i < rank - 2; ++i) {
+      if (axis[i] != i) return false;
+    }
+    Node* in = TransposeInput(transpose);
+    Node* mid = TransposeOutput(transpose);
+    if (in == nullptr || in->arg()->is_weight || in->arg()->is_persist) {
+      return false;
+    }
+
+    auto op_info = *matmul->stmt()->op_info();
+    const bool is_v2 = op_info.Type() == "matmul_v2";
+    const auto& mid_name = mid->arg()->name;
+    const bool is_x = op_info.Input("X").front() == mid_name;
+    const bool is_y = op_info.Input("Y").front() == mid_name;
+    if (is_x == is_y) return false;
+    // matmul ignores the transpose flags when the other operand is 1-D.
+    Node* other =
+        FindArg(matmul->inlinks, op_info.Input(is_x ? "Y" : "X").front());
+    auto* scope = matmul->stmt()->op()->scope();
+    if (other == nullptr || KnownRank(other, scope) < 2) return false;
+
+    std::string flag = is_x ? (is_v2 ? "trans_x" : "transpose_X")
+                            : (is_v2 ? "trans_y" : "transpose_Y");
+    op_info.UpdateAllInputs(mid_name, in->arg()->name);
+    op_info.SetAttr<bool>(flag, !op_info.GetAttr<bool>(flag));
+    matmul->stmt()->ResetOp(op_info, graph->valid_places());
+
+    std::set<const Node*> to_remove(transpose->outlinks.begin(),
+                                    transpose->outlinks.end());
+    to_remove.insert(transpose);
+    GraphSafeRemoveNodes(graph, to_remove);
+    IR_NODE_LINK_TO(in, matmul);
+    return true;
+  }
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(transpose_eliminate_pass,
+                  paddle::lite::mir::TransposeEliminatePass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,166 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+using test::AddOp;
+using test::AddVar;
+using test::CountOps;
+
+// Add x -> transpose2(axis) -> out_name, with an unused XShape, and return
+// the out arg.
+Node* AddTranspose(SSAGraph* graph,
+                   Scope* scope,
+                   Node* x,
+                   const std::vector<int>& axis,
+                   const std::string& out_name) {
+  auto* out = AddVar(graph, scope, out_name, {}, false);
+  auto* xshape = AddVar(graph, scope, out_name + "_xshape", {}, false);
+  cpp::OpDesc desc;
+  desc.SetType("transpose2");
+  desc.SetInput("X", {x->AsArg().name});
+  desc.SetOutput("Out", {out_name});
+  desc.SetOutput("XShape", {out_name + "_xshape"});
+  desc.SetAttr("axis", axis);
+  AddOp(graph, scope, desc, {x}, {out, xshape});
+  return out;
+}
+
+Node* AddUnary(SSAGraph* graph,
+               Scope* scope,
+               const std::string& op_type,
+               Node* x,
+               const std::string& out_name) {
+  auto* out = AddVar(graph, scope, out_name, {}, false);
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x->AsArg().name});
+  desc.SetOutput("Out", {out_name});
+  AddOp(graph, scope, desc, {x}, {out});
+  return out;
+}
+
+const OpInfo* FindOp(SSAGraph* graph, const std::string& op_type) {
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsStmt() && node.AsStmt().op_type() == op_type) {
+      return node.AsStmt().op_info();
+    }
+  }
+  return nullptr;
+}
+
+void ApplyPass(const std::unique_ptr<SSAGraph>& graph) {
+  auto* pass = PassManager::Global().LookUp("transpose_eliminate_pass");
+  ASSERT_TRUE(pass != nullptr);
+  pass->Apply(graph);
+  graph->CheckValid();
+}
+
+TEST(TransposeEliminatePass, remove_cancelling_pair) {
+  // x -> NCHW to NHWC -> a -> NHWC to NCHW -> b -> relu
+  Scope scope;
+  std::unique_ptr<SSAGraph> graph(new SSAGraph());
+  auto* x = AddVar(graph.get(), &scope, "x", {1, 3, 4, 5}, false);
+  auto* a = AddTranspose(graph.get(), &scope, x, {0, 2, 3, 1}, "a");
+  auto* b = AddTranspose(graph.get(), &scope, a, {0, 3, 1, 2}, "b");
+  AddUnary(graph.get(), &scope, "relu", b, "out");
+
+  ApplyPass(graph);
+  EXPECT_EQ(CountOps(graph.get(), "transpose2"), 0);
+  auto* relu = FindOp(graph.get(), "relu");
+  ASSERT_TRUE(relu != nullptr);
+  EXPECT_EQ(relu->Input("X"), std::vector<std::string>({"x"}));
+}
+
+TEST(TransposeEliminatePass, merge_mismatched_pair) {
+  // Twice NCHW to NHWC does not cancel, it leaves one transpose.
+  Scope scope;
+  std::unique_ptr<SSAGraph> graph(new SSAGraph());
+  auto* x = AddVar(graph.get(), &scope, "x", {1, 3, 4, 5}, false);
+  auto* a = AddTranspose(graph.get(), &scope, x, {0, 2, 3, 1}, "a");
+  auto* b = AddTranspose(graph.get(), &scope, a, {0, 2, 3, 1}, "b");
+  AddUnary(graph.get(), &scope, "relu", b, "out");
+
+  ApplyPass(graph);
+  EXPECT_EQ(CountOps(graph.get(), "transpose2"), 1);
+  auto* transpose = FindOp(graph.get(), "transpose2");
+  ASSERT_TRUE(transpose != nullptr);
+  EXPECT_EQ(transpose->Input("X"), std::vector<std::string>({"x"}));
+  EXPECT_EQ(transpose->Output("Out"), std::vector<std::string>({"b"}));
+  EXPECT_EQ(transpose->GetAttr<std::vector<int>>("axis"),
+            std::vector<int>({0, 3, 1, 2}));
+  auto* relu = FindOp(graph.get(), "relu");
+  ASSERT_TRUE(relu != nullptr);
+  EXPECT_EQ(relu->Input("X"), std::vector<std::string>({"b"}));
+}
+
+TEST(TransposeEliminatePass, keep_pair_with_side_consumer) {
+  // a is also read by a softmax, so neither transpose may go.
+  Scope scope;
+  std::unique_ptr<SSAGraph> graph(new SSAGraph());
+  auto* x = AddVar(graph.get(), &scope, "x", {1, 3, 4, 5}, false);
+  auto* a = AddTranspose(graph.get(), &scope, x, {0, 2, 3, 1}, "a");
+  auto* b = AddTranspose(graph.get(), &scope, a, {0, 3, 1, 2}, "b");
+  AddUnary(graph.get(), &scope, "relu", b, "out");
+  AddUnary(graph.get(), &scope, "softmax", a, "side_out");
+
+  ApplyPass(graph);
+  EXPECT_EQ(CountOps(graph.get(), "transpose2"), 2);
+  EXPECT_EQ(FindOp(graph.get(), "relu")->Input("X"),
+            std::vector<std::string>({"b"}));
+  EXPECT_EQ(FindOp(graph.get(), "softmax")->Input("X"),
+            std::vector<std::string>({"a"}));
+}
+
+TEST(TransposeEliminatePass, absorb_into_matmul) {
+  // x -> transpose of the last two axes -> y_t -> Y of matmul
+  Scope scope;
+  std::unique_ptr<SSAGraph> graph(new SSAGraph());
+  auto* x = AddVar(graph.get(), &scope, "x", {2, 4, 8}, false);
+  auto* y = AddVar(graph.get(), &scope, "y", {2, 6, 8}, false);
+  auto* y_t = AddTranspose(graph.get(), &scope, y, {0, 2, 1}, "y_t");
+  auto* out = AddVar(graph.get(), &scope, "out", {}, false);
+  cpp::OpDesc desc;
+  desc.SetType("matmul");
+  desc.SetInput("X", {"x"});
+  desc.SetInput("Y", {"y_t"});
+  desc.SetOutput("Out", {"out"});
+  desc.SetAttr<bool>("transpose_X", false);
+  desc.SetAttr<bool>("transpose_Y", false);
+  AddOp(graph.get(), &scope, desc, {x, y_t}, {out});
+
+  ApplyPass(graph);
+  EXPECT_EQ(CountOps(graph.get(), "transpose2"), 0);
+  auto* matmul = FindOp(graph.get(), "matmul");
+  ASSERT_TRUE(matmul != nullptr);
+  EXPECT_EQ(matmul->Input("Y"), std::vector<std::string>({"y"}));
+  EXPECT_FALSE(matmul->GetAttr<bool>("transpose_X"));
+  EXPECT_TRUE(matmul->GetAttr<bool>("transpose_Y"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_MIR_PASS(transpose_eliminate_pass);
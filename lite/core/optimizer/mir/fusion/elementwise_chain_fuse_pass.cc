@@ -0,0 +1,248 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/elementwise_chain_fuse_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The limits of the x86 jit kElementwiseChain kernel
+const size_t kMaxChainInputs = 6;
+const size_t kMaxChainSteps = 16;
+
+// The input and output names of an op of the chain, X and Y for binary ops
+std::vector<std::string> ChainOpInputs(const OpInfo& op_info) {
+  std::vector<std::string> inputs{op_info.Input("X").front()};
+  if (op_info.HasInput("Y")) {
+    inputs.push_back(op_info.Input("Y").front());
+  }
+  return inputs;
+}
+
+Node* FindArg(const std::list<Node*>& links, const std::string& name) {
+  for (auto* node : links) {
+    if (node->IsArg() && node->arg()->name == name) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+// The args consumed by the chain but not produced in it, in the order of the
+// ops and of their inputs.
+std::vector<Node*> ChainInputs(const std::vector<Node*>& chain) {
+  std::set<const Node*> ops(chain.begin(), chain.end());
+  std::vector<Node*> inputs;
+  for (auto* op : chain) {
+    for (auto& name : ChainOpInputs(*op->stmt()->op_info())) {
+      auto* arg = FindArg(op->inlinks, name);
+      CHECK(arg) << "Can not find the input " << name;
+      bool internal =
+          arg->inlinks.size() == 1 && ops.count(arg->inlinks.front());
+      if (!internal &&
+          std::find(inputs.begin(), inputs.end(), arg) == inputs.end()) {
+        inputs.push_back(arg);
+      }
+    }
+  }
+  return inputs;
+}
+
+}  // namespace
+
+bool ElementwiseChainFusePass::IsChainOp(Node* node) const {
+  if (!node->IsStmt() || node->outlinks.size() != 1) return false;
+  auto* op_info = node->stmt()->op_info();
+  const std::string op_type = op_info->Type();
+  if (op_info->HasAttr("enable_int8") &&
+      op_info->GetAttr<bool>("enable_int8")) {
+    return false;
+  }
+  if (binary_ops_.count(op_type)) {
+    // only the broadcasting with trailing dims aligned
+    if (op_info->HasAttr("axis") && op_info->GetAttr<int>("axis") != -1) {
+      return false;
+    }
+    return !op_info->HasAttr("act_type");
+  }
+  if (op_type == "scale") {
+    if (op_info->HasAttr("activation_type")) return false;
+    return !op_info->HasInput("ScaleTensor") ||
+           op_info->Input("ScaleTensor").empty();
+  }
+  return unary_ops_.count(op_type) > 0;
+}
+
+// The kernel of the chain is fp32 only, while elementwise ops may also
+// compute shapes in int. A chain is taken as fp32 if it has an activation,
+// or if it reads an fp32 weight, and none of its weights is not fp32.
+bool ElementwiseChainFusePass::IsFloatChain(
+    const std::vector<Node*>& chain, const std::vector<Node*>& inputs) const {
+  bool is_float = false;
+  for (auto* op : chain) {
+    auto op_type = op->stmt()->op_type();
+    if (op_type != "scale" && unary_ops_.count(op_type)) {
+      is_float = true;
+    }
+  }
+  auto* scope = chain.front()->stmt()->op()->scope();
+  for (auto* input : inputs) {
+    auto* var = scope->FindVar(input->arg()->name);
+    if (var == nullptr || !var->IsType<lite::Tensor>()) continue;
+    auto& tensor = var->Get<lite::Tensor>();
+    if (!tensor.persistable()) continue;
+    if (tensor.precision() != PRECISION(kFloat)) return false;
+    is_float = true;
+  }
+  return is_float;
+}
+
+void ElementwiseChainFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  auto nodes = graph->StmtTopologicalOrder();
+  std::map<const Node*, size_t> order;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    order[nodes[i]] = i;
+  }
+  std::set<const Node*> visited;
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+    Node* last = *it;
+    if (visited.count(last) || !IsChainOp(last)) continue;
+    std::vector<Node*> chain{last};
+    std::set<const Node*> in_chain{last};
+    bool grown = true;
+    while (grown && chain.size() < kMaxChainSteps) {
+      grown = false;
+      for (size_t i = 0; !grown && i < chain.size(); ++i) {
+        for (auto* arg : chain[i]->inlinks) {
+          if (!arg->IsArg() || arg->arg()->is_weight ||
+              arg->arg()->is_persist || arg->inlinks.size() != 1) {
+            continue;
+          }
+          Node* producer = arg->inlinks.front();
+          if (in_chain.count(producer) || visited.count(producer) ||
+              !IsChainOp(producer)) {
+            continue;
+          }
+          bool only_chain = std::all_of(
+              arg->outlinks.begin(), arg->outlinks.end(), [&](Node* op) {
+                return in_chain.count(op) > 0;
+              });
+          if (!only_chain) continue;
+          auto candidate = chain;
+          candidate.push_back(producer);
+          if (ChainInputs(candidate).size() > kMaxChainInputs) continue;
+          chain.push_back(producer);
+          in_chain.insert(producer);
+          grown = true;
+          break;
+        }
+      }
+    }
+    visited.insert(in_chain.begin(), in_chain.end());
+    if (chain.size() < 2) continue;
+    std::sort(chain.begin(), chain.end(), [&](Node* a, Node* b) {
+      return order[a] < order[b];
+    });
+    auto inputs = ChainInputs(chain);
+    if (inputs.size() > kMaxChainInputs || !IsFloatChain(chain, inputs)) {
+      continue;
+    }
+    InsertNewNode(graph.get(), chain, inputs);
+  }
+}
+
+void ElementwiseChainFusePass::InsertNewNode(SSAGraph* graph,
+                                             const std::vector<Node*>& chain,
+                                             const std::vector<Node*>& inputs) {
+  std::map<std::string, int> values;
+  std::vector<std::string> input_names;
+  for (auto* input : inputs) {
+    values[input->arg()->name] = static_cast<int>(input_names.size());
+    input_names.push_back(input->arg()->name);
+  }
+
+  std::vector<std::string> chain_ops;
+  std::vector<int> chain_x, chain_y;
+  std::vector<float> chain_alpha, chain_beta;
+  std::set<const Node*> to_remove;
+  for (auto* op : chain) {
+    auto* op_info = op->stmt()->op_info();
+    auto op_inputs = ChainOpInputs(*op_info);
+    float alpha = 1.f;
+    float beta = 0.f;
+    if (op_info->Type() == "scale") {
+      alpha = op_info->GetAttr<float>("scale");
+      beta = op_info->GetAttr<float>("bias");
+      if (!op_info->GetAttr<bool>("bias_after_scale")) {
+        beta *= alpha;
+      }
+    }
+    chain_ops.push_back(op_info->Type());
+    chain_x.push_back(values.at(op_inputs[0]));
+    chain_y.push_back(op_inputs.size() > 1 ? values.at(op_inputs[1]) : 0);
+    chain_alpha.push_back(alpha);
+    chain_beta.push_back(beta);
+    auto out_name = op_info->Output("Out").front();
+    values[out_name] =
+        static_cast<int>(input_names.size() + chain_x.size()) - 1;
+    to_remove.insert(op);
+    if (op != chain.back()) {
+      to_remove.insert(op->outlinks.front());
+    }
+  }
+
+  auto last_op = chain.back()->stmt()->op();
+  Node* out = chain.back()->outlinks.front();
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_elementwise_chain");
+  op_desc.SetInput("X", input_names);
+  op_desc.SetOutput("Out", {out->arg()->name});
+  op_desc.SetAttr("chain_ops", chain_ops);
+  op_desc.SetAttr("chain_x", chain_x);
+  op_desc.SetAttr("chain_y", chain_y);
+  op_desc.SetAttr("chain_alpha", chain_alpha);
+  op_desc.SetAttr("chain_beta", chain_beta);
+
+  auto chain_op = LiteOpRegistry::Global().Create("fusion_elementwise_chain");
+  auto* scope = last_op->scope();
+  auto& valid_places = last_op->valid_places();
+  chain_op->Attach(op_desc, scope);
+  auto* new_op_node = graph->GraphCreateInstructNode(chain_op, valid_places);
+
+  GraphSafeRemoveNodes(graph, to_remove);
+  for (auto* input : inputs) {
+    IR_NODE_LINK_TO(input, new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, out);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_elementwise_chain_fuse_pass,
+                  paddle::lite::mir::ElementwiseChainFusePass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,67 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Collapses every chain of elementwise, scale and activation ops into one
+ * fusion_elementwise_chain op. The x86 kernel of it runs the whole chain in a
+ * single loop with the intermediates kept in registers, instead of one pass
+ * over the memory for each op. For example, the tanh form of gelu:
+ *
+ *   x -> square -> elementwise_mul(x) -> scale -> elementwise_add(x) ->
+ *        scale -> tanh -> scale -> elementwise_mul(x) -> scale -> out
+ *
+ * becomes fusion_elementwise_chain(X = {x}) -> out.
+ *
+ * A chain grows from its last op towards its inputs. An op joins it only if
+ * all the consumers of its output are already in the chain, so only the
+ * output of the last op is visible outside. The broadcasting elementwise ops
+ * must use axis = -1.
+ */
+class ElementwiseChainFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool IsChainOp(Node* node) const;
+  bool IsFloatChain(const std::vector<Node*>& chain,
+                    const std::vector<Node*>& inputs) const;
+  void InsertNewNode(SSAGraph* graph,
+                     const std::vector<Node*>& chain,
+                     const std::vector<Node*>& inputs);
+
+  const std::set<std::string> binary_ops_{"elementwise_add",
+                                          "elementwise_sub",
+                                          "elementwise_mul",
+                                          "elementwise_div",
+                                          "elementwise_max",
+                                          "elementwise_min"};
+  const std::set<std::string> unary_ops_{
+      "scale", "relu", "sigmoid", "tanh", "exp", "square", "sqrt"};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
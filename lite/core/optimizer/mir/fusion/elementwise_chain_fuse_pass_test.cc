@@ -0,0 +1,126 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/elementwise_chain_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+using test::AddOp;
+using test::AddVar;
+using test::CountOps;
+
+// Add `op_type` reading x, and y for the binary ops, and return its output
+// `out_name`.
+Node* AddChainOp(SSAGraph* graph,
+                 Scope* scope,
+                 const std::string& op_type,
+                 Node* x,
+                 Node* y,
+                 const std::string& out_name) {
+  auto* out = AddVar(graph, scope, out_name, {4, 8}, false);
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x->AsArg().name});
+  std::vector<Node*> ins{x};
+  if (y) {
+    desc.SetInput("Y", {y->AsArg().name});
+    desc.SetAttr<int>("axis", -1);
+    ins.push_back(y);
+  }
+  if (op_type == "scale") {
+    desc.SetAttr<float>("scale", 2.f);
+    desc.SetAttr<float>("bias", 1.f);
+    desc.SetAttr<bool>("bias_after_scale", true);
+  }
+  desc.SetOutput("Out", {out_name});
+  AddOp(graph, scope, desc, ins, {out});
+  return out;
+}
+
+Node* FindArgNode(SSAGraph* graph, const std::string& name) {
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg() && node.AsArg().name == name) return &node;
+  }
+  return nullptr;
+}
+
+TEST(ElementwiseChainFusePass, fuse_around_side_consumer) {
+  // x -> square -> a -> elementwise_mul(x) -> b -> scale -> c -> tanh -> out,
+  // where b is also read by a softmax outside of the chains.
+  Scope scope;
+  std::unique_ptr<SSAGraph> graph(new SSAGraph());
+  auto* x = AddVar(graph.get(), &scope, "x", {4, 8}, false);
+  auto* a = AddChainOp(graph.get(), &scope, "square", x, nullptr, "a");
+  auto* b = AddChainOp(graph.get(), &scope, "elementwise_mul", a, x, "b");
+  auto* c = AddChainOp(graph.get(), &scope, "scale", b, nullptr, "c");
+  AddChainOp(graph.get(), &scope, "tanh", c, nullptr, "out");
+  AddChainOp(graph.get(), &scope, "softmax", b, nullptr, "side_out");
+
+  ElementwiseChainFusePass pass;
+  pass.Apply(graph);
+  // The chain is split at b, which stays visible to the softmax
+  EXPECT_EQ(CountOps(graph.get(), "fusion_elementwise_chain"), 2);
+  for (auto op_type : {"square", "elementwise_mul", "scale", "tanh"}) {
+    EXPECT_EQ(CountOps(graph.get(), op_type), 0) << op_type;
+  }
+  EXPECT_EQ(CountOps(graph.get(), "softmax"), 1);
+  EXPECT_EQ(FindArgNode(graph.get(), "a"), nullptr);
+  EXPECT_EQ(FindArgNode(graph.get(), "c"), nullptr);
+  auto* kept = FindArgNode(graph.get(), "b");
+  ASSERT_NE(kept, nullptr);
+  ASSERT_EQ(kept->inlinks.size(), 1u);
+  auto* producer = kept->inlinks.front()->stmt()->op_info();
+  EXPECT_EQ(producer->Type(), "fusion_elementwise_chain");
+  EXPECT_EQ(producer->Input("X"), std::vector<std::string>({"x"}));
+  EXPECT_EQ(producer->GetAttr<std::vector<std::string>>("chain_ops"),
+            std::vector<std::string>({"square", "elementwise_mul"}));
+  ASSERT_EQ(kept->outlinks.size(), 2u);
+  auto* out = FindArgNode(graph.get(), "out");
+  ASSERT_NE(out, nullptr);
+  ASSERT_EQ(out->inlinks.size(), 1u);
+  auto* consumer = out->inlinks.front()->stmt()->op_info();
+  EXPECT_EQ(consumer->Input("X"), std::vector<std::string>({"b"}));
+  EXPECT_EQ(consumer->GetAttr<std::vector<std::string>>("chain_ops"),
+            std::vector<std::string>({"scale", "tanh"}));
+  graph->CheckValid();
+}
+
+TEST(ElementwiseChainFusePass, keep_chain_without_float_ops) {
+  // Without an activation or an fp32 weight, the chain may compute int shapes
+  Scope scope;
+  std::unique_ptr<SSAGraph> graph(new SSAGraph());
+  auto* x = AddVar(graph.get(), &scope, "x", {4, 8}, false);
+  auto* a = AddChainOp(graph.get(), &scope, "scale", x, nullptr, "a");
+  AddChainOp(graph.get(), &scope, "elementwise_add", a, x, "out");
+
+  ElementwiseChainFusePass pass;
+  pass.Apply(graph);
+  EXPECT_EQ(CountOps(graph.get(), "fusion_elementwise_chain"), 0);
+  EXPECT_EQ(CountOps(graph.get(), "scale"), 1);
+  EXPECT_EQ(CountOps(graph.get(), "elementwise_add"), 1);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(fusion_elementwise_chain);
@@ -13,11 +13,24 @@
 // limitations under the License.
 
 #include "lite/core/optimizer/mir/node.h"
+#include <atomic>
 #include "lite/core/op_registry.h"
 
 namespace paddle {
 namespace lite {
 
+namespace {
+std::atomic<uint64_t> node_edit_version{0};
+}  // namespace
+
+uint64_t mir::NodeEditVersion() {
+  return node_edit_version.load(std::memory_order_relaxed);
+}
+
+void mir::BumpNodeEditVersion() {
+  node_edit_version.fetch_add(1, std::memory_order_relaxed);
+}
+
 const OpInfo *mir::Node::Stmt::op_info() const {
   CHECK(op_);
   return op_->op_info();
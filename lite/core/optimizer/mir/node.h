@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <string>
@@ -26,11 +27,79 @@ namespace paddle {
 namespace lite {
 namespace mir {
 
+class Node;
+
+// Counts the edits of the nodes that the topological orders depend on: their
+// roles, ids and links. SSAGraph keeps its cached orders until it changes.
+uint64_t NodeEditVersion();
+void BumpNodeEditVersion();
+
+// The inlinks or outlinks of a node, a std::list which bumps the edit version
+// on every change. The elements are only read through the iterators.
+class NodeLinks {
+ public:
+  using value_type = Node*;
+  using size_type = std::list<Node*>::size_type;
+  using iterator = std::list<Node*>::const_iterator;
+  using const_iterator = std::list<Node*>::const_iterator;
+
+  NodeLinks() = default;
+  NodeLinks(const NodeLinks& other) = default;
+  NodeLinks& operator=(const NodeLinks& other) {
+    BumpNodeEditVersion();
+    links_ = other.links_;
+    return *this;
+  }
+
+  operator const std::list<Node*>&() const { return links_; }
+
+  const_iterator begin() const { return links_.begin(); }
+  const_iterator end() const { return links_.end(); }
+  size_type size() const { return links_.size(); }
+  bool empty() const { return links_.empty(); }
+  Node* front() const { return links_.front(); }
+  Node* back() const { return links_.back(); }
+
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    BumpNodeEditVersion();
+    links_.assign(first, last);
+  }
+  void push_back(Node* node) {
+    BumpNodeEditVersion();
+    links_.push_back(node);
+  }
+  void emplace_back(Node* node) { push_back(node); }
+  const_iterator insert(const_iterator pos, Node* node) {
+    BumpNodeEditVersion();
+    return links_.insert(pos, node);
+  }
+  const_iterator erase(const_iterator pos) {
+    BumpNodeEditVersion();
+    return links_.erase(pos);
+  }
+  const_iterator erase(const_iterator first, const_iterator last) {
+    BumpNodeEditVersion();
+    return links_.erase(first, last);
+  }
+  void remove(Node* node) {
+    BumpNodeEditVersion();
+    links_.remove(node);
+  }
+  void clear() {
+    BumpNodeEditVersion();
+    links_.clear();
+  }
+
+ private:
+  std::list<Node*> links_;
+};
+
 // Node in a MIR graph.
 class Node {
  public:
-  std::list<Node*> inlinks;
-  std::list<Node*> outlinks;
+  NodeLinks inlinks;
+  NodeLinks outlinks;
 
   Node() = default;
 
@@ -131,6 +200,7 @@ class Node {
       CHECK(role_ == Role::kArg);
       return *arg_;
     }
+    BumpNodeEditVersion();
     role_ = Role::kArg;
     arg_.reset(new Arg);
     return *arg_;
@@ -140,6 +210,7 @@ class Node {
       CHECK(role_ == Role::kStmt);
       return *stmt_;
     }
+    BumpNodeEditVersion();
     role_ = Role::kStmt;
     stmt_.reset(new Stmt);
     return *stmt_;
@@ -166,7 +237,10 @@ class Node {
   bool IsStmt() const { return role_ == Role::kStmt; }
   bool IsArg() const { return role_ == Role::kArg; }
 
-  void set_id(int id) { id_ = id; }
+  void set_id(int id) {
+    BumpNodeEditVersion();
+    id_ = id;
+  }
   int get_id() { return id_; }
 
  private:
@@ -174,7 +248,7 @@ class Node {
   std::unique_ptr<Stmt> stmt_;
   std::unique_ptr<Arg> arg_;
   Role role_{Role::kUnk};
-  int id_;
+  int id_{-1};
 };
 }  // namespace mir
 }  // namespace lite
@@ -11,11 +11,52 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
-
 #include "lite/core/optimizer/mir/pass_manager.h"
+#include <algorithm>
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+#include "lite/core/profile/timer.h"
+#include "lite/utils/string.h"
 
 namespace paddle {
 namespace lite {
-namespace mir {}  // namespace mir
+namespace mir {
+
+void PassProfiler::Profile(const std::string& name,
+                           const std::function<void()>& apply) {
+  Record record;
+  record.name = name;
+  uint64_t visited_nodes = PatternMatcher::visited_nodes();
+  profile::Timer timer;
+  timer.Start();
+  apply();
+  record.time_ms = timer.Stop();
+  record.visited_nodes = PatternMatcher::visited_nodes() - visited_nodes;
+  records_.push_back(record);
+}
+
+void PassProfiler::Print() const {
+  if (records_.empty()) return;
+  std::vector<const Record*> records;
+  float total_time_ms = 0.f;
+  for (auto& record : records_) {
+    records.push_back(&record);
+    total_time_ms += record.time_ms;
+  }
+  std::stable_sort(records.begin(),
+                   records.end(),
+                   [](const Record* a, const Record* b) {
+                     return a->time_ms > b->time_ms;
+                   });
+  LOG(INFO) << "== Pass profile, total " << total_time_ms << " ms";
+  for (auto* record : records) {
+    LOG(INFO) << string_format("   %-48s %10.3f ms %12llu visited nodes",
+                               record->name.c_str(),
+                               record->time_ms,
+                               static_cast<unsigned long long>(  // NOLINT
+                                   record->visited_nodes));
+  }
+}
+
+}  // namespace mir
 }  // namespace lite
 }  // namespace paddle
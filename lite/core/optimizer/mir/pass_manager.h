@@ -13,16 +13,40 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "lite/core/optimizer/mir/pass.h"
 
 namespace paddle {
 namespace lite {
 namespace mir {
 
+// Records the wall time of the passes and the number of the graph nodes
+// visited by their pattern matchers.
+class PassProfiler {
+ public:
+  struct Record {
+    std::string name;
+    float time_ms{0.f};
+    uint64_t visited_nodes{0UL};
+  };
+
+  // Run `apply`, which applies the pass `name`, and record it.
+  void Profile(const std::string& name, const std::function<void()>& apply);
+
+  // Print the records, the slowest pass first.
+  void Print() const;
+
+  const std::vector<Record>& records() const { return records_; }
+
+ private:
+  std::vector<Record> records_;
+};
+
 class PassManager {
  public:
   static PassManager& Global() {
@@ -33,10 +57,12 @@ class PassManager {
   PassManager() {}
 
   void Run(const std::unique_ptr<SSAGraph>& graph) {
+    PassProfiler profiler;
     for (auto& pass : passes_) {
       LOG(INFO) << "Running MIR pass " << pass->name();
-      pass->Apply(graph);
+      profiler.Profile(pass->name(), [&] { pass->Apply(graph); });
     }
+    profiler.Print();
   }
 
   bool AddNewPass(const std::string& name, Pass* pass) {
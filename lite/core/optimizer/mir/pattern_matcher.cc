@@ -14,7 +14,10 @@
 
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "lite/core/op_lite.h"
@@ -27,6 +30,7 @@ namespace lite {
 namespace mir {
 
 size_t PMPattern::id_ = 0UL;
+std::atomic<uint64_t> PatternMatcher::visited_nodes_(0UL);
 
 PMNode &PMNode::operator>>(PMNode &right) {
   pattern_->AddEdge(this, &right);
@@ -116,12 +120,65 @@ void PatternMatcher::operator()(SSAGraph *graph,
 bool PatternMatcher::MarkPMNodesInGraph(SSAGraph *graph) {
   VLOG(3) << "mark pmnodes in graph";
   if (graph->nodes().empty()) return false;
+  // Index the statements by op type, so that the PMNodes bound to an op type
+  // only visit the anchors of that type rather than every node in the graph.
+  std::vector<Node *> all_nodes;
+  std::map<std::string, std::vector<Node *>> op_type2nodes;
   for (auto &node : graph->mutable_nodes()) {
-    for (const auto &pmnode : pattern_.nodes()) {
-      if (pmnode->Tell(&node)) {
-        pmnodes2nodes_[pmnode.get()].insert(&node);
+    all_nodes.push_back(&node);
+    if (node.IsStmt() && node.stmt()->op()) {
+      op_type2nodes[node.stmt()->op_type()].push_back(&node);
+    }
+  }
+  auto mark = [&](const PMNode *pmnode, const std::vector<Node *> &nodes) {
+    for (auto *node : nodes) {
+      if (pmnode->Tell(node)) {
+        pmnodes2nodes_[pmnode].insert(node);
       }
     }
+    visited_nodes_ += nodes.size();
+  };
+  std::vector<const PMNode *> unanchored_pmnodes;
+  for (const auto &pmnode : pattern_.nodes()) {
+    const auto &op_type = pmnode->anchor_op_type();
+    if (op_type.empty()) {
+      unanchored_pmnodes.push_back(pmnode.get());
+      continue;
+    }
+    auto it = op_type2nodes.find(op_type);
+    if (it != op_type2nodes.end()) {
+      mark(pmnode.get(), it->second);
+    }
+  }
+  // A PMNode linked to an anchored PMNode can only be matched by the
+  // neighbors of the nodes marked for that anchor, the others fall back to
+  // visiting the whole graph.
+  for (auto *pmnode : unanchored_pmnodes) {
+    const PMNode *anchor = nullptr;
+    bool is_anchor_output = false;
+    for (const auto &edge : pattern_.edges()) {
+      if (edge.second == pmnode && !edge.first->anchor_op_type().empty()) {
+        anchor = edge.first;
+        is_anchor_output = true;
+        break;
+      }
+      if (edge.first == pmnode && !edge.second->anchor_op_type().empty()) {
+        anchor = edge.second;
+        break;
+      }
+    }
+    if (!anchor) {
+      mark(pmnode, all_nodes);
+      continue;
+    }
+    auto it = pmnodes2nodes_.find(anchor);
+    if (it == pmnodes2nodes_.end()) continue;
+    std::set<Node *> neighbors;
+    for (auto *node : it->second) {
+      auto &links = is_anchor_output ? node->outlinks : node->inlinks;
+      neighbors.insert(links.begin(), links.end());
+    }
+    mark(pmnode, std::vector<Node *>(neighbors.begin(), neighbors.end()));
   }
   // Check to early stop if some PMNode can't find matched Node.
   for (auto &pmnode : pattern_.nodes()) {
@@ -230,24 +287,76 @@ std::vector<PatternMatcher::subgraph_t> PatternMatcher::DetectPatterns() {
     cur_groups.clear();
     if (pre_groups.empty()) break;
     // source -> target
-    for (Node *source : pmnodes2nodes_[edge.first]) {
-      for (Node *target : pmnodes2nodes_[edge.second]) {
-        // TODO(Superjomn) add some prune strategies.
-        for (const auto &group : pre_groups) {
-          if (IsNodesLink(source, target)) {
-            HitGroup new_group = group;
-            bool flag = new_group.Match(source, edge.first) &&
-                        new_group.Match(target, edge.second);
-            if (flag) {
-              new_group.Register(source, edge.first);
-              new_group.Register(target, edge.second);
-              cur_groups.push_back(new_group);
-              // TODO(Superjomn) need to unique
+    // A group which has registered the source or the target is only extended
+    // through the links of that node, rather than by trying all the pairs of
+    // the marked nodes.
+    auto &sources = pmnodes2nodes_[edge.first];
+    auto &targets = pmnodes2nodes_[edge.second];
+    std::vector<std::tuple<Node *, Node *, size_t>> hits;
+    std::vector<std::pair<Node *, Node *>> links;
+    bool links_collected = false;
+    for (size_t i = 0; i < pre_groups.size(); i++) {
+      auto &roles = pre_groups[i].roles;
+      auto source_it = roles.find(edge.first);
+      auto target_it = roles.find(edge.second);
+      if (source_it != roles.end()) {
+        for (auto *target : source_it->second->outlinks) {
+          if (targets.count(target)) {
+            hits.emplace_back(source_it->second, target, i);
+          }
+        }
+      } else if (target_it != roles.end()) {
+        for (auto *source : target_it->second->inlinks) {
+          if (sources.count(source) &&
+              IsNodesLink(source, target_it->second)) {
+            hits.emplace_back(source, target_it->second, i);
+          }
+        }
+      } else {
+        if (!links_collected) {
+          for (Node *source : sources) {
+            for (Node *target : targets) {
+              if (IsNodesLink(source, target)) {
+                links.emplace_back(source, target);
+              }
             }
           }
+          links_collected = true;
+        }
+        for (auto &link : links) {
+          hits.emplace_back(link.first, link.second, i);
         }
       }
     }
+    // Keep the order of iterating the sources, the targets and then the
+    // groups.
+    std::sort(hits.begin(),
+              hits.end(),
+              [](const std::tuple<Node *, Node *, size_t> &a,
+                 const std::tuple<Node *, Node *, size_t> &b) {
+                std::less<Node *> less;
+                if (std::get<0>(a) != std::get<0>(b)) {
+                  return less(std::get<0>(a), std::get<0>(b));
+                }
+                if (std::get<1>(a) != std::get<1>(b)) {
+                  return less(std::get<1>(a), std::get<1>(b));
+                }
+                return std::get<2>(a) < std::get<2>(b);
+              });
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+    for (auto &hit : hits) {
+      Node *source = std::get<0>(hit);
+      Node *target = std::get<1>(hit);
+      HitGroup new_group = pre_groups[std::get<2>(hit)];
+      bool flag = new_group.Match(source, edge.first) &&
+                  new_group.Match(target, edge.second);
+      if (flag) {
+        new_group.Register(source, edge.first);
+        new_group.Register(target, edge.second);
+        cur_groups.push_back(new_group);
+        // TODO(Superjomn) need to unique
+      }
+    }
     VLOG(3) << "step " << step << " get records: " << cur_groups.size();
   }
 
@@ -371,6 +480,9 @@ PMNode *PMNode::assert_only_one_output() {
 }
 
 PMNode *PMNode::assert_is_op(const std::string &op_type) {
+  if (anchor_op_type_.empty()) {
+    anchor_op_type_ = op_type;
+  }
   asserts_.emplace_back([op_type](const Node *x) {
     if (x && x->IsStmt()) {
       auto *op_info = x->stmt()->op_info();
@@ -18,6 +18,7 @@
 #include <gtest/gtest_prod.h>
 #endif
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <numeric>
@@ -80,6 +81,14 @@ struct PMNode {
   bool IsOp() const { return type_ == Type::kOp; }
   bool IsVar() const { return type_ == Type::kVar; }
 
+  // The op type asserted by `assert_is_op(op_type)`, the matcher only visits
+  // the statements of this type as the candidates of this node. Empty if the
+  // node is not bound to an op type.
+  const std::string& anchor_op_type() const {
+    static const std::string kEmpty;
+    return teller_ ? kEmpty : anchor_op_type_;
+  }
+
   const std::string& name() const { return name_; }
 
   PMNode& operator=(const PMNode&) = delete;
@@ -195,6 +204,7 @@ struct PMNode {
   PMPattern* pattern_;
   std::string name_;
   std::string op_type_;
+  std::string anchor_op_type_;
   Type type_{};
   Role role_{Role::kUnknown};
 };
@@ -297,6 +307,10 @@ class PatternMatcher {
   const PMPattern& pattern() const { return pattern_; }
   PMPattern* mutable_pattern() { return &pattern_; }
 
+  // The total number of the graph nodes tested by all the pattern matchers,
+  // used to profile the passes.
+  static uint64_t visited_nodes() { return visited_nodes_; }
+
  private:
   // Mark the nodes that fits the pattern.
   bool MarkPMNodesInGraph(SSAGraph* graph);
@@ -325,6 +339,7 @@ class PatternMatcher {
       std::pair<Node* /*node in graph*/, PMNode* /*node in pattern*/>;
   PMPattern pattern_;
   std::map<const PMNode*, std::set<Node*>> pmnodes2nodes_;
+  static std::atomic<uint64_t> visited_nodes_;
 };
 
 // Check whether a var node is a op node's nth input.
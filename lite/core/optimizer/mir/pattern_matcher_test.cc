@@ -15,6 +15,10 @@
 #include "lite/core/optimizer/mir/pattern_matcher.h"
 
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/test_helper.h"
+#include "lite/core/profile/timer.h"
 
 namespace paddle {
 namespace lite {
@@ -228,6 +232,90 @@ TEST(PatternMatcher, IntermediateCheck) {
   ASSERT_EQ(count, 1);
 }
 
+// Build a chain of `num_blocks` blocks of mul -> elementwise_add -> relu.
+void BuildLargeGraph(SSAGraph* g, Scope* scope, int num_blocks) {
+  const char* op_types[] = {"mul", "elementwise_add", "relu"};
+  std::vector<Node*> ins;
+  for (int i = 0; i < num_blocks; i++) {
+    for (auto* op_type : op_types) {
+      auto* var_node = g->NewArgumentNode(
+          string_format("var%d", static_cast<int>(g->nodes().size())));
+      test::AddOp(g, scope, op_type, ins, {var_node});
+      ins = {var_node};
+    }
+  }
+}
+
+TEST(PatternMatcher, LargeGraph) {
+  const int num_blocks = 4000;
+  Scope scope;
+  SSAGraph graph;
+  BuildLargeGraph(&graph, &scope, num_blocks);
+  const uint64_t num_nodes = graph.nodes().size();
+
+  auto is_op = [](const Node* x, const std::string& op_type) {
+    return x && x->IsStmt() && x->stmt()->op_type() == op_type;
+  };
+  // mul -> var -> elementwise_add, with the op types asserted to index the
+  // candidates.
+  PatternMatcher anchored;
+  auto* mul = anchored.mutable_pattern()->NewNode("mul")->assert_is_op("mul");
+  auto* mul_out = anchored.mutable_pattern()
+                      ->NewNode("mul_out")
+                      ->assert_is_var()
+                      ->AsIntermediate();
+  auto* add = anchored.mutable_pattern()
+                  ->NewNode("add")
+                  ->assert_is_op("elementwise_add");
+  anchored.mutable_pattern()->AddEdge(mul, mul_out);
+  anchored.mutable_pattern()->AddEdge(mul_out, add);
+  // The same pattern with tellers, which visits every node of the graph.
+  PatternMatcher scanned;
+  auto* mul1 = scanned.mutable_pattern()->NewNode(
+      [&](const Node* x) { return is_op(x, "mul"); }, "mul");
+  auto* mul_out1 =
+      scanned.mutable_pattern()
+          ->NewNode([](const Node* x) { return x && x->IsArg(); }, "mul_out")
+          ->AsIntermediate();
+  auto* add1 = scanned.mutable_pattern()->NewNode(
+      [&](const Node* x) { return is_op(x, "elementwise_add"); }, "add");
+  scanned.mutable_pattern()->AddEdge(mul1, mul_out1);
+  scanned.mutable_pattern()->AddEdge(mul_out1, add1);
+
+  profile::Timer timer;
+  int anchored_count = 0;
+  uint64_t visited_nodes = PatternMatcher::visited_nodes();
+  timer.Start();
+  anchored(&graph, [&](const PatternMatcher::subgraph_t& g, SSAGraph* graph) {
+    ASSERT_TRUE(is_op(g.at(mul), "mul"));
+    ASSERT_TRUE(is_op(g.at(add), "elementwise_add"));
+    ++anchored_count;
+  });
+  float anchored_time = timer.Stop();
+  uint64_t anchored_visited_nodes =
+      PatternMatcher::visited_nodes() - visited_nodes;
+
+  int scanned_count = 0;
+  visited_nodes = PatternMatcher::visited_nodes();
+  timer.Start();
+  scanned(&graph, [&](const PatternMatcher::subgraph_t& g, SSAGraph* graph) {
+    ++scanned_count;
+  });
+  float scanned_time = timer.Stop();
+  uint64_t scanned_visited_nodes =
+      PatternMatcher::visited_nodes() - visited_nodes;
+
+  LOG(INFO) << "anchored: " << anchored_time << " ms, "
+            << anchored_visited_nodes << " visited nodes; scanned: "
+            << scanned_time << " ms, " << scanned_visited_nodes
+            << " visited nodes";
+  EXPECT_EQ(anchored_count, num_blocks);
+  EXPECT_EQ(scanned_count, num_blocks);
+  EXPECT_EQ(scanned_visited_nodes, 3 * num_nodes);
+  // Visit the mul and elementwise_add anchors and the outputs of the muls.
+  EXPECT_EQ(anchored_visited_nodes, 3UL * num_blocks);
+}
+
 }  // namespace mir
 }  // namespace lite
 }  // namespace paddle
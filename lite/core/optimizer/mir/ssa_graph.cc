@@ -17,6 +17,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include "lite/core/optimizer/mir/dot.h"
 
@@ -41,97 +42,90 @@ bool SSAGraph::CheckBidirectionalConnection() {
   return true;
 }
 
-std::map<mir::Node *, std::set<mir::Node *, NodeComp>, NodeComp>
-SSAGraph::BuildOperationAdjList() {
-  std::map<mir::Node *, std::set<mir::Node *, NodeComp>, NodeComp> adj_list;
-
-  for (auto &n : mutable_nodes()) {
-    if (!n.IsStmt()) continue;
-    if (adj_list.find(&n) == adj_list.end()) {
-      adj_list[&n] = std::set<mir::Node *, NodeComp>();
+std::vector<mir::Node *> SSAGraph::SortTopologically(bool stmt_only) {
+  std::vector<mir::Node *> nodes;
+  for (auto &node : node_storage_) {
+    if (!stmt_only || node.IsStmt()) {
+      nodes.push_back(&node);
     }
-    std::vector<mir::Node *> nodes;
-    for (auto &var : n.inlinks) {
-      for (auto &adj_n : var->inlinks) {
+  }
+  std::stable_sort(
+      nodes.begin(), nodes.end(), [](mir::Node *a, mir::Node *b) {
+        return a->get_id() < b->get_id();
+      });
+  std::unordered_map<mir::Node *, size_t> indices;
+  indices.reserve(nodes.size());
+  for (size_t i = 0; i < nodes.size(); i++) {
+    indices[nodes[i]] = i;
+  }
+  auto index = [&](mir::Node *node) {
+    auto it = indices.find(node);
+    CHECK(it != indices.end()) << "The linked node is not in the graph.";
+    return it->second;
+  };
+  // The inlink edge table of the statements or the nodes, the adjacent nodes
+  // are sorted by id as well.
+  std::vector<std::vector<size_t>> adj_list(nodes.size());
+  for (size_t i = 0; i < nodes.size(); i++) {
+    auto &adj = adj_list[i];
+    for (auto *var : nodes[i]->inlinks) {
+      if (!stmt_only) {
+        adj.push_back(index(var));
+        continue;
+      }
+      for (auto *adj_n : var->inlinks) {
         CHECK(adj_n->IsStmt());
-        nodes.push_back(adj_n);
+        adj.push_back(index(adj_n));
       }
     }
-    adj_list[&n].insert(std::make_move_iterator(nodes.begin()),
-                        std::make_move_iterator(nodes.end()));
+    std::sort(adj.begin(), adj.end());
+    adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
   }
-  return adj_list;
-}
-
-std::map<mir::Node *, std::set<mir::Node *, NodeComp>, NodeComp>
-SSAGraph::BuildNodeAdjList() {
-  std::map<mir::Node *, std::set<mir::Node *, NodeComp>, NodeComp> adj_list;
-
-  for (auto &n : mutable_nodes()) {
-    if (adj_list.find(&n) == adj_list.end()) {
-      adj_list[&n] = std::set<mir::Node *, NodeComp>();
-    }
-    std::vector<mir::Node *> nodes;
-    for (auto &var : n.inlinks) {
-      nodes.push_back(var);
+  // Depth-first search in post order, with an explicit stack rather than
+  // recursion to handle the deep graphs.
+  std::vector<mir::Node *> res;
+  std::vector<bool> visited(nodes.size(), false);
+  std::vector<std::pair<size_t, size_t>> stack;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (visited[i]) continue;
+    visited[i] = true;
+    stack.emplace_back(i, 0);
+    while (!stack.empty()) {
+      size_t cur = stack.back().first;
+      size_t &next = stack.back().second;
+      if (next < adj_list[cur].size()) {
+        size_t adj = adj_list[cur][next++];
+        if (!visited[adj]) {
+          visited[adj] = true;
+          stack.emplace_back(adj, 0);
+        }
+      } else {
+        res.push_back(nodes[cur]);
+        stack.pop_back();
+      }
     }
-    adj_list[&n].insert(std::make_move_iterator(nodes.begin()),
-                        std::make_move_iterator(nodes.end()));
   }
-  return adj_list;
+  return res;
 }
 
-void SSAGraph::SortHelper(
-    const std::map<mir::Node *, std::set<mir::Node *, NodeComp>, NodeComp>
-        &adj_list,
-    mir::Node *node,
-    std::set<mir::Node *, NodeComp> *visited,
-    std::vector<mir::Node *> *ret) {
-  visited->insert(node);
-
-  for (auto adj : adj_list.at(node)) {
-    if (visited->find(adj) == visited->end()) {
-      SortHelper(adj_list, adj, visited, ret);
-    }
+const std::vector<mir::Node *> &SSAGraph::CachedOrder(OrderCache *cache,
+                                                      bool stmt_only) {
+  uint64_t version = NodeEditVersion();
+  if (version != cache->version || node_storage_.size() != cache->num_nodes) {
+    CheckBidirectionalConnection();
+    cache->order = SortTopologically(stmt_only);
+    cache->version = version;
+    cache->num_nodes = node_storage_.size();
   }
-
-  ret->push_back(node);
+  return cache->order;
 }
 
 std::vector<mir::Node *> SSAGraph::StmtTopologicalOrder() {
-  CheckBidirectionalConnection();
-
-  std::stack<mir::Node *> stack;
-  std::set<mir::Node *, NodeComp> visited;
-  std::vector<mir::Node *> res;
-
-  auto adj_list = BuildOperationAdjList();
-
-  for (auto adj : adj_list) {
-    if (visited.find(adj.first) == visited.end()) {
-      SortHelper(adj_list, adj.first, &visited, &res);
-    }
-  }
-
-  return res;
+  return CachedOrder(&stmt_order_cache_, true);
 }
 
 std::vector<mir::Node *> SSAGraph::NodeTopologicalOrder() {
-  CheckBidirectionalConnection();
-
-  std::stack<mir::Node *> stack;
-  std::set<mir::Node *, NodeComp> visited;
-  std::vector<mir::Node *> res;
-
-  auto adj_list = BuildNodeAdjList();
-
-  for (auto adj : adj_list) {
-    if (visited.find(adj.first) == visited.end()) {
-      SortHelper(adj_list, adj.first, &visited, &res);
-    }
-  }
-
-  return res;
+  return CachedOrder(&node_order_cache_, false);
 }
 
 Node *SSAGraph::GraphCreateInstructNode(
@@ -177,6 +171,7 @@ void SSAGraph::Build(const Program &program,
         node_storage_.emplace_back();
         arg_node = &node_storage_.back();
         arg_node->AsArg(var_name, node_storage_.size() - 1);
+        arg_node->set_id(num_node_created_++);
         arg_update_node_map[var_name] = arg_node;
       }
       if (var_type_map.count(var_name)) {
@@ -200,6 +195,7 @@ void SSAGraph::Build(const Program &program,
       node_storage_.emplace_back();
       auto *arg_node = &node_storage_.back();
       arg_node->AsArg(var_name, node_storage_.size() - 1);
+      arg_node->set_id(num_node_created_++);
       arg_update_node_map[var_name] = arg_node;
       if (var_type_map.count(var_name) && !arg_node->arg()->type) {
         arg_node->arg()->type = var_type_map[var_name];
@@ -221,6 +217,7 @@ void SSAGraph::RemoveNode(const mir::Node *node) {
                           node_storage_.end(),
                           [&node](mir::Node &n) { return &n == node; });
   CHECK(pos != node_storage_.end());
+  BumpNodeEditVersion();
   node_storage_.erase(pos);
 }
 
@@ -235,6 +232,7 @@ void SSAGraph::CloneFrom(const SSAGraph &from) {
       node_storage_.emplace_back();
       auto &new_node = node_storage_.back();
       new_node.AsArg() = *node.arg();
+      new_node.set_id(num_node_created_++);
       clone_node_map.emplace(&node, &new_node);
     } else {
       const auto *inst = node.stmt();
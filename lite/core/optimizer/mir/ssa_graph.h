@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
@@ -107,20 +108,21 @@ class SSAGraph : GraphBase {
     }
   }
 
-  // Build operator inlink edge table.
-  std::map<mir::Node *, std::set<mir::Node *, NodeComp>, NodeComp>
-  BuildOperationAdjList();
+  // Sort the statements, or all the nodes, in topological order. The nodes
+  // with smaller ids are visited first.
+  std::vector<mir::Node *> SortTopologically(bool stmt_only);
 
-  // Build node inlink edge table.
-  std::map<mir::Node *, std::set<mir::Node *, NodeComp>, NodeComp>
-  BuildNodeAdjList();
+  // The cached topological order, valid while the nodes are unchanged since
+  // it was computed: the node edit version and the number of nodes match.
+  struct OrderCache {
+    uint64_t version{0};
+    size_t num_nodes{0};
+    std::vector<mir::Node *> order;
+  };
 
-  void SortHelper(
-      const std::map<mir::Node *, std::set<mir::Node *, NodeComp>, NodeComp>
-          &adj_list,
-      mir::Node *node,
-      std::set<mir::Node *, NodeComp> *visited,
-      std::vector<mir::Node *> *ret);
+  // Refresh the order of `cache` if the nodes changed.
+  const std::vector<mir::Node *> &CachedOrder(OrderCache *cache,
+                                              bool stmt_only);
 
  private:
   std::list<mir::Node> node_storage_;
@@ -128,6 +130,8 @@ class SSAGraph : GraphBase {
   std::vector<Place> valid_places_;
   int block_idx_ = kRootBlockIdx;
   int num_node_created_ = 0;
+  OrderCache stmt_order_cache_;
+  OrderCache node_order_cache_;
 };
 
 // Remove the link between a -> b.
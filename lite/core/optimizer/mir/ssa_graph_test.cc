@@ -0,0 +1,103 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "lite/core/optimizer/mir/test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+using test::AddOp;
+
+// Build a chain of ops, each op also consumes the output of the op two steps
+// before it.
+void BuildChainGraph(SSAGraph* graph, Scope* scope, int num_ops) {
+  std::vector<Node*> outs;
+  for (int i = 0; i < num_ops; i++) {
+    std::vector<Node*> ins;
+    if (i >= 1) ins.push_back(outs[i - 1]);
+    if (i >= 2) ins.push_back(outs[i - 2]);
+    auto* out = graph->NewArgumentNode("out" + std::to_string(i));
+    AddOp(graph, scope, "fake", ins, {out});
+    outs.push_back(out);
+  }
+}
+
+void CheckStmtOrder(const std::vector<Node*>& order) {
+  std::unordered_map<Node*, size_t> positions;
+  for (size_t i = 0; i < order.size(); i++) {
+    positions[order[i]] = i;
+  }
+  for (auto* op : order) {
+    for (auto* in : op->inlinks) {
+      for (auto* producer : in->inlinks) {
+        ASSERT_LT(positions.at(producer), positions.at(op));
+      }
+    }
+  }
+}
+
+TEST(SSAGraph, TopologicalOrder) {
+  const int num_ops = 50000;
+  Scope scope;
+  SSAGraph graph;
+  BuildChainGraph(&graph, &scope, num_ops);
+
+  auto order = graph.StmtTopologicalOrder();
+  ASSERT_EQ(order.size(), static_cast<size_t>(num_ops));
+  CheckStmtOrder(order);
+
+  // The cached order is returned while the graph is unchanged.
+  ASSERT_EQ(graph.StmtTopologicalOrder(), order);
+
+  auto node_order = graph.NodeTopologicalOrder();
+  ASSERT_EQ(node_order.size(), graph.nodes().size());
+
+  // Append an op consuming the output of the first op, the order is updated.
+  auto* op = AddOp(&graph, &scope, "fake", {order.front()->outlinks.front()});
+  auto updated_order = graph.StmtTopologicalOrder();
+  ASSERT_EQ(updated_order.size(), static_cast<size_t>(num_ops + 1));
+  CheckStmtOrder(updated_order);
+  ASSERT_EQ(graph.NodeTopologicalOrder().size(), graph.nodes().size());
+
+  // Removing the node invalidates the cached order as well.
+  RemoveDirectedLink(order.front()->outlinks.front(), op);
+  graph.RemoveNode(op);
+  ASSERT_EQ(graph.StmtTopologicalOrder(), order);
+}
+
+TEST(SSAGraph, LinkEditInvalidatesOrder) {
+  Scope scope;
+  SSAGraph graph;
+  auto* out1 = graph.NewArgumentNode("out1");
+  auto* out2 = graph.NewArgumentNode("out2");
+  auto* op1 = AddOp(&graph, &scope, "fake", {}, {out1});
+  auto* op2 = AddOp(&graph, &scope, "fake", {}, {out2});
+  ASSERT_EQ(graph.StmtTopologicalOrder(), std::vector<Node*>({op1, op2}));
+
+  // Only the links change, op1 now consumes the output of op2.
+  DirectedLink(out2, op1);
+  ASSERT_EQ(graph.StmtTopologicalOrder(), std::vector<Node*>({op2, op1}));
+  op1->inlinks.clear();
+  out2->outlinks.clear();
+  ASSERT_EQ(graph.StmtTopologicalOrder(), std::vector<Node*>({op1, op2}));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
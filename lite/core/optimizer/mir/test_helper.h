@@ -0,0 +1,93 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_lite.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace test {
+
+// The op without kernels of the graphs built by the tests.
+class FakeOp : public OpLite {
+ public:
+  explicit FakeOp(const std::string& type) : OpLite(type) {}
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override {
+    return true;
+  }
+  void AttachKernel(KernelBase* kernel) override {}
+  std::string DebugString() const override { return "fake"; }
+};
+
+// Add the statement of a FakeOp described by `desc`, which consumes `ins` and
+// produces `outs`.
+inline Node* AddOp(SSAGraph* graph,
+                   Scope* scope,
+                   const cpp::OpDesc& desc,
+                   const std::vector<Node*>& ins = {},
+                   const std::vector<Node*>& outs = {}) {
+  std::shared_ptr<OpLite> op(new FakeOp(desc.Type()));
+  op->Attach(desc, scope);
+  auto* node = graph->NewInstructNode();
+  node->AsStmt().SetOp(op);
+  for (auto* in : ins) DirectedLink(in, node);
+  for (auto* out : outs) DirectedLink(node, out);
+  return node;
+}
+
+inline Node* AddOp(SSAGraph* graph,
+                   Scope* scope,
+                   const std::string& op_type,
+                   const std::vector<Node*>& ins = {},
+                   const std::vector<Node*>& outs = {}) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  return AddOp(graph, scope, desc, ins, outs);
+}
+
+// Add the argument of the tensor `name` in `scope`, the data of the weights
+// are allocated.
+inline Node* AddVar(SSAGraph* graph,
+                    Scope* scope,
+                    const std::string& name,
+                    const std::vector<int64_t>& shape,
+                    bool persistable) {
+  auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+  tensor->Resize(shape);
+  if (persistable) {
+    tensor->mutable_data<float>();
+    tensor->set_persistable(true);
+  }
+  auto* node = graph->NewArgumentNode(name);
+  node->AsArg().is_weight = persistable;
+  return node;
+}
+
+inline int CountOps(SSAGraph* graph, const std::string& op_type) {
+  int count = 0;
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsStmt() && node.AsStmt().op_type() == op_type) count++;
+  }
+  return count;
+}
+
+}  // namespace test
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -227,6 +227,11 @@ void PrecisionCastPass::ComplementInputs(
         break;
       }
     }
+    // The bf16 kernels of x86 convert their fp32 weights by themselves.
+    if (place.target == TARGET(kX86) && place.precision == PRECISION(kBF16)) {
+      has_fp16 = true;
+      break;
+    }
   }
   has_fp16 = has_fp16 && (in->AsArg().is_weight);
   VLOG(4) << "has_fp16: " << has_fp16 << ", arg_name: " << in->AsArg().name;
@@ -106,6 +106,7 @@ void Optimizer::InitControlFlowOpSharedInputsAndOutputsPlaceSyncPass() {
 
 void Optimizer::ApplyPasses(
     std::vector<std::unique_ptr<mir::SSAGraph>>* graphes) {
+  mir::PassProfiler profiler;
   for (auto& pass : passes_) {
     LOG(INFO) << "== Running pass: " << pass->name();
     std::set<TargetType> targets;
@@ -119,17 +120,21 @@ void Optimizer::ApplyPasses(
                 << " because the target or kernel does not match.";
     } else {
       // Check the pass whether it is supported for processing subblocks
-      if (kSubblockUnsupportedPasses.count(pass->name()) ||
-          kSubblockSkippedPasses.count(pass->name())) {
-        pass->Apply((*graphes)[kRootBlockIdx]);
-      } else {
-        for (auto& graph : *graphes) {
-          pass->Apply(graph);
+      profiler.Profile(pass->name(), [&] {
+        if (kSubblockUnsupportedPasses.count(pass->name()) ||
+            kSubblockSkippedPasses.count(pass->name())) {
+          pass->Apply((*graphes)[kRootBlockIdx]);
+        } else {
+          for (auto& graph : *graphes) {
+            pass->Apply(graph);
+          }
         }
-      }
-      LOG(INFO) << "== Finished running: " << pass->name();
+      });
+      LOG(INFO) << "== Finished running: " << pass->name() << ", "
+                << profiler.records().back().time_ms << " ms";
     }
   }
+  profiler.Print();
 }
 
 std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
@@ -152,6 +157,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "unsqueeze_calc_offline_pass",
        "reshape_calc_offline_pass",
        "ssd_boxes_calc_offline_pass",
+       "constant_folding_pass",
        // A minimal set of op fusion pass.
        "op_fusion_minimal_set_pass",
        // For the fully quantization model, the quantization parameters of the
@@ -186,12 +192,15 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "lite_fc_fuse_pass",                           //
        "lite_shuffle_channel_fuse_pass",              //
        "lite_transpose_softmax_transpose_fuse_pass",  //
+       "transpose_eliminate_pass",                    //
        "lite_interpolate_fuse_pass",                  //
        "identity_scale_eliminate_pass",               //
        "lite_scales_fuse_pass",                       //
        "lite_sequence_reverse_embedding_fuse_pass",   //
+       "lite_embedding_seq_pool_fuse_pass",           //
        "elementwise_mul_constant_eliminate_pass",     //
        "lite_sequence_pool_concat_fuse_pass",         //
+       "lite_elementwise_chain_fuse_pass",            //
        "lite_scale_activation_fuse_pass",             //
        "lite_scaleacts_fuse_pass",                    //
        "lite_elementwise_scale_fuse_pass",            //
@@ -323,6 +332,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
   const std::string pqd_pass{"post_quant_dynamic_pass"};
   const std::string pqd_depend_pass{"lite_quant_dequant_fuse_pass"};
   const std::string fp16_pass{"fp16_attribute_pass"};
+  const std::string bf16_pass{"bf16_attribute_pass"};
 
   for (const std::string& pass : passes) {
     if (pass == msa_pass) {
@@ -348,6 +358,12 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
       }
     }
   }
+  for (auto place : valid_places) {
+    if (place.target == TARGET(kX86) && place.precision == PRECISION(kBF16)) {
+      passes_local.push_back(bf16_pass);
+      break;
+    }
+  }
   for (auto& pass_name : passes_local) {
     optim.AddPass(pass_name);
   }
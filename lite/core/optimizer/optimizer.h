@@ -21,6 +21,7 @@
 #include <vector>
 #include "lite/core/optimizer/mir/control_flow_op_shared_inputs_and_outputs_place_sync_pass.h"
 #include "lite/core/optimizer/mir/elimination/control_flow_op_unused_inputs_and_outputs_eliminate_pass.h"
+#include "lite/core/optimizer/mir/bf16_attribute_pass.h"
 #include "lite/core/optimizer/mir/fp16_attribute_pass.h"
 #include "lite/core/optimizer/mir/generate_program_pass.h"
 #include "lite/core/optimizer/mir/pass_manager.h"
@@ -48,7 +49,8 @@ const std::set<std::string> kSubblockSkippedPasses(
      "range_calc_offline_pass",
      "assign_value_calc_offline_pass",
      "ssd_boxes_calc_offline_pass",
-     "p_norm_fill_constant_max_div_fuse_pass"});
+     "p_norm_fill_constant_max_div_fuse_pass",
+     "constant_folding_pass"});
 
 /*
  * lite::Optimizer optimize a program. It utilize the mir passes to analysis the
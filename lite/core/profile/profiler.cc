@@ -143,7 +143,8 @@ std::string Profiler::Summary(Type type, bool concise, size_t w) {
     ss << " " << setw(26) << left << "Remark"
        << " " << setw(15) << left << "InDim"
        << " " << setw(15) << left << "FilterDim"
-       << " " << setw(15) << left << "OutDim";
+       << " " << setw(15) << left << "OutDim"
+       << " " << setw(11) << left << "Scratch(KB)";
   }
   ss << " " << setw(7) << left << "Avg(ms)"
      << " " << setw(7) << left << "Min(ms)"
@@ -290,6 +291,8 @@ std::string Profiler::Summary(Type type, bool concise, size_t w) {
          << " " << setw(15) << left << fixed << unit.Character().input_shape
          << " " << setw(15) << left << fixed << unit.Character().filter_shape
          << " " << setw(15) << left << fixed << unit.Character().output_shape
+         << " " << setw(11) << left << fixed << setprecision(1)
+                << unit.Character().workspace_size / 1024.f
          << " " << setw(7) << left << fixed << setprecision(3) << times.Avg(w)
          << " " << setw(7) << left << fixed << setprecision(3) << times.Min(w)
          << " " << setw(7) << left << fixed << setprecision(3) << times.Max(w)
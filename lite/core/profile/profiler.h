@@ -65,6 +65,8 @@ struct OpCharacter {
   float macs_ps{0};
 
   float io_duration{0};
+  // Peak bytes of the host workspace used by the kernel.
+  size_t workspace_size{0};
 
 #ifdef LITE_WITH_OPENCL
   cl::Event cl_event{};
@@ -18,6 +18,7 @@
 #include <map>
 #include <set>
 
+#include "lite/core/thread_pool.h"
 #include "lite/model_parser/cpp_desc.h"
 #include "lite/operators/conditional_block_op.h"
 #include "lite/operators/subgraph_op.h"
@@ -242,6 +243,52 @@ void AddVariableDescFromOpInfo(
     }
     already_added_vars->insert(var_name);
   }
+  // Add the weights packed ahead of time by the kernel
+  if (op_info->HasAttr(kPackedWeightsAttr)) {
+    auto var_name = op_info->GetAttr<std::string>(kPackedWeightsAttr);
+    if (!already_added_vars->count(var_name)) {
+      auto* v = block_desc->AddVar<cpp::VarDesc>();
+      v->SetName(var_name);
+      UpdateVarDescFromTensorInfo(v, var_name, op_type, scope);
+      already_added_vars->insert(var_name);
+    }
+  }
+}
+
+// The original weights replaced by the packed ones are not saved unless the
+// other ops use them. Their var descs are kept as the non-persistable vars, so
+// the ops still get their shapes.
+void DropPackedOriginalWeights(cpp::ProgramDesc* program_desc) {
+  std::set<std::string> packed_var_names;
+  std::set<std::string> used_var_names;
+  for (size_t block_idx = 0; block_idx < program_desc->BlocksSize();
+       ++block_idx) {
+    auto* block_desc = program_desc->GetBlock<cpp::BlockDesc>(block_idx);
+    for (size_t op_idx = 0; op_idx < block_desc->OpsSize(); ++op_idx) {
+      auto* op_desc = block_desc->GetOp<cpp::OpDesc>(op_idx);
+      std::string packed_argument;
+      if (op_desc->HasAttr(kPackedWeightsArgumentAttr)) {
+        packed_argument =
+            op_desc->GetAttr<std::string>(kPackedWeightsArgumentAttr);
+      }
+      for (auto& argument : op_desc->InputArgumentNames()) {
+        auto& var_names =
+            argument == packed_argument ? packed_var_names : used_var_names;
+        for (auto& var_name : op_desc->Input(argument)) {
+          var_names.insert(var_name);
+        }
+      }
+    }
+  }
+  auto* block_desc = program_desc->GetBlock<cpp::BlockDesc>(kRootBlockIdx);
+  for (size_t var_idx = 0; var_idx < block_desc->VarsSize(); ++var_idx) {
+    auto* var_desc = block_desc->GetVar<cpp::VarDesc>(var_idx);
+    const auto& var_name = var_desc->Name();
+    if (packed_var_names.count(var_name) && !used_var_names.count(var_name)) {
+      var_desc->SetPersistable(false);
+      VLOG(3) << "Drop " << var_name << " in favor of the packed weights";
+    }
+  }
 }
 
 }  // namespace
@@ -262,6 +309,42 @@ void RuntimeProgram::SaveRuntimProgramIntoProgramDesc(
       AddOpDescFromOpInfo(program_desc, block_idx, &inst);
     }
   }
+  DropPackedOriginalWeights(program_desc.get());
+}
+
+size_t RuntimeProgram::PackWeights() {
+  size_t count = 0;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    auto* op = const_cast<OpLite*>(inst.op());
+    auto* op_info = op->mutable_op_info();
+    auto output_names = op_info->output_names();
+    if (output_names.empty() || op_info->HasAttr(kPackedWeightsAttr)) {
+      continue;
+    }
+    auto* kernel = inst.mutable_kernel();
+    Tensor packed_weights;
+    std::string argument;
+    auto layout = kernel->PackWeights(&packed_weights, &argument);
+    if (layout.empty()) continue;
+    CHECK(op_info->HasInput(argument))
+        << "The weights " << argument << " packed by the kernel of "
+        << op_info->Type() << " are not the input of the op.";
+    // Name the packed weights after the first output of the op, because the
+    // weights may be shared by the ops with the different kernels
+    auto var_name = output_names.front() + "@PACKED";
+    auto* tensor = op->scope()->Var(var_name)->GetMutable<Tensor>();
+    tensor->ShareDataWith(packed_weights);
+    tensor->set_persistable(true);
+    op_info->SetAttr<std::string>(kPackedWeightsAttr, var_name);
+    op_info->SetAttr<std::string>(kPackedWeightsLayoutAttr, layout);
+    op_info->SetAttr<std::string>(kPackedWeightsArgumentAttr, argument);
+    // The kernel of this program takes the packed weights as well
+    kernel->SetPackedWeights(tensor, layout);
+    VLOG(3) << "Packed the weights of " << op_info->Type() << " into "
+            << var_name << " with the layout " << layout;
+    count++;
+  }
+  return count;
 }
 #endif
 
@@ -407,7 +490,64 @@ void RuntimeProgram::SaveOutput() {
 }
 #endif
 
-void RuntimeProgram::Run() {
+size_t RuntimeProgram::PrepareKernelsAhead(int threads) {
+  // Only the shared weights make the kernels dependent, PrepareForRun does not
+  // read the activations.
+  auto weight_names = [&](const Instruction& inst) {
+    std::vector<std::string> names;
+    for (auto& name : inst.op()->op_info()->input_names()) {
+      auto* var = exec_scope_ ? exec_scope_->FindVar(name) : nullptr;
+      if (var && var->IsType<lite::Tensor>() &&
+          var->Get<lite::Tensor>().persistable()) {
+        names.push_back(name);
+      }
+    }
+    return names;
+  };
+  // Leave the kernels reading a lazy weight to their first run, preparing them
+  // here would materialize the weight and undo the lazy loading.
+  auto reads_lazy_weight = [&](const Instruction& inst) {
+    for (auto& name : weight_names(inst)) {
+      if (exec_scope_->FindVar(name)->Get<lite::Tensor>().lazy_pending()) {
+        return true;
+      }
+    }
+    return false;
+  };
+  std::vector<Instruction*> candidates;
+  std::map<std::string, int> weight_refs;
+  for (auto& block_instructions : instructions_) {
+    for (auto& inst : block_instructions) {
+      if (!inst.kernel()->CanPrepareAhead() || reads_lazy_weight(inst)) {
+        continue;
+      }
+      candidates.push_back(&inst);
+      for (auto& name : weight_names(inst)) {
+        weight_refs[name]++;
+      }
+    }
+  }
+  std::vector<Instruction*> independent;
+  std::vector<Instruction*> dependent;
+  for (auto* inst : candidates) {
+    bool shared = false;
+    for (auto& name : weight_names(*inst)) {
+      shared = shared || weight_refs[name] > 1;
+    }
+    (shared ? dependent : independent).push_back(inst);
+  }
+  RunInParallel(independent.size(), threads, [&](size_t i) {
+    independent[i]->mutable_kernel()->PrepareAhead();
+  });
+  for (auto* inst : dependent) {
+    inst->mutable_kernel()->PrepareAhead();
+  }
+  VLOG(4) << "Prepared " << candidates.size() << " kernels ahead, "
+          << independent.size() << " of them concurrently";
+  return candidates.size();
+}
+
+bool RuntimeProgram::Run(const std::function<bool()>& interrupted) {
 #ifdef LITE_WITH_PRECISION_PROFILE
   auto inst_precision_profiler = paddle::lite::profile::PrecisionProfiler();
   std::string precision_profiler_summary =
@@ -429,6 +569,7 @@ void RuntimeProgram::Run() {
 #endif
 
   int idx = -1;
+  bool completed = true;
 
   auto& insts = instructions_[kRootBlockIdx];
   for (auto& inst : insts) {
@@ -436,6 +577,11 @@ void RuntimeProgram::Run() {
 #if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
     if (inst.is_feed_fetch_op()) continue;
 #endif
+    if (interrupted && interrupted()) {
+      VLOG(4) << "Run interrupted before the op " << idx;
+      completed = false;
+      break;
+    }
 #ifdef LITE_WITH_NVTX
     NVTXRangeAnnotation annotation = annotator.AnnotateBlock();
     nvtxStringHandle_t registered_name = register_layer_names_[idx];
@@ -474,6 +620,34 @@ void RuntimeProgram::Run() {
 #endif  // LITE_WITH_PRECISION_PROFILE
   }
 
+  // Pre-size the host workspace once with the scratch high-water mark of all
+  // the kernels recorded in the warm-up run, an interrupted run doesn't
+  // record all of them.
+  if (completed && !workspace_reserved_) {
+    size_t workspace_size = 0;
+    size_t extended_workspace_size = 0;
+    for (auto& inst : insts) {
+      if (inst.kernel()) {
+        workspace_size =
+            (std::max)(workspace_size, inst.kernel()->workspace_peak());
+        extended_workspace_size =
+            (std::max)(extended_workspace_size,
+                       inst.kernel()->extended_workspace_peak());
+      }
+    }
+    VLOG(4) << "Reserve " << workspace_size << " bytes for the host workspace";
+    WorkSpace::Global_Host().AllocReset();
+    WorkSpace::Global_Host().Reserve(workspace_size);
+#ifdef LITE_WITH_ARM
+    if (extended_workspace_size > 0) {
+      VLOG(4) << "Extend the arm workspace by " << extended_workspace_size
+              << " bytes";
+      DeviceInfo::Global().ExtendWorkspace(extended_workspace_size);
+    }
+#endif
+    workspace_reserved_ = true;
+  }
+
 #ifdef LITE_WITH_METAL
   if (metal_ctx_) {
     MetalContext* wait_ctx = (*metal_ctx_).As<MTLContext>().context();
@@ -489,6 +663,7 @@ void RuntimeProgram::Run() {
             << precision_profiler_summary
             << inst_precision_profiler.GetSummaryTail();
 #endif
+  return completed;
 }
 
 void Program::Build(const std::shared_ptr<cpp::ProgramDesc>& program_desc) {
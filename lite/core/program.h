@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -286,11 +287,23 @@ class LITE_API RuntimeProgram {
     }
   }
 
-  void Run();
+  void Run() { Run(std::function<bool()>()); }
+  // Run with `interrupted` checked before every op, the run stops once it
+  // returns true. Return false if the run was stopped.
+  bool Run(const std::function<bool()>& interrupted);
 #ifdef LITE_WITH_METAL
   void SaveOutput();
 #endif
 
+  // Run PrepareForRun of the kernels which support preparing ahead (see
+  // KernelBase::CanPrepareAhead) on up to `threads` threads, the kernels
+  // sharing a weight are prepared one after another. The kernels reading a
+  // lazy weight which is not materialized yet are skipped, they are prepared
+  // on their first run. Note that the weights of a mapped model file are still
+  // paged in by the kernels prepared here. Returns the number of the prepared
+  // kernels.
+  size_t PrepareKernelsAhead(int threads);
+
   void set_exec_scope(Scope* x) { exec_scope_ = x; }
   Scope* exec_scope() { return exec_scope_; }
 
@@ -315,6 +328,12 @@ class LITE_API RuntimeProgram {
   // according to the instructions
   void SaveRuntimProgramIntoProgramDesc(
       std::shared_ptr<cpp::ProgramDesc> program_desc);
+
+  // Pack the weights of the kernels in the root block into the layouts used by
+  // them (see KernelBase::PackWeights), and save the packed weights as the new
+  // persistable vars referred by the attributes of the ops. Returns the number
+  // of the packed weights.
+  size_t PackWeights();
 #endif
 
 #ifdef LITE_WITH_METAL
@@ -330,6 +349,7 @@ class LITE_API RuntimeProgram {
   std::vector<std::vector<Instruction>> instructions_;
   Scope* exec_scope_{};
   int64_t version_{0};
+  bool workspace_reserved_{false};
 
 #ifdef LITE_WITH_METAL
   std::unique_ptr<KernelContext> metal_ctx_{nullptr};
@@ -31,6 +31,14 @@ void TensorLite::ShareDataWith(const TensorLite &other) {
   offset_ = other.offset_;
 }
 
+void TensorLite::ShareDataCopyOnWrite(TensorLite *other) {
+  if (!other->buffer_->shared()) {
+    other->buffer_ = std::make_shared<CopyOnWriteBuffer>(other->buffer_);
+  }
+  ShareDataWith(*other);
+  buffer_ = std::make_shared<CopyOnWriteBuffer>(other->buffer_);
+}
+
 void TensorLite::CopyDataFrom(const TensorLite &other) {
   dims_ = other.dims_;
   target_ = other.target_;
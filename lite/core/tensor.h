@@ -88,6 +88,10 @@ class TensorLite {
   bool persistable() const { return persistable_; }
   void set_persistable(bool persistable) { persistable_ = persistable; }
 
+  // Whether the data is held by a lazy buffer which is not materialized yet,
+  // see LazyBuffer.
+  bool lazy_pending() const { return buffer_->pending(); }
+
   // T is the data type and R is the return type
   // For OpenCL, the return type can be cl::Buffer
   // and the data type can be float/int8_t.
@@ -223,6 +227,9 @@ class TensorLite {
 
   // Other share data to this.
   void ShareDataWith(const TensorLite &other);
+  // Share the data with `other` until either of them is written, see
+  // CopyOnWriteBuffer.
+  void ShareDataCopyOnWrite(TensorLite *other);
 
   void CopyDataFrom(const TensorLite &other);
 
@@ -14,11 +14,155 @@
 
 #include "lite/core/thread_pool.h"
 #include <string.h>
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include "lite/core/allocator.h"
 #include "lite/utils/log/logging.h"
 
 namespace paddle {
 namespace lite {
 
+void RunInParallel(size_t size,
+                   int threads,
+                   const std::function<void(size_t)>& task) {
+  const size_t thread_num =
+      (std::min)(size, static_cast<size_t>((std::max)(threads, 1)));
+  if (thread_num <= 1) {
+    for (size_t i = 0; i < size; ++i) {
+      task(i);
+    }
+    return;
+  }
+  // The workers allocate the host memory like the calling thread.
+  auto* allocator = AllocatorRegistry::Current();
+  const size_t alignment = AllocatorRegistry::CurrentAlignment();
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    AllocatorRegistry::Current() = allocator;
+    AllocatorRegistry::CurrentAlignment() = alignment;
+    for (size_t i = next++; i < size; i = next++) {
+      task(i);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < thread_num; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : workers) {
+    thread.join();
+  }
+}
+
+AsyncRunExecutor& AsyncRunExecutor::Global() {
+  static AsyncRunExecutor x;
+  return x;
+}
+
+void AsyncRunExecutor::SetThreads(int threads) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (workers_.empty()) thread_num_ = threads;
+}
+
+void AsyncRunExecutor::Submit(std::function<void()>&& task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (workers_.empty()) {
+      int thread_num = thread_num_;
+      if (thread_num <= 0) {
+        thread_num = static_cast<int>(std::thread::hardware_concurrency());
+      }
+      for (int i = 0; i < (std::max)(thread_num, 1); ++i) {
+        workers_.emplace_back(&AsyncRunExecutor::Work, this);
+      }
+    }
+    tasks_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void AsyncRunExecutor::Work() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) return;
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+AsyncRunExecutor::~AsyncRunExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+AsyncRunQueue::~AsyncRunQueue() {
+  Cancel();
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_cv_.wait(lock, [this] { return !running_; });
+}
+
+void AsyncRunQueue::Submit(
+    RunFunc run,
+    const std::function<void(lite_api::RunStatus)>& callback,
+    int64_t timeout_ms) {
+  using Clock = std::chrono::steady_clock;
+  using lite_api::RunStatus;
+  const uint64_t epoch = cancel_epoch_.load();
+  const bool has_deadline = timeout_ms > 0;
+  const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+  auto task = [=]() {
+    RunStatus status = RunStatus::kOk;
+    auto interrupted = [&]() {
+      if (cancel_epoch_.load() != epoch) {
+        status = RunStatus::kCancelled;
+      } else if (has_deadline && Clock::now() >= deadline) {
+        status = RunStatus::kDeadlineExceeded;
+      }
+      return status != RunStatus::kOk;
+    };
+    if (!interrupted()) {
+      run(interrupted);
+    }
+    if (callback) callback(status);
+  };
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_.push_back(task);
+  if (!running_) {
+    running_ = true;
+    ScheduleNext();
+  }
+}
+
+void AsyncRunQueue::ScheduleNext() {
+  AsyncRunExecutor::Global().Submit([this]() {
+    std::function<void()> task;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    task();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.empty()) {
+      running_ = false;
+      idle_cv_.notify_all();
+    } else {
+      ScheduleNext();
+    }
+  });
+}
+
 ThreadPool* ThreadPool::gInstance = nullptr;
 static std::mutex gInitMutex;  // confirm thread-safe when use singleton mode
 int ThreadPool::Init(int number) {
@@ -15,12 +15,14 @@
 #pragma once
 #include <atomic>
 #include <condition_variable>  //NOLINT
+#include <deque>
 #include <functional>
 #include <mutex>   //NOLINT
 #include <thread>  //NOLINT
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "lite/api/paddle_api.h"
 
 namespace paddle {
 namespace lite {
@@ -52,5 +54,66 @@ class ThreadPool {
 
   int thread_num_ = 0;
 };
+
+// Runs `task(0)` ... `task(size - 1)` on up to `threads` short-lived threads,
+// the calling thread included. Unlike ThreadPool::Enqueue, the tasks may use
+// the thread pool themselves, so it suits coarse work like model loading.
+void RunInParallel(size_t size,
+                   int threads,
+                   const std::function<void(size_t)>& task);
+
+// A fixed-size pool of long-lived workers for the asynchronous runs of the
+// predictors, the tasks are started in the order of submission.
+class AsyncRunExecutor {
+ public:
+  static AsyncRunExecutor& Global();
+
+  // The number of the workers, it only takes effect before the first task.
+  void SetThreads(int threads);
+  void Submit(std::function<void()>&& task);
+
+  ~AsyncRunExecutor();
+
+ private:
+  AsyncRunExecutor() = default;
+  void Work();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::condition_variable cv_;
+  std::mutex mutex_;
+  bool stop_{false};
+  int thread_num_{0};
+};
+
+// The asynchronous runs of a predictor, they are executed on AsyncRunExecutor
+// one at a time in the order of submission.
+class AsyncRunQueue {
+ public:
+  // Run the predictor with `interrupted` checked between the ops.
+  using RunFunc = std::function<void(const std::function<bool()>&)>;
+
+  // Cancel the pending runs and wait for them, so the predictor owning the
+  // queue is not used after its destruction.
+  ~AsyncRunQueue();
+
+  // See PaddlePredictor::RunAsync.
+  void Submit(RunFunc run,
+              const std::function<void(lite_api::RunStatus)>& callback,
+              int64_t timeout_ms);
+  // Cancel the runs submitted before.
+  void Cancel() { ++cancel_epoch_; }
+
+ private:
+  void ScheduleNext();
+
+  std::mutex mutex_;
+  std::condition_variable idle_cv_;
+  // The runs waiting for the running one.
+  std::deque<std::function<void()>> pending_;
+  bool running_{false};
+  // Increased by Cancel, the runs submitted before are cancelled.
+  std::atomic<uint64_t> cancel_epoch_{0};
+};
 }  // namespace lite
 }  // namespace paddle
@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #pragma once
+#include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 #include "lite/core/memory.h"
 #include "lite/core/types.h"
 #include "lite/utils/macros.h"
@@ -29,6 +32,12 @@ namespace lite {
  * not suitable here, one need to carefully manage the workspace inside a single
  * kernel.
  *
+ * The workspace is a chunked bump arena: when the current chunk can not hold a
+ * request, a new chunk is appended instead of reallocating the old one, so the
+ * pointers returned earlier in the same kernel stay valid. On `AllocReset`, the
+ * chunks are merged into a single one sized to the high-water mark, so that
+ * after the first (warm-up) run the workspace never grows again.
+ *
  * NOTE
  *
  * For kernel developers, one need to call the workspace as follows:
@@ -39,16 +48,52 @@ namespace lite {
 class WorkSpace {
  public:
   // Reset the workspace, and treat the workspace as empty.
-  void AllocReset() { cursor_ = 0; }
+  void AllocReset() {
+    if (chunks_.size() > 1) {
+      // Merge the chunks into one, all the pointers are released here.
+      size_t capacity = std::max(capacity_, peak_);
+      chunks_.clear();
+      capacity_ = 0;
+      NewChunk(capacity);
+    }
+    cursor_ = 0;
+    used_ = 0;
+  }
 
   // Allocate a memory buffer.
   core::byte_t* Alloc(size_t size) {
-    buffer_.ResetLazy(target_, cursor_ + size);
-    auto* data = static_cast<core::byte_t*>(buffer_.data()) + cursor_;
+    size = AlignUp(size);
+    if (chunks_.empty() || cursor_ + size > chunks_.back()->space()) {
+      size_t chunk_size = capacity_ > kMinChunkSize ? capacity_ : kMinChunkSize;
+      NewChunk(std::max(size, chunk_size));
+    }
+    auto* data = static_cast<core::byte_t*>(chunks_.back()->data()) + cursor_;
     cursor_ += size;
+    used_ += size;
+    peak_ = std::max(peak_, used_);
     return data;
   }
 
+  // Pre-size the workspace to hold at least `size` bytes in a single chunk. It
+  // only takes effect when nothing is allocated since the last `AllocReset`.
+  void Reserve(size_t size) {
+    size = AlignUp(size);
+    if (size == 0 || used_ > 0 || (chunks_.size() == 1 && capacity_ >= size)) {
+      return;
+    }
+    chunks_.clear();
+    capacity_ = 0;
+    NewChunk(size);
+  }
+
+  // Bytes allocated since the last `AllocReset`.
+  size_t used() const { return used_; }
+  // The high-water mark of `used()` during the lifetime of the workspace.
+  size_t peak() const { return peak_; }
+  // Total bytes held by the chunks.
+  size_t capacity() const { return capacity_; }
+  size_t chunk_num() const { return chunks_.size(); }
+
   static WorkSpace& Global_Host() {
     static LITE_THREAD_LOCAL std::unique_ptr<WorkSpace> x(
         new WorkSpace(TARGET(kHost)));
@@ -89,9 +134,29 @@ class WorkSpace {
  private:
   explicit WorkSpace(TargetType x) : target_(x) {}
 
+  // Every allocation is rounded up to keep the returned pointers aligned as
+  // well as the chunks allocated by `TargetMalloc`.
+  enum : size_t { kAlignment = 64, kMinChunkSize = 4096 };
+
+  static size_t AlignUp(size_t size) {
+    return (size + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  void NewChunk(size_t size) {
+    std::unique_ptr<Buffer> chunk(new Buffer);
+    chunk->ResetLazy(target_, size);
+    capacity_ += size;
+    chunks_.emplace_back(std::move(chunk));
+    cursor_ = 0;
+  }
+
   TargetType target_;
-  Buffer buffer_;
-  size_t cursor_;
+  std::vector<std::unique_ptr<Buffer>> chunks_;
+  // Offset in the last chunk.
+  size_t cursor_{0};
+  size_t used_{0};
+  size_t peak_{0};
+  size_t capacity_{0};
 
   DISALLOW_COPY_AND_ASSIGN(WorkSpace);
 };
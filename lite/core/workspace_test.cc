@@ -0,0 +1,62 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/workspace.h"
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace paddle {
+namespace lite {
+
+TEST(workspace, alloc_never_moves) {
+  auto& ws = WorkSpace::Global_Host();
+  ws.AllocReset();
+  auto* first = ws.Alloc(128);
+  std::memset(first, 1, 128);
+  // Outgrow the current chunk, the previous pointer should still be valid.
+  auto* second = ws.Alloc(ws.capacity() + 1024);
+  ASSERT_TRUE(second);
+  EXPECT_GE(ws.chunk_num(), 2UL);
+  for (int i = 0; i < 128; i++) {
+    EXPECT_EQ(first[i], 1);
+  }
+  EXPECT_EQ(reinterpret_cast<size_t>(second) % 64, 0UL);
+}
+
+TEST(workspace, presize_after_warmup) {
+  auto& ws = WorkSpace::Global_Host();
+  ws.AllocReset();
+  ws.Alloc(100);
+  ws.Alloc(ws.capacity() * 2);
+  size_t peak = ws.peak();
+  EXPECT_GE(peak, ws.used());
+  // The chunks are merged into a single one which holds the peak usage.
+  ws.AllocReset();
+  EXPECT_EQ(ws.chunk_num(), 1UL);
+  EXPECT_GE(ws.capacity(), peak);
+  EXPECT_EQ(ws.used(), 0UL);
+  size_t capacity = ws.capacity();
+  ws.Alloc(100);
+  ws.Alloc(peak - 128);
+  EXPECT_EQ(ws.chunk_num(), 1UL);
+  EXPECT_EQ(ws.capacity(), capacity);
+
+  ws.AllocReset();
+  ws.Reserve(capacity * 2);
+  EXPECT_EQ(ws.chunk_num(), 1UL);
+  EXPECT_GE(ws.capacity(), capacity * 2);
+}
+
+}  // namespace lite
+}  // namespace paddle
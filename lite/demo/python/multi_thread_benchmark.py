@@ -0,0 +1,90 @@
+# Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+'''
+Paddle-Lite multi-thread python api benchmark, one predictor per python
+thread. `run` releases the GIL and `from_numpy` shares the numpy array
+without a copy, so the throughput should scale with the thread count.
+'''
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import argparse
+import threading
+import time
+
+from paddlelite.lite import *
+import numpy as np
+
+# Command arguments
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--model_dir", default="", type=str, help="Model file of naive buffer")
+parser.add_argument(
+    "--input_shape",
+    default=[1, 3, 224, 224],
+    nargs='+',
+    type=int,
+    required=False,
+    help="Model input shape, eg: 1 3 224 224. Defalut: 1 3 224 224")
+parser.add_argument(
+    "--threads",
+    default=[1, 2, 4],
+    nargs='+',
+    type=int,
+    help="The python thread counts to benchmark. Default: 1 2 4")
+parser.add_argument(
+    "--repeats", default=50, type=int, help="Runs per thread. Default: 50")
+
+
+def Worker(args, predictor):
+    input_data = np.ones(args.input_shape).astype("float32")
+    for _ in range(args.repeats):
+        predictor.get_input(0).from_numpy(input_data)
+        predictor.run()
+        predictor.get_output(0).numpy()
+
+
+def RunModel(args):
+    for thread_num in args.threads:
+        predictors = []
+        for _ in range(thread_num):
+            config = MobileConfig()
+            config.set_model_from_file(args.model_dir)
+            config.set_threads(1)
+            predictor = create_paddle_predictor(config)
+            # Warm up.
+            Worker(argparse.Namespace(
+                input_shape=args.input_shape, repeats=1), predictor)
+            predictors.append(predictor)
+
+        threads = [
+            threading.Thread(
+                target=Worker, args=(args, predictor))
+            for predictor in predictors
+        ]
+        start = time.time()
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        elapsed = time.time() - start
+        print("threads: {}, throughput: {:.2f} runs/s".format(
+            thread_num, thread_num * args.repeats / elapsed))
+
+
+if __name__ == '__main__':
+    args = parser.parse_args()
+    RunModel(args)
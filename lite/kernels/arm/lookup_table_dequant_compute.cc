@@ -47,6 +47,8 @@ void LookupTableDequantCompute::Run() {
   // outputs
   auto out = param.Out;
 
+  CHECK_EQ(param.quant_type, "uint8")
+      << "lookup_table_dequant on ARM only supports uint8 tables";
   auto table_dim = w->dims();
   int64_t ids_numel = ids->numel();
   auto ids_data = ids->data<int64_t>();
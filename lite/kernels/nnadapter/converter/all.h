@@ -30,19 +30,20 @@ REGISTER_CONVERTER(cast,
 REGISTER_CONVERTER(clip,
                    ConvertClip,
                    "huawei_ascend_npu,cambricon_mlu,verisilicon_timvx,huawei_"
-                   "kirin_npu,nvidia_tensorrt,intel_openvino");
+                   "kirin_npu,nvidia_tensorrt,intel_openvino,google_xnnpack");
 REGISTER_CONVERTER(conv2d,
                    ConvertConv2D,
                    "builtin_device,rockchip_npu,mediatek_apu,huawei_kirin_npu,"
                    "huawei_ascend_npu,amlogic_npu,imagination_nna,cambricon_"
                    "mlu,verisilicon_timvx,kunlunxin_xtcl,android_nnapi,nvidia_"
-                   "tensorrt,intel_openvino,qualcomm_qnn,eeasytech_npu,lyf_npu");
+                   "tensorrt,intel_openvino,qualcomm_qnn,eeasytech_npu,lyf_npu,"
+                   "google_xnnpack");
 REGISTER_CONVERTER(depthwise_conv2d,
                    ConvertConv2D,
                    "builtin_device,rockchip_npu,mediatek_apu,huawei_kirin_npu,"
                    "huawei_ascend_npu,amlogic_npu,imagination_nna,verisilicon_"
                    "timvx,kunlunxin_xtcl,android_nnapi,nvidia_tensorrt,intel_"
-                   "openvino,qualcomm_qnn,eeasytech_npu");
+                   "openvino,qualcomm_qnn,eeasytech_npu,google_xnnpack");
 REGISTER_CONVERTER(deformable_conv,
                    ConvertDeformableConv,
                    "huawei_ascend_npu,cambricon_mlu,intel_openvino");
@@ -55,17 +56,18 @@ REGISTER_CONVERTER(pool2d,
                    "builtin_device,rockchip_npu,mediatek_apu,huawei_kirin_npu,"
                    "huawei_ascend_npu,amlogic_npu,imagination_nna,cambricon_"
                    "mlu,verisilicon_timvx,kunlunxin_xtcl,android_nnapi,nvidia_"
-                   "tensorrt,intel_openvino,qualcomm_qnn,eeasytech_npu");
+                   "tensorrt,intel_openvino,qualcomm_qnn,eeasytech_npu,google_"
+                   "xnnpack");
 REGISTER_CONVERTER(matmul,
                    ConvertMatmul,
                    "huawei_ascend_npu,huawei_kirin_npu,imagination_nna,"
                    "verisilicon_timvx,intel_openvino,nvidia_tensorrt,qualcomm_"
-                   "qnn");
+                   "qnn,google_xnnpack");
 REGISTER_CONVERTER(matmul_v2,
                    ConvertMatmulV2,
                    "huawei_ascend_npu,huawei_kirin_npu,imagination_nna,intel_"
                    "openvino,android_nnapi,nvidia_tensorrt,intel_openvino,"
-                   "qualcomm_qnn");
+                   "qualcomm_qnn,google_xnnpack");
 REGISTER_CONVERTER(softmax,
                    ConvertSoftmax,
                    "builtin_device,rockchip_npu,mediatek_apu,huawei_kirin_npu,"
@@ -139,11 +141,11 @@ REGISTER_CONVERTER(elementwise_div,
 REGISTER_CONVERTER(elementwise_max,
                    ConvertElementwise,
                    "huawei_ascend_npu,huawei_kirin_npu,imagination_nna,"
-                   "kunlunxin_xtcl,intel_openvino,qualcomm_qnn");
+                   "kunlunxin_xtcl,intel_openvino,qualcomm_qnn,google_xnnpack");
 REGISTER_CONVERTER(elementwise_min,
                    ConvertElementwise,
                    "huawei_ascend_npu,huawei_kirin_npu,imagination_nna,"
-                   "kunlunxin_xtcl,intel_openvino,qualcomm_qnn");
+                   "kunlunxin_xtcl,intel_openvino,qualcomm_qnn,google_xnnpack");
 REGISTER_CONVERTER(elementwise_pow,
                    ConvertElementwise,
                    "huawei_ascend_npu,huawei_kirin_npu,cambricon_mlu,intel_"
@@ -190,24 +192,25 @@ REGISTER_CONVERTER(sigmoid,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,cambricon_mlu,verisilicon_timvx,kunlunxin_"
                    "xtcl,android_nnapi,nvidia_tensorrt,intel_openvino,"
-                   "eeasytech_npu");
+                   "eeasytech_npu,google_xnnpack");
 REGISTER_CONVERTER(relu,
                    ConvertUnaryActivations,
                    "builtin_device,rockchip_npu,mediatek_apu,huawei_kirin_npu,"
                    "huawei_ascend_npu,amlogic_npu,imagination_nna,cambricon_"
                    "mlu,verisilicon_timvx,kunlunxin_xtcl,android_nnapi,nvidia_"
-                   "tensorrt,intel_openvino,qualcomm_qnn,eeasytech_npu");
+                   "tensorrt,intel_openvino,qualcomm_qnn,eeasytech_npu,google_"
+                   "xnnpack");
 REGISTER_CONVERTER(relu6,
                    ConvertUnaryActivations,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,imagination_nna,cambricon_mlu,verisilicon_"
                    "timvx,kunlunxin_xtcl,android_nnapi,nvidia_tensorrt,intel_"
-                   "openvino,eeasytech_npu,qualcomm_qnn");
+                   "openvino,eeasytech_npu,qualcomm_qnn,google_xnnpack");
 REGISTER_CONVERTER(leaky_relu,
                    ConvertLeakyRelu,
                    "huawei_ascend_npu,huawei_kirin_npu,verisilicon_timvx,"
                    "kunlunxin_xtcl,cambricon_mlu,nvidia_tensorrt,intel_"
-                   "openvino,qualcomm_qnn");
+                   "openvino,qualcomm_qnn,google_xnnpack");
 REGISTER_CONVERTER(tanh,
                    ConvertUnaryActivations,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
@@ -216,7 +219,8 @@ REGISTER_CONVERTER(tanh,
                    "eeasytech_npu,qualcomm_qnn");
 REGISTER_CONVERTER(abs,
                    ConvertUnaryActivations,
-                   "huawei_ascend_npu,huawei_kirin_npu,intel_openvino");
+                   "huawei_ascend_npu,huawei_kirin_npu,intel_openvino,google_"
+                   "xnnpack");
 REGISTER_CONVERTER(exp,
                    ConvertUnaryActivations,
                    "huawei_ascend_npu,huawei_kirin_npu,intel_openvino,nvidia_"
@@ -247,7 +251,8 @@ REGISTER_CONVERTER(
 REGISTER_CONVERTER(hard_swish,
                    ConvertHardSwish,
                    "huawei_ascend_npu,huawei_kirin_npu,verisilicon_timvx,"
-                   "nvidia_tensorrt,intel_openvino,eeasytech_npu");
+                   "nvidia_tensorrt,intel_openvino,eeasytech_npu,google_"
+                   "xnnpack");
 REGISTER_CONVERTER(arg_max,
                    ConvertArgMinMax,
                    "huawei_ascend_npu,huawei_kirin_npu,nvidia_tensorrt,"
@@ -306,13 +311,13 @@ REGISTER_CONVERTER(transpose,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,android_"
                    "nnapi,nvidia_tensorrt,intel_openvino,qualcomm_qnn,"
-                   "cambricon_mlu");
+                   "cambricon_mlu,google_xnnpack");
 REGISTER_CONVERTER(transpose2,
                    ConvertTranspose,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,android_"
                    "nnapi,nvidia_tensorrt,intel_openvino,qualcomm_qnn,"
-                   "cambricon_mlu");
+                   "cambricon_mlu,google_xnnpack");
 REGISTER_CONVERTER(shape,
                    ConvertShape,
                    "huawei_ascend_npu,cambricon_mlu,nvidia_tensorrt,intel_"
@@ -355,7 +360,7 @@ REGISTER_CONVERTER(concat,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,cambricon_"
                    "mlu,android_nnapi,nvidia_tensorrt,intel_openvino,eeasytech_"
-                   "npu,qualcomm_qnn");
+                   "npu,qualcomm_qnn,google_xnnpack");
 REGISTER_CONVERTER(split,
                    ConvertSplit,
                    "huawei_kirin_npu,huawei_ascend_npu,kunlunxin_xtcl,"
@@ -374,34 +379,37 @@ REGISTER_CONVERTER(nearest_interp_v2,
 REGISTER_CONVERTER(bilinear_interp,
                    ConvertInterpolate,
                    "huawei_ascend_npu,verisilicon_timvx,cambricon_mlu,huawei_"
-                   "kirin_npu,nvidia_tensorrt,eeasytech_npu,qualcomm_qnn");
+                   "kirin_npu,nvidia_tensorrt,eeasytech_npu,qualcomm_qnn,"
+                   "google_xnnpack");
 REGISTER_CONVERTER(bilinear_interp_v2,
                    ConvertInterpolate,
                    "huawei_ascend_npu,verisilicon_timvx,cambricon_mlu,huawei_"
                    "kirin_npu,nvidia_tensorrt,eeasytech_npu,intel_openvino,"
-                   "qualcomm_qnn");
+                   "qualcomm_qnn,google_xnnpack");
 REGISTER_CONVERTER(flatten,
                    ConvertFlatten,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,cambricon_"
-                   "mlu,android_nnapi,nvidia_tensorrt,intel_openvino");
+                   "mlu,android_nnapi,nvidia_tensorrt,intel_openvino,google_"
+                   "xnnpack");
 REGISTER_CONVERTER(flatten2,
                    ConvertFlatten,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,cambricon_"
-                   "mlu,android_nnapi,nvidia_tensorrt,intel_openvino");
+                   "mlu,android_nnapi,nvidia_tensorrt,intel_openvino,google_"
+                   "xnnpack");
 REGISTER_CONVERTER(flatten_contiguous_range,
                    ConvertFlattenContiguousRange,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,cambricon_"
                    "mlu,android_nnapi,nvidia_tensorrt,intel_openvino,qualcomm_"
-                   "qnn");
+                   "qnn,google_xnnpack");
 REGISTER_CONVERTER(fc,
                    ConvertFC,
                    "builtin_device,rockchip_npu,mediatek_apu,huawei_kirin_npu,"
                    "huawei_ascend_npu,amlogic_npu,imagination_nna,cambricon_"
                    "mlu,verisilicon_timvx,kunlunxin_xtcl,android_nnapi,nvidia_"
-                   "tensorrt,intel_openvino,qualcomm_qnn");
+                   "tensorrt,intel_openvino,qualcomm_qnn,google_xnnpack");
 REGISTER_CONVERTER(norm,
                    ConvertNorm,
                    "huawei_ascend_npu,cambricon_mlu,huawei_kirin_npu");
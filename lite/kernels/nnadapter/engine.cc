@@ -15,12 +15,15 @@
 #include "lite/kernels/nnadapter/engine.h"
 #include <sys/time.h>
 #include <time.h>
+#include <algorithm>
+#include <cstring>
 #include <functional>
 #include <utility>
 #include "lite/core/op_registry.h"
 #include "lite/kernels/nnadapter/converter/converter.h"
 #include "lite/utils/env.h"
 #include "lite/utils/md5.h"
+#include "lite/utils/string.h"
 
 namespace paddle {
 namespace lite {
@@ -114,6 +117,83 @@ void* AccessModelOutput(void* memory,
   return tensor->raw_data();
 }
 
+void PadTensor(const Tensor& input,
+               const std::vector<int64_t>& output_shape,
+               Tensor* output) {
+  auto input_shape = input.dims().Vectorize();
+  auto rank = input_shape.size();
+  CHECK_EQ(rank, output_shape.size());
+  auto element_size = PrecisionTypeLength(input.precision());
+  output->Resize(output_shape);
+  output->set_precision(input.precision());
+  auto output_data = static_cast<int8_t*>(output->mutable_data(
+      TARGET(kHost), output->dims().production() * element_size));
+  memset(output_data, 0, output->memory_size());
+  auto input_count = input.dims().production();
+  if (rank == 0 || input_count == 0) return;
+  auto input_data = static_cast<const int8_t*>(input.raw_data());
+  std::vector<int64_t> output_strides(rank, 1);
+  for (int i = static_cast<int>(rank) - 2; i >= 0; i--) {
+    output_strides[i] = output_strides[i + 1] * output_shape[i + 1];
+  }
+  // Copy the innermost rows one by one
+  auto row_size = input_shape[rank - 1];
+  auto row_count = input_count / row_size;
+  for (int64_t i = 0; i < row_count; i++) {
+    int64_t offset = 0;
+    int64_t remain = i;
+    for (int j = static_cast<int>(rank) - 2; j >= 0; j--) {
+      offset += (remain % input_shape[j]) * output_strides[j];
+      remain /= input_shape[j];
+    }
+    memcpy(output_data + offset * element_size,
+           input_data + i * row_size * element_size,
+           row_size * element_size);
+  }
+}
+
+void CropTensor(const std::vector<int64_t>& shape, Tensor* tensor) {
+  auto origin_shape = tensor->dims().Vectorize();
+  if (origin_shape == shape) return;
+  auto rank = origin_shape.size();
+  CHECK_EQ(rank, shape.size());
+  for (size_t i = 0; i < rank; i++) {
+    CHECK_LE(shape[i], origin_shape[i]);
+  }
+  auto element_size = PrecisionTypeLength(tensor->precision());
+  auto data = static_cast<int8_t*>(tensor->raw_data());
+  auto count = DDim(shape).production();
+  tensor->Resize(shape);
+  if (rank == 0 || count == 0) return;
+  std::vector<int64_t> origin_strides(rank, 1);
+  for (int i = static_cast<int>(rank) - 2; i >= 0; i--) {
+    origin_strides[i] = origin_strides[i + 1] * origin_shape[i + 1];
+  }
+  // Move the innermost rows forward one by one, a row never overlaps with the
+  // rows after it
+  auto row_size = shape[rank - 1];
+  auto row_count = count / row_size;
+  for (int64_t i = 0; i < row_count; i++) {
+    int64_t offset = 0;
+    int64_t remain = i;
+    for (int j = static_cast<int>(rank) - 2; j >= 0; j--) {
+      offset += (remain % shape[j]) * origin_strides[j];
+      remain /= shape[j];
+    }
+    memmove(data + i * row_size * element_size,
+            data + offset * element_size,
+            row_size * element_size);
+  }
+}
+
+ProgramCache::Shapes GetInputShapes(const std::vector<Variable>& input_vars) {
+  ProgramCache::Shapes input_shapes;
+  for (auto& input_var : input_vars) {
+    input_shapes.push_back(input_var.value->dims().Vectorize());
+  }
+  return input_shapes;
+}
+
 Program::~Program() {
   if (execution_) {
     NNAdapterExecution_destroy_invoke(execution_);
@@ -209,10 +289,12 @@ bool Program::SetInputsAndOutputs(std::vector<Variable>* input_vars,
   CHECK_EQ(input_count, input_vars->size());
   CHECK_EQ(output_count, output_vars->size());
   // Create an execution for executing the compiled device program
-  result = NNAdapterExecution_create_invoke(compilation_, &execution_);
-  if (result != NNADAPTER_NO_ERROR) {
-    LOG(FATAL) << "Create a execution failed(" << result << ") !";
-    return false;
+  if (!execution_) {
+    result = NNAdapterExecution_create_invoke(compilation_, &execution_);
+    if (result != NNADAPTER_NO_ERROR) {
+      LOG(FATAL) << "Create a execution failed(" << result << ") !";
+      return false;
+    }
   }
   // Set the model input and output tensors and the functions to access them
   for (uint32_t i = 0; i < input_count; i++) {
@@ -249,6 +331,111 @@ int Program::Execute() {
   return NNADAPTER_NO_ERROR;
 }
 
+PipelinedExecutor::PipelinedExecutor(std::function<bool(int)> execute)
+    : execute_(execute), worker_(&PipelinedExecutor::Work, this) {}
+
+PipelinedExecutor::~PipelinedExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+void PipelinedExecutor::Work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return stop_ || running_index_ >= 0; });
+    // Finish the launched execution before stopping
+    if (running_index_ < 0) break;
+    auto index = running_index_;
+    lock.unlock();
+    CHECK(execute_(index)) << "Program execute failed.";
+    lock.lock();
+    running_index_ = -1;
+    cv_.notify_all();
+  }
+}
+
+int PipelinedExecutor::Launch(int index) {
+  CHECK_GE(index, 0);
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return running_index_ < 0; });
+  auto previous_index = pending_index_;
+  running_index_ = index;
+  pending_index_ = index;
+  cv_.notify_all();
+  return previous_index;
+}
+
+void PipelinedExecutor::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return running_index_ < 0; });
+}
+
+int PipelinedExecutor::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return running_index_ < 0; });
+  auto index = pending_index_;
+  pending_index_ = -1;
+  return index;
+}
+
+std::shared_ptr<Program> ProgramCache::Get(const Shapes& input_shapes) {
+  auto it = indexes_.find(input_shapes);
+  if (it == indexes_.end()) return nullptr;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->program;
+}
+
+void ProgramCache::Put(const Shapes& input_shapes,
+                       std::shared_ptr<Program> program,
+                       size_t memory_size) {
+  auto it = std::find_if(
+      entries_.begin(), entries_.end(), [&](const Entry& entry) {
+        return entry.program == program;
+      });
+  if (it == entries_.end()) {
+    entries_.push_front(Entry{program, {}, memory_size});
+    memory_size_ += memory_size;
+  } else {
+    entries_.splice(entries_.begin(), entries_, it);
+  }
+  entries_.front().input_shapes.insert(input_shapes);
+  indexes_[input_shapes] = entries_.begin();
+  // Release the least recently used programs except the current one
+  while (entries_.size() > 1 &&
+         ((capacity_ > 0 && entries_.size() > capacity_) ||
+          (memory_budget_ > 0 && memory_size_ > memory_budget_))) {
+    auto& entry = entries_.back();
+    VLOG(3) << "Release the least recently used program with "
+            << entry.input_shapes.size() << " input shapes and "
+            << entry.memory_size << " bytes.";
+    for (auto& shapes : entry.input_shapes) {
+      indexes_.erase(shapes);
+    }
+    memory_size_ -= entry.memory_size;
+    entries_.pop_back();
+  }
+}
+
+std::vector<std::shared_ptr<Program>> ProgramCache::GetPrograms() {
+  std::vector<std::shared_ptr<Program>> programs;
+  for (auto& entry : entries_) {
+    programs.push_back(entry.program);
+  }
+  return programs;
+}
+
+std::vector<ProgramCache::Shapes> ProgramCache::GetShapes() {
+  std::vector<Shapes> shapes;
+  for (auto& index : indexes_) {
+    shapes.push_back(index.first);
+  }
+  return shapes;
+}
+
 Engine::Engine(KernelContext* ctx,
                const cpp::BlockDesc* block_desc,
                Scope* exec_scope,
@@ -326,10 +513,107 @@ Engine::Engine(KernelContext* ctx,
   model_cache_dir_ =
       ctx_->As<NNAdapterContext>().NNAdapterModelCacheDir(exec_scope_);
   VLOG(3) << "NNAdapter model_cache_dir: " << model_cache_dir_;
+  // Create the program cache with the limits of the number and the memory
+  auto program_cache_capacity =
+      GetIntFromEnv(SUBGRAPH_PROGRAM_CACHE_CAPACITY, 0);
+  auto program_cache_memory_budget =
+      GetIntFromEnv(SUBGRAPH_PROGRAM_CACHE_MEMORY_BUDGET, 0);
+  VLOG(3) << "NNAdapter program cache capacity: " << program_cache_capacity
+          << ", memory budget: " << program_cache_memory_budget << "MB";
+  programs_.reset(
+      new ProgramCache(std::max(program_cache_capacity, 0),
+                       std::max(program_cache_memory_budget, 0) * 1024UL *
+                           1024UL));
+  // Parse the axes of the inputs which can be padded, such as 'x:3;y:1,2'
+  auto padding_input_axes = GetStringFromEnv(SUBGRAPH_PADDING_INPUT_AXES);
+  if (!padding_input_axes.empty()) {
+    padding_axes_.resize(input_count);
+    for (auto& item : Split(padding_input_axes, ";")) {
+      auto name_axes = Split(item, ":");
+      CHECK_EQ(name_axes.size(), 2) << "Invalid padding input axes '" << item
+                                    << "', expected 'name:axis0,axis1'.";
+      for (size_t i = 0; i < input_count; i++) {
+        if (input_vars_[i].name == name_axes[0]) {
+          padding_axes_[i] = Split<int>(name_axes[1], ",");
+        }
+      }
+    }
+    // Parse the output axes which follow the padded input axes, such as
+    // 'out:1=x:3,2=y:1;mask:', it means the 2nd axis of 'out' follows the 4th
+    // axis of 'x', its 3rd axis follows the 2nd axis of 'y', and 'mask' is not
+    // affected by the padding
+    auto padding_output_axes = GetStringFromEnv(SUBGRAPH_PADDING_OUTPUT_AXES);
+    for (auto& item : Split(padding_output_axes, ";")) {
+      auto pos = item.find(':');
+      CHECK(pos != std::string::npos)
+          << "Invalid padding output axes '" << item
+          << "', expected 'name:axis0=input:axis0,axis1=input:axis1'.";
+      auto& output_axes = output_padding_axes_[item.substr(0, pos)];
+      for (auto& pair : Split(item.substr(pos + 1), ",")) {
+        auto axis_input = Split(pair, "=");
+        CHECK_EQ(axis_input.size(), 2)
+            << "Invalid padding output axis '" << pair
+            << "', expected 'axis=input:axis'.";
+        auto name_axis = Split(axis_input[1], ":");
+        CHECK_EQ(name_axis.size(), 2)
+            << "Invalid padding output axis '" << pair
+            << "', expected 'axis=input:axis'.";
+        size_t input_index = 0;
+        while (input_index < input_count &&
+               input_vars_[input_index].name != name_axis[0]) {
+          input_index++;
+        }
+        CHECK_LT(input_index, input_count) << "Input '" << name_axis[0]
+                                           << "' not found.";
+        output_axes.push_back({parse_string<int>(axis_input[0]),
+                               input_index,
+                               parse_string<int>(name_axis[1])});
+      }
+    }
+    // The outputs can't be cropped back if any of them is not specified
+    for (auto& output_var : output_vars_) {
+      if (!output_padding_axes_.count(output_var.name)) {
+        LOG(WARNING) << "The padding is disabled since the axes of the output '"
+                     << output_var.name << "' are not specified by "
+                     << SUBGRAPH_PADDING_OUTPUT_AXES << ".";
+        padding_axes_.clear();
+        break;
+      }
+    }
+    padded_input_vars_ = input_vars_;
+    for (auto& input_var : padded_input_vars_) {
+      padded_tensors_.emplace_back(new Tensor());
+      input_var.value = padded_tensors_.back().get();
+    }
+  }
+  // Allocate the double buffers for the pipelined execution
+  auto pipelined =
+      ctx_->As<NNAdapterContext>().NNAdapterPipelinedExecution(exec_scope_);
+  VLOG(3) << "NNAdapter pipelined execution: " << pipelined;
+  if (pipelined) {
+    for (int i = 0; i < 2; i++) {
+      pipelined_input_vars_[i] = input_vars_;
+      for (auto& input_var : pipelined_input_vars_[i]) {
+        pipelined_tensors_.emplace_back(new Tensor());
+        input_var.value = pipelined_tensors_.back().get();
+      }
+      pipelined_output_vars_[i] = output_vars_;
+      for (auto& output_var : pipelined_output_vars_[i]) {
+        pipelined_tensors_.emplace_back(new Tensor());
+        output_var.value = pipelined_tensors_.back().get();
+      }
+    }
+    pipelined_executor_.reset(new PipelinedExecutor([this](int index) {
+      return Execute(&pipelined_input_vars_[index],
+                     &pipelined_output_vars_[index]);
+    }));
+  }
 }
 
 Engine::~Engine() {
-  programs_.clear();
+  // Stop the worker thread before the programs are released
+  pipelined_executor_.reset();
+  programs_.reset();
   NNAdapterContext_destroy_invoke(context_);
   for (auto* device : devices_) {
     NNAdapterDevice_release_invoke(device);
@@ -337,19 +621,55 @@ Engine::~Engine() {
 }
 
 bool Engine::Run() {
-  // Try to execute all cached programs.
-  for (auto program : programs_) {
+  if (pipelined_executor_) {
+    return RunPipelined();
+  }
+  return Execute(&input_vars_, &output_vars_);
+}
+
+bool Engine::Execute(std::vector<Variable>* input_vars,
+                     std::vector<Variable>* output_vars) {
+  if (!padding_axes_.empty() && PadInputs(*input_vars)) {
+    CHECK(ExecuteProgram(&padded_input_vars_, output_vars));
+    CropOutputs(*input_vars, output_vars);
+    return true;
+  }
+  return ExecuteProgram(input_vars, output_vars);
+}
+
+bool Engine::ExecuteProgram(std::vector<Variable>* input_vars,
+                            std::vector<Variable>* output_vars) {
+  // Find the program by the input shapes, the variables of the current run are
+  // bound since they may be the double buffers or the padded inputs
+  auto input_shapes = GetInputShapes(*input_vars);
+  auto program = programs_->Get(input_shapes);
+  if (program) {
+    CHECK(program->SetInputsAndOutputs(input_vars, output_vars));
     int ret = program->Execute();
-    if (ret == NNADAPTER_INVALID_DIMENSIONS) {
-      VLOG(1) << "Warning: Input shapes are not supported by the program, try "
-                 "the next "
-                 "program.";
-      continue;
-    }
     CHECK_EQ(ret, static_cast<int>(NNADAPTER_NO_ERROR))
         << "Program execute failed.";
     return true;
   }
+  // Try to execute the cached programs built with the dynamic shapes
+  bool dynamic = false;
+  for (auto& input_var : *input_vars) {
+    dynamic |= !input_var.dynamic_dimensions.empty();
+  }
+  if (dynamic) {
+    for (auto program : programs_->GetPrograms()) {
+      CHECK(program->SetInputsAndOutputs(input_vars, output_vars));
+      int ret = program->Execute();
+      if (ret == NNADAPTER_INVALID_DIMENSIONS) {
+        VLOG(1) << "Warning: Input shapes are not supported by the program, "
+                   "try the next program.";
+        continue;
+      }
+      CHECK_EQ(ret, static_cast<int>(NNADAPTER_NO_ERROR))
+          << "Program execute failed.";
+      programs_->Put(input_shapes, program, 0);
+      return true;
+    }
+  }
   // Rebuild the device program corresponding to the input dimensions if not
   // find valid program.
   VLOG(1) << "Warning: No suitable program found for current input shapes, try "
@@ -360,11 +680,11 @@ bool Engine::Run() {
     NNAdapterDevice_getName_invoke(device, &name);
     device_names.push_back(name);
   }
-  auto program = std::make_shared<Program>(context_);
+  program = std::make_shared<Program>(context_);
   // Take the model cache buffer from the scope
   std::vector<char> model_cache_buffer;
   // Generate a cache token based on the input names and shapes
-  auto model_cache_token = GenerateModelCacheToken(device_names, input_vars_);
+  auto model_cache_token = GenerateModelCacheToken(device_names, *input_vars);
   VLOG(3) << "NNAdapter model_cache_token: " << model_cache_token;
   ctx_->As<NNAdapterContext>().NNAdapterModelCacheBuffers(
       exec_scope_, model_cache_token, &model_cache_buffer);
@@ -376,17 +696,190 @@ bool Engine::Run() {
     // the file
     CHECK(program->BuildAndCacheToFile(block_desc_,
                                        exec_scope_,
-                                       input_vars_,
-                                       &output_vars_,
+                                       *input_vars,
+                                       output_vars,
                                        model_cache_token,
                                        model_cache_dir_));
   }
   CHECK(program->IsValid());
-  CHECK(program->SetInputsAndOutputs(&input_vars_, &output_vars_));
-  programs_.push_back(program);
+  CHECK(program->SetInputsAndOutputs(input_vars, output_vars));
   int ret = program->Execute();
   CHECK_EQ(ret, static_cast<int>(NNADAPTER_NO_ERROR))
       << "Program execute failed.";
+  programs_->Put(input_shapes,
+                 program,
+                 EstimateProgramMemorySize(*input_vars, *output_vars));
+  return true;
+}
+
+bool Engine::PadInputs(const std::vector<Variable>& input_vars) {
+  auto input_count = input_vars.size();
+  auto input_shapes = GetInputShapes(input_vars);
+  auto is_padding_axis = [&](size_t i, int axis) {
+    return std::find(padding_axes_[i].begin(), padding_axes_[i].end(), axis) !=
+           padding_axes_[i].end();
+  };
+  // Find the smallest shapes of the cached programs which the inputs can be
+  // padded to
+  ProgramCache::Shapes padded_shapes;
+  int64_t min_count = -1;
+  for (auto& shapes : programs_->GetShapes()) {
+    bool matched = true;
+    int64_t count = 0;
+    for (size_t i = 0; i < input_count && matched; i++) {
+      matched = shapes[i].size() == input_shapes[i].size();
+      for (size_t j = 0; j < shapes[i].size() && matched; j++) {
+        matched = shapes[i][j] == input_shapes[i][j] ||
+                  (shapes[i][j] > input_shapes[i][j] && is_padding_axis(i, j));
+      }
+      count += DDim(shapes[i]).production();
+    }
+    if (matched && (min_count < 0 || count < min_count)) {
+      padded_shapes = shapes;
+      min_count = count;
+    }
+  }
+  // Round up the padding axes to the powers of 2 to build a new program
+  if (min_count < 0) {
+    padded_shapes = input_shapes;
+    for (size_t i = 0; i < input_count; i++) {
+      for (auto axis : padding_axes_[i]) {
+        if (axis < 0 || axis >= static_cast<int>(input_shapes[i].size())) {
+          continue;
+        }
+        int64_t dimension = 1;
+        while (dimension < input_shapes[i][axis]) dimension <<= 1;
+        padded_shapes[i][axis] = dimension;
+      }
+    }
+  }
+  if (padded_shapes == input_shapes) return false;
+  for (size_t i = 0; i < input_count; i++) {
+    PadTensor(
+        *input_vars[i].value, padded_shapes[i], padded_input_vars_[i].value);
+  }
+  return true;
+}
+
+void Engine::CropOutputs(const std::vector<Variable>& input_vars,
+                         std::vector<Variable>* output_vars) {
+  for (auto& output_var : *output_vars) {
+    auto output = output_var.value;
+    auto shape = output->dims().Vectorize();
+    for (auto& axis : output_padding_axes_[output_var.name]) {
+      CHECK_GE(axis.output_axis, 0);
+      CHECK_LT(axis.output_axis, static_cast<int>(shape.size()));
+      auto& input_dims = input_vars[axis.input_index].value->dims();
+      CHECK_GE(axis.input_axis, 0);
+      CHECK_LT(axis.input_axis, static_cast<int>(input_dims.size()));
+      auto extent = input_dims[axis.input_axis];
+      auto padded_extent =
+          padded_input_vars_[axis.input_index].value->dims()[axis.input_axis];
+      auto& dimension = shape[axis.output_axis];
+      dimension = (dimension * extent + padded_extent - 1) / padded_extent;
+    }
+    CHECK(output->target() == TARGET(kHost))
+        << "Only the host outputs can be cropped.";
+    CropTensor(shape, output);
+  }
+}
+
+size_t Engine::EstimateProgramMemorySize(
+    const std::vector<Variable>& input_vars,
+    const std::vector<Variable>& output_vars) {
+  // The weights are held by each program
+  if (weight_memory_size_ == 0) {
+    std::set<std::string> weight_names;
+    for (size_t i = 0; i < block_desc_->OpsSize(); i++) {
+      OpInfo op_info(*block_desc_->GetOp<cpp::OpDesc>(i));
+      for (auto& name : op_info.input_names()) {
+        auto tensor = exec_scope_->FindTensor(name);
+        if (tensor && tensor->persistable() &&
+            weight_names.insert(name).second) {
+          weight_memory_size_ += tensor->memory_size();
+        }
+      }
+    }
+  }
+  auto memory_size = weight_memory_size_;
+  for (auto& input_var : input_vars) {
+    memory_size += input_var.value->memory_size();
+  }
+  for (auto& output_var : output_vars) {
+    memory_size += output_var.value->memory_size();
+  }
+  return memory_size;
+}
+
+void Engine::ShareOutputsWithBuffers(int index) {
+  auto& output_vars = pipelined_output_vars_[index];
+  // Some outputs may be removed when building the device program, so remove
+  // them from the origin outputs and the other buffers too
+  if (output_vars.size() != output_vars_.size()) {
+    auto remove_outputs = [&](std::vector<Variable>* vars) {
+      std::vector<Variable> valid_vars;
+      for (auto& var : *vars) {
+        for (auto& output_var : output_vars) {
+          if (var.name == output_var.name) {
+            valid_vars.push_back(var);
+            break;
+          }
+        }
+      }
+      *vars = valid_vars;
+    };
+    remove_outputs(&output_vars_);
+    remove_outputs(&pipelined_output_vars_[1 - index]);
+  }
+  // The buffers will not be written until the run after the next one is
+  // launched, so the ops after the subgraph can read them safely
+  for (size_t i = 0; i < output_vars.size(); i++) {
+    output_vars_[i].value->ShareDataWith(*output_vars[i].value);
+  }
+}
+
+void Engine::ZeroOutputsLikeBuffers(int index) {
+  // Remove the outputs which are removed by the device program too
+  ShareOutputsWithBuffers(index);
+  auto& output_vars = pipelined_output_vars_[index];
+  for (size_t i = 0; i < output_vars.size(); i++) {
+    auto* output = output_vars[i].value;
+    // Allocate a new buffer rather than writing the shared one
+    Tensor zeros;
+    zeros.Resize(output->dims());
+    zeros.set_precision(output->precision());
+    memset(zeros.mutable_data(TARGET(kHost), output->memory_size()),
+           0,
+           output->memory_size());
+    output_vars_[i].value->ShareDataWith(zeros);
+  }
+}
+
+bool Engine::RunPipelined() {
+  if (ctx_->As<NNAdapterContext>().NNAdapterPipelinedFlush(exec_scope_)) {
+    auto index = pipelined_executor_->Flush();
+    if (index >= 0) {
+      ShareOutputsWithBuffers(index);
+    }
+    return true;
+  }
+  // The buffers of the last launched run may be executed by the device, and
+  // the ones of the run before it are not read by the host ops any more
+  auto index = pipelined_index_;
+  pipelined_index_ = 1 - index;
+  auto& input_vars = pipelined_input_vars_[index];
+  for (size_t i = 0; i < input_vars.size(); i++) {
+    input_vars[i].value->CopyDataFrom(*input_vars_[i].value);
+  }
+  auto previous_index = pipelined_executor_->Launch(index);
+  if (previous_index >= 0) {
+    ShareOutputsWithBuffers(previous_index);
+  } else {
+    // Nothing is delivered by the first run after the creation or a flush,
+    // wait for the current run to get the shapes of its outputs
+    pipelined_executor_->Wait();
+    ZeroOutputsLikeBuffers(index);
+  }
   return true;
 }
 
@@ -14,10 +14,15 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <set>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 #include "lite/backends/nnadapter/nnadapter_wrapper.h"
 #include "lite/core/program.h"
@@ -51,8 +56,8 @@ class Program {
                            std::vector<Variable>* output_vars,
                            const std::string& model_cache_token,
                            const std::string& model_cache_dir);
-  // Create an execution, set the model input and output variables and the
-  // functions to access them
+  // Create an execution if it doesn't exist, set the model input and output
+  // variables and the functions to access them
   bool SetInputsAndOutputs(std::vector<Variable>* input_vars,
                            std::vector<Variable>* output_vars);
   int Execute();
@@ -66,6 +71,79 @@ class Program {
   ::NNAdapterContext* context_{nullptr};
 };
 
+// Copy the input tensor to the beginning of each axis of the output tensor, and
+// fill the rest with zeros
+void PadTensor(const Tensor& input,
+               const std::vector<int64_t>& output_shape,
+               Tensor* output);
+// Keep the beginning of each axis of the tensor in place
+void CropTensor(const std::vector<int64_t>& shape, Tensor* tensor);
+
+// The device programs cached by their input shapes, the least recently used
+// one is released if the number of the programs exceeds the capacity or their
+// estimated memory exceeds the budget, 0 means unlimited.
+class ProgramCache {
+ public:
+  typedef std::vector<std::vector<int64_t>> Shapes;
+  ProgramCache(size_t capacity, size_t memory_budget)
+      : capacity_(capacity), memory_budget_(memory_budget) {}
+  // Find the program which has been executed with the input shapes, and mark
+  // it as the most recently used one
+  std::shared_ptr<Program> Get(const Shapes& input_shapes);
+  // Add a new program or add the input shapes to a cached program(built with
+  // the dynamic shapes), and release the least recently used programs
+  void Put(const Shapes& input_shapes,
+           std::shared_ptr<Program> program,
+           size_t memory_size);
+  // All of the cached programs, the most recently used one is the first
+  std::vector<std::shared_ptr<Program>> GetPrograms();
+  // All of the input shapes of the cached programs
+  std::vector<Shapes> GetShapes();
+
+ private:
+  struct Entry {
+    std::shared_ptr<Program> program;
+    std::set<Shapes> input_shapes;
+    size_t memory_size;
+  };
+  size_t capacity_{0};
+  size_t memory_budget_{0};
+  size_t memory_size_{0};
+  std::list<Entry> entries_;
+  std::map<Shapes, std::list<Entry>::iterator> indexes_;
+};
+
+// Execute the device programs on a persistent worker thread one at a time, so
+// the device execution of a run overlaps with the host ops of the next run. A
+// launched execution is pending until it's returned by the next Launch or
+// Flush, so the outputs of each run are delivered exactly once and in order.
+class PipelinedExecutor {
+ public:
+  // <execute>: execute the device program with the index-th buffers
+  explicit PipelinedExecutor(std::function<bool(int)> execute);
+  ~PipelinedExecutor();
+  // Launch the execution with the index-th buffers after the previous one is
+  // finished, and return the index of the previous one or -1 if none
+  int Launch(int index);
+  // Wait for the launched execution
+  void Wait();
+  // Wait for the launched execution and return its index or -1 if none
+  int Flush();
+
+ private:
+  void Work();
+
+  std::function<bool(int)> execute_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // The index of the execution which is running on the worker, -1 if idle
+  int running_index_{-1};
+  // The index of the execution which has not been returned yet
+  int pending_index_{-1};
+  bool stop_{false};
+  std::thread worker_;
+};
+
 class Engine {
  public:
   Engine(KernelContext* ctx,
@@ -78,6 +156,36 @@ class Engine {
   ~Engine();
   bool Run();
 
+ private:
+  // Execute with the padded inputs if any, and crop the outputs back
+  bool Execute(std::vector<Variable>* input_vars,
+               std::vector<Variable>* output_vars);
+  // Execute the cached program which supports the shapes of the input
+  // variables, or build a new one if not found
+  bool ExecuteProgram(std::vector<Variable>* input_vars,
+                      std::vector<Variable>* output_vars);
+  // Pad the input variables to the shapes of a cached program or the rounded
+  // up shapes for building a new one, return false if no padding is needed
+  bool PadInputs(const std::vector<Variable>& input_vars);
+  // Crop the output axes which follow the padded input axes in proportion to
+  // the extents of the input axes before the padding, which is exact only if
+  // the output extents are proportional to the input extents, see
+  // SUBGRAPH_PADDING_OUTPUT_AXES
+  void CropOutputs(const std::vector<Variable>& input_vars,
+                   std::vector<Variable>* output_vars);
+  // The estimated memory size of a program, including the weights and the
+  // inputs and outputs
+  size_t EstimateProgramMemorySize(const std::vector<Variable>& input_vars,
+                                   const std::vector<Variable>& output_vars);
+  // Launch the device execution of the current run on the worker thread, and
+  // return the outputs of the previous run, or the outputs of the last run if
+  // it's a flush
+  bool RunPipelined();
+  // Share the output buffers of a finished run with the origin outputs
+  void ShareOutputsWithBuffers(int index);
+  // Fill the origin outputs with zeros in the shapes of a finished run
+  void ZeroOutputsLikeBuffers(int index);
+
  private:
   KernelContext* ctx_{nullptr};
   const cpp::BlockDesc* block_desc_{nullptr};
@@ -86,8 +194,26 @@ class Engine {
   std::vector<Variable> output_vars_;
   std::vector<NNAdapterDevice*> devices_;
   ::NNAdapterContext* context_{nullptr};
-  std::vector<std::shared_ptr<Program>> programs_;
+  std::unique_ptr<ProgramCache> programs_;
+  // The axes of each input which can be padded with zeros
+  std::vector<std::vector<int>> padding_axes_;
+  // The axes of each output which follow the padded input axes
+  struct OutputPaddingAxis {
+    int output_axis;
+    size_t input_index;
+    int input_axis;
+  };
+  std::map<std::string, std::vector<OutputPaddingAxis>> output_padding_axes_;
+  std::vector<Variable> padded_input_vars_;
+  std::vector<std::unique_ptr<Tensor>> padded_tensors_;
+  size_t weight_memory_size_{0};
   std::string model_cache_dir_{""};
+  // The double buffers used by the pipelined execution
+  std::vector<std::unique_ptr<Tensor>> pipelined_tensors_;
+  std::vector<Variable> pipelined_input_vars_[2];
+  std::vector<Variable> pipelined_output_vars_[2];
+  int pipelined_index_{0};
+  std::unique_ptr<PipelinedExecutor> pipelined_executor_;
 };
 
 }  // namespace nnadapter
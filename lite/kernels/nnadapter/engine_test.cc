@@ -0,0 +1,178 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/nnadapter/engine.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace nnadapter {
+
+TEST(PipelinedExecutor, ordering_and_flush) {
+  // Each execution doubles the input of its buffers after a simulated latency
+  int inputs[2] = {0, 0};
+  int outputs[2] = {0, 0};
+  std::vector<int> executed;
+  std::vector<std::thread::id> thread_ids;
+  std::atomic<int> running{0};
+  PipelinedExecutor executor([&](int index) {
+    EXPECT_EQ(running.fetch_add(1), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    outputs[index] = inputs[index] * 2;
+    executed.push_back(inputs[index]);
+    thread_ids.push_back(std::this_thread::get_id());
+    running--;
+    return true;
+  });
+  // The results of each run are delivered by the next run or the flush
+  std::vector<int> delivered;
+  int index = 0;
+  for (int run = 1; run <= 5; run++) {
+    inputs[index] = run;
+    auto previous_index = executor.Launch(index);
+    if (run == 1) {
+      EXPECT_EQ(previous_index, -1);
+    } else {
+      ASSERT_EQ(previous_index, 1 - index);
+      delivered.push_back(outputs[previous_index]);
+    }
+    index = 1 - index;
+  }
+  auto last_index = executor.Flush();
+  ASSERT_EQ(last_index, 1 - index);
+  delivered.push_back(outputs[last_index]);
+  EXPECT_EQ(delivered, std::vector<int>({2, 4, 6, 8, 10}));
+  EXPECT_EQ(executed, std::vector<int>({1, 2, 3, 4, 5}));
+  // Nothing is pending after the flush
+  EXPECT_EQ(executor.Flush(), -1);
+  EXPECT_EQ(executor.Launch(index), -1);
+  executor.Wait();
+  EXPECT_EQ(executed.size(), 6u);
+  // All of the executions are on the same worker thread
+  for (auto thread_id : thread_ids) {
+    EXPECT_EQ(thread_id, thread_ids.front());
+  }
+  EXPECT_NE(thread_ids.front(), std::this_thread::get_id());
+}
+
+TEST(PipelinedExecutor, finish_launched_execution_on_destruction) {
+  bool executed = false;
+  {
+    PipelinedExecutor executor([&](int index) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      executed = true;
+      return true;
+    });
+    executor.Launch(0);
+  }
+  EXPECT_TRUE(executed);
+}
+
+TEST(ProgramCache, release_least_recently_used) {
+  ProgramCache programs(2, 0);
+  ProgramCache::Shapes a{{1, 8}}, b{{1, 16}}, c{{1, 32}}, d{{1, 64}};
+  auto program_a = std::make_shared<Program>(nullptr);
+  auto program_b = std::make_shared<Program>(nullptr);
+  auto program_c = std::make_shared<Program>(nullptr);
+  programs.Put(a, program_a, 0);
+  programs.Put(b, program_b, 0);
+  // The shapes accepted by a program built with the dynamic shapes share its
+  // entry
+  programs.Put(d, program_b, 0);
+  EXPECT_EQ(programs.GetPrograms().size(), 2u);
+  // a is used more recently than b, so b is released with both of its shapes
+  EXPECT_EQ(programs.Get(a), program_a);
+  programs.Put(c, program_c, 0);
+  EXPECT_EQ(programs.Get(b), nullptr);
+  EXPECT_EQ(programs.Get(d), nullptr);
+  EXPECT_EQ(programs.Get(a), program_a);
+  EXPECT_EQ(programs.Get(c), program_c);
+  EXPECT_EQ(programs.GetPrograms(),
+            std::vector<std::shared_ptr<Program>>({program_c, program_a}));
+  EXPECT_EQ(programs.GetShapes().size(), 2u);
+}
+
+TEST(ProgramCache, memory_budget) {
+  ProgramCache programs(0, 100);
+  ProgramCache::Shapes a{{1, 8}}, b{{1, 16}}, c{{1, 32}};
+  auto program_a = std::make_shared<Program>(nullptr);
+  auto program_b = std::make_shared<Program>(nullptr);
+  auto program_c = std::make_shared<Program>(nullptr);
+  programs.Put(a, program_a, 40);
+  programs.Put(b, program_b, 40);
+  EXPECT_EQ(programs.GetPrograms().size(), 2u);
+  // 120 bytes exceed the budget, so the least recently used a is released
+  programs.Put(c, program_c, 40);
+  EXPECT_EQ(programs.Get(a), nullptr);
+  EXPECT_EQ(programs.Get(b), program_b);
+  // The current program is kept even if it exceeds the budget alone
+  programs.Put(a, program_a, 200);
+  EXPECT_EQ(programs.GetPrograms(),
+            std::vector<std::shared_ptr<Program>>({program_a}));
+}
+
+TEST(PadTensor, pad_and_crop) {
+  Tensor input;
+  input.Resize({2, 3});
+  auto input_data = input.mutable_data<float>();
+  for (int i = 0; i < 6; i++) {
+    input_data[i] = i + 1;
+  }
+  Tensor output;
+  PadTensor(input, {3, 4}, &output);
+  ASSERT_EQ(output.dims().Vectorize(), std::vector<int64_t>({3, 4}));
+  std::vector<float> padded(output.data<float>(), output.data<float>() + 12);
+  EXPECT_EQ(padded,
+            std::vector<float>({1, 2, 3, 0, 4, 5, 6, 0, 0, 0, 0, 0}));
+  // Crop the padded tensor back in place
+  CropTensor({2, 3}, &output);
+  ASSERT_EQ(output.dims().Vectorize(), std::vector<int64_t>({2, 3}));
+  std::vector<float> cropped(output.data<float>(), output.data<float>() + 6);
+  EXPECT_EQ(cropped, std::vector<float>({1, 2, 3, 4, 5, 6}));
+}
+
+TEST(PadTensor, pad_and_crop_inner_axes) {
+  Tensor input;
+  input.Resize({2, 2, 3});
+  auto input_data = input.mutable_data<int32_t>();
+  for (int i = 0; i < 12; i++) {
+    input_data[i] = i + 1;
+  }
+  Tensor output;
+  PadTensor(input, {2, 4, 4}, &output);
+  auto output_data = output.data<int32_t>();
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 4; j++) {
+      for (int k = 0; k < 4; k++) {
+        auto value = output_data[(i * 4 + j) * 4 + k];
+        EXPECT_EQ(value, j < 2 && k < 3 ? input_data[(i * 2 + j) * 3 + k] : 0);
+      }
+    }
+  }
+  CropTensor({2, 2, 3}, &output);
+  std::vector<int32_t> cropped(output.data<int32_t>(),
+                               output.data<int32_t>() + 12);
+  EXPECT_EQ(cropped, std::vector<int32_t>(input_data, input_data + 12));
+}
+
+}  // namespace nnadapter
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -43,9 +43,9 @@ namespace x86 {
 
 #define PREPARE_PARAM                                                         \
   auto& param = this->Param<param_t>();                                       \
-  const int input_channel = param.x->dims()[1];                               \
-  const int output_channel = param.filter->dims()[0];                         \
   const int groups = param.groups;                                            \
+  const int input_channel = param.filter->dims()[1] * groups;                 \
+  const int output_channel = param.filter->dims()[0];                         \
   const int kernel_h = param.filter->dims()[2];                               \
   const int kernel_w = param.filter->dims()[3];                               \
   const int stride_h = param.strides[0];                                      \
@@ -79,9 +79,59 @@ namespace x86 {
   bool pads_equal =                                                 \
       ((paddings[0] == paddings[1]) && (paddings[2] == paddings[3]));
 
+using DirectConvFp32 = DirectConv<PRECISION(kFloat), PRECISION(kFloat)>;
+
+template <PrecisionType Ptype, PrecisionType OutType>
+std::string Conv2dCompute<Ptype, OutType>::PackWeights(Tensor* packed_weights,
+                                                       std::string* argument) {
+  return "";
+}
+
+template <>
+bool Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::UseDirectConv() {
+#if defined(_WIN64) || defined(__MINGW64__) || \
+    (defined(__CYGWIN__) && defined(__x86_64__)) || defined(__x86_64__)
+  auto& param = this->Param<param_t>();
+  const int groups = param.groups;
+  const int output_channel = param.filter->dims()[0];
+  const int kernel_h = param.filter->dims()[2];
+  const int kernel_w = param.filter->dims()[3];
+  const int stride_h = param.strides[0];
+  const int stride_w = param.strides[1];
+  auto paddings = *param.paddings;
+  bool ks_equal = (stride_h == stride_w) && (kernel_h == kernel_w);
+  bool kps_equal = (paddings[0] == paddings[2]) && ks_equal;
+  bool nodilations = true;
+  for (auto ele : *(param.dilations))
+    if (ele != 1) nodilations = false;
+
+  bool pad_all_equal = (paddings[0] == paddings[1]) &&
+                       (paddings[1] == paddings[2]) &&
+                       (paddings[2] == paddings[3]);
+  bool flag_p = paddings[0] <= stride_h;
+  // support 3x3s1p01,5x5s1p01,7x7s1p01
+  //  3x3s2p012,5x5s1p012,7x7s1p012
+  return output_channel % 8 == 0 && groups == 1 &&
+         (kernel_h == 3 || kernel_h == 5 || kernel_h == 7) &&
+         (stride_h == 2 || stride_h == 1) && nodilations && kps_equal &&
+         pad_all_equal && flag_p &&
+         !DirectConvFp32::PackedWeightsLayout().empty();
+#else
+  return false;
+#endif
+}
+
 template <>
 void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   PREPARE_PARAM
+  // The original filter isn't saved with the packed weights, restore it if
+  // the packed layout differs from the one of the running CPU
+  if (this->packed_weights_ && !param.filter->IsInitialized() &&
+      this->packed_weights_layout_ != DirectConvFp32::PackedWeightsLayout()) {
+    VLOG(3) << "Repack the weights in the layout "
+            << this->packed_weights_layout_;
+    DirectConvFp32::UnpackFilter(*this->packed_weights_, param.filter);
+  }
   //! todo add conv_5x5_depthwise implement
   bool flag_dw = flag_dw_3x3 || flag_dw_5x5;
   if (kernel_w == 1 && stride_w == 1 && paddings[0] == 0 && kps_equal &&
@@ -91,15 +141,6 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
     flag_1x1gemm_ = false;
   }
 
-  bool nodilations = true;
-  for (auto ele : *(param.dilations))
-    if (ele != 1) nodilations = false;
-
-  bool pad_all_equal = (paddings[0] == paddings[1]) &&
-                       (paddings[1] == paddings[2]) &&
-                       (paddings[2] == paddings[3]);
-  bool flag_p = paddings[0] <= stride_h;
-
   //! select conv impl
   if (dw_kernel && kps_equal && flag_dw && pads_equal &&
       ((flag_dw_5x5 && no_dilation) || (flag_dw_3x3 && (groups & 3) == 0))) {
@@ -107,27 +148,33 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
     VLOG(3) << "invoking conv_depthwise_3x3p0p1 or conv_depthwise_5x5";
   }
 
-  // support 3x3s1p01,5x5s1p01,7x7s1p01
-  //  3x3s2p012,5x5s1p012,7x7s1p012
-  if (output_channel % 8 == 0 && groups == 1 &&
-      (kernel_h == 3 || kernel_h == 5 || kernel_h == 7) &&
-      (stride_h == 2 || stride_h == 1) && nodilations && kps_equal &&
-      pad_all_equal && flag_p) {
-#if defined(_WIN64) || defined(__MINGW64__) || \
-    (defined(__CYGWIN__) && defined(__x86_64__)) || defined(__x86_64__)
+  if (UseDirectConv()) {
     impl_ = new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>();
     VLOG(3) << "invoking directConv";
-#endif
   }
 
   if (impl_) {
     impl_->SetContext(std::move(this->ctx_));
     impl_->SetParam(param);
+    impl_->SetPackedWeights(this->packed_weights_,
+                            this->packed_weights_layout_);
     impl_->PrepareForRun();
     is_first_epoch_ = false;
   }
 }
 
+template <>
+std::string Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PackWeights(
+    Tensor* packed_weights, std::string* argument) {
+  if (!UseDirectConv()) {
+    return "";
+  }
+  auto& param = this->Param<param_t>();
+  DirectConvFp32::PackFilter(*param.filter, packed_weights);
+  *argument = "Filter";
+  return DirectConvFp32::PackedWeightsLayout();
+}
+
 template <>
 void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   if (impl_) {
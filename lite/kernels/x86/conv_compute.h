@@ -51,6 +51,16 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
  public:
   virtual void PrepareForRun();
 
+  // The fp32 kernel picks its implementation and packs the filter only from
+  // the filter and the attributes.
+  bool CanPrepareAhead() const override {
+    return Ptype == PRECISION(kFloat) && OutType == PRECISION(kFloat);
+  }
+
+  // Only the weights of the direct conv are packed ahead of time.
+  std::string PackWeights(Tensor* packed_weights,
+                          std::string* argument) override;
+
   virtual void ReInitWhenNeeded() {
     if (impl_) {
       impl_->ReInitWhenNeeded();
@@ -79,6 +89,8 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
 
  private:
   using param_t = operators::ConvParam;
+  bool UseDirectConv();
+
   KernelLite<TARGET(kX86), Ptype>* impl_{nullptr};
   Context<TargetType::kX86>* device_ctx;
   bool flag_1x1gemm_{false};
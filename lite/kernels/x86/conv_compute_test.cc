@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -92,6 +93,79 @@ TEST(conv2d_x86, run_test) {
   }
 }
 
+// Run the 3x3s1p1 conv with 16 output channels, which uses the direct conv,
+// with the given filter and packed weights.
+void RunDirectConv(lite::Tensor* filter,
+                   const lite::Tensor* packed_weights,
+                   const std::string& packed_weights_layout,
+                   std::vector<float>* output) {
+  lite::Tensor x, out;
+  x.Resize({1, 8, 10, 10});
+  auto x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 5) * 0.5f;
+  }
+  out.Resize({1, 16, 10, 10});
+  Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)> conv2d;
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = filter;
+  param.output = &out;
+  param.strides = {1, 1};
+  param.groups = 1;
+  param.paddings = std::make_shared<std::vector<int>>(4, 1);
+  param.dilations = std::make_shared<std::vector<int>>(2, 1);
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.SetPackedWeights(packed_weights, packed_weights_layout);
+  conv2d.Launch();
+  output->assign(out.data<float>(), out.data<float>() + out.numel());
+}
+
+TEST(conv2d_x86, repack_weights) {
+  lite::Tensor filter;
+  filter.Resize({16, 8, 3, 3});
+  auto filter_data = filter.mutable_data<float>();
+  for (int64_t i = 0; i < filter.numel(); i++) {
+    filter_data[i] = static_cast<float>(i % 7) - 3.f;
+  }
+  operators::ConvParam param;
+  param.filter = &filter;
+  param.strides = {1, 1};
+  param.groups = 1;
+  param.paddings = std::make_shared<std::vector<int>>(4, 1);
+  param.dilations = std::make_shared<std::vector<int>>(2, 1);
+  Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)> conv2d;
+  conv2d.SetParam(param);
+  lite::Tensor packed_weights;
+  std::string argument;
+  auto layout = conv2d.PackWeights(&packed_weights, &argument);
+  if (layout.empty()) {
+    LOG(INFO) << "The direct conv is not supported on this CPU.";
+    return;
+  }
+  EXPECT_EQ(argument, "Filter");
+
+  std::vector<float> expected_output;
+  RunDirectConv(&filter, nullptr, "", &expected_output);
+  // The packed weights are taken as they are
+  lite::Tensor unloaded_filter;
+  unloaded_filter.Resize({16, 8, 3, 3});
+  std::vector<float> output;
+  RunDirectConv(&unloaded_filter, &packed_weights, layout, &output);
+  EXPECT_FALSE(unloaded_filter.IsInitialized());
+  EXPECT_EQ(output, expected_output);
+  // The weights packed for another ISA restore the original filter first
+  RunDirectConv(&unloaded_filter, &packed_weights, "x86_other", &output);
+  ASSERT_TRUE(unloaded_filter.IsInitialized());
+  EXPECT_EQ(std::vector<float>(unloaded_filter.data<float>(),
+                               unloaded_filter.data<float>() + filter.numel()),
+            std::vector<float>(filter_data, filter_data + filter.numel()));
+  EXPECT_EQ(output, expected_output);
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
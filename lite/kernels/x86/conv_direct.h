@@ -17,6 +17,7 @@
 #include <cmath>
 #include <string>
 #include <vector>
+#include "lite/backends/x86/cpu_info.h"
 #include "lite/backends/x86/math/avx/conv_utils.h"
 #include "lite/backends/x86/math/conv_direct_fp32.h"
 #include "lite/core/context.h"
@@ -41,36 +42,83 @@ class DirectConv : public KernelLite<TARGET(kX86), Ptype> {
 
   virtual void PrepareForRun() {
     auto& param = this->template Param<param_t>();
+    if (this->packed_weights_ &&
+        this->packed_weights_layout_ == PackedWeightsLayout()) {
+      weights_.ShareDataWith(*this->packed_weights_);
+      oc_expand_ = weights_.dims()[0] * kBlock;
+      return;
+    }
+    oc_expand_ = PackFilter(*param.filter, &weights_);
+  }
+
+  // The layout tag of the packed weights on the running CPU, the block size
+  // depends on the ISA of the jit code. Empty if the CPU can't run it.
+  static std::string PackedWeightsLayout() {
 #ifdef __AVX__
-    constexpr int block = 8;
+    return lite::x86::MayIUse(lite::x86::avx) ? "x86_avx_OIhw8o" : "";
 #else
-    constexpr int block = 4;
+    return "x86_sse_OIhw4o";
 #endif
+  }
 
-    int oc = param.filter->dims()[0];
-    int ic = param.filter->dims()[1];
-    int wh = param.filter->dims()[2];
-    int ww = param.filter->dims()[3];
-    int cround = ROUNDUP(oc, block);
-    oc_expand_ = cround;
+  // Pack the filter and return the number of the expanded output channels.
+  static int PackFilter(const Tensor& filter, Tensor* weights) {
+    int oc = filter.dims()[0];
+    int ic = filter.dims()[1];
+    int wh = filter.dims()[2];
+    int ww = filter.dims()[3];
+    int cround = ROUNDUP(oc, kBlock);
     // [chout, chin, wh, ww] -> [chout / block, chin, wh, ww, block]
-    weights_.Resize({cround / block, ic, wh, ww, block});
-    auto filter_data = param.filter->template data<float>();
-    auto weights_w_data = weights_.mutable_data<float>();
+    weights->Resize({cround / kBlock, ic, wh, ww, kBlock});
+    auto filter_data = filter.template data<float>();
+    auto weights_w_data = weights->template mutable_data<float>();
     lite::x86::math::conv_trans_weights_numc(
-        filter_data, weights_w_data, oc, ic, wh, ww, block);
+        filter_data, weights_w_data, oc, ic, wh, ww, kBlock);
+    return cround;
+  }
+
+  // Restore the filter from the weights packed with any block size, the
+  // filter is resized to its original shape ahead.
+  static void UnpackFilter(const Tensor& weights, Tensor* filter) {
+    int block = weights.dims()[4];
+    int oc = filter->dims()[0];
+    int chw = filter->dims().production() / oc;
+    auto weights_data = weights.template data<float>();
+    auto filter_data = filter->template mutable_data<float>();
+    // [chout / block, chin, wh, ww, block] -> [chout, chin, wh, ww]
+    for (int oc_i = 0; oc_i < oc; oc_i++) {
+      const float* from_address =
+          weights_data + oc_i / block * chw * block + oc_i % block;
+      for (int i = 0; i < chw; i++) {
+        *filter_data++ = from_address[i * block];
+      }
+    }
+  }
 
+  // The jit code depends on the shape of the input, so it is generated at the
+  // first launch and regenerated when the shape changes.
+  virtual void ReInitWhenNeeded() {
+    auto& param = this->template Param<param_t>();
     auto x_dims = param.x->dims();
+    if (code_ && x_dims == last_x_dims_) {
+      return;
+    }
+    last_x_dims_ = x_dims;
     auto w_dims = param.filter->dims();
     auto o_dims = param.output->dims();
 
     const int ph = (*(param.paddings))[0];
     const int pw = (*(param.paddings))[2];
 
+    int ic = w_dims[1];
+    int oc = w_dims[0];
+    int wh = w_dims[2];
+    int ww = w_dims[3];
     int iw = x_dims[3];
     int ih = x_dims[2];
     int oh = o_dims[2];
     int ow = o_dims[3];
+    delete code_;
     code_ = new lite::x86::math::conv_direct();
     code_->generate_code(
         ic, ih, iw, oc, oc_expand_, oh, ow, ph, pw, wh, ww, param.strides[1]);
@@ -88,6 +136,11 @@ class DirectConv : public KernelLite<TARGET(kX86), Ptype> {
 
  private:
   using param_t = operators::ConvParam;
+#ifdef __AVX__
+  static constexpr int kBlock = 8;
+#else
+  static constexpr int kBlock = 4;
+#endif
   Tensor weights_;
   Tensor bias_;
   Tensor trans_in_;
@@ -95,7 +148,8 @@ class DirectConv : public KernelLite<TARGET(kX86), Ptype> {
   bool flag_trans_bias_{false};
   std::vector<float> w_scale_;
   int oc_expand_;
-  lite::x86::math::conv_direct* code_;
+  lite::x86::math::conv_direct* code_{nullptr};
+  DDim last_x_dims_;
 };
 
 }  // namespace x86
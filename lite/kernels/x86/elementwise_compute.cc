@@ -17,9 +17,11 @@
 
 #include "lite/kernels/x86/elementwise_compute.h"
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "lite/backends/x86/math/elementwise.h"
 #include "lite/backends/x86/math/elementwise_common_broadcast_config.h"
+#include "lite/backends/x86/math/isa/elementwise_isa.h"
 #include "lite/kernels/host/elementwise_op_func.h"
 
 namespace paddle {
@@ -28,6 +30,7 @@ namespace kernels {
 namespace x86 {
 
 namespace x86_math = paddle::lite::x86::math;
+namespace x86_isa = paddle::lite::x86::math::isa;
 
 // Remove trailing dimensions of size 1 for y
 DDim trim_trailing_singular_dims(const DDim& dims) {
@@ -231,6 +234,76 @@ struct X86CommonElementWise<Elem_t,
   }
 };
 
+// fp32 add/sub/mul/div/max/min, optionally fused with relu, have variants
+// for each ISA picked at runtime, see lite/backends/x86/math/isa.
+template <class X86Config>
+bool isa_binary_op(x86_isa::BinaryOp* op) {
+  if (std::is_base_of<x86_math::AddConfig<float>, X86Config>::value) {
+    *op = x86_isa::BinaryOp::kAdd;
+  } else if (std::is_base_of<x86_math::SubConfig<float>, X86Config>::value) {
+    *op = x86_isa::BinaryOp::kSub;
+  } else if (std::is_base_of<x86_math::MulConfig<float>, X86Config>::value) {
+    *op = x86_isa::BinaryOp::kMul;
+  } else if (std::is_base_of<x86_math::DivConfig<float>, X86Config>::value) {
+    *op = x86_isa::BinaryOp::kDiv;
+  } else if (std::is_base_of<x86_math::MaxConfig<float>, X86Config>::value) {
+    *op = x86_isa::BinaryOp::kMax;
+  } else if (std::is_base_of<x86_math::MinConfig<float>, X86Config>::value) {
+    *op = x86_isa::BinaryOp::kMin;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+template <class T>
+bool elementwise_isa_compute(const T* x_data,
+                             const T* y_data,
+                             T* out_data,
+                             const DDim& x_dims,
+                             const DDim& y_dims,
+                             int axis,
+                             x86_isa::BinaryOp op,
+                             bool relu) {
+  return false;
+}
+
+bool elementwise_isa_compute(const float* x_data,
+                             const float* y_data,
+                             float* out_data,
+                             const DDim& x_dims,
+                             const DDim& y_dims,
+                             int axis,
+                             x86_isa::BinaryOp op,
+                             bool relu) {
+  const auto& kernels = x86_isa::Elementwise();
+  int pre, n, post;
+  if (x_dims == y_dims) {
+    kernels.range_to_range(
+        x_data, y_data, out_data, x_dims.production(), op, relu);
+  } else if (is_fast_broadcast(x_dims, y_dims, axis, &pre, &n, &post)) {
+    for (int i = 0; i < pre; ++i) {
+      for (int j = 0; j < n; ++j) {
+        int offset = (i * n + j) * post;
+        kernels.range_to_one(
+            x_data + offset, y_data + j, out_data + offset, post, op, relu);
+      }
+    }
+  } else if (axis == -1 &&
+             is_fast_broadcast(y_dims, x_dims, axis, &pre, &n, &post)) {
+    for (int i = 0; i < pre; ++i) {
+      for (int j = 0; j < n; ++j) {
+        int offset = (i * n + j) * post;
+        kernels.one_to_range(
+            x_data + j, y_data + offset, out_data + offset, post, op, relu);
+      }
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
 template <class OpParamType, class T, class X86Config>
 void elementwise_compute_template(paddle::lite::KernelBase* kernel,
                                   FastBCastFn<T> fast_bcast_fn,
@@ -250,6 +323,13 @@ void elementwise_compute_template(paddle::lite::KernelBase* kernel,
   auto y_dims = y->dims();
   int pre, n, post;
 
+  x86_isa::BinaryOp isa_op;
+  if (isa_binary_op<X86Config>(&isa_op) &&
+      (!has_active || act_type == "relu") &&
+      elementwise_isa_compute(
+          x_data, y_data, out_data, x_dims, y_dims, axis, isa_op, has_active)) {
+    return;
+  }
   if (elementwise_fn && x_dims == y_dims) {
     elementwise_fn(
         x_data, y_data, out_data, x_dims.production(), has_active, act_type);
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/fc_compute.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
 #include "lite/backends/x86/math/gemm_s8u8_compute.h"
 #include "lite/backends/x86/math/saturate.h"
 
@@ -139,6 +140,42 @@ class FCFunctor {
   }
 };
 
+template <PrecisionType PType, PrecisionType OutType>
+void FcCompute<PType, OutType>::PrepareForRun() {}
+
+// The weights are kept in bf16, converted here unless the light predictor
+// already did it when loading the model.
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<operators::FcParam>();
+  lite::x86::math::TensorToBF16(param.w);
+}
+
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::Run() {
+  auto& param = this->Param<operators::FcParam>();
+  CHECK(param.w->precision() == PRECISION(kBF16))
+      << "The weight of fc is not bf16";
+  if (param.activation_type != "" && param.activation_type != "relu")
+    LOG(FATAL) << "not support fuse activation except relu.";
+  bool padding_weights = param.padding_weights;
+  const auto& w_dims = param.w->dims();
+  int k = padding_weights ? w_dims[0] - 4 : w_dims[0];
+  int n = padding_weights ? w_dims[1] - 4 : w_dims[1];
+  int m = param.output->dims().production() / n;
+  lite::x86::math::GemmBF16(m,
+                            n,
+                            k,
+                            param.input->data<float>(),
+                            k,
+                            param.w->data<uint16_t>(),
+                            w_dims[1],
+                            param.bias ? param.bias->data<float>() : nullptr,
+                            param.activation_type == "relu",
+                            param.output->mutable_data<float>(),
+                            n);
+}
+
 template <>
 void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& param = *param_.get_mutable<param_t>();
@@ -279,6 +316,9 @@ void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
 typedef paddle::lite::kernels::x86::FcCompute<PRECISION(kFloat),
                                               PRECISION(kFloat)>
     FcCompute_FP32;
+typedef paddle::lite::kernels::x86::FcCompute<PRECISION(kBF16),
+                                              PRECISION(kFloat)>
+    FcCompute_BF16;
 typedef paddle::lite::kernels::x86::FcCompute<PRECISION(kInt8),
                                               PRECISION(kFloat)>
     FcCompute_int8_fp32;
@@ -293,6 +333,13 @@ REGISTER_LITE_KERNEL(fc, kX86, kFloat, kNCHW, FcCompute_FP32, def)
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
 
+REGISTER_LITE_KERNEL(fc, kX86, kBF16, kNCHW, FcCompute_BF16, def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kBF16))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
+
 REGISTER_LITE_KERNEL(fc, kX86, kInt8, kNCHW, FcCompute_int8_int8, int8_out)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
@@ -35,6 +35,8 @@ class FcCompute : public KernelLite<TARGET(kX86), PType> {
  public:
   using param_t = operators::FcParam;
 
+  virtual void PrepareForRun();
+
   virtual void Run();
 
   virtual ~FcCompute() = default;
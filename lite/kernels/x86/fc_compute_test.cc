@@ -0,0 +1,102 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/fc_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void TestBF16Weight(const std::string& activation_type) {
+  const int m = 4, k = 9, n = 5;
+  lite::Tensor input, w, bias, out;
+  input.Resize(lite::DDim(std::vector<int64_t>{m, k}));
+  w.Resize(lite::DDim(std::vector<int64_t>{k, n}));
+  bias.Resize(lite::DDim(std::vector<int64_t>{n}));
+  out.Resize(lite::DDim(std::vector<int64_t>{m, n}));
+  auto input_data = input.mutable_data<float>();
+  auto w_data = w.mutable_data<float>();
+  auto bias_data = bias.mutable_data<float>();
+  for (int i = 0; i < m * k; i++) {
+    input_data[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+  }
+  for (int i = 0; i < k * n; i++) {
+    w_data[i] = static_cast<float>(i % 13) * 0.07f - 0.4f;
+  }
+  for (int i = 0; i < n; i++) {
+    bias_data[i] = static_cast<float>(i) * 0.1f - 0.2f;
+  }
+  w.set_persistable(true);
+  // The product with w rounded to bf16
+  std::vector<float> ref_result(m * n, 0.f);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float sum = bias_data[j];
+      for (int p = 0; p < k; p++) {
+        sum += input_data[i * k + p] *
+               lite::x86::math::BF16ToFloat(
+                   lite::x86::math::FloatToBF16(w_data[p * n + j]));
+      }
+      ref_result[i * n + j] =
+          activation_type == "relu" && sum < 0.f ? 0.f : sum;
+    }
+  }
+
+  auto kernels = KernelRegistry::Global().Create(
+      "fc", TARGET(kX86), PRECISION(kBF16), DATALAYOUT(kNCHW));
+  ASSERT_FALSE(kernels.empty());
+  auto fc = std::move(kernels.front());
+  operators::FcParam param;
+  param.input = &input;
+  param.w = &w;
+  param.bias = &bias;
+  param.output = &out;
+  param.in_num_col_dims = 1;
+  param.activation_type = activation_type;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  fc->SetContext(std::move(ctx));
+  fc->SetParam(param);
+  fc->PrepareForRun();
+  // The weight is converted in place
+  ASSERT_EQ(w.precision(), PRECISION(kBF16));
+  fc->Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m * n; i++) {
+    EXPECT_NEAR(out_data[i], ref_result[i], 1e-4);
+  }
+}
+
+TEST(fc_x86, bf16_weight) {
+  TestBF16Weight("");
+  TestBF16Weight("relu");
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fc, kX86, kBF16, kNCHW, def);
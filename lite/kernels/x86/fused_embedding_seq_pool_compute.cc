@@ -0,0 +1,66 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_embedding_seq_pool_compute.h"
+#include <string>
+#include "lite/backends/x86/math/embedding.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void FusedEmbeddingSeqPoolCompute::Run() {
+  auto& param = this->Param<param_t>();
+  auto* w = param.W;
+  auto* ids = param.Ids;
+  auto* out = param.Out;
+  const auto& lod = ids->lod().back();
+
+  std::string pool_type = "SUM";
+  if (param.combiner == "average") {
+    pool_type = "AVERAGE";
+  } else if (param.combiner == "sqrt") {
+    pool_type = "SQRT";
+  }
+  lite::x86::math::EmbeddingSeqPool(
+      w->data<float>(),
+      w->dims()[0],
+      w->dims()[1],
+      lite::x86::math::ParseEmbeddingQuantType(param.quant_type),
+      ids->data<int64_t>(),
+      lod.data(),
+      static_cast<int64_t>(lod.size()) - 1,
+      param.padding_idx,
+      pool_type,
+      param.pad_value,
+      out->mutable_data<float>());
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fused_embedding_seq_pool,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::FusedEmbeddingSeqPoolCompute,
+                     def)
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
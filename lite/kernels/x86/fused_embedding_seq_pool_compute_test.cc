@@ -0,0 +1,156 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_embedding_seq_pool_compute.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lite/backends/x86/math/embedding.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/lookup_table_dequant_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+namespace math = lite::x86::math;
+
+void PrepareTable(int vocab_size,
+                  int emb_size,
+                  const std::string& quant_type,
+                  std::vector<float>* table,
+                  lite::Tensor* w) {
+  table->resize(vocab_size * emb_size);
+  for (int i = 0; i < vocab_size * emb_size; i++) {
+    (*table)[i] = std::sin(static_cast<float>(i)) * (i % 7 + 1);
+  }
+  auto type = math::ParseEmbeddingQuantType(quant_type);
+  int64_t table_width = math::EmbeddingTableWidth(type, emb_size);
+  w->Resize({vocab_size, table_width});
+  math::QuantizeEmbeddingTable(
+      table->data(), vocab_size, emb_size, type, w->mutable_data<float>());
+}
+
+float Tolerance(const std::string& quant_type, float range) {
+  if (quant_type == "uint8") return range / 128.f;
+  if (quant_type == "fp16") return range / 512.f;
+  return 1e-5f;
+}
+
+TEST(lookup_table_dequant_x86, compute) {
+  int vocab_size = 40;
+  int emb_size = 16;
+  int64_t padding_idx = 3;
+  for (std::string quant_type : {"uint8", "fp16"}) {
+    std::vector<float> table;
+    lite::Tensor w, ids, out;
+    PrepareTable(vocab_size, emb_size, quant_type, &table, &w);
+    ids.Resize({60, 1});
+    auto* ids_data = ids.mutable_data<int64_t>();
+    for (int i = 0; i < 60; i++) {
+      ids_data[i] = (i * 7) % vocab_size;
+    }
+    out.Resize({60, emb_size});
+
+    LookupTableDequantCompute lookup_table;
+    operators::LookupTableDequantParam param;
+    param.W = &w;
+    param.Ids = &ids;
+    param.Out = &out;
+    param.padding_idx = padding_idx;
+    param.quant_type = quant_type;
+    lookup_table.SetParam(param);
+    lookup_table.Run();
+
+    auto* out_data = out.data<float>();
+    for (int i = 0; i < 60; i++) {
+      for (int k = 0; k < emb_size; k++) {
+        float ref = ids_data[i] == padding_idx
+                        ? 0.f
+                        : table[ids_data[i] * emb_size + k];
+        EXPECT_NEAR(out_data[i * emb_size + k],
+                    ref,
+                    Tolerance(quant_type, 2.f * 7.f));
+      }
+    }
+  }
+}
+
+TEST(fused_embedding_seq_pool_x86, compute) {
+  int vocab_size = 50;
+  int emb_size = 32;
+  int64_t padding_idx = 5;
+  // The sequence [6, 6) is empty.
+  std::vector<uint64_t> lod{0, 4, 6, 6, 15, 40};
+  for (std::string quant_type : {"none", "uint8", "fp16"}) {
+    for (std::string combiner : {"sum", "average", "sqrt"}) {
+      std::vector<float> table;
+      lite::Tensor w, ids, out;
+      PrepareTable(vocab_size, emb_size, quant_type, &table, &w);
+      ids.Resize({static_cast<int64_t>(lod.back()), 1});
+      ids.set_lod({lod});
+      auto* ids_data = ids.mutable_data<int64_t>();
+      for (uint64_t i = 0; i < lod.back(); i++) {
+        ids_data[i] = (i * 13 + 1) % vocab_size;
+      }
+      int num_seqs = lod.size() - 1;
+      out.Resize({num_seqs, emb_size});
+
+      FusedEmbeddingSeqPoolCompute fused;
+      operators::FusedEmbeddingSeqPoolParam param;
+      param.W = &w;
+      param.Ids = &ids;
+      param.Out = &out;
+      param.padding_idx = padding_idx;
+      param.combiner = combiner;
+      param.quant_type = quant_type;
+      param.pad_value = -1.f;
+      fused.SetParam(param);
+      fused.Run();
+
+      auto* out_data = out.data<float>();
+      for (int s = 0; s < num_seqs; s++) {
+        int len = lod[s + 1] - lod[s];
+        for (int k = 0; k < emb_size; k++) {
+          float ref = 0.f;
+          for (uint64_t i = lod[s]; i < lod[s + 1]; i++) {
+            if (ids_data[i] == padding_idx) continue;
+            ref += table[ids_data[i] * emb_size + k];
+          }
+          if (len == 0) {
+            ref = -1.f;
+          } else if (combiner == "average") {
+            ref /= len;
+          } else if (combiner == "sqrt") {
+            ref /= std::sqrt(static_cast<float>(len));
+          }
+          EXPECT_NEAR(out_data[s * emb_size + k],
+                      ref,
+                      Tolerance(quant_type, 2.f * 7.f) * (len + 1))
+              << quant_type << " " << combiner << " seq " << s;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(lookup_table_dequant, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(fused_embedding_seq_pool, kX86, kFloat, kNCHW, def);
@@ -0,0 +1,236 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fusion_elementwise_chain_compute.h"
+#include <map>
+#include <string>
+#include "lite/backends/x86/parallel.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+namespace {
+
+const std::map<std::string, jit::ChainOpType>& ChainOpTypes() {
+  static const std::map<std::string, jit::ChainOpType> types = {
+      {"elementwise_add", jit::kChainAdd},
+      {"elementwise_sub", jit::kChainSub},
+      {"elementwise_mul", jit::kChainMul},
+      {"elementwise_div", jit::kChainDiv},
+      {"elementwise_max", jit::kChainMax},
+      {"elementwise_min", jit::kChainMin},
+      {"scale", jit::kChainScale},
+      {"relu", jit::kChainRelu},
+      {"sigmoid", jit::kChainSigmoid},
+      {"tanh", jit::kChainTanh},
+      {"exp", jit::kChainExp},
+      {"square", jit::kChainSquare},
+      {"sqrt", jit::kChainSqrt}};
+  return types;
+}
+
+// dims of x with leading 1s, so that its trailing dims align with the output
+std::vector<int64_t> AlignDims(const DDim& x_dims, size_t rank) {
+  std::vector<int64_t> dims(rank, 1);
+  size_t shift = rank - x_dims.size();
+  for (size_t i = 0; i < x_dims.size(); ++i) {
+    dims[i + shift] = x_dims[i];
+  }
+  return dims;
+}
+
+// Whether x is a full, row, column or scalar input of the output viewed as
+// [out[0, k), out[k, rank)].
+bool MatchSplit(const std::vector<int64_t>& x,
+                const std::vector<int64_t>& out,
+                size_t k,
+                jit::ChainBcastType* type) {
+  bool lead_same = true, lead_one = true, tail_same = true, tail_one = true;
+  for (size_t i = 0; i < out.size(); ++i) {
+    bool same = x[i] == out[i];
+    bool one = x[i] == 1;
+    if (i < k) {
+      lead_same = lead_same && same;
+      lead_one = lead_one && one;
+    } else {
+      tail_same = tail_same && same;
+      tail_one = tail_one && one;
+    }
+  }
+  if (lead_same && tail_same) {
+    *type = jit::kChainFull;
+  } else if (lead_one && tail_one) {
+    *type = jit::kChainScalar;
+  } else if (lead_one && tail_same) {
+    *type = jit::kChainRow;
+  } else if (lead_same && tail_one) {
+    *type = jit::kChainCol;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Copy x broadcast to out_dims into out.
+void BroadcastTo(const lite::Tensor& x, const DDim& out_dims, float* out) {
+  const size_t rank = out_dims.size();
+  auto x_dims = AlignDims(x.dims(), rank);
+  std::vector<int64_t> strides(rank, 0);
+  int64_t stride = 1;
+  for (int i = static_cast<int>(rank) - 1; i >= 0; --i) {
+    strides[i] = x_dims[i] == 1 ? 0 : stride;
+    stride *= x_dims[i];
+  }
+  const float* x_data = x.data<float>();
+  std::vector<int64_t> index(rank, 0);
+  int64_t offset = 0;
+  for (int64_t n = 0; n < out_dims.production(); ++n) {
+    out[n] = x_data[offset];
+    for (int i = static_cast<int>(rank) - 1; i >= 0; --i) {
+      offset += strides[i];
+      if (++index[i] < out_dims[i]) {
+        break;
+      }
+      offset -= strides[i] * index[i];
+      index[i] = 0;
+    }
+  }
+}
+
+}  // namespace
+
+void FusionElementwiseChainCompute::PrepareForRun() {
+  auto& param = *param_.get_mutable<param_t>();
+  const int num_inputs = static_cast<int>(param.X.size());
+  const int num_steps = static_cast<int>(param.chain_ops.size());
+  CHECK_LE(num_inputs, jit::kChainMaxInputs);
+  CHECK_LE(num_steps, jit::kChainMaxSteps);
+  CHECK_GT(num_steps, 0);
+  attr_ = jit::elementwise_chain_attr_t();
+  attr_.num_inputs = num_inputs;
+  attr_.num_steps = num_steps;
+  auto& types = ChainOpTypes();
+  for (int i = 0; i < num_steps; ++i) {
+    auto iter = types.find(param.chain_ops[i]);
+    CHECK(iter != types.end()) << "Not supported op in the elementwise chain: "
+                               << param.chain_ops[i];
+    auto& step = attr_.steps[i];
+    step.type = iter->second;
+    step.x = param.chain_x[i];
+    step.y = jit::IsChainBinaryOp(step.type) ? param.chain_y[i] : 0;
+    step.alpha = param.chain_alpha[i];
+    step.beta = param.chain_beta[i];
+  }
+}
+
+void FusionElementwiseChainCompute::Run() {
+  auto& param = *param_.get_mutable<param_t>();
+  auto out_dims = param.Out->dims();
+  const int64_t numel = out_dims.production();
+  float* out = param.Out->mutable_data<float>();
+  if (numel == 0) {
+    return;
+  }
+  const int rank = static_cast<int>(out_dims.size());
+  auto out_vec = out_dims.Vectorize();
+  std::vector<std::vector<int64_t>> x_dims;
+  for (auto* x : param.X) {
+    x_dims.push_back(AlignDims(x->dims(), rank));
+  }
+
+  // Find the [h, w] view that fits all the inputs. Prefer more rows for the
+  // threads, as long as a row is still long enough for the vector loop.
+  std::vector<const float*> x_data(param.X.size());
+  int split = -1;
+  for (int k = rank; k >= 0; --k) {
+    bool fit = true;
+    for (size_t i = 0; fit && i < x_dims.size(); ++i) {
+      fit = MatchSplit(x_dims[i], out_vec, k, &attr_.bcast[i]);
+    }
+    if (!fit) {
+      continue;
+    }
+    split = k;
+    if (out_dims.count(0, k) < 2 ||
+        out_dims.count(k, rank) >= 64) {
+      break;
+    }
+  }
+  if (split >= 0) {
+    for (size_t i = 0; i < x_dims.size(); ++i) {
+      MatchSplit(x_dims[i], out_vec, split, &attr_.bcast[i]);
+      x_data[i] = param.X[i]->data<float>();
+    }
+  } else {
+    // no view fits, broadcast the inputs that are not full
+    split = 0;
+    expanded_.resize(param.X.size());
+    for (size_t i = 0; i < x_dims.size(); ++i) {
+      if (param.X[i]->numel() == numel) {
+        attr_.bcast[i] = jit::kChainFull;
+        x_data[i] = param.X[i]->data<float>();
+      } else if (param.X[i]->numel() == 1) {
+        attr_.bcast[i] = jit::kChainScalar;
+        x_data[i] = param.X[i]->data<float>();
+      } else {
+        expanded_[i].Resize(out_dims);
+        BroadcastTo(*param.X[i], out_dims, expanded_[i].mutable_data<float>());
+        attr_.bcast[i] = jit::kChainFull;
+        x_data[i] = expanded_[i].data<float>();
+      }
+    }
+  }
+  attr_.h = static_cast<int>(out_dims.count(0, split));
+  attr_.w = static_cast<int>(out_dims.count(split, rank));
+
+  auto ker = jit::KernelFuncs<jit::ElementwiseChainTuple<float>,
+                              fluid::CPUPlace>::Cache()
+                 .At(attr_);
+  const int w = attr_.w;
+  auto run_rows = [&](int64_t begin, int64_t end) {
+    jit::elementwise_chain_attr_t attr = attr_;
+    attr.h = static_cast<int>(end - begin);
+    std::vector<const float*> x(x_data);
+    for (size_t i = 0; i < x.size(); ++i) {
+      if (attr.bcast[i] == jit::kChainFull) {
+        x[i] += begin * w;
+      } else if (attr.bcast[i] == jit::kChainCol) {
+        x[i] += begin;
+      }
+    }
+    ker(x.data(), out + begin * w, &attr);
+  };
+  if (numel < (1 << 14)) {
+    run_rows(0, attr_.h);
+  } else {
+    lite::x86::RunParallelFor(0, attr_.h, run_rows);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_elementwise_chain,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::FusionElementwiseChainCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
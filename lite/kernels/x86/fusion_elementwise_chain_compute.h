@@ -0,0 +1,53 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernel_base.h"
+#include "lite/backends/x86/jit/kernels.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/operators/fusion_elementwise_chain_op.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// Runs the whole chain in one pass over the output with the jit
+// kElementwiseChain kernel. The output is viewed as [h, w] so that every
+// input is full, a row, a column or a scalar of it. Inputs that do not fit
+// any such view are broadcast to the output shape first.
+class FusionElementwiseChainCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusionElementwiseChainParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~FusionElementwiseChainCompute() = default;
+
+ private:
+  jit::elementwise_chain_attr_t attr_;
+  std::vector<lite::Tensor> expanded_;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
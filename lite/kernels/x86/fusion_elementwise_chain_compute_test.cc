@@ -0,0 +1,277 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fusion_elementwise_chain_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/profile/timer.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+using paddle::lite::profile::Timer;
+
+struct ChainCase {
+  std::string name;
+  std::vector<DDim> input_dims;
+  operators::FusionElementwiseChainParam param;
+};
+
+void AddStep(operators::FusionElementwiseChainParam* param,
+             const std::string& op,
+             int x,
+             int y = 0,
+             float alpha = 1.f,
+             float beta = 0.f) {
+  param->chain_ops.push_back(op);
+  param->chain_x.push_back(x);
+  param->chain_y.push_back(y);
+  param->chain_alpha.push_back(alpha);
+  param->chain_beta.push_back(beta);
+}
+
+// gelu(x) = 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+ChainCase GeluCase(const DDim& dims) {
+  ChainCase c{"gelu", {dims}, {}};
+  auto* p = &c.param;
+  AddStep(p, "square", 0);                        // 1
+  AddStep(p, "elementwise_mul", 1, 0);            // 2
+  AddStep(p, "scale", 2, 0, 0.044715f);           // 3
+  AddStep(p, "elementwise_add", 0, 3);            // 4
+  AddStep(p, "scale", 4, 0, 0.7978845608f);       // 5
+  AddStep(p, "tanh", 5);                          // 6
+  AddStep(p, "scale", 6, 0, 1.f, 1.f);            // 7
+  AddStep(p, "elementwise_mul", 0, 7);            // 8
+  AddStep(p, "scale", 8, 0, 0.5f);                // 9
+  return c;
+}
+
+// swish(x) = x * sigmoid(beta * x), after a bias add
+ChainCase SwishCase(const DDim& dims, const DDim& bias_dims) {
+  ChainCase c{"swish", {dims, bias_dims}, {}};
+  auto* p = &c.param;
+  AddStep(p, "elementwise_add", 0, 1);  // 2
+  AddStep(p, "scale", 2, 0, 1.5f);      // 3
+  AddStep(p, "sigmoid", 3);             // 4
+  AddStep(p, "elementwise_mul", 2, 4);  // 5
+  return c;
+}
+
+// (x - mean) * rsqrt_var * gamma + beta, mean and rsqrt_var for every row
+ChainCase LayerNormTailCase(const DDim& dims,
+                            const DDim& row_dims,
+                            const DDim& norm_dims) {
+  ChainCase c{"layer_norm_tail",
+              {dims, row_dims, row_dims, norm_dims, norm_dims},
+              {}};
+  auto* p = &c.param;
+  AddStep(p, "elementwise_sub", 0, 1);  // 5
+  AddStep(p, "elementwise_mul", 5, 2);  // 6
+  AddStep(p, "elementwise_mul", 6, 3);  // 7
+  AddStep(p, "elementwise_add", 7, 4);  // 8
+  return c;
+}
+
+DDim BroadcastDims(const std::vector<DDim>& dims) {
+  size_t rank = 0;
+  for (auto& d : dims) rank = std::max(rank, d.size());
+  std::vector<int64_t> out(rank, 1);
+  for (auto& d : dims) {
+    for (size_t i = 0; i < d.size(); ++i) {
+      int64_t& o = out[i + rank - d.size()];
+      o = std::max(o, d[i]);
+    }
+  }
+  return DDim(out);
+}
+
+// The input value at the flat index n of the output, trailing dims aligned
+float BroadcastAt(const lite::Tensor& x, const DDim& out_dims, int64_t n) {
+  auto x_dims = x.dims();
+  size_t shift = out_dims.size() - x_dims.size();
+  int64_t offset = 0;
+  int64_t stride = 1;
+  for (int i = static_cast<int>(out_dims.size()) - 1; i >= 0; --i) {
+    int64_t idx = n % out_dims[i];
+    n /= out_dims[i];
+    if (i >= static_cast<int>(shift)) {
+      int64_t d = x_dims[i - shift];
+      offset += (d == 1 ? 0 : idx) * stride;
+      stride *= d;
+    }
+  }
+  return x.data<float>()[offset];
+}
+
+// Run the chain op by op, each step is a pass over the whole output, like
+// the ops before the fusion.
+void RunUnfused(const std::vector<lite::Tensor>& inputs,
+                const operators::FusionElementwiseChainParam& param,
+                const DDim& out_dims,
+                std::vector<std::vector<float>>* values) {
+  const int64_t numel = out_dims.production();
+  values->resize(inputs.size() + param.chain_ops.size());
+  for (size_t k = 0; k < inputs.size(); ++k) {
+    auto& v = (*values)[k];
+    v.resize(numel);
+    for (int64_t n = 0; n < numel; ++n) {
+      v[n] = BroadcastAt(inputs[k], out_dims, n);
+    }
+  }
+  for (size_t s = 0; s < param.chain_ops.size(); ++s) {
+    const auto& op = param.chain_ops[s];
+    const float* x = (*values)[param.chain_x[s]].data();
+    const float* y = (*values)[param.chain_y[s]].data();
+    auto& out = (*values)[inputs.size() + s];
+    out.resize(numel);
+    const float alpha = param.chain_alpha[s];
+    const float beta = param.chain_beta[s];
+    for (int64_t n = 0; n < numel; ++n) {
+      float r = 0.f;
+      if (op == "elementwise_add") {
+        r = x[n] + y[n];
+      } else if (op == "elementwise_sub") {
+        r = x[n] - y[n];
+      } else if (op == "elementwise_mul") {
+        r = x[n] * y[n];
+      } else if (op == "elementwise_div") {
+        r = x[n] / y[n];
+      } else if (op == "scale") {
+        r = alpha * x[n] + beta;
+      } else if (op == "square") {
+        r = x[n] * x[n];
+      } else if (op == "tanh") {
+        r = std::tanh(x[n]);
+      } else if (op == "sigmoid") {
+        r = 1.f / (1.f + std::exp(-x[n]));
+      } else {
+        LOG(FATAL) << "Not supported op " << op;
+      }
+      out[n] = r;
+    }
+  }
+}
+
+void TestChain(ChainCase* c, int repeats = 0) {
+  std::vector<lite::Tensor> inputs(c->input_dims.size());
+  for (size_t k = 0; k < inputs.size(); ++k) {
+    inputs[k].Resize(c->input_dims[k]);
+    float* data = inputs[k].mutable_data<float>();
+    for (int64_t n = 0; n < inputs[k].numel(); ++n) {
+      data[n] = 0.5f + static_cast<float>((n * 7 + k * 3) % 23) / 11.f -
+                static_cast<float>(k == 0);
+    }
+    c->param.X.push_back(&inputs[k]);
+  }
+  DDim out_dims = BroadcastDims(c->input_dims);
+  lite::Tensor out;
+  out.Resize(out_dims);
+  c->param.Out = &out;
+
+  FusionElementwiseChainCompute chain;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  chain.SetContext(std::move(ctx));
+  chain.SetParam(c->param);
+  chain.PrepareForRun();
+  chain.Run();
+
+  std::vector<std::vector<float>> values;
+  RunUnfused(inputs, c->param, out_dims, &values);
+  const float* out_data = out.data<float>();
+  for (int64_t n = 0; n < out_dims.production(); ++n) {
+    ASSERT_NEAR(out_data[n], values.back()[n], 1e-4)
+        << c->name << " " << out_dims << " at " << n;
+  }
+  if (repeats <= 0) {
+    return;
+  }
+
+  Timer fused, unfused;
+  for (int i = 0; i < repeats; ++i) {
+    fused.Start();
+    chain.Run();
+    fused.Stop();
+    unfused.Start();
+    RunUnfused(inputs, c->param, out_dims, &values);
+    unfused.Stop();
+  }
+  LOG(INFO) << c->name << " " << out_dims << ": fused "
+            << fused.LapTimes().Avg() << " ms, op by op "
+            << unfused.LapTimes().Avg() << " ms";
+}
+
+TEST(fusion_elementwise_chain_x86, retrive_op) {
+  auto chain = KernelRegistry::Global().Create("fusion_elementwise_chain");
+  ASSERT_FALSE(chain.empty());
+  ASSERT_TRUE(chain.front());
+}
+
+TEST(fusion_elementwise_chain_x86, gelu) {
+  for (int64_t w : {1, 3, 8, 13, 64, 100}) {
+    auto c = GeluCase(DDim({4, w}));
+    TestChain(&c);
+  }
+}
+
+TEST(fusion_elementwise_chain_x86, swish) {
+  for (int64_t w : {5, 16, 31}) {
+    auto c = SwishCase(DDim({2, 3, w}), DDim({w}));
+    TestChain(&c);
+  }
+  // a scalar and a full bias
+  auto scalar = SwishCase(DDim({3, 10}), DDim({1}));
+  TestChain(&scalar);
+  auto full = SwishCase(DDim({3, 10}), DDim({3, 10}));
+  TestChain(&full);
+}
+
+TEST(fusion_elementwise_chain_x86, layer_norm_tail) {
+  for (int64_t w : {7, 32, 45}) {
+    auto c = LayerNormTailCase(DDim({2, 5, w}), DDim({2, 5, 1}), DDim({w}));
+    TestChain(&c);
+  }
+}
+
+TEST(fusion_elementwise_chain_x86, no_view_fits) {
+  // a per channel bias of NCHW, broadcast to the output first
+  auto c = SwishCase(DDim({2, 3, 4, 5}), DDim({3, 1, 1}));
+  TestChain(&c);
+}
+
+TEST(fusion_elementwise_chain_x86, benchmark) {
+  const int repeats = 10;
+  auto gelu = GeluCase(DDim({32, 3072}));
+  TestChain(&gelu, repeats);
+  auto swish = SwishCase(DDim({8, 56, 256}), DDim({256}));
+  TestChain(&swish, repeats);
+  auto layer_norm =
+      LayerNormTailCase(DDim({4, 128, 768}), DDim({4, 128, 1}), DDim({768}));
+  TestChain(&layer_norm, repeats);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fusion_elementwise_chain, kX86, kFloat, kNCHW, def);
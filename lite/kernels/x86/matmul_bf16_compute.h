@@ -0,0 +1,141 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <memory>
+#include <utility>
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// out[m, n] = alpha * x[m, k] * y[k, n] with y a bf16 weight.
+struct BF16GemmArgs {
+  int m{0};
+  int n{0};
+  int k{0};
+  float alpha{1.f};
+};
+
+// Whether y of mul is a weight that can be kept in bf16, i.e. it is
+// persistable; fills `args` if so.
+inline bool GetBF16GemmArgs(const operators::MulParam& param,
+                            BF16GemmArgs* args) {
+  if (!param.y->persistable()) return false;
+  auto x_dims = param.x->dims().Flatten2D(param.x_num_col_dims);
+  auto y_dims = param.y->dims().Flatten2D(param.y_num_col_dims);
+  args->m = x_dims[0];
+  args->k = x_dims[1];
+  args->n = y_dims[1];
+  args->alpha = 1.f;
+  return y_dims[0] == args->k;
+}
+
+// The same for matmul and matmul_v2, which only use bf16 for a 2-D weight y
+// that is not transposed, multiplied by a non transposed x of any rank.
+inline bool GetBF16GemmArgs(const operators::MatMulParam& param,
+                            BF16GemmArgs* args) {
+  const auto& x_dims = param.X->dims();
+  const auto& y_dims = param.Y->dims();
+  if (!param.Y->persistable() || param.transpose_X || param.transpose_Y ||
+      y_dims.size() != 2 || x_dims.size() < 1 ||
+      x_dims[x_dims.size() - 1] != y_dims[0]) {
+    return false;
+  }
+  args->k = y_dims[0];
+  args->n = y_dims[1];
+  args->m = x_dims.production() / args->k;
+  args->alpha = param.alpha;
+  return true;
+}
+
+// mul, matmul and matmul_v2 with a weight y stored in bf16 and fp32 x and
+// out. The weight is converted when the kernel is prepared, unless the light
+// predictor already did it when loading the model; any other y, e.g. an
+// activation, runs the fp32 kernel FP32Kernel instead.
+template <typename FP32Kernel>
+class MatMulBF16Compute : public KernelLite<TARGET(kX86), PRECISION(kBF16)> {
+ public:
+  using param_t = typename FP32Kernel::param_t;
+
+  void PrepareForRun() override {
+    auto& param = this->template Param<param_t>();
+    BF16GemmArgs args;
+    if (GetBF16GemmArgs(param, &args)) {
+      lite::x86::math::TensorToBF16(const_cast<Tensor*>(y(param)));
+      return;
+    }
+    CHECK(y(param)->precision() != PRECISION(kBF16))
+        << "The bf16 weight can not be used by " << op_type();
+    fp32_impl_.reset(new FP32Kernel);
+    fp32_impl_->SetContext(std::move(this->ctx_));
+    fp32_impl_->SetParam(param);
+    fp32_impl_->PrepareForRun();
+  }
+
+  void Run() override {
+    if (fp32_impl_) {
+      return fp32_impl_->Run();
+    }
+    auto& param = this->template Param<param_t>();
+    BF16GemmArgs args;
+    CHECK(GetBF16GemmArgs(param, &args));
+    float* out_data = out(param)->template mutable_data<float>();
+    lite::x86::math::GemmBF16(args.m,
+                              args.n,
+                              args.k,
+                              x(param)->template data<float>(),
+                              args.k,
+                              y(param)->template data<uint16_t>(),
+                              args.n,
+                              nullptr,
+                              false,
+                              out_data,
+                              args.n);
+    if (args.alpha != 1.f) {
+      const int64_t num = static_cast<int64_t>(args.m) * args.n;
+      for (int64_t i = 0; i < num; ++i) {
+        out_data[i] *= args.alpha;
+      }
+    }
+  }
+
+  virtual ~MatMulBF16Compute() = default;
+
+ private:
+  static const Tensor* x(const operators::MulParam& param) { return param.x; }
+  static const Tensor* y(const operators::MulParam& param) { return param.y; }
+  static Tensor* out(const operators::MulParam& param) {
+    return param.output;
+  }
+  static const Tensor* x(const operators::MatMulParam& param) {
+    return param.X;
+  }
+  static const Tensor* y(const operators::MatMulParam& param) {
+    return param.Y;
+  }
+  static Tensor* out(const operators::MatMulParam& param) { return param.Out; }
+
+  std::unique_ptr<FP32Kernel> fp32_impl_;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
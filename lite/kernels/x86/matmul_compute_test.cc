@@ -20,7 +20,9 @@
 #include <vector>
 
 #include "lite/core/op_registry.h"
+#include "lite/kernels/x86/matmul_bf16_compute.h"
 #include "lite/kernels/x86/matmul_compute.h"
+#include "lite/kernels/x86/matmul_v2_compute.h"
 
 namespace paddle {
 namespace lite {
@@ -80,6 +82,73 @@ TEST(matmul_x86, run_test) {
   }
 }
 
+// Run the bf16 kernel of matmul or matmul_v2 on a 3-D x and a 2-D weight y,
+// transposed if `transpose_y`, and check it against the fp32 product.
+template <typename FP32Kernel>
+void TestBF16Weight(bool transpose_y) {
+  const int batch = 2, m = 3, k = 10, n = 6;
+  lite::Tensor x, y, out;
+  x.Resize(lite::DDim(std::vector<int64_t>{batch, m, k}));
+  y.Resize(transpose_y ? lite::DDim(std::vector<int64_t>{n, k})
+                       : lite::DDim(std::vector<int64_t>{k, n}));
+  out.Resize(lite::DDim(std::vector<int64_t>{batch, m, n}));
+  auto x_data = x.mutable_data<float>();
+  auto y_data = y.mutable_data<float>();
+  for (int i = 0; i < batch * m * k; i++) {
+    x_data[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+  }
+  for (int i = 0; i < k * n; i++) {
+    y_data[i] = static_cast<float>(i % 13) * 0.07f - 0.4f;
+  }
+  y.set_persistable(true);
+  // The product with y rounded to bf16, the transposed y stays in fp32
+  std::vector<float> ref_result(batch * m * n, 0.f);
+  for (int p = 0; p < k; p++) {
+    for (int j = 0; j < n; j++) {
+      float y_value = transpose_y ? y_data[j * k + p] : y_data[p * n + j];
+      if (!transpose_y) {
+        y_value = lite::x86::math::BF16ToFloat(
+            lite::x86::math::FloatToBF16(y_value));
+      }
+      for (int i = 0; i < batch * m; i++) {
+        ref_result[i * n + j] += x_data[i * k + p] * y_value;
+      }
+    }
+  }
+
+  MatMulBF16Compute<FP32Kernel> matmul;
+  ASSERT_EQ(matmul.precision(), PRECISION(kBF16));
+  operators::MatMulParam param;
+  param.X = &x;
+  param.Y = &y;
+  param.Out = &out;
+  param.transpose_Y = transpose_y;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  matmul.SetContext(std::move(ctx));
+  matmul.SetParam(param);
+  matmul.PrepareForRun();
+  ASSERT_EQ(y.precision(),
+            transpose_y ? PRECISION(kFloat) : PRECISION(kBF16));
+  matmul.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < batch * m * n; i++) {
+    EXPECT_NEAR(out_data[i], ref_result[i], 1e-4);
+  }
+}
+
+TEST(matmul_x86, bf16_weight) {
+  TestBF16Weight<MatMulCompute<float>>(false);
+  // The fp32 kernel runs the transposed y
+  TestBF16Weight<MatMulCompute<float>>(true);
+}
+
+TEST(matmul_v2_x86, bf16_weight) {
+  TestBF16Weight<MatMulV2Compute<float>>(false);
+  TestBF16Weight<MatMulV2Compute<float>>(true);
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
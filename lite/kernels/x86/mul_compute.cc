@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/mul_compute.h"
+#include "lite/kernels/x86/matmul_bf16_compute.h"
 
 REGISTER_LITE_KERNEL(mul,
                      kX86,
@@ -24,3 +25,13 @@ REGISTER_LITE_KERNEL(mul,
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
+
+typedef paddle::lite::kernels::x86::MatMulBF16Compute<
+    paddle::lite::kernels::x86::MulCompute<float>>
+    MulCompute_BF16;
+
+REGISTER_LITE_KERNEL(mul, kX86, kBF16, kNCHW, MulCompute_BF16, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kAny))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "lite/core/op_registry.h"
+#include "lite/kernels/x86/matmul_bf16_compute.h"
 #include "lite/kernels/x86/mul_compute.h"
 
 namespace paddle {
@@ -80,6 +81,54 @@ TEST(mul_x86, run_test) {
   }
 }
 
+TEST(mul_x86, bf16_weight) {
+  const int m = 5, k = 12, n = 7;
+  lite::Tensor x, y, out;
+  x.Resize(lite::DDim(std::vector<int64_t>{m, k}));
+  y.Resize(lite::DDim(std::vector<int64_t>{k, n}));
+  out.Resize(lite::DDim(std::vector<int64_t>{m, n}));
+  auto x_data = x.mutable_data<float>();
+  auto y_data = y.mutable_data<float>();
+  for (int i = 0; i < m * k; i++) {
+    x_data[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+  }
+  for (int i = 0; i < k * n; i++) {
+    y_data[i] = static_cast<float>(i % 13) * 0.07f - 0.4f;
+  }
+  y.set_persistable(true);
+  // The product with y rounded to bf16
+  std::vector<float> ref_result(m * n, 0.f);
+  for (int p = 0; p < k; p++) {
+    for (int j = 0; j < n; j++) {
+      float y_value = lite::x86::math::BF16ToFloat(
+          lite::x86::math::FloatToBF16(y_data[p * n + j]));
+      for (int i = 0; i < m; i++) {
+        ref_result[i * n + j] += x_data[i * k + p] * y_value;
+      }
+    }
+  }
+
+  MatMulBF16Compute<MulCompute<float>> mul;
+  ASSERT_EQ(mul.precision(), PRECISION(kBF16));
+  operators::MulParam param;
+  param.x = &x;
+  param.y = &y;
+  param.output = &out;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  mul.SetContext(std::move(ctx));
+  mul.SetParam(param);
+  mul.PrepareForRun();
+  // The weight is converted in place
+  ASSERT_EQ(y.precision(), PRECISION(kBF16));
+  mul.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m * n; i++) {
+    EXPECT_NEAR(out_data[i], ref_result[i], 1e-4);
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -631,6 +631,155 @@ static void RunRnnLayer(X86Context* ctx,
   }
 }
 
+/******************************************************
+input:
+    gates:(3D)time_step, batch, gate_num * hidden_size, the input projections
+    init_h, init_c:(2D)batch, hidden_size
+output:
+    output:(3D)time_step, batch, hidden_size with the row stride ldo
+    last_h, last_c:(2D)batch, hidden_size
+******************************************************/
+static void RunFusedRnnDirection(const X86Context& ctx,
+                                 const std::string& mode,
+                                 lite::x86::math::RnnRecurrentGemm* gemm,
+                                 Tensor* gates,
+                                 const float* reset_bias,
+                                 const float* init_h,
+                                 const float* init_c,
+                                 bool is_reverse,
+                                 float* output,
+                                 int ldo,
+                                 float* last_h,
+                                 float* last_c) {
+  const int time_step = gates->dims()[0];
+  const int batch = gates->dims()[1];
+  const int gate_width = gates->dims()[2];
+  const int hidden_size = gate_width / ("LSTM" == mode ? 4 : 3);
+  float* gates_data = gates->mutable_data<float>();
+  // The recurrent projections of GRU, the ones of LSTM are accumulated into
+  // the gates directly.
+  std::vector<float> h_gates;
+  if ("LSTM" == mode) {
+    std::memcpy(last_c, init_c, batch * hidden_size * sizeof(float));
+  } else {
+    h_gates.resize(batch * gate_width);
+  }
+  const float* prev_h = init_h;
+  int ld_prev_h = hidden_size;
+  for (int i = 0; i < time_step; i++) {
+    int t = is_reverse ? time_step - 1 - i : i;
+    float* gate = gates_data + t * batch * gate_width;
+    float* h = output + t * batch * ldo;
+    if ("LSTM" == mode) {
+      gemm->Compute(ctx, batch, prev_h, ld_prev_h, gate, gate_width, true);
+      lite::x86::math::FusedLstmCell(
+          gate, last_c, last_c, h, ldo, batch, hidden_size);
+    } else {
+      gemm->Compute(
+          ctx, batch, prev_h, ld_prev_h, h_gates.data(), gate_width, false);
+      lite::x86::math::FusedGruCell(gate,
+                                    h_gates.data(),
+                                    reset_bias,
+                                    prev_h,
+                                    ld_prev_h,
+                                    h,
+                                    ldo,
+                                    batch,
+                                    hidden_size);
+    }
+    prev_h = h;
+    ld_prev_h = ldo;
+  }
+  for (int b = 0; b < batch; b++) {
+    std::memcpy(last_h + b * hidden_size,
+                prev_h + b * ld_prev_h,
+                hidden_size * sizeof(float));
+  }
+}
+
+// The input projections of all the time steps are computed by one GEMM, then
+// each step runs a GEMM with the packed recurrent weight and one fused pass of
+// the gate math, which writes the hidden states into the output in place. The
+// two directions of a bidirectional layer run in parallel.
+void RnnCompute::RunFused() {
+  auto& param = this->Param<operators::RnnParam>();
+  auto& ctx = this->ctx_->As<X86Context>();
+  const std::string& mode = param.mode;
+  const int gate_num = "LSTM" == mode ? 4 : 3;
+  const int direction_num = param.is_bidirec ? 2 : 1;
+  const int num_layers = param.num_layers;
+  const int batch_size = param.Input->dims()[1];
+  const int hidden_size = param.Out->dims()[2] / direction_num;
+  const int state_size = batch_size * hidden_size;
+
+  std::vector<std::vector<Tensor>> parameter_lists;
+  parameter_lists.reserve(num_layers);
+  reset_parameter_vector(param.WeightList,
+                         num_layers,
+                         gate_num,
+                         param.is_bidirec,
+                         &parameter_lists);
+  if (recurrent_gemms_.size() !=
+      static_cast<size_t>(num_layers * direction_num)) {
+    recurrent_gemms_.clear();
+    for (int i = 0; i < num_layers * direction_num; i++) {
+      recurrent_gemms_.emplace_back(new lite::x86::math::RnnRecurrentGemm());
+    }
+  }
+
+  const float* init_h = param.PreState[0]->data<float>();
+  float* last_h = param.State[0]->mutable_data<float>();
+  const float* init_c = nullptr;
+  float* last_c = nullptr;
+  if ("LSTM" == mode) {
+    init_c = param.PreState[1]->data<float>();
+    last_c = param.State[1]->mutable_data<float>();
+  }
+
+  // The outputs of the layers but the last one are in the ping-pong buffers
+  Tensor layer_outputs[2];
+  std::vector<Tensor> gates(direction_num);
+  const Tensor* layer_input = param.Input;
+  for (int i = 0; i < num_layers; i++) {
+    Tensor* layer_output = param.Out;
+    if (i + 1 < num_layers) {
+      layer_output = &layer_outputs[i % 2];
+      layer_output->Resize(param.Out->dims());
+    }
+    float* output_data = layer_output->mutable_data<float>();
+    auto& vec = parameter_lists[i];
+    for (int j = 0; j < direction_num; j++) {
+      preprocess(&ctx,
+                 layer_input,
+                 vec[j * 4],
+                 vec[j * 4 + 2],
+                 vec[j * 4 + 3],
+                 mode,
+                 &gates[j]);
+      recurrent_gemms_[i * direction_num + j]->Init(
+          vec[j * 4 + 1].data<float>(), gate_num * hidden_size, hidden_size);
+    }
+#pragma omp parallel for num_threads(direction_num)
+    for (int j = 0; j < direction_num; j++) {
+      int state_offset = (i * direction_num + j) * state_size;
+      RunFusedRnnDirection(
+          ctx,
+          mode,
+          recurrent_gemms_[i * direction_num + j].get(),
+          &gates[j],
+          vec[j * 4 + 3].data<float>() + 2 * hidden_size,
+          init_h + state_offset,
+          init_c ? init_c + state_offset : nullptr,
+          j > 0,
+          output_data + j * hidden_size,
+          direction_num * hidden_size,
+          last_h + state_offset,
+          last_c ? last_c + state_offset : nullptr);
+    }
+    layer_input = layer_output;
+  }
+}
+
 void RnnCompute::Run() {
   auto& param = this->Param<operators::RnnParam>();
   auto& ctx = this->ctx_->As<X86Context>();
@@ -656,6 +805,12 @@ void RnnCompute::Run() {
                << mode;
     return;
   }
+  // The masked steps of the variable length sequences are only supported by
+  // the unfused path.
+  if (sequence_length == nullptr) {
+    RunFused();
+    return;
+  }
 
   state[0]->mutable_data<float>();
   if ("LSTM" == mode) {
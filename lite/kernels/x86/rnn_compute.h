@@ -14,6 +14,9 @@
 
 #pragma once
 #include <algorithm>
+#include <memory>
+#include <vector>
+#include "lite/backends/x86/math/fused_rnn.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -27,6 +30,14 @@ class RnnCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override;
 
   virtual ~RnnCompute() = default;
+
+ private:
+  void RunFused();
+
+  // The recurrent GEMMs of the directions of all the layers, in the order of
+  // layer * direction_num + direction.
+  std::vector<std::unique_ptr<lite::x86::math::RnnRecurrentGemm>>
+      recurrent_gemms_;
 };
 
 }  // namespace x86
@@ -0,0 +1,263 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/rnn_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+static float sigmoid(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+// The reference of a rnn op without the sequence length, the weights are
+// [Wih, Whh] * direction_num * num_layers + [bih, bhh] * direction_num *
+// num_layers as in Paddle.
+static void rnn_ref(const std::string& mode,
+                    const std::vector<float>& input,
+                    const std::vector<std::vector<float>>& weights,
+                    const std::vector<float>& init_h,
+                    const std::vector<float>& init_c,
+                    int time_step,
+                    int batch,
+                    int input_size,
+                    int hidden,
+                    int num_layers,
+                    bool is_bidirec,
+                    std::vector<float>* output,
+                    std::vector<float>* last_h,
+                    std::vector<float>* last_c) {
+  const int gate_num = mode == "LSTM" ? 4 : 3;
+  const int direction_num = is_bidirec ? 2 : 1;
+  const int bias_start = num_layers * direction_num * 2;
+  std::vector<float> layer_input = input;
+  int in_size = input_size;
+  last_h->resize(num_layers * direction_num * batch * hidden);
+  last_c->resize(last_h->size());
+  for (int l = 0; l < num_layers; l++) {
+    std::vector<float> layer_output(time_step * batch * direction_num * hidden);
+    for (int d = 0; d < direction_num; d++) {
+      int idx = (l * direction_num + d) * 2;
+      const auto& w_ih = weights[idx];
+      const auto& w_hh = weights[idx + 1];
+      const auto& b_ih = weights[bias_start + idx];
+      const auto& b_hh = weights[bias_start + idx + 1];
+      int state_offset = (l * direction_num + d) * batch * hidden;
+      std::vector<float> h(init_h.begin() + state_offset,
+                           init_h.begin() + state_offset + batch * hidden);
+      std::vector<float> c(init_c.begin() + state_offset,
+                           init_c.begin() + state_offset + batch * hidden);
+      for (int s = 0; s < time_step; s++) {
+        int t = d > 0 ? time_step - 1 - s : s;
+        std::vector<float> new_h(batch * hidden);
+        for (int b = 0; b < batch; b++) {
+          std::vector<float> xg(gate_num * hidden), hg(gate_num * hidden);
+          for (int n = 0; n < gate_num * hidden; n++) {
+            float x_sum = b_ih[n];
+            for (int k = 0; k < in_size; k++) {
+              x_sum += layer_input[(t * batch + b) * in_size + k] *
+                       w_ih[n * in_size + k];
+            }
+            float h_sum = b_hh[n];
+            for (int k = 0; k < hidden; k++) {
+              h_sum += h[b * hidden + k] * w_hh[n * hidden + k];
+            }
+            xg[n] = x_sum;
+            hg[n] = h_sum;
+          }
+          for (int i = 0; i < hidden; i++) {
+            int o = b * hidden + i;
+            if (mode == "LSTM") {
+              float ig = sigmoid(xg[i] + hg[i]);
+              float fg = sigmoid(xg[hidden + i] + hg[hidden + i]);
+              float gg = std::tanh(xg[2 * hidden + i] + hg[2 * hidden + i]);
+              float og = sigmoid(xg[3 * hidden + i] + hg[3 * hidden + i]);
+              c[o] = fg * c[o] + ig * gg;
+              new_h[o] = og * std::tanh(c[o]);
+            } else {
+              float r = sigmoid(xg[i] + hg[i]);
+              float z = sigmoid(xg[hidden + i] + hg[hidden + i]);
+              float cand =
+                  std::tanh(xg[2 * hidden + i] + r * hg[2 * hidden + i]);
+              new_h[o] = (1.f - z) * cand + z * h[o];
+            }
+            layer_output[(t * batch + b) * direction_num * hidden +
+                         d * hidden + i] = new_h[o];
+          }
+        }
+        h = new_h;
+      }
+      std::copy(h.begin(), h.end(), last_h->begin() + state_offset);
+      std::copy(c.begin(), c.end(), last_c->begin() + state_offset);
+    }
+    layer_input = layer_output;
+    in_size = direction_num * hidden;
+  }
+  *output = layer_input;
+}
+
+static void test_rnn(const std::string& mode, bool is_bidirec) {
+  const int time_step = 5;
+  const int input_size = 7;
+  const int hidden = 10;
+  const int num_layers = 2;
+  const int gate_num = mode == "LSTM" ? 4 : 3;
+  const int direction_num = is_bidirec ? 2 : 1;
+
+  auto fill = [](std::vector<float>* v) {
+    for (size_t i = 0; i < v->size(); i++) {
+      (*v)[i] = static_cast<float>((i * 37 + 11) % 101) / 101.f - 0.5f;
+    }
+  };
+  std::vector<std::vector<float>> weight_data;
+  for (int i = 0; i < 2; i++) {
+    for (int l = 0; l < num_layers; l++) {
+      int in_size = l == 0 ? input_size : direction_num * hidden;
+      for (int d = 0; d < direction_num; d++) {
+        if (i == 0) {
+          weight_data.emplace_back(gate_num * hidden * in_size);
+          weight_data.emplace_back(gate_num * hidden * hidden);
+        } else {
+          weight_data.emplace_back(gate_num * hidden);
+          weight_data.emplace_back(gate_num * hidden);
+        }
+      }
+    }
+  }
+  for (auto& w : weight_data) fill(&w);
+  std::vector<Tensor> weights(weight_data.size());
+  int half = weight_data.size() / 2;
+  for (size_t i = 0; i < weights.size(); i++) {
+    int l = (i % half) / (2 * direction_num);
+    int in_size = l == 0 ? input_size : direction_num * hidden;
+    if (static_cast<int>(i) >= half) {
+      weights[i].Resize({gate_num * hidden});
+    } else if (i % 2 == 0) {
+      weights[i].Resize({gate_num * hidden, in_size});
+    } else {
+      weights[i].Resize({gate_num * hidden, hidden});
+    }
+    std::copy(weight_data[i].begin(),
+              weight_data[i].end(),
+              weights[i].mutable_data<float>());
+  }
+
+  RnnCompute rnn;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  rnn.SetContext(std::move(ctx));
+  // The second run with another batch size repacks the recurrent weights
+  for (int batch : {3, 5}) {
+    std::vector<float> input_data(time_step * batch * input_size);
+    fill(&input_data);
+    std::vector<float> init_h(num_layers * direction_num * batch * hidden);
+    std::vector<float> init_c(init_h.size());
+    fill(&init_h);
+    std::reverse(init_h.begin(), init_h.end());
+    fill(&init_c);
+
+    Tensor input, pre_h, pre_c, out, last_h, last_c, dropout_state, reserve;
+    input.Resize({time_step, batch, input_size});
+    std::copy(input_data.begin(),
+              input_data.end(),
+              input.mutable_data<float>());
+    pre_h.Resize({num_layers * direction_num, batch, hidden});
+    std::copy(init_h.begin(), init_h.end(), pre_h.mutable_data<float>());
+    pre_c.Resize({num_layers * direction_num, batch, hidden});
+    std::copy(init_c.begin(), init_c.end(), pre_c.mutable_data<float>());
+    out.Resize({time_step, batch, direction_num * hidden});
+    last_h.Resize(pre_h.dims());
+    last_c.Resize(pre_c.dims());
+
+    operators::RnnParam param;
+    param.Input = &input;
+    for (auto& w : weights) param.WeightList.push_back(&w);
+    param.PreState.push_back(&pre_h);
+    param.State.push_back(&last_h);
+    if (mode == "LSTM") {
+      param.PreState.push_back(&pre_c);
+      param.State.push_back(&last_c);
+    }
+    param.DropoutState = &dropout_state;
+    param.Reserve = &reserve;
+    param.Out = &out;
+    param.is_bidirec = is_bidirec;
+    param.input_size = input_size;
+    param.hidden_size = hidden;
+    param.num_layers = num_layers;
+    param.mode = mode;
+    param.is_test = true;
+    rnn.SetParam(param);
+    rnn.Run();
+
+    std::vector<float> out_ref, last_h_ref, last_c_ref;
+    rnn_ref(mode,
+            input_data,
+            weight_data,
+            init_h,
+            init_c,
+            time_step,
+            batch,
+            input_size,
+            hidden,
+            num_layers,
+            is_bidirec,
+            &out_ref,
+            &last_h_ref,
+            &last_c_ref);
+    auto* out_data = out.data<float>();
+    for (size_t i = 0; i < out_ref.size(); i++) {
+      EXPECT_NEAR(out_data[i], out_ref[i], 1e-4) << batch << " " << i;
+    }
+    auto* last_h_data = last_h.data<float>();
+    for (size_t i = 0; i < last_h_ref.size(); i++) {
+      EXPECT_NEAR(last_h_data[i], last_h_ref[i], 1e-4) << batch << " " << i;
+    }
+    if (mode == "LSTM") {
+      auto* last_c_data = last_c.data<float>();
+      for (size_t i = 0; i < last_c_ref.size(); i++) {
+        EXPECT_NEAR(last_c_data[i], last_c_ref[i], 1e-4) << batch << " " << i;
+      }
+    }
+  }
+}
+
+TEST(rnn_x86, retrive_op) {
+  auto rnn = KernelRegistry::Global().Create("rnn");
+  ASSERT_FALSE(rnn.empty());
+  ASSERT_TRUE(rnn.front());
+}
+
+TEST(rnn_x86, run_test) {
+  for (auto mode : {"LSTM", "GRU"}) {
+    for (bool is_bidirec : {false, true}) {
+      test_rnn(mode, is_bidirec);
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(rnn, kX86, kFloat, kNCHW, def);
@@ -17,6 +17,7 @@
 #include <Eigen/Core>
 #include <vector>
 #include "lite/backends/x86/math/math_function.h"
+#include "lite/backends/x86/math/transpose.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -34,6 +35,13 @@ inline void TransCompute(const int dim,
                          const lite::Tensor& in,
                          lite::Tensor* out,
                          const std::vector<int>& axis) {
+  if (paddle::lite::x86::math::BlockedTranspose<T>(
+          in.data<T>(),
+          out->template mutable_data<T>(),
+          in.dims().Vectorize(),
+          axis)) {
+    return;
+  }
   switch (dim) {
     case 1:
       paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 1> trans1;
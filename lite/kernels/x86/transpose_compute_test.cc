@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "lite/backends/x86/cpu_info.h"
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/transpose_compute.h"
 
@@ -127,6 +128,97 @@ TEST(transpose2_x86, run_test) {
   }
 }
 
+template <typename T>
+void TransposeRef(const lite::Tensor& x,
+                  const std::vector<int>& axis,
+                  lite::Tensor* out) {
+  auto in_dims = x.dims().Vectorize();
+  int rank = in_dims.size();
+  std::vector<int64_t> out_dims(rank);
+  for (int i = 0; i < rank; ++i) out_dims[i] = in_dims[axis[i]];
+  out->Resize(out_dims);
+  std::vector<int64_t> in_stride(rank, 1);
+  for (int i = rank - 2; i >= 0; --i) {
+    in_stride[i] = in_stride[i + 1] * in_dims[i + 1];
+  }
+  const T* x_data = x.data<T>();
+  T* out_data = out->mutable_data<T>();
+  for (int64_t o = 0; o < out->numel(); ++o) {
+    int64_t rem = o;
+    int64_t offset = 0;
+    for (int i = rank - 1; i >= 0; --i) {
+      offset += (rem % out_dims[i]) * in_stride[axis[i]];
+      rem /= out_dims[i];
+    }
+    out_data[o] = x_data[offset];
+  }
+}
+
+template <typename T>
+void TestTransposePermutation(const std::vector<int64_t>& x_shape,
+                              const std::vector<int>& axis) {
+  lite::Tensor x, out, out_ref;
+  x.Resize(x_shape);
+  auto* x_data = x.mutable_data<T>();
+  for (int64_t i = 0; i < x.numel(); ++i) {
+    x_data[i] = static_cast<T>(i % 1000);
+  }
+  TransposeRef<T>(x, axis, &out_ref);
+  out.Resize(out_ref.dims());
+
+  TransposeCompute<T> transpose;
+  operators::TransposeParam param;
+  param.x = &x;
+  param.output = &out;
+  param.axis = axis;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  transpose.SetContext(std::move(ctx));
+  transpose.SetParam(param);
+  transpose.Run();
+
+  const T* out_data = out.data<T>();
+  const T* ref_data = out_ref.data<T>();
+  for (int64_t i = 0; i < out.numel(); ++i) {
+    ASSERT_EQ(out_data[i], ref_data[i]) << "at " << i;
+  }
+}
+
+TEST(transpose_x86, blocked_permutations) {
+  // {shape, axis}: 0213, 0132, NCHW -> NHWC, NHWC -> NCHW, plain 2-D, size-1
+  // dims, tails smaller than a tile and a permutation left to Eigen.
+  std::vector<std::pair<std::vector<int64_t>, std::vector<int>>> cases = {
+      {{2, 12, 33, 64}, {0, 2, 1, 3}},
+      {{2, 3, 37, 45}, {0, 1, 3, 2}},
+      {{2, 3, 17, 19}, {0, 2, 3, 1}},
+      {{2, 17, 19, 35}, {0, 3, 1, 2}},
+      {{128, 256}, {1, 0}},
+      {{67, 9}, {1, 0}},
+      {{1, 4, 1, 9}, {3, 1, 2, 0}},
+      {{5, 6, 7}, {0, 1, 2}},
+      {{2, 3, 4, 5}, {1, 3, 0, 2}},
+      {{2, 3, 4, 5, 6}, {0, 3, 1, 4, 2}},
+  };
+  for (auto& c : cases) {
+    TestTransposePermutation<float>(c.first, c.second);
+    TestTransposePermutation<int64_t>(c.first, c.second);
+  }
+}
+
+TEST(transpose_x86, blocked_isa_variants) {
+  // The float tiles run the micro kernel of the variant picked at runtime.
+  const lite::x86::cpu_isa_t host_isa = lite::x86::RuntimeIsa();
+  for (auto variant : {lite::x86::isa_any,
+                       lite::x86::sse42,
+                       lite::x86::avx2,
+                       lite::x86::avx512f}) {
+    lite::x86::SetMaxIsa(variant);
+    TestTransposePermutation<float>({2, 3, 37, 45}, {0, 1, 3, 2});
+    TestTransposePermutation<float>({67, 9}, {1, 0});
+  }
+  lite::x86::SetMaxIsa(host_isa);
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -19,11 +19,53 @@
 #include <utility>
 #include <vector>
 #include "lite/core/model/base/io.h"
+#include "lite/core/thread_pool.h"
 #include "lite/model_parser/flatbuffers/traits.h"
 
 namespace paddle {
 namespace lite {
 namespace fbs {
+namespace {
+// Alignment of the data section in the mapped param format.
+const uint32_t kMappedSectionAlignment = 4096;
+// Alignment of every payload in the data section.
+const uint32_t kMappedDataAlignment = 64;
+// Zero bytes appended to the data section, the SIMD kernels may read a little
+// beyond the end of the last tensor.
+const uint32_t kMappedTailBytes = 64;
+
+// The upper bound of the bytes read ahead of decoding in ParamDeserializer.
+const size_t kDecodeBatchBytes = 64 * 1024 * 1024;
+
+inline uint64_t AlignTo(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Buffer referring to a payload in a mapped model file. The mapping is kept
+// alive as long as any tensor uses it. A tensor growing beyond its payload
+// leaves the mapping and switches to an owned buffer.
+class MappedBuffer : public lite::Buffer {
+ public:
+  MappedBuffer(std::shared_ptr<model_parser::MappedFile> file,
+               void* data,
+               size_t size)
+      : lite::Buffer(data, TargetType::kHost, size), file_(file) {}
+
+  void ResetLazy(TargetType target, size_t size) override {
+    if (!own_data_ && (target != target_ || space_ < size)) {
+      data_ = nullptr;
+      space_ = 0;
+      own_data_ = true;
+      file_.reset();
+    }
+    lite::Buffer::ResetLazy(target, size);
+  }
+
+ private:
+  std::shared_ptr<model_parser::MappedFile> file_;
+};
+}  // namespace
+
 namespace deprecated {
 void SetCombinedParamsWithScope(const lite::Scope& scope,
                                 const std::set<std::string>& param_names,
@@ -113,6 +155,69 @@ void ParamSerializer::WriteHeader() {
   // 2. size of meta information (reserved)
   writer_->Write<uint16_t>(0U);
 }
+
+/*
+ * Binary structure of the mapped params:
+ * ------------------------------------------------------------------
+ * |  header   | version(uint16) | meta_size(uint16) | meta        |
+ * |  meta     | params_size(uint32) | section_alignment(uint32)   |
+ * |           | data_alignment(uint32)                            |
+ * |  params   | desc_size(uint32) | data_offset(uint64)           |
+ * |  (each)   | data_size(uint64) | ParamDesc without data        |
+ * |  padding  | up to section_alignment of the file               |
+ * |  data     | payloads at data_offset of the section, each one  |
+ * |           | aligned to data_alignment, then zero tail bytes   |
+ * ------------------------------------------------------------------
+ * The offsets of the file are counted from the first byte the writer wrote,
+ * so the params are expected to be written into the same file as the model.
+ */
+void MappedParamSerializer::ForwardWrite(
+    const lite::Scope& scope, const std::set<std::string>& param_names) {
+  CHECK_LT(param_names.size(), (std::numeric_limits<uint32_t>::max)())
+      << "The number of params is out of range.";
+  writer_->Write<uint32_t>(param_names.size());
+  writer_->Write<uint32_t>(kMappedSectionAlignment);
+  writer_->Write<uint32_t>(kMappedDataAlignment);
+
+  std::vector<const lite::Tensor*> tensors;
+  uint64_t data_offset = 0;
+  for (const auto& name : param_names) {
+    auto& tensor = scope.FindVar(name)->Get<lite::Tensor>();
+    fbs::ParamDesc param;
+    param.SetName(name);
+    param.SetDim(tensor.dims().Vectorize());
+    param.SetDataType(lite::ConvertPrecisionType(tensor.precision()));
+    param.CopyDataToBuffer(buf_.get());
+
+    const size_t param_bytes = buf_->size();
+    CHECK(param_bytes) << "The bytes size of param can not be zero";
+    data_offset = AlignTo(data_offset, kMappedDataAlignment);
+    writer_->Write<uint32_t>(param_bytes);
+    writer_->Write<uint64_t>(data_offset);
+    writer_->Write<uint64_t>(tensor.memory_size());
+    writer_->Write(buf_->data(), param_bytes);
+    data_offset += tensor.memory_size();
+    tensors.push_back(&tensor);
+  }
+
+  writer_->Align(kMappedSectionAlignment);
+  for (const auto* tensor : tensors) {
+    writer_->Align(kMappedDataAlignment);
+    if (tensor->memory_size()) {
+      writer_->Write(tensor->raw_data(), tensor->memory_size());
+    }
+  }
+  for (uint32_t i = 0; i < kMappedTailBytes; ++i) {
+    writer_->Write<uint8_t>(0U);
+  }
+}
+
+void MappedParamSerializer::WriteHeader() {
+  // 1. version id
+  writer_->Write<uint16_t>(version_);
+  // 2. size of meta information (reserved)
+  writer_->Write<uint16_t>(0U);
+}
 #endif
 
 void ParamDeserializer::ForwardRead(lite::Scope* scope) {
@@ -121,22 +226,102 @@ void ParamDeserializer::ForwardRead(lite::Scope* scope) {
   ReadBytesToBuffer(header_size);
   char const* data = static_cast<char const*>(buf_->data());
   uint16_t params_size = *reinterpret_cast<uint16_t const*>(data);
-  uint32_t max_tensor_size =
-      *reinterpret_cast<uint32_t const*>(data + sizeof(uint16_t));
 
-  buf_->ResetLazy(max_tensor_size);
+  std::vector<model_parser::Buffer> batch;
+  size_t batch_bytes = 0;
+  auto decode_batch = [&]() {
+    std::vector<fbs::ParamDescView> params(batch.size());
+    RunInParallel(batch.size(), threads_, [&](size_t i) {
+      params[i] = fbs::ParamDescView(&batch[i]);
+    });
+    // The scope is not thread-safe, so the variables are created serially.
+    std::vector<lite::Tensor*> tensors(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+      tensors[i] = scope->Var(params[i].Name())->GetMutable<lite::Tensor>();
+    }
+    RunInParallel(batch.size(), threads_, [&](size_t i) {
+      FillTensor(tensors[i], params[i]);
+    });
+    batch.clear();
+    batch_bytes = 0;
+  };
+
   for (size_t i = 0; i < params_size; ++i) {
     uint32_t total_size = reader_->Read<uint32_t>();
     uint32_t offset = reader_->Read<uint32_t>();
     uint32_t param_bytes = total_size - offset;
     ReadBytesToBuffer(offset - sizeof(offset));
+    batch.emplace_back(param_bytes);
+    reader_->Read(batch.back().data(), param_bytes);
+    batch_bytes += param_bytes;
+    if (batch_bytes >= kDecodeBatchBytes) {
+      decode_batch();
+    }
+  }
+  decode_batch();
+}
+
+void ParamDeserializer::ReadHeader() {
+  // 1. version id
+  uint16_t version = reader_->Read<uint16_t>();
+  CHECK_EQ(version, 0U)
+      << "File format error: The version of params must be zero.";
+  // 2. meta version
+  uint16_t meta_size = reader_->Read<uint16_t>();
+  ReadBytesToBuffer(meta_size);
+}
+
+void MappedParamDeserializer::ForwardRead(lite::Scope* scope) {
+  CHECK(scope) << "The pointer of scope is nullptr";
+  const uint32_t params_size = reader_->Read<uint32_t>();
+  const uint32_t section_alignment = reader_->Read<uint32_t>();
+  const uint32_t data_alignment = reader_->Read<uint32_t>();
+  CHECK(section_alignment && data_alignment)
+      << "File format error: The alignments of params can not be zero.";
+
+  struct Payload {
+    lite::Tensor* tensor;
+    uint64_t offset;
+    uint64_t size;
+  };
+  std::vector<Payload> payloads;
+  payloads.reserve(params_size);
+  for (uint32_t i = 0; i < params_size; ++i) {
+    const uint32_t param_bytes = reader_->Read<uint32_t>();
+    const uint64_t data_offset = reader_->Read<uint64_t>();
+    const uint64_t data_size = reader_->Read<uint64_t>();
     ReadBytesToBuffer(param_bytes);
     fbs::ParamDescView param(buf_.get());
-    FillTensor(scope->Var(param.Name())->GetMutable<lite::Tensor>(), param);
+    auto* tensor = scope->Var(param.Name())->GetMutable<lite::Tensor>();
+    tensor->Resize(param.Dim());
+    tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+    tensor->set_persistable(true);
+    payloads.push_back({tensor, data_offset, data_size});
+  }
+
+  const uint64_t section_begin =
+      AlignTo(reader_->current(), section_alignment);
+  for (const auto& payload : payloads) {
+    const uint64_t begin = section_begin + payload.offset;
+    if (file_) {
+      CHECK_LE(begin + payload.size, file_->size())
+          << "File format error: The payload of param is out of range.";
+      void* data = static_cast<char*>(file_->data()) + begin;
+      payload.tensor->ResetBuffer(
+          std::make_shared<MappedBuffer>(file_, data, payload.size),
+          payload.size);
+      continue;
+    }
+    CHECK_GE(begin, reader_->current())
+        << "File format error: The payloads of params are out of order.";
+    ReadBytesToBuffer(begin - reader_->current());
+    if (payload.size) {
+      reader_->Read(payload.tensor->mutable_data(payload.size), payload.size);
+    }
   }
 }
 
-void ParamDeserializer::ReadHeader() {
+void MappedParamDeserializer::ReadHeader() {
   // 1. version id
   uint16_t version = reader_->Read<uint16_t>();
   CHECK_EQ(version, 0U)
@@ -52,12 +52,37 @@ class ParamSerializer {
   uint16_t version_{0};
   std::unique_ptr<model_parser::Buffer> buf_;
 };
+
+// Writes the params with their payloads moved out of the flatbuffers
+// descriptions into a separate data section. The section starts at a page
+// boundary of the file and every payload is aligned to 64 bytes, so that the
+// loader is able to map the file and use the payloads in place.
+class MappedParamSerializer {
+ public:
+  explicit MappedParamSerializer(model_parser::ByteWriter* writer,
+                                 uint16_t version = 0)
+      : writer_(writer), version_{version}, buf_(new model_parser::Buffer) {
+    CHECK(writer_) << "A valid writer should be passed in the ctor of mapped "
+                      "param serializer.";
+    WriteHeader();
+  }
+  void ForwardWrite(const lite::Scope& scope,
+                    const std::set<std::string>& param_names);
+
+ private:
+  void WriteHeader();
+  model_parser::ByteWriter* writer_{nullptr};
+  uint16_t version_{0};
+  std::unique_ptr<model_parser::Buffer> buf_;
+};
 #endif
 
+// The params are read in batches, and the verification and copy of the params
+// in a batch run on `threads` threads.
 class ParamDeserializer {
  public:
-  explicit ParamDeserializer(model_parser::ByteReader* reader)
-      : reader_(reader), buf_(new model_parser::Buffer) {
+  explicit ParamDeserializer(model_parser::ByteReader* reader, int threads = 1)
+      : reader_(reader), threads_(threads), buf_(new model_parser::Buffer) {
     CHECK(reader_)
         << "A valid reader should be passed in the ctor of param deserializer.";
     ReadHeader();
@@ -71,6 +96,33 @@ class ParamDeserializer {
   }
   void ReadHeader();
   model_parser::ByteReader* reader_{nullptr};
+  int threads_{1};
+  std::unique_ptr<model_parser::Buffer> buf_;
+};
+
+// Reads the params written by MappedParamSerializer. If the mapped model file
+// is given, the tensors refer to the payloads in the mapping directly,
+// otherwise the payloads are copied from the reader.
+class MappedParamDeserializer {
+ public:
+  explicit MappedParamDeserializer(
+      model_parser::ByteReader* reader,
+      std::shared_ptr<model_parser::MappedFile> file = nullptr)
+      : reader_(reader), file_(file), buf_(new model_parser::Buffer) {
+    CHECK(reader_) << "A valid reader should be passed in the ctor of mapped "
+                      "param deserializer.";
+    ReadHeader();
+  }
+  void ForwardRead(lite::Scope* scope);
+
+ private:
+  void ReadBytesToBuffer(size_t size) {
+    buf_->ResetLazy(size);
+    reader_->Read(buf_->data(), size);
+  }
+  void ReadHeader();
+  model_parser::ByteReader* reader_{nullptr};
+  std::shared_ptr<model_parser::MappedFile> file_;
   std::unique_ptr<model_parser::Buffer> buf_;
 };
 
@@ -128,6 +128,75 @@ TEST(CombinedParamsDesc, Scope) {
     deserializer.ForwardRead(&scope_3);
     check_params(scope_3);
   }
+
+  {
+    Scope scope_4;
+    LOG(INFO) << "Load params from file with multiple threads...";
+    model_parser::BinaryFileReader reader(path);
+    fbs::ParamDeserializer deserializer(&reader, 4);
+    deserializer.ForwardRead(&scope_4);
+    check_params(scope_4);
+  }
+}
+
+TEST(MappedParams, Scope) {
+  const std::string path{"io_test.mapped_params.fbs"};
+  Scope scope;
+  std::vector<std::string> param_names({"var_0", "var_1", "var_2"});
+  Tensor* tensor_0 = scope.Var(param_names[0])->GetMutable<Tensor>();
+  set_tensor<float>(tensor_0, std::vector<int64_t>({3, 2}));
+  Tensor* tensor_1 = scope.Var(param_names[1])->GetMutable<Tensor>();
+  set_tensor<int8_t>(tensor_1, std::vector<int64_t>({10, 1}));
+  Tensor* tensor_2 = scope.Var(param_names[2])->GetMutable<Tensor>();
+  set_tensor<int16_t>(tensor_2, std::vector<int64_t>({16, 1}));
+  std::set<std::string> params_set(param_names.begin(), param_names.end());
+
+  {
+    model_parser::BinaryFileWriter writer{path};
+    fbs::MappedParamSerializer serializer{&writer};
+    serializer.ForwardWrite(scope, params_set);
+  }
+
+  auto check_params = [&](const lite::Scope& scope) {
+    CHECK(TensorCompareWith(*tensor_0,
+                            scope.FindVar(param_names[0])->Get<Tensor>()));
+    CHECK(TensorCompareWith(*tensor_1,
+                            scope.FindVar(param_names[1])->Get<Tensor>()));
+    CHECK(TensorCompareWith(*tensor_2,
+                            scope.FindVar(param_names[2])->Get<Tensor>()));
+  };
+
+  {
+    Scope scope_0;
+    LOG(INFO) << "Load mapped params from file...";
+    model_parser::BinaryFileReader reader(path);
+    std::shared_ptr<model_parser::MappedFile> file(
+        new model_parser::MappedFile(path));
+    fbs::MappedParamDeserializer deserializer(&reader, file);
+    deserializer.ForwardRead(&scope_0);
+    check_params(scope_0);
+    for (const auto& name : param_names) {
+      const auto& tensor = scope_0.FindVar(name)->Get<Tensor>();
+      const char* data = static_cast<const char*>(tensor.raw_data());
+      // The payloads are used in place and aligned to 64 bytes.
+      CHECK(data >= static_cast<const char*>(file->data()));
+      CHECK(data < static_cast<const char*>(file->data()) + file->size());
+      CHECK_EQ(reinterpret_cast<uintptr_t>(data) % 64, 0u);
+    }
+  }
+
+  {
+    Scope scope_1;
+    LOG(INFO) << "Load mapped params from string buffer...";
+    model_parser::BinaryFileReader file_reader(path);
+    model_parser::Buffer buf(file_reader.length());
+    file_reader.Read(buf.data(), file_reader.length());
+    std::string str{static_cast<const char*>(buf.data()), buf.size()};
+    model_parser::StringBufferReader reader(str);
+    fbs::MappedParamDeserializer deserializer(&reader);
+    deserializer.ForwardRead(&scope_1);
+    check_params(scope_1);
+  }
 }
 #endif  // LITE_WITH_FLATBUFFERS_DESC
 
@@ -513,6 +513,12 @@ void SaveModelNaive(const std::string &model_file,
   if (PADDLE_LITE_EXPERIMENTAL_MODEL != nullptr) {
     meta_version = 1;
   }
+  // Register environment variable 'PADDLE_LITE_MODEL_MAPPED_PARAMS' to save
+  // the params into a page-aligned data section (meta_version = 3), which is
+  // mapped instead of copied when the model is loaded from file.
+  if (std::getenv("PADDLE_LITE_MODEL_MAPPED_PARAMS") != nullptr) {
+    meta_version = 3;
+  }
   // Save meta_version(uint16) into file
   writer.Write(&meta_version, sizeof(uint16_t));
 
@@ -560,9 +566,15 @@ void SaveModelNaive(const std::string &model_file,
       serializer.ForwardWrite(exec_scope, unique_var_names);
       break;
     }
+    case 3: {
+      fbs::MappedParamSerializer serializer{&writer};
+      // 3.3 Save params with an aligned data section into naive model
+      serializer.ForwardWrite(exec_scope, unique_var_names);
+      break;
+    }
     default: {
       LOG(FATAL) << "Error: Unsupported opt meta_version, "
-                    "meta_version should be set as 1 or 2.";
+                    "meta_version should be set as 1, 2 or 3.";
       break;
     }
   }
@@ -764,7 +776,8 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
  * |   5   |  param_data     |   char[]    |                |
  * ----------------------------------------------------------
  *  Meaning of each part:
- *      meta_version: meata_version, 0 default.
+ *      meta_version: meata_version, 0 default. The param_data of version 3
+ *                    ends with a page-aligned section of raw payloads.
  *      opt_version:  lite_version of opt tool that transformed this model.
  *      topo_size:    length of `topo_data`.
  *      topo_data:    contains model's topology data.
@@ -773,7 +786,8 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
 
 void LoadModelNaiveFromFile(const std::string &filename,
                             Scope *scope,
-                            cpp::ProgramDesc *cpp_prog) {
+                            cpp::ProgramDesc *cpp_prog,
+                            int threads) {
   CHECK(cpp_prog);
   CHECK(scope);
   // ModelFile
@@ -797,10 +811,13 @@ void LoadModelNaiveFromFile(const std::string &filename,
 #endif
       break;
     case 1:
-      LoadModelFbsFromFile(&reader, scope, cpp_prog, 1);
+      LoadModelFbsFromFile(&reader, scope, cpp_prog, 1, threads);
       break;
     case 2:
-      LoadModelFbsFromFile(&reader, scope, cpp_prog, 2);
+      LoadModelFbsFromFile(&reader, scope, cpp_prog, 2, threads);
+      break;
+    case 3:
+      LoadModelFbsFromFile(&reader, scope, cpp_prog, 3, threads);
       break;
     default:
       LOG(FATAL) << "The model format cannot be recognized. Please make sure "
@@ -868,7 +885,8 @@ void LoadModelNaiveV0FromFile(const std::string &filename,
 void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
                           Scope *scope,
                           cpp::ProgramDesc *cpp_prog,
-                          uint16_t meta_version) {
+                          uint16_t meta_version,
+                          int threads) {
   CHECK(cpp_prog);
   CHECK(scope);
   CHECK_EQ(cpp_prog->BlocksSize(), 0);
@@ -920,7 +938,15 @@ void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
     }
     case 2: {
       /* load scope from param.fbs with meta_version=2 */
-      fbs::ParamDeserializer deserializer(reader);
+      fbs::ParamDeserializer deserializer(reader, threads);
+      deserializer.ForwardRead(scope);
+      break;
+    }
+    case 3: {
+      /* map the data section of params with meta_version=3 */
+      std::shared_ptr<model_parser::MappedFile> file(
+          new model_parser::MappedFile(reader->path()));
+      fbs::MappedParamDeserializer deserializer(reader, file);
       deserializer.ForwardRead(scope);
       break;
     }
@@ -932,7 +958,8 @@ void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
 
 void LoadModelNaiveFromMemory(const std::string &model_buffer,
                               Scope *scope,
-                              cpp::ProgramDesc *cpp_prog) {
+                              cpp::ProgramDesc *cpp_prog,
+                              int threads) {
   CHECK(cpp_prog);
   CHECK(scope);
   cpp_prog->ClearBlocks();
@@ -954,10 +981,13 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
 #endif
       break;
     case 1:
-      LoadModelFbsFromMemory(&reader, scope, cpp_prog, 1);
+      LoadModelFbsFromMemory(&reader, scope, cpp_prog, 1, threads);
       break;
     case 2:
-      LoadModelFbsFromMemory(&reader, scope, cpp_prog, 2);
+      LoadModelFbsFromMemory(&reader, scope, cpp_prog, 2, threads);
+      break;
+    case 3:
+      LoadModelFbsFromMemory(&reader, scope, cpp_prog, 3, threads);
       break;
     default:
       LOG(FATAL) << "The model format cannot be recognized. Please make sure "
@@ -1003,12 +1033,13 @@ void LoadModelNaiveV0FromMemory(const std::string &model_buffer,
 }
 #endif
 ///////////////////////////////////////////////////////////////////
-// Meta_version=1,2
+// Meta_version=1,2,3
 ///////////////////////////////////////////////////////////////////
 void LoadModelFbsFromMemory(model_parser::StringBufferReader *reader,
                             Scope *scope,
                             cpp::ProgramDesc *cpp_prog,
-                            uint16_t meta_version) {
+                            uint16_t meta_version,
+                            int threads) {
   // (1)get opt version
   char opt_version[16];
   const uint64_t paddle_version_length = 16 * sizeof(char);
@@ -1042,7 +1073,13 @@ void LoadModelFbsFromMemory(model_parser::StringBufferReader *reader,
       break;
     }
     case 2: {
-      fbs::ParamDeserializer deserializer(reader);
+      fbs::ParamDeserializer deserializer(reader, threads);
+      deserializer.ForwardRead(scope);
+      break;
+    }
+    case 3: {
+      // The model buffer is owned by the caller, so copy the payloads.
+      fbs::MappedParamDeserializer deserializer(reader);
       deserializer.ForwardRead(scope);
       break;
     }
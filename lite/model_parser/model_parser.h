@@ -139,21 +139,26 @@ void LoadNonCombinedParamsPb(const std::string& model_dir,
                              const lite_api::CxxModelBuffer& model_buffer,
                              Scope* scope);
 #endif  // LITE_ON_TINY_PUBLISH
+// `threads` is the number of the threads to decode the params.
 void LoadModelFbsFromFile(model_parser::BinaryFileReader* reader,
                           Scope* scope,
                           cpp::ProgramDesc* cpp_prog,
-                          uint16_t meta_version);
+                          uint16_t meta_version,
+                          int threads = 1);
 
 void LoadModelNaiveFromFile(const std::string& filename,
                             lite::Scope* scope,
-                            cpp::ProgramDesc* prog);
+                            cpp::ProgramDesc* prog,
+                            int threads = 1);
 
 void LoadModelNaiveFromMemory(const std::string& model_buffer,
                               lite::Scope* scope,
-                              cpp::ProgramDesc* cpp_prog);
+                              cpp::ProgramDesc* cpp_prog,
+                              int threads = 1);
 void LoadModelFbsFromMemory(model_parser::StringBufferReader* reader,
                             Scope* scope,
                             cpp::ProgramDesc* cpp_prog,
-                            uint16_t meta_version);
+                            uint16_t meta_version,
+                            int threads = 1);
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,100 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fused_embedding_seq_pool_op.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusedEmbeddingSeqPoolOpLite::CheckShape() const {
+  CHECK_OR_FALSE(param_.W)
+  CHECK_OR_FALSE(param_.Ids)
+  CHECK_OR_FALSE(param_.Out)
+
+  const auto& table_dims = param_.W->dims();
+  const auto& ids_dims = param_.Ids->dims();
+  const auto& lod = param_.Ids->lod();
+
+  CHECK_EQ_OR_FALSE(table_dims.size(), 2);
+  CHECK_EQ_OR_FALSE(ids_dims[ids_dims.size() - 1], 1);
+  CHECK_OR_FALSE(!lod.empty() && lod.size() <= 2);
+  CHECK_OR_FALSE(param_.combiner == "sum" || param_.combiner == "average" ||
+                 param_.combiner == "sqrt");
+  CHECK_OR_FALSE(param_.quant_type == "none" ||
+                 param_.quant_type == "uint8" || param_.quant_type == "fp16");
+  if (param_.quant_type != "none") {
+    CHECK_GT_OR_FALSE(table_dims[1], 2);
+  }
+  return true;
+}
+
+bool FusedEmbeddingSeqPoolOpLite::InferShapeImpl() const {
+  const auto& table_dims = param_.W->dims();
+  const auto& lod = param_.Ids->lod();
+
+  int64_t emb_dim = table_dims[1];
+  if (param_.quant_type == "uint8") {
+    emb_dim = (table_dims[1] - 2) * 4;
+  } else if (param_.quant_type == "fp16") {
+    emb_dim = (table_dims[1] - 2) * 2;
+  }
+  // Same as lookup_table followed by sequence_pool on the last lod level.
+  int64_t num_seqs = static_cast<int64_t>(lod.back().size()) - 1;
+  param_.Out->Resize({num_seqs, emb_dim});
+  LoD out_lod;
+  if (lod.size() == 2) {
+    out_lod.push_back(lod[0]);
+  } else {
+    std::vector<uint64_t> offset(num_seqs + 1);
+    for (int64_t i = 0; i <= num_seqs; ++i) offset[i] = i;
+    out_lod.push_back(offset);
+  }
+  param_.Out->set_lod(out_lod);
+  return true;
+}
+
+bool FusedEmbeddingSeqPoolOpLite::AttachImpl(const cpp::OpDesc& op_desc,
+                                             lite::Scope* scope) {
+  auto input = op_desc.Input("W").front();
+  auto ids = op_desc.Input("Ids").front();
+  auto out = op_desc.Output("Out").front();
+
+  param_.W = scope->FindVar(input)->GetMutable<lite::Tensor>();
+  param_.Ids = scope->FindVar(ids)->GetMutable<lite::Tensor>();
+  param_.Out = scope->FindVar(out)->GetMutable<lite::Tensor>();
+
+  if (op_desc.HasAttr("padding_idx")) {
+    param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  }
+  if (op_desc.HasAttr("combiner")) {
+    param_.combiner = op_desc.GetAttr<std::string>("combiner");
+  }
+  if (op_desc.HasAttr("quant_type")) {
+    param_.quant_type = op_desc.GetAttr<std::string>("quant_type");
+  }
+  if (op_desc.HasAttr("pad_value")) {
+    param_.pad_value = op_desc.GetAttr<float>("pad_value");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fused_embedding_seq_pool,
+                 paddle::lite::operators::FusedEmbeddingSeqPoolOpLite)
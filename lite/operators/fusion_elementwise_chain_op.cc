@@ -0,0 +1,95 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_elementwise_chain_op.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionElementwiseChainOp::CheckShape() const {
+  CHECK_GE_OR_FALSE(param_.X.size(), 1UL);
+  CHECK_OR_FALSE(param_.Out);
+  size_t num_steps = param_.chain_ops.size();
+  CHECK_GE_OR_FALSE(num_steps, 1UL);
+  CHECK_EQ_OR_FALSE(param_.chain_x.size(), num_steps);
+  CHECK_EQ_OR_FALSE(param_.chain_y.size(), num_steps);
+  CHECK_EQ_OR_FALSE(param_.chain_alpha.size(), num_steps);
+  CHECK_EQ_OR_FALSE(param_.chain_beta.size(), num_steps);
+  for (size_t i = 0; i < num_steps; ++i) {
+    // a step can only use the inputs and the steps before it
+    int num_values = static_cast<int>(param_.X.size() + i);
+    CHECK_OR_FALSE(param_.chain_x[i] < num_values);
+    CHECK_OR_FALSE(param_.chain_y[i] < num_values);
+  }
+  return true;
+}
+
+bool FusionElementwiseChainOp::InferShapeImpl() const {
+  // broadcast all the inputs with their trailing dims aligned
+  size_t max_rank = 0;
+  const lite::Tensor* largest = param_.X.front();
+  for (auto* x : param_.X) {
+    max_rank = (std::max)(max_rank, x->dims().size());
+    if (x->numel() > largest->numel()) {
+      largest = x;
+    }
+  }
+  std::vector<int64_t> out_dims(max_rank, 1);
+  for (auto* x : param_.X) {
+    auto x_dims = x->dims();
+    size_t shift = max_rank - x_dims.size();
+    for (size_t i = 0; i < x_dims.size(); ++i) {
+      int64_t& out_dim = out_dims[i + shift];
+      if (x_dims[i] == -1 || out_dim == -1) {
+        out_dim = -1;
+      } else if (x_dims[i] != 1) {
+        CHECK(out_dim == 1 || out_dim == x_dims[i])
+            << "Can not broadcast " << x_dims << " in " << op_type_;
+        out_dim = x_dims[i];
+      }
+    }
+  }
+  param_.Out->Resize(DDim(out_dims));
+  auto out_lod = param_.Out->mutable_lod();
+  *out_lod = largest->lod();
+  return true;
+}
+
+bool FusionElementwiseChainOp::AttachImpl(const cpp::OpDesc& opdesc,
+                                          lite::Scope* scope) {
+  param_.X.clear();
+  for (auto& name : opdesc.Input("X")) {
+    param_.X.push_back(GetVar<lite::Tensor>(scope, name));
+  }
+  auto Out_name = opdesc.Output("Out").front();
+  param_.Out = GetMutableVar<lite::Tensor>(scope, Out_name);
+  param_.chain_ops = opdesc.GetAttr<std::vector<std::string>>("chain_ops");
+  param_.chain_x = opdesc.GetAttr<std::vector<int>>("chain_x");
+  param_.chain_y = opdesc.GetAttr<std::vector<int>>("chain_y");
+  param_.chain_alpha = opdesc.GetAttr<std::vector<float>>("chain_alpha");
+  param_.chain_beta = opdesc.GetAttr<std::vector<float>>("chain_beta");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_elementwise_chain,
+                 paddle::lite::operators::FusionElementwiseChainOp);
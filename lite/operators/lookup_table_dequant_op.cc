@@ -33,6 +33,7 @@ bool LookupTableDequantOpLite::CheckShape() const {
   CHECK_EQ_OR_FALSE(table_dims.size(), 2);
   CHECK_EQ_OR_FALSE(ids_dims[ids_rank - 1], 1);
   CHECK_GT_OR_FALSE(table_dims[1], 2);
+  CHECK_OR_FALSE(param_.quant_type == "uint8" || param_.quant_type == "fp16");
   return true;
 }
 
@@ -42,7 +43,9 @@ bool LookupTableDequantOpLite::InferShapeImpl() const {
 
   auto out_dims = ids_dims;
   int ids_rank = ids_dims.size();
-  out_dims[ids_rank - 1] = (table_dims[1] - 2) * 4;
+  // 4 uint8 or 2 fp16 codes are packed in every float after [min, max].
+  int64_t codes_per_float = param_.quant_type == "fp16" ? 2 : 4;
+  out_dims[ids_rank - 1] = (table_dims[1] - 2) * codes_per_float;
 
   param_.Out->Resize(out_dims);
   param_.Out->set_lod(param_.Ids->lod());
@@ -60,6 +63,9 @@ bool LookupTableDequantOpLite::AttachImpl(const cpp::OpDesc& op_desc,
   param_.Out = scope->FindVar(out)->GetMutable<lite::Tensor>();
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  if (op_desc.HasAttr("quant_type")) {
+    param_.quant_type = op_desc.GetAttr<std::string>("quant_type");
+  }
 
   return true;
 }
@@ -574,6 +574,19 @@ struct FusionElementwiseActivationGradParam : public ElementwiseGradParam {
   std::string act_type;
 };
 
+// A chain of elementwise ops fused by lite_elementwise_chain_fuse_pass.
+// Step i computes value X.size() + i from chain_x[i] (and chain_y[i] for
+// binary ops), the value of the last step is Out.
+struct FusionElementwiseChainParam : ParamBase {
+  std::vector<const lite::Tensor*> X{};
+  lite::Tensor* Out{};
+  std::vector<std::string> chain_ops{};
+  std::vector<int> chain_x{};
+  std::vector<int> chain_y{};
+  std::vector<float> chain_alpha{};
+  std::vector<float> chain_beta{};
+};
+
 /// ----------------------- mean operators ----------------------
 struct MeanParam : ParamBase {
   const lite::Tensor* X{};
@@ -976,6 +989,20 @@ struct LookupTableDequantParam : ParamBase {
   lite::Tensor* Ids{nullptr};
   lite::Tensor* Out{nullptr};
   int64_t padding_idx{-1};
+  // "uint8": rows of [min, max, uint8 codes], "fp16": [scale, bias, fp16].
+  std::string quant_type{"uint8"};
+};
+
+struct FusedEmbeddingSeqPoolParam : ParamBase {
+  const lite::Tensor* W{nullptr};
+  const lite::Tensor* Ids{nullptr};
+  lite::Tensor* Out{nullptr};
+  int64_t padding_idx{-1};
+  // "sum", "average" or "sqrt".
+  std::string combiner{"sum"};
+  // "none", or the row-quantized layouts of lookup_table_dequant.
+  std::string quant_type{"none"};
+  float pad_value{0.0f};
 };
 
 struct Im2SequenceParam : ParamBase {
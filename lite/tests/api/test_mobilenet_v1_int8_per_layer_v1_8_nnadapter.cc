@@ -14,6 +14,7 @@
 
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <vector>
 #include "lite/api/paddle_api.h"
 #include "lite/api/test/lite_api_test_helper.h"
@@ -157,5 +158,82 @@ TEST(MobileNetV1, test_mobilenet_v1_int8_per_layer_v1_8_nnadapter) {
   ASSERT_GE(out_accuracy, out_accuracy_threshold);
 }
 
+// Overlap the device execution with the host ops by the pipelined execution,
+// and simulate the latency of a real device with the fake device
+TEST(MobileNetV1, test_mobilenet_v1_int8_per_layer_v1_8_nnadapter_pipelined) {
+#if defined(LITE_WITH_NNADAPTER) && defined(NNADAPTER_WITH_FAKE_DEVICE)
+  std::vector<std::string> nnadapter_device_names({"fake_device"});
+  std::string nnadapter_context_properties("FAKE_DEVICE_SIMULATED_LATENCY=10;");
+  float out_accuracy_threshold = 0.78f;
+  paddle::lite_api::MobileConfig mobile_config;
+  mobile_config.set_model_from_file(FLAGS_model_dir + ".nb");
+  mobile_config.set_threads(FLAGS_threads);
+  mobile_config.set_power_mode(
+      static_cast<lite_api::PowerMode>(FLAGS_power_mode));
+  mobile_config.set_nnadapter_device_names(nnadapter_device_names);
+  mobile_config.set_nnadapter_context_properties(nnadapter_context_properties);
+  mobile_config.set_nnadapter_pipelined_execution(true);
+  auto predictor = paddle::lite_api::CreatePaddlePredictor(mobile_config);
+
+  std::string raw_data_dir = FLAGS_data_dir + std::string("/raw_data");
+  std::vector<int> input_shape{
+      FLAGS_batch, FLAGS_channel, FLAGS_im_width, FLAGS_im_height};
+  auto raw_data = ReadRawData(raw_data_dir, input_shape, FLAGS_iteration);
+
+  int input_size = 1;
+  for (auto i : input_shape) {
+    input_size *= i;
+  }
+
+  auto get_output = [&]() {
+    auto output_tensor = predictor->GetOutput(0);
+    auto output_shape = output_tensor->shape();
+    auto output_data = output_tensor->data<float>();
+    EXPECT_EQ(output_shape.size(), 2UL);
+    EXPECT_EQ(output_shape[0], 1);
+    EXPECT_EQ(output_shape[1], 1000);
+    int output_size = output_shape[0] * output_shape[1];
+    return std::vector<float>(output_data, output_data + output_size);
+  };
+
+  // The outputs of a run are the results of the previous one, the outputs of
+  // the first run are zeros, and the results of the last one are got by the
+  // flush
+  std::vector<std::vector<float>> out_rets;
+  double cost_time = 0;
+  for (size_t i = 0; i < raw_data.size(); ++i) {
+    auto input_tensor = predictor->GetInput(0);
+    input_tensor->Resize(
+        std::vector<int64_t>(input_shape.begin(), input_shape.end()));
+    auto* data = input_tensor->mutable_data<float>();
+    memcpy(data, raw_data[i].data(), sizeof(float) * input_size);
+
+    double start = GetCurrentUS();
+    predictor->Run();
+    cost_time += GetCurrentUS() - start;
+    auto output = get_output();
+    if (i == 0) {
+      ASSERT_TRUE(std::all_of(
+          output.begin(), output.end(), [](float v) { return v == 0.f; }));
+      continue;
+    }
+    out_rets.push_back(output);
+  }
+  predictor->FlushPipelinedRuns();
+  out_rets.push_back(get_output());
+  ASSERT_EQ(out_rets.size(), raw_data.size());
+
+  LOG(INFO) << "================== Speed Report ===================";
+  LOG(INFO) << "Model: " << FLAGS_model_dir << ", threads num " << FLAGS_threads
+            << ", pipelined, iteration: " << raw_data.size() << ", spend "
+            << cost_time / raw_data.size() / 1000.0 << " ms in average.";
+
+  std::string labels_dir = FLAGS_data_dir + std::string("/labels.txt");
+  float out_accuracy = CalOutAccuracy(out_rets, labels_dir);
+  LOG(INFO) << "out_accuracy: " << out_accuracy;
+  ASSERT_GE(out_accuracy, out_accuracy_threshold);
+#endif
+}
+
 }  // namespace lite
 }  // namespace paddle
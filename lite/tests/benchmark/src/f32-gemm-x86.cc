@@ -0,0 +1,143 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "lite/tests/benchmark/src/gemm_configs.h"
+#include "lite/tests/benchmark/src/roofline-x86.h"
+
+#include "lite/backends/x86/jit/kernels.h"
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include "lite/core/context.h"
+
+namespace {
+
+void RandomFill(std::vector<float>* data) {
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto f32rng =
+      std::bind(std::uniform_real_distribution<float>(), std::ref(rng));
+  std::generate(data->begin(), data->end(), std::ref(f32rng));
+}
+
+}  // namespace
+
+// c = a * b through the blas of the build, MKL if WITH_MKL.
+static void blas_f32_gemm(const benchmark::State &state_in, const char *net) {
+  // const in parameter is used to pass CI system
+  // because google bench mark must work with a `benchmark::State &`
+  // we do a const cast here
+  benchmark::State &state = const_cast<benchmark::State &>(state_in);
+
+  const int m = state.range(0);
+  const int n = state.range(1);
+  const int k = state.range(2);
+  std::vector<float> a(m * k), b(k * n), c(m * n);
+  RandomFill(&a);
+  RandomFill(&b);
+
+  paddle::lite::X86Context ctx;
+  auto blas = paddle::lite::x86::math::GetBlas<paddle::lite::TargetType::kX86,
+                                               float>(ctx);
+  for (auto _ : state) {
+    blas.GEMM(false,
+              false,
+              m,
+              n,
+              k,
+              1.f,
+              a.data(),
+              k,
+              b.data(),
+              n,
+              0.f,
+              c.data(),
+              n);
+  }
+
+  SetRooflineCounters(state, 2. * m * n * k, 4. * (m * k + k * n + m * n));
+}
+
+// c = a * b through the jit kMatMul kernel, the best of the jit, more and
+// refer implementations for the shape.
+static void jit_f32_gemm(const benchmark::State &state_in, const char *net) {
+  benchmark::State &state = const_cast<benchmark::State &>(state_in);
+
+  const int m = state.range(0);
+  const int n = state.range(1);
+  const int k = state.range(2);
+  std::vector<float> a(m * k), b(k * n), c(m * n);
+  RandomFill(&a);
+  RandomFill(&b);
+
+  namespace jit = paddle::lite::jit;
+  jit::matmul_attr_t attr(m, n, k);
+  auto matmul = jit::KernelFuncs<jit::MatMulTuple<float>,
+                                 paddle::lite::fluid::CPUPlace>::Cache()
+                    .At(attr);
+  for (auto _ : state) {
+    matmul(a.data(), b.data(), c.data(), &attr);
+  }
+
+  SetRooflineCounters(state, 2. * m * n * k, 4. * (m * k + k * n + m * n));
+}
+
+// c = a * b with b stored in bf16, the kernel of the bf16 fc and matmul.
+static void bf16_f32_gemm(const benchmark::State &state_in, const char *net) {
+  benchmark::State &state = const_cast<benchmark::State &>(state_in);
+
+  const int m = state.range(0);
+  const int n = state.range(1);
+  const int k = state.range(2);
+  std::vector<float> a(m * k), b(k * n), c(m * n);
+  RandomFill(&a);
+  RandomFill(&b);
+  std::vector<uint16_t> b_bf16(k * n);
+  paddle::lite::x86::math::FloatToBF16(b.data(), b_bf16.data(), k * n);
+
+  for (auto _ : state) {
+    paddle::lite::x86::math::GemmBF16(m,
+                                      n,
+                                      k,
+                                      a.data(),
+                                      k,
+                                      b_bf16.data(),
+                                      n,
+                                      nullptr,
+                                      false,
+                                      c.data(),
+                                      n);
+  }
+
+  SetRooflineCounters(
+      state, 2. * m * n * k, 4. * m * k + 2. * k * n + 4. * m * n);
+}
+
+BENCHMARK_GEMM(blas_f32_gemm)
+BENCHMARK_GEMM(jit_f32_gemm)
+BENCHMARK_GEMM(bf16_f32_gemm)
+
+int main(int argc, char **argv) {
+  // M,N,K
+  RegisterEnvShapes(
+      "LITE_BENCH_GEMM_SHAPES", "blas_f32_gemm", blas_f32_gemm, 3);
+  RegisterEnvShapes("LITE_BENCH_GEMM_SHAPES", "jit_f32_gemm", jit_f32_gemm, 3);
+  RegisterEnvShapes(
+      "LITE_BENCH_GEMM_SHAPES", "bf16_f32_gemm", bf16_f32_gemm, 3);
+  return RunRooflineBenchmarks(argc, argv);
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "lite/tests/benchmark/src/gemm_configs.h"
+#include "lite/tests/benchmark/src/roofline-x86.h"
+
+#include "lite/backends/x86/math/gemm_s8u8_compute.h"
+
+// c = a * b with int8 a and b, c dequantized to fp32 or requantized to int8,
+// as the x86 int8 conv and fc run it. a is packed once like a weight.
+template <typename TYPE_C>
+static void test_gemm_s8u8(const benchmark::State &state_in) {
+  // const in parameter is used to pass CI system
+  // because google bench mark must work with a `benchmark::State &`
+  // we do a const cast here
+  benchmark::State &state = const_cast<benchmark::State &>(state_in);
+
+  const int m = state.range(0);
+  const int n = state.range(1);
+  const int k = state.range(2);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto i8rng = std::bind(std::uniform_int_distribution<int32_t>(
+                             std::numeric_limits<int8_t>::min(),
+                             std::numeric_limits<int8_t>::max()),
+                         std::ref(rng));
+  std::vector<int8_t> a(m * k), b(k * n);
+  std::generate(a.begin(), a.end(), std::ref(i8rng));
+  std::generate(b.begin(), b.end(), std::ref(i8rng));
+  std::vector<TYPE_C> c(m * n);
+  std::vector<float> scale_a(m, 0.01f), bias(m, 0.f);
+
+  paddle::lite::x86::math::generate_gemm_s8u8_x86_kern<TYPE_C> gemm(
+      false,
+      false,
+      m,
+      n,
+      k,
+      a.data(),
+      n,
+      scale_a.data(),
+      0.01f,
+      1.f,
+      bias.data(),
+      0,
+      1.f);
+  for (auto _ : state) {
+    gemm.compute(a.data(), b.data(), c.data());
+  }
+
+  SetRooflineCounters(state,
+                      2. * m * n * k,
+                      1. * m * k + 1. * k * n + sizeof(TYPE_C) * m * n,
+                      true);
+}
+
+static void int8_gemm_fp32_out(const benchmark::State &state,
+                               const char *net) {
+  test_gemm_s8u8<float>(state);
+}
+
+static void int8_gemm_int8_out(const benchmark::State &state,
+                               const char *net) {
+  test_gemm_s8u8<int8_t>(state);
+}
+
+BENCHMARK_GEMM(int8_gemm_fp32_out)
+BENCHMARK_GEMM(int8_gemm_int8_out)
+
+int main(int argc, char **argv) {
+  // M,N,K
+  RegisterEnvShapes(
+      "LITE_BENCH_GEMM_SHAPES", "int8_gemm_fp32_out", int8_gemm_fp32_out, 3);
+  RegisterEnvShapes(
+      "LITE_BENCH_GEMM_SHAPES", "int8_gemm_int8_out", int8_gemm_int8_out, 3);
+  return RunRooflineBenchmarks(argc, argv);
+}
@@ -0,0 +1,238 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "lite/kernels/x86/elementwise_compute.h"
+#include "lite/kernels/x86/layer_norm_compute.h"
+#include "lite/kernels/x86/pool_compute.h"
+#include "lite/kernels/x86/softmax_compute.h"
+#include "lite/tests/benchmark/src/roofline-x86.h"
+
+using paddle::lite::DDim;
+using paddle::lite::Tensor;
+
+static void FillRandom(Tensor* tensor) {
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto input_rng = std::bind(std::uniform_real_distribution<float>(-1.f, 1.f),
+                             std::ref(rng));
+  float* data = tensor->mutable_data<float>();
+  std::generate(data, data + tensor->numel(), std::ref(input_rng));
+}
+
+template <class Kernel, class Param>
+static void RunKernel(benchmark::State& state,  // NOLINT
+                      Kernel* kernel,
+                      const Param& param) {
+  kernel->SetParam(param);
+  std::unique_ptr<paddle::lite::KernelContext> ctx(
+      new paddle::lite::KernelContext);
+  ctx->As<paddle::lite::X86Context>();
+  kernel->SetContext(std::move(ctx));
+  kernel->PrepareForRun();
+
+  for (int i = 0; i < 2; ++i) {
+    kernel->Launch();
+  }
+
+  for (auto _ : state) {
+    kernel->Launch();
+  }
+}
+
+// args: N, C, H, W, broadcast (Y is [C] with axis 1 when broadcast != 0)
+static void elementwise_add(const benchmark::State& state_in, const char* net) {
+  benchmark::State& state = const_cast<benchmark::State&>(state_in);
+  const int64_t n = state.range(0);
+  const int64_t c = state.range(1);
+  const int64_t h = state.range(2);
+  const int64_t w = state.range(3);
+  const bool broadcast = state.range(4) != 0;
+
+  Tensor x, y, out;
+  x.Resize(DDim({n, c, h, w}));
+  FillRandom(&x);
+  y.Resize(broadcast ? DDim({c}) : DDim({n, c, h, w}));
+  FillRandom(&y);
+  out.Resize(DDim({n, c, h, w}));
+
+  paddle::lite::kernels::x86::ElementwiseAddCompute<float> add;
+  paddle::lite::operators::ElementwiseParam param;
+  param.X = &x;
+  param.Y = &y;
+  param.Out = &out;
+  param.axis = broadcast ? 1 : -1;
+  RunKernel(state, &add, param);
+
+  const double flops = out.numel();
+  const double bytes = sizeof(float) * (x.numel() + y.numel() + out.numel());
+  SetRooflineCounters(state, flops, bytes);
+}
+
+static void ElementwiseArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "C", "H", "W", "Bcast"});
+  b->Args({1, 64, 56, 56, 0});
+  b->Args({1, 64, 56, 56, 1});
+  b->Args({1, 256, 28, 28, 0});
+  b->Args({1, 512, 14, 14, 1});
+  b->Args({8, 768, 128, 1, 0});
+}
+
+// args: N, C, H, W, K, S, P, avg, global
+static void pool2d(const benchmark::State& state_in, const char* net) {
+  benchmark::State& state = const_cast<benchmark::State&>(state_in);
+  const int64_t n = state.range(0);
+  const int64_t c = state.range(1);
+  const int64_t h = state.range(2);
+  const int64_t w = state.range(3);
+  const int k = state.range(4);
+  const int s = state.range(5);
+  const int p = state.range(6);
+  const bool avg = state.range(7) != 0;
+  const bool global = state.range(8) != 0;
+
+  const int64_t out_h = global ? 1 : (h + 2 * p - k) / s + 1;
+  const int64_t out_w = global ? 1 : (w + 2 * p - k) / s + 1;
+  Tensor x, out;
+  x.Resize(DDim({n, c, h, w}));
+  FillRandom(&x);
+  out.Resize(DDim({n, c, out_h, out_w}));
+
+  paddle::lite::kernels::x86::PoolCompute<float> pool;
+  paddle::lite::operators::PoolParam param;
+  param.x = &x;
+  param.output = &out;
+  param.pooling_type = avg ? "avg" : "max";
+  param.ksize = std::vector<int>{k, k};
+  param.strides = std::vector<int>{s, s};
+  param.paddings = std::make_shared<std::vector<int>>(4, global ? 0 : p);
+  param.global_pooling = global;
+  RunKernel(state, &pool, param);
+
+  // global pooling rewrites ksize to the input extent on the first run
+  const double window = global ? h * w : k * k;
+  const double flops = window * out.numel();
+  const double bytes = sizeof(float) * (x.numel() + out.numel());
+  SetRooflineCounters(state, flops, bytes);
+}
+
+static void PoolArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "C", "H", "W", "K", "S", "P", "Avg", "Global"});
+  b->Args({1, 64, 112, 112, 3, 2, 1, 0, 0});
+  b->Args({1, 256, 28, 28, 2, 2, 0, 0, 0});
+  b->Args({1, 512, 14, 14, 3, 1, 1, 1, 0});
+  b->Args({1, 2048, 7, 7, 7, 1, 0, 1, 1});
+}
+
+// args: rows, cols (softmax over the last axis)
+static void softmax(const benchmark::State& state_in, const char* net) {
+  benchmark::State& state = const_cast<benchmark::State&>(state_in);
+  const int64_t rows = state.range(0);
+  const int64_t cols = state.range(1);
+
+  Tensor x, out;
+  x.Resize(DDim({rows, cols}));
+  FillRandom(&x);
+  out.Resize(DDim({rows, cols}));
+
+  paddle::lite::kernels::x86::SoftmaxCompute<float> softmax_compute;
+  paddle::lite::operators::SoftmaxParam param;
+  param.x = &x;
+  param.output = &out;
+  param.axis = -1;
+  RunKernel(state, &softmax_compute, param);
+
+  // max, sub, exp, sum and scale, counting exp as one op
+  const double flops = 5. * x.numel();
+  const double bytes = sizeof(float) * (x.numel() + out.numel());
+  SetRooflineCounters(state, flops, bytes);
+}
+
+static void SoftmaxArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"Rows", "Cols"});
+  b->Args({1, 1000});
+  b->Args({128, 128});
+  b->Args({12 * 128, 128});
+  b->Args({64, 32000});
+}
+
+// args: rows, cols (normalized over the last axis)
+static void layer_norm(const benchmark::State& state_in, const char* net) {
+  benchmark::State& state = const_cast<benchmark::State&>(state_in);
+  const int64_t rows = state.range(0);
+  const int64_t cols = state.range(1);
+
+  Tensor x, scale, bias, y, mean, var;
+  x.Resize(DDim({rows, cols}));
+  FillRandom(&x);
+  scale.Resize(DDim({cols}));
+  FillRandom(&scale);
+  bias.Resize(DDim({cols}));
+  FillRandom(&bias);
+  y.Resize(DDim({rows, cols}));
+  mean.Resize(DDim({rows}));
+  var.Resize(DDim({rows}));
+
+  paddle::lite::kernels::x86::LayerNormCompute<float> layer_norm_compute;
+  paddle::lite::operators::LayerNormParam param;
+  param.X = &x;
+  param.Scale = &scale;
+  param.Bias = &bias;
+  param.Y = &y;
+  param.Mean = &mean;
+  param.Variance = &var;
+  param.begin_norm_axis = 1;
+  RunKernel(state, &layer_norm_compute, param);
+
+  // mean, variance, normalize, scale and shift
+  const double flops = 8. * x.numel();
+  const double bytes =
+      sizeof(float) * (x.numel() + y.numel() + 2 * cols + 2 * rows);
+  SetRooflineCounters(state, flops, bytes);
+}
+
+static void LayerNormArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"Rows", "Cols"});
+  b->Args({128, 768});
+  b->Args({512, 768});
+  b->Args({128, 1024});
+  b->Args({32, 4096});
+}
+
+BENCHMARK_CAPTURE(elementwise_add, x86, "")
+    ->Apply(ElementwiseArguments)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(pool2d, x86, "")->Apply(PoolArguments)->UseRealTime();
+BENCHMARK_CAPTURE(softmax, x86, "")->Apply(SoftmaxArguments)->UseRealTime();
+BENCHMARK_CAPTURE(layer_norm, x86, "")
+    ->Apply(LayerNormArguments)
+    ->UseRealTime();
+
+int main(int argc, char** argv) {
+  RegisterEnvShapes(
+      "LITE_BENCH_ELTWISE_SHAPES", "elementwise_add", elementwise_add, 5);
+  RegisterEnvShapes("LITE_BENCH_POOL_SHAPES", "pool2d", pool2d, 9);
+  RegisterEnvShapes("LITE_BENCH_SOFTMAX_SHAPES", "softmax", softmax, 2);
+  RegisterEnvShapes(
+      "LITE_BENCH_LAYER_NORM_SHAPES", "layer_norm", layer_norm, 2);
+  return RunRooflineBenchmarks(argc, argv);
+}
@@ -0,0 +1,237 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include "lite/backends/x86/parallel.h"
+
+// Roofline reporting of the x86 micro benchmarks. The peak of the machine is
+// measured once per process, then every benchmark reports
+//   FLOPS:     the operations per second, a multiply-add counts as two;
+//   Bytes:     the compulsory memory traffic per second, every input read
+//              once and every output written once;
+//   AI:        the arithmetic intensity, FLOPS / Bytes;
+//   %roofline: the achieved FLOPS in percent of min(peak FLOPS, AI * peak
+//              bandwidth), what the machine could do at this intensity.
+// Low %roofline marks the kernels worth optimizing.
+
+struct MachinePeak {
+  double flops{0.};      // fp32 operations per second
+  double int8_ops{0.};   // int8 multiply-adds (x2) per second
+  double bandwidth{0.};  // bytes per second of a streaming triad
+};
+
+// The threads of the kernels and of the peak measurement, LITE_BENCH_THREADS
+// or 1.
+static int BenchThreads() {
+  static const int threads = [] {
+    const char* env = getenv("LITE_BENCH_THREADS");
+    int num = std::max(env ? atoi(env) : 1, 1);
+    paddle::lite::x86::SetNumThreads(num);
+    return num;
+  }();
+  return threads;
+}
+
+// Runs `f` on BenchThreads() threads at once and returns the best wall time
+// in seconds of `repeats` rounds.
+static double TimeOnAllThreads(const std::function<void(int)>& f,
+                               int repeats = 3) {
+  double best = 1e30;
+  for (int r = 0; r < repeats; ++r) {
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < BenchThreads(); ++t) {
+      threads.emplace_back(f, t);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+// Independent chains of fp32 multiply-adds, enough of them to hide the
+// latency. Returns the operations done.
+static double FlopsKernel(int64_t iters) {
+  const int kChains = 10;
+#ifdef __AVX__
+  __m256 acc[kChains];
+  for (int j = 0; j < kChains; ++j) acc[j] = _mm256_set1_ps(j * 0.1f);
+  const __m256 a = _mm256_set1_ps(0.999f);
+  const __m256 b = _mm256_set1_ps(1e-3f);
+  for (int64_t i = 0; i < iters; ++i) {
+    for (int j = 0; j < kChains; ++j) {
+#ifdef __FMA__
+      acc[j] = _mm256_fmadd_ps(acc[j], a, b);
+#else
+      acc[j] = j & 1 ? _mm256_add_ps(acc[j], b) : _mm256_mul_ps(acc[j], a);
+#endif
+    }
+  }
+  for (int j = 0; j < kChains; ++j) benchmark::DoNotOptimize(acc[j]);
+#ifdef __FMA__
+  return static_cast<double>(iters) * kChains * 16;
+#else
+  return static_cast<double>(iters) * kChains * 8;
+#endif
+#else
+  float acc[kChains][4];
+  for (int j = 0; j < kChains; ++j) {
+    for (int l = 0; l < 4; ++l) acc[j][l] = j * 0.1f;
+  }
+  for (int64_t i = 0; i < iters; ++i) {
+    for (int j = 0; j < kChains; ++j) {
+      for (int l = 0; l < 4; ++l) acc[j][l] = acc[j][l] * 0.999f + 1e-3f;
+    }
+  }
+  benchmark::DoNotOptimize(acc);
+  return static_cast<double>(iters) * kChains * 8;
+#endif
+}
+
+// Chains of u8 x s8 multiply-adds as the x86 int8 gemm issues them.
+static double Int8OpsKernel(int64_t iters) {
+#ifdef __AVX2__
+  const int kChains = 10;
+  __m256i acc[kChains];
+  for (int j = 0; j < kChains; ++j) acc[j] = _mm256_set1_epi8(j + 1);
+  const __m256i b = _mm256_set1_epi8(1);
+  for (int64_t i = 0; i < iters; ++i) {
+    for (int j = 0; j < kChains; ++j) {
+      acc[j] = _mm256_maddubs_epi16(acc[j], b);
+    }
+  }
+  for (int j = 0; j < kChains; ++j) benchmark::DoNotOptimize(acc[j]);
+  return static_cast<double>(iters) * kChains * 64;
+#else
+  return FlopsKernel(iters);
+#endif
+}
+
+static const MachinePeak& GetMachinePeak() {
+  static const MachinePeak peak = [] {
+    MachinePeak ret;
+    const int threads = BenchThreads();
+    const int64_t iters = 1 << 22;
+    ret.flops = FlopsKernel(iters) * threads /
+                TimeOnAllThreads([&](int) { FlopsKernel(iters); });
+    ret.int8_ops = Int8OpsKernel(iters) * threads /
+                   TimeOnAllThreads([&](int) { Int8OpsKernel(iters); });
+
+    // a = b + s * c over arrays far larger than the last level cache.
+    const int64_t size = 16 << 20;
+    std::vector<float> a(size, 0.f), b(size, 1.f), c(size, 2.f);
+    auto triad = [&](int t) {
+      const int64_t begin = size * t / threads;
+      const int64_t end = size * (t + 1) / threads;
+      for (int64_t i = begin; i < end; ++i) {
+        a[i] = b[i] + 0.5f * c[i];
+      }
+    };
+    ret.bandwidth = 3. * size * sizeof(float) / TimeOnAllThreads(triad);
+    benchmark::DoNotOptimize(a.data());
+    return ret;
+  }();
+  return peak;
+}
+
+// Sets the roofline counters of a benchmark doing `flops` operations and
+// moving `bytes` bytes per iteration, against the int8 peak if `int8`.
+static void SetRooflineCounters(benchmark::State& state,  // NOLINT
+                                double flops,
+                                double bytes,
+                                bool int8 = false) {
+  const auto& peak = GetMachinePeak();
+  const double iters = state.iterations();
+  const double intensity = flops / bytes;
+  const double roof = std::min(int8 ? peak.int8_ops : peak.flops,
+                               intensity * peak.bandwidth);
+  state.counters["FLOPS"] =
+      benchmark::Counter(iters * flops, benchmark::Counter::kIsRate);
+  state.counters["Bytes"] =
+      benchmark::Counter(iters * bytes, benchmark::Counter::kIsRate);
+  state.counters["AI"] = intensity;
+  state.counters["%roofline"] = benchmark::Counter(
+      iters * flops / roof * 100, benchmark::Counter::kIsRate);
+}
+
+typedef void (*ShapeBenchmark)(const benchmark::State&, const char*);
+
+// Registers `fn` as "<name>/env" over the shapes listed in the environment
+// variable `env`, such as "64,64,64;128,256,512" for two shapes of three
+// values. Shapes with other than `num_args` values are skipped.
+static void RegisterEnvShapes(const char* env,
+                              const std::string& name,
+                              ShapeBenchmark fn,
+                              size_t num_args) {
+  const char* value = getenv(env);
+  if (value == nullptr) return;
+  std::vector<std::vector<int64_t>> shapes;
+  std::stringstream list(value);
+  std::string item;
+  while (std::getline(list, item, ';')) {
+    std::vector<int64_t> shape;
+    std::stringstream dims(item);
+    std::string dim;
+    while (std::getline(dims, dim, ',')) {
+      shape.push_back(atoll(dim.c_str()));
+    }
+    if (shape.size() != num_args) {
+      fprintf(stderr, "Skip the shape \"%s\" of %s\n", item.c_str(), env);
+      continue;
+    }
+    shapes.push_back(shape);
+  }
+  if (shapes.empty()) return;
+  auto* b = benchmark::RegisterBenchmark(
+      (name + "/env").c_str(),
+      [fn](benchmark::State& state) { fn(state, "env"); });
+  for (auto& shape : shapes) {
+    b->Args(shape);
+  }
+  b->UseRealTime();
+}
+
+// The main of the x86 benchmarks, prints the peak of the machine first.
+static int RunRooflineBenchmarks(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  const auto& peak = GetMachinePeak();
+  fprintf(stderr,
+          "threads: %d, peak: %.1f GFLOP/s fp32, %.1f GOP/s int8, %.1f GB/s\n",
+          BenchThreads(),
+          peak.flops * 1e-9,
+          peak.int8_ops * 1e-9,
+          peak.bandwidth * 1e-9);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
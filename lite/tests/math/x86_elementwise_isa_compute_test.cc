@@ -0,0 +1,122 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef LITE_WITH_X86
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/math/isa/elementwise_isa.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace x86 = paddle::lite::x86;
+namespace isa = paddle::lite::x86::math::isa;
+
+namespace {
+
+const x86::cpu_isa_t kVariants[] = {
+    x86::isa_any, x86::sse42, x86::avx2, x86::avx512f};
+
+float naive_binary(isa::BinaryOp op, float a, float b, bool relu) {
+  float r = 0.f;
+  switch (op) {
+    case isa::BinaryOp::kAdd:
+      r = a + b;
+      break;
+    case isa::BinaryOp::kSub:
+      r = a - b;
+      break;
+    case isa::BinaryOp::kMul:
+      r = a * b;
+      break;
+    case isa::BinaryOp::kDiv:
+      r = a / b;
+      break;
+    case isa::BinaryOp::kMax:
+      r = a > b ? a : b;
+      break;
+    case isa::BinaryOp::kMin:
+      r = a < b ? a : b;
+      break;
+  }
+  return relu && r < 0.f ? 0.f : r;
+}
+
+void test_variant(const isa::ElementwiseKernels& kernels, int num) {
+  std::vector<float> x(num), y(num), z(num);
+  fill_data_rand(x.data(), -2.f, 2.f, num);
+  fill_data_rand(y.data(), 0.5f, 3.f, num);
+  for (int op = 0; op <= static_cast<int>(isa::BinaryOp::kMin); ++op) {
+    auto binary_op = static_cast<isa::BinaryOp>(op);
+    for (bool relu : {false, true}) {
+      kernels.range_to_range(
+          x.data(), y.data(), z.data(), num, binary_op, relu);
+      for (int i = 0; i < num; ++i) {
+        EXPECT_FLOAT_EQ(z[i], naive_binary(binary_op, x[i], y[i], relu))
+            << "isa " << kernels.isa << " op " << op << " num " << num;
+      }
+      kernels.range_to_one(
+          x.data(), y.data(), z.data(), num, binary_op, relu);
+      for (int i = 0; i < num; ++i) {
+        EXPECT_FLOAT_EQ(z[i], naive_binary(binary_op, x[i], y[0], relu))
+            << "isa " << kernels.isa << " op " << op << " num " << num;
+      }
+      kernels.one_to_range(
+          x.data(), y.data(), z.data(), num, binary_op, relu);
+      for (int i = 0; i < num; ++i) {
+        EXPECT_FLOAT_EQ(z[i], naive_binary(binary_op, x[0], y[i], relu))
+            << "isa " << kernels.isa << " op " << op << " num " << num;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TestX86ElementwiseIsa, all_host_variants) {
+  ASSERT_TRUE(isa::ElementwiseKernelsFor(x86::isa_any) != nullptr);
+  for (auto variant : kVariants) {
+    const isa::ElementwiseKernels* kernels =
+        isa::ElementwiseKernelsFor(variant);
+    if (kernels == nullptr || !x86::HostSupportsIsa(variant)) {
+      LOG(INFO) << "skip isa " << variant;
+      continue;
+    }
+    EXPECT_EQ(kernels->isa, variant);
+    for (int num : {1, 3, 4, 15, 16, 31, 33, 100, 1027}) {
+      test_variant(*kernels, num);
+    }
+  }
+}
+
+TEST(TestX86ElementwiseIsa, force_lower_isa) {
+  const x86::cpu_isa_t host_isa = x86::RuntimeIsa();
+  for (auto variant : kVariants) {
+    x86::SetMaxIsa(variant);
+    const isa::ElementwiseKernels& kernels = isa::Elementwise();
+    EXPECT_TRUE(x86::HostSupportsIsa(kernels.isa));
+    if (x86::HostSupportsIsa(variant)) {
+      EXPECT_EQ(x86::RuntimeIsa(), variant);
+    }
+    if (variant == x86::isa_any) {
+      EXPECT_EQ(kernels.isa, x86::isa_any);
+    }
+    test_variant(kernels, 37);
+  }
+  x86::SetMaxIsa(host_isa);
+  EXPECT_EQ(x86::RuntimeIsa(), host_isa);
+}
+
+#endif  // LITE_WITH_X86
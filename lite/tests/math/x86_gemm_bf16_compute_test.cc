@@ -0,0 +1,143 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifdef LITE_WITH_X86
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include "lite/backends/x86/math/isa/gemm_bf16_isa.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace x86 = paddle::lite::x86;
+namespace math = paddle::lite::x86::math;
+namespace isa = paddle::lite::x86::math::isa;
+
+namespace {
+
+const x86::cpu_isa_t kVariants[] = {
+    x86::isa_any, x86::sse42, x86::avx2, x86::avx512f};
+
+void naive_gemm_bf16(int m,
+                     int n,
+                     int k,
+                     const float* a,
+                     const uint16_t* b,
+                     const float* bias,
+                     bool relu,
+                     float* c) {
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double sum = bias ? bias[j] : 0.;
+      for (int p = 0; p < k; ++p) {
+        sum += a[i * k + p] * math::BF16ToFloat(b[p * n + j]);
+      }
+      c[i * n + j] = relu && sum < 0. ? 0.f : static_cast<float>(sum);
+    }
+  }
+}
+
+void test_variant(const isa::GemmBF16Kernels& kernels, int m, int n, int k) {
+  std::vector<float> a(m * k), w(k * n), bias(n), c(m * n), ref(m * n);
+  std::vector<uint16_t> b(k * n);
+  fill_data_rand(a.data(), -1.f, 1.f, m * k);
+  fill_data_rand(w.data(), -1.f, 1.f, k * n);
+  fill_data_rand(bias.data(), -1.f, 1.f, n);
+  math::FloatToBF16(w.data(), b.data(), k * n);
+  for (bool with_bias : {false, true}) {
+    for (bool relu : {false, true}) {
+      const float* bias_data = with_bias ? bias.data() : nullptr;
+      naive_gemm_bf16(m, n, k, a.data(), b.data(), bias_data, relu, ref.data());
+      // Two calls over halves of the columns, as the threads would do.
+      const int split = n / 2;
+      for (int half = 0; half < 2; ++half) {
+        int n_begin = half == 0 ? 0 : split;
+        int n_end = half == 0 ? split : n;
+        kernels.gemm(m,
+                     k,
+                     a.data(),
+                     k,
+                     b.data(),
+                     n,
+                     bias_data,
+                     relu,
+                     c.data(),
+                     n,
+                     n_begin,
+                     n_end);
+      }
+      for (int i = 0; i < m * n; ++i) {
+        EXPECT_NEAR(c[i], ref[i], 1e-4f * (k + 1))
+            << "isa " << kernels.isa << " m " << m << " n " << n << " k " << k;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TestX86GemmBF16, convert) {
+  EXPECT_EQ(math::FloatToBF16(1.f), 0x3f80);
+  EXPECT_EQ(math::FloatToBF16(-2.f), 0xc000);
+  // 1 + 2^-8 is a tie between 1 and 1 + 2^-7 and rounds to the even one.
+  EXPECT_EQ(math::FloatToBF16(1.00390625f), 0x3f80);
+  EXPECT_EQ(math::FloatToBF16(1.01171875f), 0x3f82);
+  EXPECT_TRUE(std::isnan(math::BF16ToFloat(math::FloatToBF16(NAN))));
+  EXPECT_TRUE(std::isinf(math::BF16ToFloat(math::FloatToBF16(INFINITY))));
+  std::vector<float> x(1000);
+  fill_data_rand(x.data(), -100.f, 100.f, 1000);
+  for (float v : x) {
+    float r = math::BF16ToFloat(math::FloatToBF16(v));
+    EXPECT_LE(std::fabs(r - v), std::fabs(v) / 256.f);
+  }
+}
+
+TEST(TestX86GemmBF16, all_host_variants) {
+  ASSERT_TRUE(isa::GemmBF16KernelsFor(x86::isa_any) != nullptr);
+  for (auto variant : kVariants) {
+    const isa::GemmBF16Kernels* kernels = isa::GemmBF16KernelsFor(variant);
+    if (kernels == nullptr || !x86::HostSupportsIsa(variant)) {
+      LOG(INFO) << "skip isa " << variant;
+      continue;
+    }
+    EXPECT_EQ(kernels->isa, variant);
+    for (int m : {1, 3, 4, 9}) {
+      for (int n : {1, 7, 16, 33, 100}) {
+        for (int k : {1, 5, 64}) {
+          test_variant(*kernels, m, n, k);
+        }
+      }
+    }
+  }
+}
+
+TEST(TestX86GemmBF16, threaded) {
+  const int m = 8, n = 1000, k = 300;
+  std::vector<float> a(m * k), w(k * n), bias(n), c(m * n), ref(m * n);
+  std::vector<uint16_t> b(k * n);
+  fill_data_rand(a.data(), -1.f, 1.f, m * k);
+  fill_data_rand(w.data(), -1.f, 1.f, k * n);
+  fill_data_rand(bias.data(), -1.f, 1.f, n);
+  math::FloatToBF16(w.data(), b.data(), k * n);
+  naive_gemm_bf16(m, n, k, a.data(), b.data(), bias.data(), true, ref.data());
+  math::GemmBF16(
+      m, n, k, a.data(), k, b.data(), n, bias.data(), true, c.data(), n);
+  for (int i = 0; i < m * n; ++i) {
+    EXPECT_NEAR(c[i], ref[i], 1e-2f);
+  }
+}
+
+#endif  // LITE_WITH_X86
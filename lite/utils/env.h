@@ -35,6 +35,39 @@
 // target device model online during the execution phase.
 #define SUBGRAPH_ONLINE_MODE "SUBGRAPH_ONLINE_MODE"
 
+// The device programs of a subgraph are cached by their input shapes, and the
+// least recently used one is released if the number of the programs exceeds
+// 'SUBGRAPH_PROGRAM_CACHE_CAPACITY' or their estimated memory exceeds
+// 'SUBGRAPH_PROGRAM_CACHE_MEMORY_BUDGET'(MB), both of them are unlimited by
+// default. Only supported by the NNAdapter subgraph engine now.
+#define SUBGRAPH_PROGRAM_CACHE_CAPACITY "SUBGRAPH_PROGRAM_CACHE_CAPACITY"
+#define SUBGRAPH_PROGRAM_CACHE_MEMORY_BUDGET \
+  "SUBGRAPH_PROGRAM_CACHE_MEMORY_BUDGET"
+
+// Specify the axes of the subgraph inputs which can be padded with zeros, such
+// as 'x:3;y:1,2', it means the 4th axis of 'x' and the 2nd and 3rd axes of 'y'.
+// The inputs are padded to the nearest shapes of the cached device programs,
+// or rounded up to the powers of 2 to build a new one, so that the
+// recompilation becomes rare. It only works for the models which are not
+// affected by the zero padding, and 'SUBGRAPH_PADDING_OUTPUT_AXES' should
+// specify the axes of all of the outputs, or the padding is disabled. Only
+// supported by the NNAdapter subgraph engine now.
+#define SUBGRAPH_PADDING_INPUT_AXES "SUBGRAPH_PADDING_INPUT_AXES"
+
+// Specify the output axes which follow the padded input axes, such as
+// 'out:1=x:3;mask:', it means the 2nd axis of 'out' follows the 4th axis of
+// 'x' and 'mask' is not affected by the padding. The output axes are cropped
+// in proportion to the extents of the input axes before the padding, i.e.
+// ceil(padded_output_extent * input_extent / padded_input_extent). The engine
+// can not infer the output shapes of the device program, so an output axis
+// may only follow an input axis through the ops whose output extent is
+// proportional to their input extent, such as the element-wise ops, the
+// 'same' padded convolutions and poolings, and the strided ones with the
+// padded extents divisible by the strides. The outputs of the other ops, e.g.
+// a convolution or a pooling with 'valid' padding, are cropped to wrong
+// shapes.
+#define SUBGRAPH_PADDING_OUTPUT_AXES "SUBGRAPH_PADDING_OUTPUT_AXES"
+
 // The environment variables for the quant model settings, use "QUANT_" as
 // prefix.
 // Apply the constraints for the quantized ops(such as concat) that the inputs
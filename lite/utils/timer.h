@@ -18,6 +18,8 @@
 #include <cmath>
 #include <string>
 #include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
 #include "lite/utils/log/cp_logging.h"
 #include "lite/utils/string.h"
 
@@ -98,5 +100,39 @@ class Timer {
   int count_;
 };
 
+// Records the elapsed time of consecutive phases, e.g. of the construction of
+// a predictor.
+class PhaseTimer {
+ public:
+  PhaseTimer() : last_us_(Timer::GetCurrentUS()) {}
+
+  // End the current phase with the name `phase` and start the next one.
+  void Mark(const std::string& phase) {
+    uint64_t now_us = Timer::GetCurrentUS();
+    phases_.emplace_back(phase, (now_us - last_us_) / 1000.0f);
+    last_us_ = now_us;
+  }
+
+  // The phases and their elapsed time in ms.
+  const std::vector<std::pair<std::string, float>>& phases() const {
+    return phases_;
+  }
+
+  std::string Summary() const {
+    std::string summary;
+    float total = 0.f;
+    for (auto& phase : phases_) {
+      summary +=
+          string_format("%s: %.3f ms, ", phase.first.c_str(), phase.second);
+      total += phase.second;
+    }
+    return summary + string_format("total: %.3f ms", total);
+  }
+
+ private:
+  uint64_t last_us_;
+  std::vector<std::pair<std::string, float>> phases_;
+};
+
 }  // namespace lite
 }  // namespace paddle